@@ -1,13 +1,77 @@
+// Deklarasi POSIX/GNU (open_memstream, fdopen, clock_gettime, SOCK_NONBLOCK) juga saat dikompilasi -std=c11
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+#include <ctype.h> // tolower, hanya untuk pembanding di --uji-cari
+
+// mmap hanya tersedia di sistem POSIX; di Windows (MinGW) data dibaca ke memori biasa
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <poll.h>
+#define PAKAI_MMAP 1
+#else
+#include <io.h> // dup/dup2 untuk mode batch
+#define PAKAI_MMAP 0
+#endif
+
+// Mode server memakai epoll dan soket Unix, keduanya khusus Linux
+#ifdef __linux__
+#include <errno.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#define PAKAI_EPOLL 1
+#else
+#define PAKAI_EPOLL 0
+#endif
+
+// Pencocok substring SIMD (SSE2/AVX2) dipilih saat runtime; selain x86 + GCC/Clang hanya versi skalar
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PAKAI_SIMD_X86 1
+#else
+#define PAKAI_SIMD_X86 0
+#endif
 
 #define NAMA_FILE "data_tiket.txt"
+#define NAMA_FILE_SEMENTARA "data_tiket.txt.tmp"
+#define NAMA_FILE_UBAH "data_tiket.txt.ubah" // record yang sedang ditimpa di tempat (double write)
+#define MAGIC_UBAH "UBH"
+#define MAGIC_FILE "TKT"
+#define VERSI_FILE 2 // versi 2: header menyimpan urutan ID (id_berikutnya)
+#define NAMA_FILE_JURNAL "data_tiket.jurnal"
+#define NAMA_FILE_JURNAL_LAMA "data_tiket.jurnal.lama"
+#define BATAS_JURNAL 1024 // jumlah transaksi di jurnal sebelum dipadatkan ke snapshot
+#define JENDELA_KOMIT_MS 2 // group commit: batas tunda fsync jurnal saat pembelian terus berdatangan
+#define JEDA_ULANG_KOMIT_MS 100 // fsync jurnal yang gagal dicoba lagi setelah jeda ini
 #define MAX_NAMA 50
 #define MAX_KATEGORI 20
 #define KADALUARSA_DETIK (7 * 24 * 60 * 60) // 7 hari dalam detik
+#define KAPASITAS_AWAL 16 // kapasitas minimum blok tiket
+#define ID_NISAN 0 // id slot tiket yang sudah dihapus (ID asli selalu mulai dari 1)
+#define RASIO_NISAN 4 // padatkan array bila lebih dari 1/RASIO_NISAN slot berisi nisan
+#define RASIO_KOTOR 4 // tulis ulang file utuh bila lebih dari 1/RASIO_KOTOR record berubah sejak snapshot terakhir
+#define RASIO_TERSEDIA_JARANG 16 // di bawah 1/RASIO_TERSEDIA_JARANG slot bersetok, daftar tersedia dibangun dari peta bit
+#define ADMIN_USERNAME "NabilahArkanKey"
+#define ADMIN_PASSWORD 2025
+
+// Hasil beli_stok_atomik()
+#define BELI_BERHASIL 0
+#define BELI_TIDAK_DITEMUKAN 1
+#define BELI_STOK_KURANG 2
+#define BELI_JUMLAH_TIDAK_VALID 3
 
 // Struktur Tiket
 typedef struct {
@@ -19,17 +83,259 @@ typedef struct {
     time_t waktu_dibuat;
 } Tiket;
 
+// Header file data, diikuti langsung oleh array Tiket (32 byte agar array tetap rata saat di-mmap)
+typedef struct {
+    char magic[4];          // "TKT\0"
+    uint32_t versi;
+    uint32_t jumlah_record; // jumlah slot tiket di file, termasuk nisan (id 0)
+    uint32_t ukuran_record; // sizeof(Tiket) saat file ditulis
+    uint64_t lsn_snapshot;  // nomor transaksi jurnal terakhir yang sudah tercakup file ini
+    uint32_t id_berikutnya; // ID untuk tiket baru berikutnya; tidak pernah mundur
+    uint32_t urutan_tampilan; // hasil SORT terakhir (0 = urutan simpan, 1 = harga, 2 = nama)
+} HeaderFile;
+
+// Satu transaksi stok di jurnal (ukuran tetap). stok_sesudah membuat pemutaran ulang idempotent.
+typedef struct {
+    uint64_t lsn;           // nomor urut transaksi, selalu naik
+    int32_t id;
+    int32_t delta_stok;     // perubahan stok (negatif untuk pembelian)
+    int32_t stok_sesudah;
+    uint32_t checksum;      // untuk mengenali ekor jurnal yang tertulis setengah
+} RecordJurnal;
+
 // Variabel global
 Tiket *daftar_tiket = NULL;
-int jumlah_tiket = 0;
+int jumlah_tiket = 0; // jumlah slot terpakai, termasuk nisan
+int jumlah_nisan = 0; // slot yang ditandai terhapus dan menunggu pemadatan
+
+// Header file ubah (NAMA_FILE_UBAH), diikuti HeaderFile baru, posisi[jumlah] dan Tiket[jumlah]
+typedef struct {
+    char magic[4];      // "UBH\0"
+    uint32_t jumlah;    // jumlah record yang ditimpa
+    uint32_t checksum;  // FNV-1a atas semua byte sesudah header ini
+    uint32_t cadangan;
+} HeaderUbah;
+
+// Blok penyimpanan = HeaderFile + array Tiket. Dengan PAKAI_MMAP file data dipetakan MAP_PRIVATE
+// (copy-on-write), tanpa mmap hasil malloc biasa. Perubahan di memori tidak pernah sampai ke file
+// dengan sendirinya: file hanya ditulis tulis_penyangga(), jadi setelah crash isinya selalu satu
+// snapshot yang lengkap (ditambah jurnal).
+char *blok_data = NULL;
+size_t ukuran_blok = 0;
+
+// Record kotor: posisi di file data yang berubah sejak snapshot terakhir. Bit di peta_kotor
+// mencegah posisi yang sama masuk daftar dua kali.
+int jumlah_record_disk = 0; // record yang sudah ada di file data; di belakangnya ekor baru
+uint64_t *peta_kotor = NULL;
+int *posisi_kotor = NULL;
+int jumlah_kotor = 0, kapasitas_kotor = 0;
+int tulis_ulang_penuh = 1; // setelah pemadatan (record bergeser) atau terlalu banyak perubahan
+
+// Penyangga snapshot: utas utama menyalin perubahan (beserta lsn yang dicakupnya) ke penyangga,
+// utas penulis menulisnya tanpa menyentuh blok_data. Penyangga penuh berisi semua record (file
+// sementara + rename), penyangga sebagian hanya record kotor + ekor baru (lewat file ubah).
+// Satu penyangga sedang ditulis, satu diisi; permintaan selagi penulis sibuk digabung ke yang menunggu.
+typedef struct {
+    HeaderFile header;
+    int penuh, jumlah, kapasitas;
+    int *posisi; // penyangga sebagian: posisi isi[k] di file data
+    Tiket *isi;
+} PenyanggaSimpan;
+PenyanggaSimpan penyangga_simpan[2];
+int penyangga_antre = -1, penyangga_ditulis = -1; // -1 = tidak ada
+int simpan_gagal = 0; // file data tertinggal dari memori: penyangga sebagian dilewati, snapshot berikutnya penuh
+
+// Jurnal pembelian yang ditambahkan di belakang snapshot
+FILE *file_jurnal = NULL;
+uint64_t lsn_terakhir = 0;
+int isi_jurnal = 0;
+// Group commit: record jurnal sampai lsn_tahan_crash sudah di-fsync. Record sesudahnya baru
+// ada di page cache dan dikomit bersama begitu masukan menganggur, paling lambat jendela_komit_ms
+// setelah record pertamanya.
+uint64_t lsn_tahan_crash = 0;
+long long tenggat_komit = -1; // waktu_ms() saat komit wajib dijalankan; -1 = tidak ada yang tertunda
+int komit_gagal = 0; // fsync terakhir gagal: jawaban tetap ditahan dan komit diulang setelah JEDA_ULANG_KOMIT_MS
+int jendela_komit_ms = JENDELA_KOMIT_MS;
+#if PAKAI_MMAP
+// Utas penulis snapshot: utas utama hanya mengisi penyangga, file ditulis di utas ini
+pthread_mutex_t kunci_snapshot = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t sinyal_snapshot = PTHREAD_COND_INITIALIZER; // ada permintaan baru, atau penulis selesai
+pthread_t utas_penulis;
+int penulis_hidup = 0, penulis_berhenti = 0;
+int jurnal_lama_ada = 0;  // jurnal hasil rotasi yang belum tercakup snapshot
+#endif
+
+// Indeks hash id -> posisi di daftar_tiket
+typedef struct {
+    int id;
+    int posisi; // -1 jika slot kosong
+} SlotIndeks;
+SlotIndeks *indeks_id = NULL;
+int kapasitas_indeks = 0; // selalu pangkat dua, minimal dua kali jumlah tiket
+
+// Indeks kadaluarsa: min-heap (waktu kadaluarsa, id). Entri tiket yang sudah dihapus
+// dibiarkan basi dan baru dibuang saat sampai di puncak heap.
+typedef struct {
+    time_t waktu; // waktu_dibuat + KADALUARSA_DETIK
+    int id;
+} EntriKadaluarsa;
+EntriKadaluarsa *heap_kadaluarsa = NULL;
+int ukuran_heap = 0;
+int kapasitas_heap = 0;
+
+// Salinan casefold nama & kode kategori, sejajar dengan daftar_tiket (teks_lipat[i] milik daftar_tiket[i]).
+// Hanya di memori; blok tiket di file tidak berubah.
+typedef struct {
+    char nama[MAX_NAMA];
+    unsigned char panjang_nama; // strlen(nama), agar pencocok tidak perlu mencari '\0'
+    unsigned char kode_kategori; // indeks kamus_kategori
+} TeksLipat;
+TeksLipat *teks_lipat = NULL;
+int kapasitas_lipat = 0;
+
+// Kolom panas (structure-of-arrays): id, harga, stok dan waktu_dibuat setiap tiket disalin ke array
+// per kolom, sejajar dengan daftar_tiket. Pemindaian stok, heap kadaluarsa dan indeks urutan harga cukup
+// membaca 4-8 byte per tiket, bukan seluruh Tiket beserta teksnya. Blok tiket tetap sumber kebenaran
+// (dan format file); penulisan field ini harus lewat atur_harga/atur_stok agar kolomnya ikut berubah.
+int *kolom_id = NULL;       // ID_NISAN untuk slot yang dihapus
+float *kolom_harga = NULL;
+int *kolom_stok = NULL;
+time_t *kolom_waktu = NULL;
+int kapasitas_kolom = 0;
+
+// Peta tersedia: bit i menyala = daftar_tiket[i] aktif dan stoknya > 0, ditambah hitungan bit yang menyala.
+// "Masih ada tiket?" cukup O(1), dan daftar tiket tersedia hanya menelusuri bit yang menyala; saat tiket
+// ludes sebagian besar word bernilai 0 dan dilompati 64 slot sekaligus.
+uint64_t *peta_tersedia = NULL; // kapasitas_kolom bit
+int jumlah_tersedia = 0;
+
+// Indeks urutan: posisi tiket terurut menurut (harga, id) dan (nama, id), dirawat setiap tiket
+// ditambah, diubah atau dihapus. SORT hanya memilih indeks yang dijalani daftar; Tiket tidak dipindah.
+typedef struct {
+    int *isi;           // posisi tiket; -1 = lubang (tiket dihapus atau kuncinya berubah)
+    int jumlah;         // entri terpakai, termasuk lubang
+    int terurut;        // isi[0..terurut) sudah urut, sisanya ekor tiket baru/berubah
+    int lubang;
+    int kapasitas;
+    int *letak;         // letak[posisi] = indeks entri tiket itu di isi, -1 jika tidak ada
+    int kapasitas_letak;
+    int (*banding)(const void *a, const void *b); // membandingkan dua posisi (int *)
+    uint64_t (*kunci)(int posisi, int kedalaman); // kunci radix yang urutannya sama dengan `banding`
+    int kunci_awalan;   // 1 = kunci hanya 8 byte nama mulai byte ke-8*kedalaman; seri dipecah lagi
+} IndeksUrut;
+int banding_urut_harga(const void *a, const void *b);
+int banding_urut_nama(const void *a, const void *b);
+uint64_t kunci_urut_harga(int posisi, int kedalaman);
+uint64_t kunci_urut_nama(int posisi, int kedalaman);
+IndeksUrut urut_harga = { NULL, 0, 0, 0, 0, NULL, 0, banding_urut_harga, kunci_urut_harga, 0 };
+IndeksUrut urut_nama = { NULL, 0, 0, 0, 0, NULL, 0, banding_urut_nama, kunci_urut_nama, 1 };
+int urutan_tampilan = 0; // 0 = urutan simpan, 1 = harga termurah, 2 = nama A-Z; disimpan di header
+
+// Kamus kategori: setiap kategori (casefold) di-intern menjadi kode kecil dengan bitmap slot
+// daftar_tiket yang aktif berkategori itu. Kode 0 menampung kategori yang tidak muat lagi di kamus.
+#define MAX_KODE_KATEGORI 256
+#define SLOT_KAMUS_KATEGORI 512 // tabel hash nama -> kode, pangkat dua dan > 2 * MAX_KODE_KATEGORI
+typedef struct {
+    char nama[MAX_KATEGORI];
+    uint64_t *bitmap; // bit i menyala = daftar_tiket[i] aktif dan berkategori ini
+} EntriKategori;
+EntriKategori kamus_kategori[MAX_KODE_KATEGORI];
+int jumlah_kode_kategori = 1; // kode 0 selalu ada
+unsigned char slot_kamus_kategori[SLOT_KAMUS_KATEGORI]; // 0 = slot kosong
+int kata_bitmap_kategori = 0; // panjang setiap bitmap dalam uint64_t
+
+// Indeks trigram nama konser: potongan 3 huruf (casefold) -> posting list ID tiket (urut naik)
+typedef struct {
+    uint32_t kode; // 3 byte casefold; 0 = slot tabel kosong
+    int jumlah;
+    int kapasitas;
+    int *id;
+} PostingTrigram;
+PostingTrigram *tabel_trigram = NULL;
+int kapasitas_trigram = 0; // selalu pangkat dua
+int jumlah_trigram = 0;
+int tiket_basi_trigram = 0; // tiket yang dihapus sejak indeks terakhir dibangun
 
 // --- FUNGSI PROTOTIPE ---
 void bersihkan_buffer();
 void muat_data();
-void simpan_data();
+int simpan_data();
+void simpan_data_latar();
+int ubah_kapasitas(int kapasitas);
+int cadangkan_kapasitas(int minimal);
+int susutkan_kapasitas();
+void tutup_data();
+int catat_jurnal(int id, int delta_stok, int stok_sesudah);
+void tunggu_snapshot();
+void hentikan_penulis();
 int buat_id_unik();
+int pesan_blok_id(int jumlah);
+void bangun_indeks_id();
+void indeks_tambah(int posisi);
+void indeks_hapus(int id);
+int cari_indeks_id(int id);
+int jumlah_tiket_aktif();
+void tandai_nisan(int posisi);
+void padatkan_tiket();
+void padatkan_jika_perlu();
+void bangun_kolom();
+void isi_kolom(int posisi);
+void kosongkan_kolom();
+void perbarui_tersedia(int posisi);
+void bangun_tersedia();
+int tersedia_berikutnya(int mulai);
+void atur_harga(int posisi, float harga);
+void atur_stok(int posisi, int stok);
+void tandai_kotor(int posisi);
+void reset_kotor(int jumlah);
+void bangun_urutan(IndeksUrut *x);
+void kosongkan_urutan(IndeksUrut *x);
+void urutan_tambah(IndeksUrut *x, int posisi);
+void urutan_lepas(IndeksUrut *x, int posisi);
+void urutan_pindah(IndeksUrut *x, int dari, int ke);
+int siapkan_tampilan();
+int posisi_tampilan(int k);
+void urutkan_hasil_tampilan(int *posisi, int jumlah);
+int letak_kursor(int id);
+int letak_offset(int offset, int hanya_tersedia);
+int ambil_halaman(int mulai, int batas, int hanya_tersedia, int *posisi, int *kursor);
+int ambil_termurah(int k, int *posisi);
+int lanjut_halaman();
+void pohon_harga_tambah(float harga, int id);
+void pohon_harga_lepas(float harga, int id);
+void kosongkan_pohon_harga();
+int ambil_rentang_harga(float harga_min, float harga_max, int setelah, int hanya_tersedia, const char *kategori_lipat, int *posisi, int batas, int *kursor);
+int bandingkan_int(const void *a, const void *b);
+void bangun_heap_kadaluarsa();
+void kadaluarsa_tambah(int posisi);
+int ada_tiket_kadaluarsa(time_t sekarang);
+int ambil_tiket_kadaluarsa(time_t sekarang);
+void periksa_kadaluarsa_berkala();
+size_t lipat_teks(char *tujuan, const char *asal, size_t ukuran);
+void lipat_tiket(int posisi);
+void bangun_teks_lipat();
+int nama_memuat(int posisi, const char *kriteria_lipat, size_t panjang_kriteria);
+int kode_kategori(const char *nama_lipat, int buat);
+void perbesar_bitmap_kategori(int kapasitas_slot);
+void kategori_pasang(int posisi);
+void kategori_lepas(int posisi);
+void bangun_bitmap_kategori();
+void kosongkan_kamus_kategori();
+int hitung_kategori(int kode);
+int cari_posisi_kategori(const char *kriteria_lipat, int hanya_tersedia, int **posisi);
+int tiket_berkategori(int posisi, int kode, const char *kriteria_lipat);
+void bangun_indeks_trigram();
+void kosongkan_indeks_trigram();
+void trigram_tambah(int id, const char *nama, int urut);
+void trigram_catat_basi();
+int cari_posisi_nama(const char *kriteria, int **posisi);
 void tampilkan_tiket_detail(const Tiket *t);
 
+// Operasi inti tanpa prompt, dipakai menu interaktif maupun mode batch
+int masukkan_tiket(const Tiket *baru);
+int hapus_tiket_id(int id);
+void urutkan_tiket(int kriteria);
+
 // Fungsionalitas Admin
 void tambah_tiket();
 void lihat_semua_tiket_admin();
@@ -43,7 +349,10 @@ int login_admin();
 void mode_administrator();
 
 // Fungsionalitas Pelanggan (Diperbarui)
+int beli_stok_atomik(int id, int jumlah, int *stok_sesudah);
 void lihat_tiket_pelanggan(); // FUNGSI INI YANG DIUBAH
+void lihat_tiket_termurah();
+void cari_rentang_pelanggan();
 void beli_tiket();
 void tampilkan_menu_pelanggan();
 void mode_pelanggan();
@@ -58,124 +367,2273 @@ void bersihkan_buffer() {
     while ((c = getchar()) != '\n' && c != EOF);
 }
 
+// ----------------------------------------------------------------------------------
+// PENYUSUN TAMPILAN: banyak tiket disusun ke satu buffer besar lalu ditulis dengan satu fwrite,
+// bukan tujuh printf per tiket. Angka dan harga diformat sendiri (hasilnya sama persis dengan
+// %d dan %.2f), dan teks waktu disimpan per detik karena banyak tiket dibuat pada detik yang sama.
+// Isi buffer wajib disiram sebelum printf/fprintf lain ke aliran yang sama.
+// ----------------------------------------------------------------------------------
+#define UKURAN_BUFFER_TAMPIL (64 * 1024)
+#define SLOT_CACHE_WAKTU 64
+
+char buffer_tampil[UKURAN_BUFFER_TAMPIL];
+size_t isi_tampil = 0;
+FILE *tujuan_tampil = NULL;
+
+typedef struct { time_t detik; int panjang; char teks[40]; } CacheWaktu; // panjang 0 = slot kosong
+CacheWaktu cache_waktu[SLOT_CACHE_WAKTU];
+
+void tampil_siram() {
+    if (isi_tampil > 0 && tujuan_tampil != NULL) fwrite(buffer_tampil, 1, isi_tampil, tujuan_tampil);
+    isi_tampil = 0;
+}
+
+// Pilih aliran tujuan; isi milik aliran sebelumnya disiram dulu
+void tampil_ke(FILE *tujuan) {
+    if (tujuan != tujuan_tampil) { tampil_siram(); tujuan_tampil = tujuan; }
+}
+
+void tampil_teks(const char *teks, size_t panjang) {
+    if (isi_tampil + panjang > UKURAN_BUFFER_TAMPIL) tampil_siram();
+    if (panjang > UKURAN_BUFFER_TAMPIL) { fwrite(teks, 1, panjang, tujuan_tampil); return; }
+    memcpy(buffer_tampil + isi_tampil, teks, panjang);
+    isi_tampil += panjang;
+}
+
+void tampil_str(const char *teks) { tampil_teks(teks, strlen(teks)); }
+
+// Seperti "%-<lebar>s": teks lalu spasi sampai `lebar` byte
+void tampil_kiri(const char *teks, size_t panjang, int lebar) {
+    static const char spasi[] = "                                ";
+    tampil_teks(teks, panjang);
+    for (int kurang = lebar - (int)panjang; kurang > 0; kurang -= (int)sizeof(spasi) - 1) {
+        tampil_teks(spasi, kurang < (int)sizeof(spasi) - 1 ? (size_t)kurang : sizeof(spasi) - 1);
+    }
+}
+
+// Sama dengan "%lld"; mengembalikan panjang teks (tanpa NUL) di `tujuan` (muat 24 byte)
+int format_int(char *tujuan, long long nilai) {
+    char balik[24]; int n = 0, panjang = 0;
+    unsigned long long u = nilai < 0 ? 0ULL - (unsigned long long)nilai : (unsigned long long)nilai;
+    do { balik[n++] = (char)('0' + u % 10); u /= 10; } while (u > 0);
+    if (nilai < 0) tujuan[panjang++] = '-';
+    while (n > 0) tujuan[panjang++] = balik[--n];
+    return panjang;
+}
+
+// Sama dengan "%.2f" untuk float (muat 64 byte). float * 100 selalu eksak di double (24 + 7 bit),
+// jadi pembulatan ke sen cukup half-even seperti printf; NaN/inf/nilai raksasa diserahkan ke snprintf.
+int format_harga(char *tujuan, float harga) {
+    double sen = (double)harga * 100.0;
+    if (!(sen > -1e17 && sen < 1e17)) return snprintf(tujuan, 64, "%.2f", harga);
+    uint32_t bit; memcpy(&bit, &harga, sizeof(bit));
+    if (sen < 0) sen = -sen;
+    unsigned long long bulat = (unsigned long long)sen;
+    double sisa = sen - (double)bulat;
+    if (sisa > 0.5 || (sisa == 0.5 && (bulat & 1))) bulat++;
+    int panjang = 0;
+    if (bit & 0x80000000u) tujuan[panjang++] = '-'; // -0.0 dan -0.001 pun tercetak "-0.00" oleh printf
+    panjang += format_int(tujuan + panjang, (long long)(bulat / 100));
+    tujuan[panjang++] = '.';
+    tujuan[panjang++] = (char)('0' + bulat % 100 / 10);
+    tujuan[panjang++] = (char)('0' + bulat % 10);
+    return panjang;
+}
+
+void tampil_int(long long nilai) { char teks[24]; tampil_teks(teks, format_int(teks, nilai)); }
+void tampil_harga(float harga) { char teks[64]; tampil_teks(teks, format_harga(teks, harga)); }
+
+// "%Y-%m-%d %H:%M:%S" waktu lokal; localtime + strftime hanya saat detik itu belum ada di cache
+void tampil_waktu(time_t waktu) {
+    CacheWaktu *c = &cache_waktu[(unsigned long long)waktu % SLOT_CACHE_WAKTU];
+    if (c->panjang == 0 || c->detik != waktu) {
+        struct tm *info_waktu = localtime(&waktu);
+        c->detik = waktu;
+        c->panjang = info_waktu != NULL ? (int)strftime(c->teks, sizeof(c->teks), "%Y-%m-%d %H:%M:%S", info_waktu) : 0;
+    }
+    tampil_teks(c->teks, c->panjang);
+}
+
+// Tampilan detail satu tiket ke buffer; pemanggil menyiram setelah satu atau banyak tiket
+void susun_tiket_detail(const Tiket *t) {
+    tampil_ke(stdout);
+    tampil_str("  | ID: "); tampil_int(t->id);
+    tampil_str("\n  | Nama Konser: "); tampil_str(t->nama_konser);
+    tampil_str("\n  | Kategori: "); tampil_str(t->kategori);
+    tampil_str("\n  | Harga: Rp"); tampil_harga(t->harga);
+    tampil_str("\n  | Stok: "); tampil_int(t->jumlah_stok);
+    tampil_str("\n  | Waktu Dibuat: "); tampil_waktu(t->waktu_dibuat);
+    tampil_str("\n  +-----------------------------------\n");
+}
+
 void tampilkan_tiket_detail(const Tiket *t) {
-    char waktu_str[64];
-    struct tm *info_waktu = localtime(&t->waktu_dibuat);
-    strftime(waktu_str, sizeof(waktu_str), "%Y-%m-%d %H:%M:%S", info_waktu);
+    susun_tiket_detail(t);
+    tampil_siram();
+}
 
-    printf("  | ID: %d\n", t->id);
-    printf("  | Nama Konser: %s\n", t->nama_konser);
-    printf("  | Kategori: %s\n", t->kategori);
-    printf("  | Harga: Rp%.2f\n", t->harga);
-    printf("  | Stok: %d\n", t->jumlah_stok);
-    printf("  | Waktu Dibuat: %s\n", waktu_str);
-    printf("  +-----------------------------------\n");
+HeaderFile *header_data() { return (HeaderFile *)blok_data; }
+
+void isi_header_baru(HeaderFile *header, int jumlah, uint32_t id_berikutnya) {
+    memset(header, 0, sizeof(HeaderFile));
+    memcpy(header->magic, MAGIC_FILE, sizeof(header->magic));
+    header->versi = VERSI_FILE;
+    header->jumlah_record = (uint32_t)jumlah;
+    header->ukuran_record = sizeof(Tiket);
+    header->id_berikutnya = id_berikutnya;
 }
 
-void muat_data() {
-    FILE *file = fopen(NAMA_FILE, "r");
-    if (file == NULL) { printf("⚠️ File data tidak ditemukan. Membuat file baru...\n"); return; }
+// Paksa isi file sampai ke disk, bukan hanya ke buffer stdio / page cache
+int sinkronkan_file(FILE *file) {
+    if (fflush(file) != 0) return 0;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// fsync direktori kerja agar rename dan file baru di dalamnya ikut tahan crash (POSIX saja)
+void sinkronkan_direktori() {
+#ifndef _WIN32
+    int fd = open(".", O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+#endif
+}
+
+// Tulis file data utuh lewat file sementara + fsync + rename + fsync direktori: setelah crash
+// yang ada di disk selalu salah satu dari file lama atau file baru yang lengkap
+int tulis_file_data(const HeaderFile *header, const Tiket *data) {
+    int jumlah = (int)header->jumlah_record;
+    FILE *file = fopen(NAMA_FILE_SEMENTARA, "wb");
+    if (file == NULL) return 0;
+    int berhasil = fwrite(header, sizeof(HeaderFile), 1, file) == 1 &&
+                   (jumlah == 0 || fwrite(data, sizeof(Tiket), jumlah, file) == (size_t)jumlah) &&
+                   sinkronkan_file(file);
+    if (fclose(file) != 0) berhasil = 0;
+    if (!berhasil) { remove(NAMA_FILE_SEMENTARA); return 0; }
+#ifdef _WIN32
+    remove(NAMA_FILE); // rename di Windows gagal jika file tujuan sudah ada
+#endif
+    if (rename(NAMA_FILE_SEMENTARA, NAMA_FILE) != 0) return 0;
+    sinkronkan_direktori();
+    return 1;
+}
 
-    int count = 0;
-    Tiket temp_tiket;
-    while (fread(&temp_tiket, sizeof(Tiket), 1, file) == 1) { count++; }
+// File format lama = array Tiket tanpa header; diubah sekali ke format berheader
+int migrasi_format_lama() {
+    FILE *file = fopen(NAMA_FILE, "rb");
+    if (file == NULL) return 0;
+    fseek(file, 0, SEEK_END);
+    long ukuran = ftell(file);
+    rewind(file);
+    if (ukuran < 0 || ukuran % sizeof(Tiket) != 0) { fclose(file); return 0; }
 
+    int count = (int)(ukuran / sizeof(Tiket));
+    Tiket *lama = NULL;
     if (count > 0) {
-        daftar_tiket = (Tiket *)malloc(count * sizeof(Tiket));
-        if (daftar_tiket == NULL) { perror("Gagal mengalokasikan memori saat memuat data"); fclose(file); exit(EXIT_FAILURE); }
-        rewind(file);
-        size_t items_read = fread(daftar_tiket, sizeof(Tiket), count, file);
-        if (items_read != count) {
-            fprintf(stderr, "Kesalahan saat membaca data dari file.\n");
-            free(daftar_tiket); daftar_tiket = NULL; jumlah_tiket = 0;
-        } else {
-            jumlah_tiket = count;
-            printf("✅ Berhasil memuat %d tiket dari file.\n", jumlah_tiket);
+        lama = (Tiket *)malloc(count * sizeof(Tiket));
+        if (lama == NULL || fread(lama, sizeof(Tiket), count, file) != (size_t)count) {
+            free(lama); fclose(file); return 0;
+        }
+    }
+    fclose(file);
+
+    // Urutan ID dilanjutkan dari ID terbesar yang ada (sekali saja, saat migrasi)
+    int max_id = 0;
+    for (int i = 0; i < count; i++) {
+        if (lama[i].id > max_id) max_id = lama[i].id;
+    }
+    HeaderFile header;
+    isi_header_baru(&header, count, (uint32_t)max_id + 1);
+    int berhasil = tulis_file_data(&header, lama);
+    free(lama);
+    return berhasil;
+}
+
+// Buka file berheader menjadi blok_data. Dengan mmap (MAP_PRIVATE) waktu muat tidak bergantung jumlah tiket.
+int buka_blok_data() {
+#if PAKAI_MMAP
+    int fd = open(NAMA_FILE, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat info;
+    void *peta = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(HeaderFile)) {
+        peta = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // pemetaan tetap berlaku; file tidak pernah ditulis lewat pemetaan ini
+    if (peta == MAP_FAILED) return 0;
+    blok_data = (char *)peta;
+    ukuran_blok = info.st_size;
+#else
+    FILE *file = fopen(NAMA_FILE, "rb");
+    if (file == NULL) return 0;
+    fseek(file, 0, SEEK_END);
+    long ukuran = ftell(file);
+    rewind(file);
+    if (ukuran < (long)sizeof(HeaderFile)) { fclose(file); return 0; }
+    blok_data = (char *)malloc(ukuran);
+    if (blok_data == NULL || fread(blok_data, 1, ukuran, file) != (size_t)ukuran) { fclose(file); tutup_data(); return 0; }
+    fclose(file);
+    ukuran_blok = ukuran;
+#endif
+
+    HeaderFile *header = header_data();
+    if (header->versi < 1 || header->versi > VERSI_FILE || header->ukuran_record != sizeof(Tiket) ||
+        ukuran_blok < sizeof(HeaderFile) + (size_t)header->jumlah_record * sizeof(Tiket)) {
+        tutup_data();
+        return 0;
+    }
+    daftar_tiket = (Tiket *)(blok_data + sizeof(HeaderFile));
+    jumlah_tiket = header->jumlah_record;
+    reset_kotor(jumlah_tiket);
+
+    // Versi 1 belum punya urutan ID: lanjutkan dari ID terbesar, lalu header dinaikkan ke versi 2
+    if (header->versi == 1) {
+        int max_id = 0;
+        for (int i = 0; i < jumlah_tiket; i++) {
+            if (daftar_tiket[i].id > max_id) max_id = daftar_tiket[i].id;
+        }
+        header->id_berikutnya = (uint32_t)max_id + 1;
+        header->versi = VERSI_FILE;
+    }
+    return 1;
+}
+
+// Ubah kapasitas blok menjadi tepat `kapasitas` tiket (mmap: isi dipindah ke pemetaan anonim baru, file tidak berubah)
+int ubah_kapasitas(int kapasitas) {
+    size_t ukuran_baru = sizeof(HeaderFile) + (size_t)kapasitas * sizeof(Tiket);
+#if PAKAI_MMAP
+    void *peta = mmap(NULL, ukuran_baru, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (peta == MAP_FAILED) return 0;
+    memcpy(peta, blok_data, ukuran_baru < ukuran_blok ? ukuran_baru : ukuran_blok);
+    munmap(blok_data, ukuran_blok);
+    blok_data = (char *)peta;
+    ukuran_blok = ukuran_baru;
+#else
+    void *peta = realloc(blok_data, ukuran_baru);
+    if (peta == NULL) return 0;
+    blok_data = (char *)peta;
+    ukuran_blok = ukuran_baru;
+#endif
+    daftar_tiket = (Tiket *)(blok_data + sizeof(HeaderFile));
+    return 1;
+}
+
+int kapasitas_tiket() { return (int)((ukuran_blok - sizeof(HeaderFile)) / sizeof(Tiket)); }
+
+// Pastikan blok muat minimal `minimal` tiket. Kapasitas tumbuh dua kali lipat sehingga tambah satu
+// per satu tetap O(1) teramortisasi; muat/impor massal bisa memesan tempat sekaligus di sini.
+int cadangkan_kapasitas(int minimal) {
+    int kapasitas = kapasitas_tiket();
+    if (minimal <= kapasitas) return 1;
+    int baru = kapasitas < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas;
+    while (baru < minimal) baru *= 2;
+    return ubah_kapasitas(baru);
+}
+
+// Susutkan hanya jika terisi <= 1/4, dan hanya ke ukuran yang masih menyisakan ruang dua kali lipat
+// (histeresis), agar hapus/tambah bergantian di sekitar batas tidak memicu realokasi terus-menerus
+int susutkan_kapasitas() {
+    int kapasitas = kapasitas_tiket();
+    if (kapasitas <= KAPASITAS_AWAL || jumlah_tiket > kapasitas / 4) return 1;
+    int baru = kapasitas / 2;
+    while (baru / 2 >= KAPASITAS_AWAL && jumlah_tiket <= baru / 4) baru /= 2;
+    if (baru < KAPASITAS_AWAL) baru = KAPASITAS_AWAL;
+    return ubah_kapasitas(baru);
+}
+
+void tutup_data() {
+    hentikan_penulis();
+    if (file_jurnal != NULL) { fclose(file_jurnal); file_jurnal = NULL; }
+#if PAKAI_MMAP
+    if (blok_data != NULL) munmap(blok_data, ukuran_blok);
+#else
+    free(blok_data);
+#endif
+    free(peta_kotor); free(posisi_kotor);
+    peta_kotor = NULL; posisi_kotor = NULL;
+    jumlah_kotor = 0; kapasitas_kotor = 0; tulis_ulang_penuh = 1;
+    blok_data = NULL; ukuran_blok = 0;
+    daftar_tiket = NULL; jumlah_tiket = 0; jumlah_nisan = 0;
+    free(indeks_id);
+    indeks_id = NULL; kapasitas_indeks = 0;
+    free(heap_kadaluarsa);
+    heap_kadaluarsa = NULL; ukuran_heap = 0; kapasitas_heap = 0;
+    kosongkan_indeks_trigram();
+    free(teks_lipat);
+    teks_lipat = NULL; kapasitas_lipat = 0;
+    kosongkan_kamus_kategori();
+    kosongkan_kolom();
+    kosongkan_urutan(&urut_harga); kosongkan_urutan(&urut_nama);
+    kosongkan_pohon_harga();
+    urutan_tampilan = 0;
+}
+
+// Record di belakang jumlah_record_disk tidak perlu ditandai: seluruh ekor ikut disalin saat snapshot.
+// Di --uji-beli katalog tidak dimuat dari file (jumlah_record_disk 0), jadi pembeli serentak tidak menulis di sini.
+void tandai_kotor(int posisi) {
+    if (tulis_ulang_penuh || posisi >= jumlah_record_disk || (peta_kotor[posisi >> 6] >> (posisi & 63)) & 1) return;
+    if (jumlah_kotor >= jumlah_record_disk / RASIO_KOTOR) { tulis_ulang_penuh = 1; return; } // berurutan sekali lebih murah
+    peta_kotor[posisi >> 6] |= 1ULL << (posisi & 63);
+    posisi_kotor[jumlah_kotor++] = posisi;
+}
+
+// Pelacakan baru setelah perubahan sampai `jumlah` record disalin ke penyangga; hanya bit yang
+// menyala yang dihapus, sehingga biayanya sebanding jumlah perubahan, bukan ukuran katalog
+void reset_kotor(int jumlah) {
+    for (int k = 0; k < jumlah_kotor; k++) peta_kotor[posisi_kotor[k] >> 6] &= ~(1ULL << (posisi_kotor[k] & 63));
+    jumlah_kotor = 0;
+    jumlah_record_disk = jumlah;
+    if (jumlah > kapasitas_kotor) {
+        int baru = kapasitas_kotor < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_kotor;
+        while (baru < jumlah) baru *= 2;
+        uint64_t *peta = (uint64_t *)realloc(peta_kotor, ((size_t)baru / 64 + 1) * sizeof(uint64_t));
+        if (peta != NULL) {
+            size_t kata_lama = kapasitas_kotor > 0 ? (size_t)kapasitas_kotor / 64 + 1 : 0;
+            memset(peta + kata_lama, 0, ((size_t)baru / 64 + 1 - kata_lama) * sizeof(uint64_t));
+            peta_kotor = peta;
         }
+        int *posisi = (int *)realloc(posisi_kotor, ((size_t)baru / RASIO_KOTOR + 1) * sizeof(int));
+        if (posisi != NULL) posisi_kotor = posisi;
+        if (peta != NULL && posisi != NULL) kapasitas_kotor = baru;
+    }
+    tulis_ulang_penuh = jumlah > kapasitas_kotor; // gagal alokasi: simpan berikutnya menulis ulang utuh
+}
+
+int siapkan_penyangga(PenyanggaSimpan *p, int jumlah) {
+    if (jumlah <= p->kapasitas) return 1;
+    int baru = p->kapasitas < KAPASITAS_AWAL ? KAPASITAS_AWAL : p->kapasitas;
+    while (baru < jumlah) baru *= 2;
+    Tiket *isi = (Tiket *)realloc(p->isi, (size_t)baru * sizeof(Tiket));
+    if (isi == NULL) return 0;
+    p->isi = isi;
+    int *posisi = (int *)realloc(p->posisi, (size_t)baru * sizeof(int));
+    if (posisi == NULL) return 0;
+    p->posisi = posisi;
+    p->kapasitas = baru;
+    return 1;
+}
+
+// Salin perubahan sejak snapshot terakhir ke `p` sebagai snapshot sampai `lsn` (utas utama). Dengan
+// `gabung` p masih menunggu ditulis dan perubahan baru ditambahkan ke dalamnya. Penyangga penuh dibuat
+// setelah pemadatan, bila perubahan terlalu banyak, atau bila penulisan sebelumnya gagal. 0 = gagal alokasi.
+int isi_penyangga(PenyanggaSimpan *p, int gabung, uint64_t lsn) {
+    int ekor = jumlah_tiket - jumlah_record_disk;
+    if (tulis_ulang_penuh || simpan_gagal || ekor < 0) {
+        if (!siapkan_penyangga(p, jumlah_tiket)) return 0;
+        memcpy(p->isi, daftar_tiket, (size_t)jumlah_tiket * sizeof(Tiket));
+        p->jumlah = jumlah_tiket; p->penuh = 1;
+        simpan_gagal = 0;
+    } else if (gabung && p->penuh) { // penyangga penuh yang belum ditulis cukup diperbarui di tempat
+        if (!siapkan_penyangga(p, jumlah_tiket)) return 0;
+        for (int k = 0; k < jumlah_kotor; k++) p->isi[posisi_kotor[k]] = daftar_tiket[posisi_kotor[k]];
+        memcpy(p->isi + jumlah_record_disk, daftar_tiket + jumlah_record_disk, (size_t)ekor * sizeof(Tiket));
+        p->jumlah = jumlah_tiket;
     } else {
-        printf("ℹ️ File data kosong.\n");
+        int awal = gabung ? p->jumlah : 0;
+        if (!siapkan_penyangga(p, awal + jumlah_kotor + ekor)) return 0;
+        if (jumlah_kotor > 0) qsort(posisi_kotor, jumlah_kotor, sizeof(int), bandingkan_int); // ditulis searah offset
+        for (int k = 0; k < jumlah_kotor; k++) { p->posisi[awal + k] = posisi_kotor[k]; p->isi[awal + k] = daftar_tiket[posisi_kotor[k]]; }
+        awal += jumlah_kotor;
+        for (int k = 0; k < ekor; k++) p->posisi[awal + k] = jumlah_record_disk + k;
+        memcpy(p->isi + awal, daftar_tiket + jumlah_record_disk, (size_t)ekor * sizeof(Tiket));
+        p->jumlah = awal + ekor; p->penuh = 0;
+    }
+    header_data()->jumlah_record = (uint32_t)jumlah_tiket;
+    header_data()->lsn_snapshot = lsn;
+    p->header = *header_data();
+    reset_kotor(jumlah_tiket);
+    return 1;
+}
+
+uint32_t checksum_ubah(uint32_t h, const void *data, size_t ukuran) {
+    const unsigned char *p = (const unsigned char *)data; // FNV-1a berantai
+    for (size_t i = 0; i < ukuran; i++) { h ^= p[i]; h *= 16777619u; }
+    return h;
+}
+
+// Timpa record di offset tetapnya (posisi berurutan ditulis sekaligus), lalu header, lalu fsync
+int terapkan_ubah(const HeaderFile *header, const int *posisi, const Tiket *isi, int jumlah) {
+    FILE *file = fopen(NAMA_FILE, "r+b");
+    if (file == NULL) return 0;
+    int berhasil = 1;
+    for (int k = 0; k < jumlah && berhasil;) {
+        int n = 1;
+        while (k + n < jumlah && posisi[k + n] == posisi[k] + n) n++;
+        long offset = (long)sizeof(HeaderFile) + (long)posisi[k] * (long)sizeof(Tiket);
+        berhasil = fseek(file, offset, SEEK_SET) == 0 && fwrite(&isi[k], sizeof(Tiket), n, file) == (size_t)n;
+        k += n;
+    }
+    berhasil = berhasil && fseek(file, 0, SEEK_SET) == 0 && fwrite(header, sizeof(HeaderFile), 1, file) == 1 && sinkronkan_file(file);
+    if (fclose(file) != 0) berhasil = 0;
+    return berhasil;
+}
+
+// Double write untuk penyangga sebagian: record baru ditulis utuh ke NAMA_FILE_UBAH (fsync + fsync
+// direktori) sebelum file data ditimpa di tempat; crash di tengah penimpaan diselesaikan pulihkan_ubah()
+int tulis_ubah(const PenyanggaSimpan *p) {
+    HeaderUbah kepala;
+    memset(&kepala, 0, sizeof(kepala));
+    memcpy(kepala.magic, MAGIC_UBAH, sizeof(kepala.magic));
+    kepala.jumlah = (uint32_t)p->jumlah;
+    uint32_t h = checksum_ubah(2166136261u, &p->header, sizeof(HeaderFile));
+    h = checksum_ubah(h, p->posisi, (size_t)p->jumlah * sizeof(int));
+    kepala.checksum = checksum_ubah(h, p->isi, (size_t)p->jumlah * sizeof(Tiket));
+
+    FILE *file = fopen(NAMA_FILE_UBAH, "wb");
+    if (file == NULL) return 0;
+    int berhasil = fwrite(&kepala, sizeof(kepala), 1, file) == 1 && fwrite(&p->header, sizeof(HeaderFile), 1, file) == 1 &&
+                   fwrite(p->posisi, sizeof(int), p->jumlah, file) == (size_t)p->jumlah &&
+                   fwrite(p->isi, sizeof(Tiket), p->jumlah, file) == (size_t)p->jumlah && sinkronkan_file(file);
+    if (fclose(file) != 0) berhasil = 0;
+    if (!berhasil) { remove(NAMA_FILE_UBAH); return 0; } // file data belum disentuh
+    sinkronkan_direktori();
+    if (!terapkan_ubah(&p->header, p->posisi, p->isi, p->jumlah)) return 0; // file ubah tetap ada untuk pulihkan_ubah()
+    remove(NAMA_FILE_UBAH);
+    sinkronkan_direktori(); // file ubah basi tidak boleh muncul lagi di atas snapshot berikutnya
+    return 1;
+}
+
+// Selesaikan file ubah sisa simpan yang terputus: yang utuh diterapkan lagi (idempotent), yang tertulis
+// setengah dibuang karena file data baru ditimpa setelah file ubah lengkap di disk. 0 jika gagal.
+int pulihkan_ubah() {
+    FILE *file = fopen(NAMA_FILE_UBAH, "rb");
+    if (file == NULL) return 1;
+    HeaderUbah kepala; HeaderFile header;
+    int *posisi = NULL; Tiket *isi = NULL;
+    int utuh = fread(&kepala, sizeof(kepala), 1, file) == 1 && memcmp(kepala.magic, MAGIC_UBAH, sizeof(kepala.magic)) == 0 &&
+               kepala.jumlah <= INT_MAX / sizeof(Tiket) && fread(&header, sizeof(HeaderFile), 1, file) == 1;
+    int jumlah = utuh ? (int)kepala.jumlah : 0;
+    if (utuh && jumlah > 0) {
+        posisi = (int *)malloc((size_t)jumlah * sizeof(int));
+        isi = (Tiket *)malloc((size_t)jumlah * sizeof(Tiket));
+        if (posisi == NULL || isi == NULL) { free(posisi); free(isi); fclose(file); return 0; }
+        utuh = fread(posisi, sizeof(int), jumlah, file) == (size_t)jumlah && fread(isi, sizeof(Tiket), jumlah, file) == (size_t)jumlah;
     }
     fclose(file);
+    if (utuh) {
+        uint32_t h = checksum_ubah(2166136261u, &header, sizeof(HeaderFile));
+        h = checksum_ubah(h, posisi, (size_t)jumlah * sizeof(int));
+        utuh = checksum_ubah(h, isi, (size_t)jumlah * sizeof(Tiket)) == kepala.checksum;
+    }
+    int berhasil = !utuh || terapkan_ubah(&header, posisi, isi, jumlah);
+    free(posisi); free(isi);
+    if (berhasil) { remove(NAMA_FILE_UBAH); sinkronkan_direktori(); }
+    return berhasil;
 }
 
-void simpan_data() {
-    FILE *file = fopen(NAMA_FILE, "w");
-    if (file == NULL) { perror("❌ Gagal membuka file untuk menyimpan data"); return; }
-    if (jumlah_tiket > 0) {
-        if (fwrite(daftar_tiket, sizeof(Tiket), jumlah_tiket, file) != jumlah_tiket) {
-             fprintf(stderr, "Kesalahan saat menulis data ke file.\n");
-        } else {
-            printf("✅ Data tiket berhasil disimpan.\n");
+// Tulis penyangga ke file data tanpa menyentuh blok_data (aman dari utas penulis):
+// penuh lewat file sementara + rename, sebagian lewat file ubah
+int tulis_penyangga(const PenyanggaSimpan *p) {
+    if (!pulihkan_ubah()) return 0; // file ubah lama harus selesai dulu agar tidak menimpa snapshot ini
+    return p->penuh ? tulis_file_data(&p->header, p->isi) : tulis_ubah(p);
+}
+
+// Snapshot sinkron sampai `lsn` di utas ini; hanya dipanggil saat utas penulis diam
+int tulis_snapshot(uint64_t lsn) {
+    PenyanggaSimpan *p = &penyangga_simpan[0];
+    if (!isi_penyangga(p, 0, lsn)) return 0;
+    if (!tulis_penyangga(p)) { simpan_gagal = 1; return 0; }
+    return 1;
+}
+
+// ----------------------------------------------------------------------------------
+// JURNAL PEMBELIAN: tiap transaksi ditambahkan ke jurnal (O(1)) alih-alih menulis ulang
+// katalog. Jurnal diputar ulang di atas snapshot saat muat_data() dan dipadatkan ke
+// snapshot oleh utas penulis setelah BATAS_JURNAL transaksi.
+// ----------------------------------------------------------------------------------
+uint32_t checksum_jurnal(const RecordJurnal *r) {
+    // FNV-1a atas semua field sebelum checksum
+    const unsigned char *p = (const unsigned char *)r;
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < offsetof(RecordJurnal, checksum); i++) { h ^= p[i]; h *= 16777619u; }
+    return h;
+}
+
+int buka_jurnal() {
+    file_jurnal = fopen(NAMA_FILE_JURNAL, "ab");
+    return file_jurnal != NULL;
+}
+
+long long waktu_ms() {
+#ifdef _WIN32
+    return (long long)clock() * 1000 / CLOCKS_PER_SEC;
+#else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000 + t.tv_nsec / 1000000;
+#endif
+}
+
+// Satu fsync membuat semua record yang tertunda tahan crash sekaligus; 1 jika berhasil. Bila gagal,
+// lsn_tahan_crash tidak maju (jawaban yang menunggu tetap ditahan) dan tenggat diset ulang untuk mencoba lagi.
+int komit_jurnal() {
+    if (lsn_tahan_crash >= lsn_terakhir) { tenggat_komit = -1; komit_gagal = 0; return 1; }
+    if (file_jurnal == NULL || !sinkronkan_file(file_jurnal)) {
+        if (!komit_gagal) perror("⚠️ Peringatan: Gagal fsync jurnal, transaksi belum tahan crash (dicoba lagi)");
+        komit_gagal = 1;
+        tenggat_komit = waktu_ms() + JEDA_ULANG_KOMIT_MS;
+        return 0;
+    }
+    lsn_tahan_crash = lsn_terakhir;
+    tenggat_komit = -1;
+    komit_gagal = 0;
+    return 1;
+}
+
+// Milidetik sampai komit tertunda jatuh tempo: -1 bila tidak ada, 0 bila sudah waktunya
+int sisa_jendela_komit() {
+    if (tenggat_komit < 0) return -1;
+    long long sisa = tenggat_komit - waktu_ms();
+    return sisa > 0 ? (int)sisa : 0;
+}
+
+// Setelah snapshot mencakup semua transaksi, jurnal dimulai dari kosong
+void kosongkan_jurnal() {
+    if (file_jurnal != NULL) fclose(file_jurnal);
+    file_jurnal = fopen(NAMA_FILE_JURNAL, "wb");
+    remove(NAMA_FILE_JURNAL_LAMA);
+    sinkronkan_direktori();
+    isi_jurnal = 0;
+    lsn_tahan_crash = lsn_terakhir; // semua record sudah tercakup snapshot
+    tenggat_komit = -1;
+    komit_gagal = 0;
+#if PAKAI_MMAP
+    jurnal_lama_ada = 0; // dipanggil hanya saat penulis diam
+#endif
+}
+
+// Jurnal aktif menjadi jurnal lama dan transaksi baru masuk jurnal kosong; 0 bila rotasi gagal
+int putar_jurnal() {
+    if (!komit_jurnal()) return 0; // record yang tertunda harus tahan crash sebelum pindah ke jurnal lama
+    if (file_jurnal != NULL) { fclose(file_jurnal); file_jurnal = NULL; }
+    if (rename(NAMA_FILE_JURNAL, NAMA_FILE_JURNAL_LAMA) != 0) { buka_jurnal(); return 0; }
+    buka_jurnal(); // bila gagal, catat_jurnal mencoba membuka lagi
+    sinkronkan_direktori();
+    isi_jurnal = 0;
+    return 1;
+}
+
+// Terapkan record yang lebih baru dari snapshot; mengembalikan jumlah record yang terbaca
+int putar_ulang_file_jurnal(const char *nama_file, uint64_t lsn_snapshot, int *diterapkan) {
+    FILE *file = fopen(nama_file, "rb");
+    if (file == NULL) return 0;
+    int terbaca = 0;
+    RecordJurnal r;
+    while (fread(&r, sizeof(RecordJurnal), 1, file) == 1) {
+        terbaca++;
+        if (r.checksum != checksum_jurnal(&r)) break; // ekor yang tertulis setengah saat crash
+        if (r.lsn > lsn_terakhir) lsn_terakhir = r.lsn;
+        if (r.lsn <= lsn_snapshot) continue;
+        int posisi = cari_indeks_id(r.id);
+        if (posisi >= 0) { atur_stok(posisi, r.stok_sesudah); (*diterapkan)++; }
+    }
+    fclose(file);
+    return terbaca;
+}
+
+void pulihkan_jurnal() {
+    uint64_t lsn_snapshot = header_data()->lsn_snapshot;
+    int diterapkan = 0;
+    lsn_terakhir = lsn_snapshot;
+    // Jurnal hasil rotasi (snapshot yang belum selesai) lebih tua dari jurnal aktif
+    int terbaca = putar_ulang_file_jurnal(NAMA_FILE_JURNAL_LAMA, lsn_snapshot, &diterapkan)
+                + putar_ulang_file_jurnal(NAMA_FILE_JURNAL, lsn_snapshot, &diterapkan);
+    if (diterapkan > 0) printf("ℹ️ %d transaksi dipulihkan dari jurnal.\n", diterapkan);
+
+    // Sisa jurnal dari sesi sebelumnya langsung dipadatkan agar sesi ini mulai dengan jurnal kosong
+    if (terbaca > 0 && !tulis_snapshot(lsn_terakhir)) {
+        perror("❌ Gagal memadatkan jurnal");
+        exit(EXIT_FAILURE);
+    }
+    kosongkan_jurnal();
+}
+
+// Satu putaran penulis: tulis penyangga (snapshot sampai lsn di header-nya), lalu jurnal lama dibuang karena sudah tercakup
+int jalankan_snapshot(const PenyanggaSimpan *p, int buang_jurnal_lama) {
+    if (!tulis_penyangga(p)) {
+        fprintf(stderr, "⚠️ Peringatan: Gagal menulis snapshot, akan dicoba saat simpan berikutnya.\n");
+        return 0;
+    }
+    if (buang_jurnal_lama) remove(NAMA_FILE_JURNAL_LAMA);
+    return 1;
+}
+
+#if PAKAI_MMAP
+// Utas penulis tidur sampai ada penyangga yang menunggu. Penyangga sebagian dilewati bila penulisan
+// sebelumnya gagal (isinya selisih dari snapshot yang tidak sampai ke disk); simpan berikutnya penuh.
+void *jalankan_penulis(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&kunci_snapshot);
+    for (;;) {
+        while (penyangga_antre < 0 && !penulis_berhenti) pthread_cond_wait(&sinyal_snapshot, &kunci_snapshot);
+        if (penyangga_antre < 0) break;
+        penyangga_ditulis = penyangga_antre; penyangga_antre = -1;
+        PenyanggaSimpan *p = &penyangga_simpan[penyangga_ditulis];
+        int buang = jurnal_lama_ada, lewati = simpan_gagal && !p->penuh;
+        pthread_mutex_unlock(&kunci_snapshot);
+        int berhasil = !lewati && jalankan_snapshot(p, buang);
+        pthread_mutex_lock(&kunci_snapshot);
+        if (berhasil && buang) jurnal_lama_ada = 0;
+        if (!berhasil) simpan_gagal = 1;
+        else if (p->penuh) simpan_gagal = 0; // penyangga sebagian yang menunggu dibuat di atas snapshot ini
+        penyangga_ditulis = -1;
+        pthread_cond_broadcast(&sinyal_snapshot);
+    }
+    pthread_mutex_unlock(&kunci_snapshot);
+    return NULL;
+}
+#endif
+
+// Simpan tanpa menunggu disk: perubahan disalin ke penyangga, diserahkan ke utas penulis, dan fungsi
+// langsung kembali. Jurnal yang berisi diputar dulu (kecuali jurnal lama sebelumnya belum tercakup
+// snapshot) agar transaksi baru tidak ikut terbuang bersama jurnal lama.
+void simpan_data_latar() {
+#if PAKAI_MMAP
+    pthread_mutex_lock(&kunci_snapshot);
+    if (!jurnal_lama_ada && isi_jurnal > 0 && putar_jurnal()) jurnal_lama_ada = 1;
+    PenyanggaSimpan *p = &penyangga_simpan[penyangga_ditulis == 0 ? 1 : 0];
+    if (!isi_penyangga(p, penyangga_antre >= 0, lsn_terakhir)) {
+        pthread_mutex_unlock(&kunci_snapshot);
+        perror("⚠️ Peringatan: Gagal menyiapkan snapshot");
+        return;
+    }
+    penyangga_antre = (int)(p - penyangga_simpan);
+    if (!penulis_hidup) {
+        penulis_berhenti = 0;
+        penulis_hidup = pthread_create(&utas_penulis, NULL, jalankan_penulis, NULL) == 0;
+    }
+    if (penulis_hidup) {
+        pthread_cond_broadcast(&sinyal_snapshot);
+    } else { // utas tidak bisa dibuat: tulis langsung di utas ini
+        penyangga_antre = -1;
+        if (jalankan_snapshot(p, jurnal_lama_ada)) jurnal_lama_ada = 0;
+        else simpan_gagal = 1;
+    }
+    pthread_mutex_unlock(&kunci_snapshot);
+#else
+    if (tulis_snapshot(lsn_terakhir)) kosongkan_jurnal();
+    else fprintf(stderr, "⚠️ Peringatan: Gagal menulis snapshot, akan dicoba saat simpan berikutnya.\n");
+#endif
+}
+
+// Penghalang: kembali setelah semua snapshot yang sudah diminta selesai ditulis
+void tunggu_snapshot() {
+#if PAKAI_MMAP
+    pthread_mutex_lock(&kunci_snapshot);
+    while (penyangga_antre >= 0 || penyangga_ditulis >= 0) pthread_cond_wait(&sinyal_snapshot, &kunci_snapshot);
+    pthread_mutex_unlock(&kunci_snapshot);
+#endif
+}
+
+void hentikan_penulis() {
+#if PAKAI_MMAP
+    if (penulis_hidup) {
+        pthread_mutex_lock(&kunci_snapshot);
+        penulis_berhenti = 1; // penulis menyelesaikan permintaan yang tersisa sebelum berhenti
+        pthread_cond_broadcast(&sinyal_snapshot);
+        pthread_mutex_unlock(&kunci_snapshot);
+        pthread_join(utas_penulis, NULL);
+        penulis_hidup = 0;
+    }
+#endif
+    for (int b = 0; b < 2; b++) {
+        free(penyangga_simpan[b].isi); free(penyangga_simpan[b].posisi);
+        memset(&penyangga_simpan[b], 0, sizeof(PenyanggaSimpan));
+    }
+}
+
+// Record baru hanya di-flush ke OS; fsync-nya dikumpulkan oleh komit_jurnal() (group commit)
+int catat_jurnal(int id, int delta_stok, int stok_sesudah) {
+    if (file_jurnal == NULL && !buka_jurnal()) return 0;
+    RecordJurnal r;
+    memset(&r, 0, sizeof(r));
+    r.lsn = lsn_terakhir + 1;
+    r.id = id;
+    r.delta_stok = delta_stok;
+    r.stok_sesudah = stok_sesudah;
+    r.checksum = checksum_jurnal(&r);
+    if (fwrite(&r, sizeof(RecordJurnal), 1, file_jurnal) != 1 || fflush(file_jurnal) != 0) return 0;
+    lsn_terakhir = r.lsn;
+    if (tenggat_komit < 0) tenggat_komit = waktu_ms() + jendela_komit_ms;
+    if (++isi_jurnal % BATAS_JURNAL == 0) simpan_data_latar(); // rotasi bisa tertunda selama jurnal lama belum tercakup
+    return 1;
+}
+
+void muat_data() {
+    if (!pulihkan_ubah()) { perror("Gagal menyelesaikan simpan yang terputus"); exit(EXIT_FAILURE); }
+    int file_baru = 0;
+    FILE *file = fopen(NAMA_FILE, "rb");
+    if (file == NULL) {
+        printf("⚠️ File data tidak ditemukan. Membuat file baru...\n");
+        HeaderFile header;
+        isi_header_baru(&header, 0, 1);
+        if (!tulis_file_data(&header, NULL)) { perror("Gagal membuat file data"); exit(EXIT_FAILURE); }
+        file_baru = 1;
+    } else {
+        HeaderFile header;
+        int berheader = fread(&header, sizeof(HeaderFile), 1, file) == 1 &&
+                        memcmp(header.magic, MAGIC_FILE, sizeof(header.magic)) == 0;
+        fclose(file);
+        if (!berheader && !migrasi_format_lama()) {
+            fprintf(stderr, "Kesalahan saat membaca data dari file.\n");
+            exit(EXIT_FAILURE);
         }
+    }
+
+    if (!buka_blok_data()) {
+        fprintf(stderr, "Kesalahan saat membaca data dari file (format tidak dikenali).\n");
+        exit(EXIT_FAILURE);
+    }
+    bangun_kolom();
+    bangun_indeks_id();
+    bangun_heap_kadaluarsa();
+    bangun_teks_lipat();
+    bangun_indeks_trigram();
+    bangun_urutan(&urut_harga); bangun_urutan(&urut_nama);
+    urutan_tampilan = header_data()->urutan_tampilan <= 2 ? (int)header_data()->urutan_tampilan : 0;
+    pulihkan_jurnal();
+    if (file_baru) return;
+    if (jumlah_tiket_aktif() > 0) {
+        printf("✅ Berhasil memuat %d tiket dari file.\n", jumlah_tiket_aktif());
+    } else {
+        printf("ℹ️ File data kosong.\n");
+    }
+}
+
+// Simpan sinkron (keluar program/server): tunggu utas penulis, lalu tulis perubahan yang tersisa.
+// Hasilnya snapshot baru yang mencakup seluruh jurnal, sehingga jurnal bisa dikosongkan. 1 jika berhasil.
+int simpan_data() {
+    tunggu_snapshot();
+    if (!tulis_snapshot(lsn_terakhir)) { perror("❌ Gagal menyimpan data ke file"); return 0; }
+    kosongkan_jurnal();
+    if (jumlah_tiket_aktif() > 0) {
+        printf("✅ Data tiket berhasil disimpan.\n");
     } else {
         printf("ℹ️ Tidak ada tiket untuk disimpan.\n");
     }
-    fclose(file);
+    return 1;
+}
+
+// Urutan ID tersimpan di header file: O(1), dan ID tiket yang sudah dihapus tidak pernah dipakai ulang.
+// pesan_blok_id(n) memesan n ID berurutan sekaligus (untuk tambah massal) dan mengembalikan ID pertama.
+int pesan_blok_id(int jumlah) {
+    HeaderFile *header = header_data();
+    int id_awal = (int)header->id_berikutnya;
+    header->id_berikutnya += (uint32_t)jumlah;
+    return id_awal;
 }
 
 int buat_id_unik() {
-    if (jumlah_tiket == 0) return 1;
-    int max_id = 0;
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id > max_id) max_id = daftar_tiket[i].id;
-    }
-    return max_id + 1;
+    return pesan_blok_id(1);
 }
 
-// ==========================================================
-// 2. FUNGSI KHUSUS PELANGGAN (PEMBELI)
-// ==========================================================
+// ----------------------------------------------------------------------------------
+// INDEKS HASH ID -> POSISI (open addressing, linear probing). Dibangun di muat_data()
+// dan diperbarui setiap kali tiket ditambah, dihapus, atau posisinya berpindah.
+// ----------------------------------------------------------------------------------
+unsigned int hash_id(int id) {
+    unsigned int x = (unsigned int)id;
+    x ^= x >> 16; x *= 0x45d9f3bu; x ^= x >> 16;
+    return x;
+}
 
-// FUNGSI INI DIUBAH: Hanya menampilkan tiket dengan stok > 0
-void lihat_tiket_pelanggan() {
-    printf("\n🛍️ --- DAFTAR TIKET TERSEDIA ---\n");
-    int tiket_tersedia = 0;
+void indeks_pasang(int id, int posisi) {
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0 && indeks_id[i].id != id) i = (i + 1) & mask;
+    indeks_id[i].id = id;
+    indeks_id[i].posisi = posisi;
+}
 
+// Bangun ulang seluruh indeks (O(n)); dipakai setelah muat dan pemadatan yang menggeser posisi.
+// Nisan tidak masuk indeks, sekaligus dihitung ulang di sini.
+void bangun_indeks_id() {
+    int kapasitas = 16;
+    while (kapasitas < jumlah_tiket * 2) kapasitas *= 2;
+    if (kapasitas != kapasitas_indeks) {
+        SlotIndeks *baru = (SlotIndeks *)realloc(indeks_id, kapasitas * sizeof(SlotIndeks));
+        if (baru == NULL) { perror("Gagal mengalokasikan indeks tiket"); exit(EXIT_FAILURE); }
+        indeks_id = baru;
+        kapasitas_indeks = kapasitas;
+    }
+    for (int i = 0; i < kapasitas_indeks; i++) indeks_id[i].posisi = -1;
+    jumlah_nisan = 0;
     for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].jumlah_stok > 0) {
-            tiket_tersedia = 1;
-            break;
+        if (kolom_id[i] == ID_NISAN) jumlah_nisan++;
+        else indeks_pasang(kolom_id[i], i);
+    }
+}
+
+// Daftarkan tiket di `posisi` yang baru ditambahkan (jumlah_tiket sudah termasuk tiket ini)
+void indeks_tambah(int posisi) {
+    if (jumlah_tiket * 2 > kapasitas_indeks) bangun_indeks_id();
+    else indeks_pasang(daftar_tiket[posisi].id, posisi);
+}
+
+// Keluarkan `id` dari indeks. Slot sesudahnya digeser mundur (backward shift) agar rantai
+// probing tetap utuh tanpa perlu penanda hapus di tabel indeks.
+void indeks_hapus(int id) {
+    if (kapasitas_indeks == 0) return;
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0 && indeks_id[i].id != id) i = (i + 1) & mask;
+    if (indeks_id[i].posisi < 0) return;
+    for (unsigned int j = (i + 1) & mask; indeks_id[j].posisi >= 0; j = (j + 1) & mask) {
+        unsigned int asal = hash_id(indeks_id[j].id) & mask;
+        // Slot j boleh mengisi lubang i hanya jika posisi asalnya tidak berada di antara i (eksklusif) dan j
+        if (((j - asal) & mask) >= ((j - i) & mask)) {
+            indeks_id[i] = indeks_id[j];
+            i = j;
         }
     }
+    indeks_id[i].posisi = -1;
+}
 
-    if (jumlah_tiket == 0 || !tiket_tersedia) {
-        printf("⚠️ Saat ini tidak ada tiket yang tersedia untuk dijual.\n");
-        return;
+// Posisi tiket dengan `id` di daftar_tiket, atau -1 jika tidak ada
+int cari_indeks_id(int id) {
+    if (kapasitas_indeks == 0) return -1;
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0) {
+        if (indeks_id[i].id == id) return indeks_id[i].posisi;
+        i = (i + 1) & mask;
     }
+    return -1;
+}
 
-    printf("------------------------------------------------------------------------\n");
-    printf("| ID | Nama Konser          | Kategori           | Harga (Rp)   | Stk |\n");
-    printf("------------------------------------------------------------------------\n");
+// ----------------------------------------------------------------------------------
+// PENGHAPUSAN DENGAN NISAN: tiket yang dihapus hanya ditandai id = ID_NISAN (O(1)).
+// Semua pemindaian melewati nisan; array baru dipadatkan dalam satu sapuan linear
+// setelah nisan melewati 1/RASIO_NISAN dari slot yang terpakai.
+// ----------------------------------------------------------------------------------
+int jumlah_tiket_aktif() {
+    return jumlah_tiket - jumlah_nisan;
+}
+
+void tandai_nisan(int posisi) {
+    pohon_harga_lepas(kolom_harga[posisi], kolom_id[posisi]);
+    indeks_hapus(daftar_tiket[posisi].id);
+    kategori_lepas(posisi);
+    urutan_lepas(&urut_harga, posisi); urutan_lepas(&urut_nama, posisi);
+    daftar_tiket[posisi].id = ID_NISAN; tandai_kotor(posisi);
+    kolom_id[posisi] = ID_NISAN;
+    perbarui_tersedia(posisi);
+    jumlah_nisan++;
+    trigram_catat_basi();
+}
 
+void padatkan_tiket() {
+    if (jumlah_nisan == 0) return;
+    int tujuan = 0;
     for (int i = 0; i < jumlah_tiket; i++) {
-        // HANYA tampilkan jika STOK > 0
-        if (daftar_tiket[i].jumlah_stok > 0) {
-            printf("| %-2d | %-20s | %-18s | %-12.2f | %-3d |\n",
-                daftar_tiket[i].id,
-                daftar_tiket[i].nama_konser,
-                daftar_tiket[i].kategori,
-                daftar_tiket[i].harga,
-                daftar_tiket[i].jumlah_stok
-            );
+        if (kolom_id[i] == ID_NISAN) continue;
+        if (tujuan != i) {
+            daftar_tiket[tujuan] = daftar_tiket[i]; teks_lipat[tujuan] = teks_lipat[i];
+            kolom_id[tujuan] = kolom_id[i]; kolom_harga[tujuan] = kolom_harga[i];
+            kolom_stok[tujuan] = kolom_stok[i]; kolom_waktu[tujuan] = kolom_waktu[i];
+            urutan_pindah(&urut_harga, i, tujuan); urutan_pindah(&urut_nama, i, tujuan);
         }
+        tujuan++;
+    }
+    jumlah_tiket = tujuan;
+    header_data()->jumlah_record = (uint32_t)jumlah_tiket;
+    tulis_ulang_penuh = 1; // hampir semua record bergeser dari slot yang tercatat di disk
+    bangun_indeks_id(); // sekaligus mengembalikan jumlah_nisan ke 0
+    bangun_bitmap_kategori(); // posisi tiket bergeser
+    bangun_tersedia();
+
+    // Perkecil blok data bila sudah jauh lebih besar dari isinya (jika gagal, blok lama tetap dipakai)
+    if (!susutkan_kapasitas()) {
+        perror("⚠️ Peringatan: Gagal realloc setelah pemadatan.");
     }
-    printf("------------------------------------------------------------------------\n");
 }
 
-void beli_tiket() {
-    int id_beli, jumlah_beli, index_tiket = -1;
+void padatkan_jika_perlu() {
+    if (jumlah_nisan * RASIO_NISAN > jumlah_tiket) padatkan_tiket();
+}
 
-    printf("\n🛒 --- BELI TIKET ---\n");
+// ----------------------------------------------------------------------------------
+// KOLOM PANAS: salinan field numerik per kolom (kolom_x[i] milik daftar_tiket[i]), dibangun
+// saat muat, ditambah saat tiket masuk, dan digeser bersama tiket saat pemadatan.
+// ----------------------------------------------------------------------------------
+void cadangkan_kolom(int minimal) {
+    if (minimal <= kapasitas_kolom) return;
+    int kapasitas = kapasitas_kolom < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_kolom;
+    while (kapasitas < minimal) kapasitas *= 2;
+    int *id = (int *)realloc(kolom_id, kapasitas * sizeof(int));
+    if (id != NULL) kolom_id = id;
+    float *harga = (float *)realloc(kolom_harga, kapasitas * sizeof(float));
+    if (harga != NULL) kolom_harga = harga;
+    int *stok = (int *)realloc(kolom_stok, kapasitas * sizeof(int));
+    if (stok != NULL) kolom_stok = stok;
+    time_t *waktu = (time_t *)realloc(kolom_waktu, kapasitas * sizeof(time_t));
+    if (waktu != NULL) kolom_waktu = waktu;
+    int kata_lama = (kapasitas_kolom + 63) / 64, kata = (kapasitas + 63) / 64;
+    uint64_t *peta = (uint64_t *)realloc(peta_tersedia, kata * sizeof(uint64_t));
+    if (peta != NULL) { memset(peta + kata_lama, 0, (kata - kata_lama) * sizeof(uint64_t)); peta_tersedia = peta; }
+    if (id == NULL || harga == NULL || stok == NULL || waktu == NULL || peta == NULL) { perror("Gagal alokasi kolom tiket"); exit(EXIT_FAILURE); }
+    kapasitas_kolom = kapasitas;
+}
 
-    if (jumlah_tiket == 0) { printf("⚠️ Saat ini tidak ada tiket yang tersedia.\n"); return; }
+// Salin field numerik daftar_tiket[posisi] ke kolomnya
+void isi_kolom(int posisi) {
+    cadangkan_kolom(posisi + 1);
+    kolom_id[posisi] = daftar_tiket[posisi].id;
+    kolom_harga[posisi] = daftar_tiket[posisi].harga;
+    kolom_stok[posisi] = daftar_tiket[posisi].jumlah_stok;
+    kolom_waktu[posisi] = daftar_tiket[posisi].waktu_dibuat;
+    perbarui_tersedia(posisi);
+}
 
-    printf("Masukkan ID Tiket yang akan dibeli: ");
-    if (scanf("%d", &id_beli) != 1) { printf("❌ ID tidak valid.\n"); bersihkan_buffer(); return; }
-    bersihkan_buffer();
+void bangun_kolom() {
+    cadangkan_kolom(jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) isi_kolom(i);
+    bangun_tersedia();
+}
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id == id_beli) { index_tiket = i; break; }
+void kosongkan_kolom() {
+    free(kolom_id); free(kolom_harga); free(kolom_stok); free(kolom_waktu); free(peta_tersedia);
+    kolom_id = NULL; kolom_harga = NULL; kolom_stok = NULL; kolom_waktu = NULL; peta_tersedia = NULL;
+    kapasitas_kolom = 0; jumlah_tersedia = 0;
+}
+
+// Samakan bit tersedia slot `posisi` dengan kolom id/stoknya (pembelian serentak memakai jalur atomik sendiri)
+void perbarui_tersedia(int posisi) {
+    uint64_t bit = 1ULL << (posisi & 63), *kata = &peta_tersedia[posisi >> 6];
+    int tersedia = kolom_id[posisi] != ID_NISAN && kolom_stok[posisi] > 0;
+    if (tersedia == ((*kata & bit) != 0)) return;
+    *kata ^= bit;
+    jumlah_tersedia += tersedia ? 1 : -1;
+}
+
+// Isi ulang peta dari kolom (setelah muat data atau pemadatan); bit di atas jumlah_tiket selalu 0
+void bangun_tersedia() {
+    if (kapasitas_kolom == 0) return;
+    memset(peta_tersedia, 0, (kapasitas_kolom + 63) / 64 * sizeof(uint64_t));
+    jumlah_tersedia = 0;
+    for (int i = 0; i < jumlah_tiket; i++) perbarui_tersedia(i);
+}
+
+// Posisi tiket tersedia pertama mulai `mulai`; jumlah_tiket jika tidak ada lagi
+int tersedia_berikutnya(int mulai) {
+    if (mulai >= jumlah_tiket) return jumlah_tiket;
+    int w = mulai >> 6, kata_terpakai = (jumlah_tiket + 63) >> 6;
+    uint64_t kata = peta_tersedia[w] & (~0ULL << (mulai & 63));
+    while (kata == 0) {
+        if (++w >= kata_terpakai) return jumlah_tiket;
+        kata = peta_tersedia[w];
     }
+    return w * 64 + __builtin_ctzll(kata);
+}
+
+// Tiket bersetok tinggal sedikit: lebih murah dikumpulkan dari peta daripada menjalani seluruh urutan
+int tersedia_jarang() {
+    return (long long)jumlah_tersedia * RASIO_TERSEDIA_JARANG < jumlah_tiket;
+}
+
+void atur_harga(int posisi, float harga) {
+    daftar_tiket[posisi].harga = harga; tandai_kotor(posisi);
+    if (kolom_harga[posisi] == harga) return;
+    pohon_harga_lepas(kolom_harga[posisi], kolom_id[posisi]); pohon_harga_tambah(harga, kolom_id[posisi]);
+    kolom_harga[posisi] = harga;
+    // Entri di bagian yang sudah urut pindah ke ekor; yang sudah di ekor tetap di sana
+    int k = urut_harga.letak[posisi];
+    if (k >= 0 && k < urut_harga.terurut) { urutan_lepas(&urut_harga, posisi); urutan_tambah(&urut_harga, posisi); }
+}
+
+void atur_stok(int posisi, int stok) {
+    daftar_tiket[posisi].jumlah_stok = stok; tandai_kotor(posisi);
+    kolom_stok[posisi] = stok;
+    perbarui_tersedia(posisi);
+}
+
+// ----------------------------------------------------------------------------------
+// INDEKS URUTAN: tiket baru/berubah cukup masuk ekor (O(1)) dan entri lamanya dijadikan lubang
+// lewat `letak` (O(1)). Saat urutan dibutuhkan, hanya ekor yang di-qsort lalu digabung dengan
+// bagian yang sudah urut dalam satu sapuan linear: O(n + m log m) untuk m perubahan.
+// ----------------------------------------------------------------------------------
+int banding_urut_harga(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    if (kolom_harga[x] != kolom_harga[y]) return kolom_harga[x] < kolom_harga[y] ? -1 : 1;
+    return (kolom_id[x] > kolom_id[y]) - (kolom_id[x] < kolom_id[y]);
+}
+
+int banding_urut_nama(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    int hasil = strcmp(daftar_tiket[x].nama_konser, daftar_tiket[y].nama_konser);
+    if (hasil != 0) return hasil;
+    return (kolom_id[x] > kolom_id[y]) - (kolom_id[x] < kolom_id[y]);
+}
+
+// ----------------------------------------------------------------------------------
+// RADIX SORT untuk pengurutan penuh (bangun indeks saat muat, ekor besar): alih-alih qsort yang
+// memanggil pembanding lewat pointer fungsi di setiap perbandingan, setiap tiket diwakili pasangan
+// 16 byte (kunci, id, posisi) lalu diurutkan LSD 8 bit per lintasan, dibagi ke beberapa utas.
+//   harga: bit float dibalik agar urutan bilangan = urutan bit, id di 32 bit bawah -> kunci lengkap
+//   nama : 8 byte nama (big-endian) + id; kelompok berawalan sama diurutkan lagi dengan 8 byte
+//          berikutnya (kelompok kecil cukup di-qsort), jadi seri selalu pecah menurut id
+// ----------------------------------------------------------------------------------
+#define AMBANG_RADIX 2048          // di bawah ini qsort lebih murah dari 256 ember per lintasan
+#define AMBANG_RADIX_PARALEL 65536 // di bawah ini membuat utas lebih mahal dari sortingnya
+#define MAKS_UTAS_SORTIR 8
+
+typedef struct {
+    uint64_t kunci;
+    uint32_t id;  // id dengan bit tanda dibalik; 0 jika sudah tercakup kunci
+    int posisi;
+} KunciUrut;
+
+typedef struct {
+    KunciUrut *sumber, *tujuan;
+    const int *isi;       // tahap 0: posisi yang diurutkan
+    const IndeksUrut *indeks;
+    int awal, akhir;      // potongan milik utas ini
+    int lintasan, tahap;  // tahap 0 = isi kunci, 1 = hitung ember, 2 = sebar
+    int hitungan[256];    // hasil tahap 1, lalu offset tulis untuk tahap 2
+} TugasRadix;
+
+uint64_t kunci_urut_harga(int posisi, int kedalaman) {
+    (void)kedalaman;
+    float harga = kolom_harga[posisi];
+    if (harga == 0.0f) harga = 0.0f; // -0.0 sama dengan 0.0 bagi pembanding
+    uint32_t bit; memcpy(&bit, &harga, sizeof(bit));
+    bit = (bit & 0x80000000u) ? ~bit : bit | 0x80000000u;
+    return ((uint64_t)bit << 32) | ((uint32_t)kolom_id[posisi] ^ 0x80000000u);
+}
+
+uint64_t kunci_urut_nama(int posisi, int kedalaman) {
+    const unsigned char *nama = (const unsigned char *)daftar_tiket[posisi].nama_konser;
+    uint64_t kunci = 0; int habis = 0;
+    for (int i = 8 * kedalaman; i < 8 * kedalaman + 8; i++) {
+        if (i >= MAX_NAMA || nama[i] == '\0') habis = 1;
+        kunci = (kunci << 8) | (habis ? 0 : nama[i]);
+    }
+    return kunci;
+}
+
+int banding_kunci_nama(const void *a, const void *b) {
+    return banding_urut_nama(&((const KunciUrut *)a)->posisi, &((const KunciUrut *)b)->posisi);
+}
+
+void kerjakan_radix(TugasRadix *t) {
+    int geser = 8 * (t->lintasan < 4 ? t->lintasan : t->lintasan - 4);
+    if (t->tahap == 0) {
+        for (int i = t->awal; i < t->akhir; i++) {
+            int posisi = t->isi[i];
+            t->sumber[i].kunci = t->indeks->kunci(posisi, 0);
+            t->sumber[i].id = t->indeks->kunci_awalan ? (uint32_t)kolom_id[posisi] ^ 0x80000000u : 0;
+            t->sumber[i].posisi = posisi;
+        }
+    } else if (t->tahap == 1) {
+        memset(t->hitungan, 0, sizeof(t->hitungan));
+        for (int i = t->awal; i < t->akhir; i++) {
+            uint64_t nilai = t->lintasan < 4 ? t->sumber[i].id : t->sumber[i].kunci;
+            t->hitungan[(nilai >> geser) & 0xFF]++;
+        }
+    } else {
+        for (int i = t->awal; i < t->akhir; i++) {
+            uint64_t nilai = t->lintasan < 4 ? t->sumber[i].id : t->sumber[i].kunci;
+            t->tujuan[t->hitungan[(nilai >> geser) & 0xFF]++] = t->sumber[i];
+        }
+    }
+}
+
+#if PAKAI_MMAP
+void *jalankan_radix(void *arg) { kerjakan_radix((TugasRadix *)arg); return NULL; }
+#endif
+
+// Utas 0 dikerjakan pemanggil; potongan yang utasnya gagal dibuat juga dikerjakan di sini
+void jalankan_tahap_radix(TugasRadix *tugas, int jumlah_utas, int tahap) {
+    int dibuat[MAKS_UTAS_SORTIR] = { 0 };
+    for (int t = 0; t < jumlah_utas; t++) tugas[t].tahap = tahap;
+#if PAKAI_MMAP
+    pthread_t utas[MAKS_UTAS_SORTIR];
+    for (int t = 1; t < jumlah_utas; t++) dibuat[t] = pthread_create(&utas[t], NULL, jalankan_radix, &tugas[t]) == 0;
+#endif
+    for (int t = 0; t < jumlah_utas; t++) if (!dibuat[t]) kerjakan_radix(&tugas[t]);
+#if PAKAI_MMAP
+    for (int t = 1; t < jumlah_utas; t++) if (dibuat[t]) pthread_join(utas[t], NULL);
+#endif
+}
+
+// 12 lintasan stabil: 4 byte id lalu 8 byte kunci. Lintasan yang semua elemennya jatuh di satu ember
+// dilewati (id nol pada kunci harga, byte atas harga yang seragam). Mengembalikan a atau b, mana yang berisi hasil.
+KunciUrut *radix_kunci(TugasRadix *tugas, int jumlah_utas, KunciUrut *a, KunciUrut *b, int n) {
+    for (int lintasan = 0; lintasan < 12; lintasan++) {
+        for (int t = 0; t < jumlah_utas; t++) { tugas[t].sumber = a; tugas[t].tujuan = b; tugas[t].lintasan = lintasan; }
+        jalankan_tahap_radix(tugas, jumlah_utas, 1);
+        int satu_ember = 0;
+        for (int d = 0; d < 256 && !satu_ember; d++) {
+            int isi_ember = 0;
+            for (int t = 0; t < jumlah_utas; t++) isi_ember += tugas[t].hitungan[d];
+            satu_ember = isi_ember == n;
+        }
+        if (satu_ember) continue;
+        // Offset tulis per (ember, utas): utas dengan potongan lebih awal menulis lebih dulu -> stabil
+        int total = 0;
+        for (int d = 0; d < 256; d++) {
+            for (int t = 0; t < jumlah_utas; t++) { int c = tugas[t].hitungan[d]; tugas[t].hitungan[d] = total; total += c; }
+        }
+        jalankan_tahap_radix(tugas, jumlah_utas, 2);
+        KunciUrut *tukar = a; a = b; b = tukar;
+    }
+    return a;
+}
+
+// a[0..n) urut menurut nama sampai byte 8*(kedalaman+1) lalu id; pecah kelompok yang kuncinya sama
+// dan namanya belum habis dengan 8 byte berikutnya
+void urutkan_kelompok_nama(KunciUrut *a, KunciUrut *bantu, int n, int kedalaman) {
+    for (int k = 0; k < n;) {
+        int j = k + 1;
+        while (j < n && a[j].kunci == a[k].kunci) j++;
+        if (j - k > 1 && (a[k].kunci & 0xFF) != 0) {
+            if (j - k < AMBANG_RADIX) qsort(a + k, j - k, sizeof(KunciUrut), banding_kunci_nama);
+            else {
+                // Kelompok ini sudah urut id, jadi cukup lintasan kunci (id dinolkan agar dilewati)
+                for (int i = k; i < j; i++) { a[i].kunci = kunci_urut_nama(a[i].posisi, kedalaman + 1); a[i].id = 0; }
+                TugasRadix tugas = { 0 };
+                tugas.awal = 0; tugas.akhir = j - k;
+                KunciUrut *hasil = radix_kunci(&tugas, 1, a + k, bantu + k, j - k);
+                if (hasil != a + k) memcpy(a + k, hasil, (j - k) * sizeof(KunciUrut));
+                urutkan_kelompok_nama(a + k, bantu + k, j - k, kedalaman + 1);
+            }
+        }
+        k = j;
+    }
+}
+
+// Urutkan n posisi menurut indeks x; hasil sama persis dengan qsort(isi, n, sizeof(int), x->banding)
+void urutkan_posisi(IndeksUrut *x, int *isi, int n) {
+    if (n < AMBANG_RADIX) { qsort(isi, n, sizeof(int), x->banding); return; }
+    KunciUrut *a = (KunciUrut *)malloc(n * sizeof(KunciUrut));
+    KunciUrut *b = (KunciUrut *)malloc(n * sizeof(KunciUrut));
+    if (a == NULL || b == NULL) { perror("Gagal alokasi sorting"); exit(EXIT_FAILURE); }
+    int jumlah_utas = 1;
+#if PAKAI_MMAP
+    if (n >= AMBANG_RADIX_PARALEL) {
+        long cpu = sysconf(_SC_NPROCESSORS_ONLN);
+        jumlah_utas = cpu < 1 ? 1 : cpu > MAKS_UTAS_SORTIR ? MAKS_UTAS_SORTIR : (int)cpu;
+    }
+#endif
+    TugasRadix tugas[MAKS_UTAS_SORTIR] = { 0 };
+    for (int t = 0; t < jumlah_utas; t++) {
+        tugas[t].sumber = a; tugas[t].isi = isi; tugas[t].indeks = x;
+        tugas[t].awal = (int)((long)n * t / jumlah_utas); tugas[t].akhir = (int)((long)n * (t + 1) / jumlah_utas);
+    }
+    jalankan_tahap_radix(tugas, jumlah_utas, 0);
+    KunciUrut *hasil = radix_kunci(tugas, jumlah_utas, a, b, n);
+    if (x->kunci_awalan) urutkan_kelompok_nama(hasil, hasil == a ? b : a, n, 0);
+    for (int k = 0; k < n; k++) isi[k] = hasil[k].posisi;
+    free(a); free(b);
+}
+
+void cadangkan_urutan(IndeksUrut *x, int minimal_isi, int minimal_letak) {
+    if (minimal_isi > x->kapasitas) {
+        int kapasitas = x->kapasitas < KAPASITAS_AWAL ? KAPASITAS_AWAL : x->kapasitas;
+        while (kapasitas < minimal_isi) kapasitas *= 2;
+        int *baru = (int *)realloc(x->isi, kapasitas * sizeof(int));
+        if (baru == NULL) { perror("Gagal alokasi indeks urutan"); exit(EXIT_FAILURE); }
+        x->isi = baru; x->kapasitas = kapasitas;
+    }
+    if (minimal_letak > x->kapasitas_letak) {
+        int kapasitas = x->kapasitas_letak < KAPASITAS_AWAL ? KAPASITAS_AWAL : x->kapasitas_letak;
+        while (kapasitas < minimal_letak) kapasitas *= 2;
+        int *baru = (int *)realloc(x->letak, kapasitas * sizeof(int));
+        if (baru == NULL) { perror("Gagal alokasi indeks urutan"); exit(EXIT_FAILURE); }
+        x->letak = baru; x->kapasitas_letak = kapasitas;
+    }
+}
+
+void urutan_tambah(IndeksUrut *x, int posisi) {
+    cadangkan_urutan(x, x->jumlah + 1, posisi + 1);
+    x->letak[posisi] = x->jumlah;
+    x->isi[x->jumlah++] = posisi;
+}
+
+void urutan_lepas(IndeksUrut *x, int posisi) {
+    int k = x->letak[posisi];
+    if (k < 0) return;
+    x->isi[k] = -1; x->letak[posisi] = -1; x->lubang++;
+}
+
+// Tiket pindah dari posisi `dari` ke `ke` saat pemadatan (ke <= dari); urutan entri tetap
+void urutan_pindah(IndeksUrut *x, int dari, int ke) {
+    int k = x->letak[dari];
+    if (k >= 0) x->isi[k] = ke;
+    x->letak[ke] = k;
+}
+
+// Isi ulang dari semua tiket aktif; semuanya masuk ekor dan baru diurutkan saat pertama dibutuhkan
+void bangun_urutan(IndeksUrut *x) {
+    x->jumlah = 0; x->terurut = 0; x->lubang = 0;
+    cadangkan_urutan(x, jumlah_tiket, jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) x->letak[i] = -1;
+        else urutan_tambah(x, i);
+    }
+}
+
+// Urutkan ekor lalu gabungkan dengan bagian yang sudah urut; sesudahnya tidak ada lubang
+void rapikan_urutan(IndeksUrut *x) {
+    if (x->terurut == x->jumlah && x->lubang == 0) return;
+    int awal_ekor = x->terurut, akhir_ekor = x->terurut;
+    for (int k = awal_ekor; k < x->jumlah; k++) {
+        if (x->isi[k] >= 0) x->isi[akhir_ekor++] = x->isi[k];
+    }
+    urutkan_posisi(x, x->isi + awal_ekor, akhir_ekor - awal_ekor);
+
+    int *baru = (int *)malloc((x->kapasitas > 0 ? x->kapasitas : 1) * sizeof(int));
+    if (baru == NULL) { perror("Gagal alokasi indeks urutan"); exit(EXIT_FAILURE); }
+    int i = 0, j = awal_ekor, n = 0;
+    while (i < awal_ekor || j < akhir_ekor) {
+        if (i < awal_ekor && x->isi[i] < 0) { i++; continue; }
+        int posisi = (j >= akhir_ekor || (i < awal_ekor && x->banding(&x->isi[i], &x->isi[j]) <= 0)) ? x->isi[i++] : x->isi[j++];
+        baru[n] = posisi;
+        x->letak[posisi] = n++;
+    }
+    free(x->isi);
+    x->isi = baru;
+    x->jumlah = x->terurut = n; x->lubang = 0;
+}
+
+void kosongkan_urutan(IndeksUrut *x) {
+    free(x->isi); free(x->letak);
+    x->isi = NULL; x->letak = NULL;
+    x->jumlah = 0; x->terurut = 0; x->lubang = 0; x->kapasitas = 0; x->kapasitas_letak = 0;
+}
+
+// Siapkan urutan tampilan aktif; mengembalikan banyaknya k yang dijalani posisi_tampilan(k)
+int siapkan_tampilan() {
+    if (urutan_tampilan == 0) return jumlah_tiket;
+    IndeksUrut *x = urutan_tampilan == 1 ? &urut_harga : &urut_nama;
+    rapikan_urutan(x);
+    return x->jumlah;
+}
+
+// Posisi tiket ke-k menurut urutan tampilan (sesudah siapkan_tampilan); pada urutan simpan bisa nisan
+int posisi_tampilan(int k) {
+    if (urutan_tampilan == 0) return k;
+    return (urutan_tampilan == 1 ? &urut_harga : &urut_nama)->isi[k];
+}
+
+// Susun ulang posisi hasil pencarian (urut naik) mengikuti urutan tampilan lewat letaknya di indeks
+void urutkan_hasil_tampilan(int *posisi, int jumlah) {
+    if (urutan_tampilan == 0 || jumlah < 2) return;
+    siapkan_tampilan();
+    IndeksUrut *x = urutan_tampilan == 1 ? &urut_harga : &urut_nama;
+    for (int k = 0; k < jumlah; k++) posisi[k] = x->letak[posisi[k]];
+    qsort(posisi, jumlah, sizeof(int), bandingkan_int);
+    for (int k = 0; k < jumlah; k++) posisi[k] = x->isi[posisi[k]];
+}
+
+// ----------------------------------------------------------------------------------
+// HALAMAN & TOP-K: daftar dibaca per halaman menurut urutan tampilan. Kursor = ID tiket terakhir
+// di halaman sebelumnya; letaknya di urutan didapat lewat indeks ID dan `letak`, jadi halaman
+// berikutnya cukup O(halaman) walau katalog berubah di antaranya. Tiket termurah dicari dengan
+// max-heap berukuran k, tanpa menyalin atau mengurutkan seluruh katalog.
+// ----------------------------------------------------------------------------------
+#define UKURAN_HALAMAN 10 // tiket per halaman di menu interaktif
+
+int tiket_lolos(int posisi, int hanya_tersedia) {
+    return kolom_id[posisi] != ID_NISAN && (!hanya_tersedia || kolom_stok[posisi] > 0);
+}
+
+// Letak (untuk posisi_tampilan) semua tiket tersedia yang letaknya >= `mulai`, urut naik, langsung dari
+// peta tersedia: O(n/64 + m log m) untuk m tiket bersetok. `*letak` dibebaskan pemanggil.
+int letak_tersedia(int mulai, int **letak) {
+    siapkan_tampilan();
+    IndeksUrut *x = urutan_tampilan == 0 ? NULL : urutan_tampilan == 1 ? &urut_harga : &urut_nama;
+    int jumlah = 0;
+    if ((*letak = (int *)malloc((jumlah_tersedia + 1) * sizeof(int))) == NULL) { perror("Gagal alokasi daftar tersedia"); exit(EXIT_FAILURE); }
+    for (int w = 0; w < (jumlah_tiket + 63) >> 6; w++) {
+        for (uint64_t bit = peta_tersedia[w]; bit; bit &= bit - 1) {
+            int i = w * 64 + __builtin_ctzll(bit), k = x != NULL ? x->letak[i] : i;
+            if (k >= mulai) (*letak)[jumlah++] = k;
+        }
+    }
+    if (x != NULL) qsort(*letak, jumlah, sizeof(int), bandingkan_int);
+    return jumlah;
+}
+
+// Letak (k untuk posisi_tampilan) tepat sesudah tiket `id`; -1 jika tiket sudah tidak ada
+int letak_kursor(int id) {
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) return -1;
+    siapkan_tampilan();
+    if (urutan_tampilan == 0) return posisi + 1;
+    return (urutan_tampilan == 1 ? &urut_harga : &urut_nama)->letak[posisi] + 1;
+}
+
+// Letak tiket lolos ke-`offset` (mulai 0). Tanpa saringan stok dan tanpa nisan di urutan langsung
+// O(1); selain itu tiket sebelumnya harus dihitung satu per satu.
+int letak_offset(int offset, int hanya_tersedia) {
+    int n = siapkan_tampilan();
+    if (!hanya_tersedia && (urutan_tampilan != 0 || jumlah_nisan == 0)) return offset < n ? offset : n;
+    if (hanya_tersedia && urutan_tampilan == 0) { // urutan simpan = urutan bit: dihitung per word
+        for (int w = 0; w < (jumlah_tiket + 63) >> 6; w++) {
+            int isi = __builtin_popcountll(peta_tersedia[w]);
+            if (offset >= isi) { offset -= isi; continue; }
+            uint64_t kata = peta_tersedia[w];
+            while (offset-- > 0) kata &= kata - 1;
+            return w * 64 + __builtin_ctzll(kata);
+        }
+        return n;
+    }
+    if (hanya_tersedia && tersedia_jarang()) {
+        int *letak, m = letak_tersedia(0, &letak);
+        int k = offset < m ? letak[offset] : n;
+        free(letak);
+        return k;
+    }
+    for (int k = 0; k < n; k++) {
+        if (tiket_lolos(posisi_tampilan(k), hanya_tersedia) && offset-- == 0) return k;
+    }
+    return n;
+}
+
+// Isi `posisi` dengan paling banyak `batas` tiket lolos mulai letak `mulai`. *kursor = ID tiket
+// terakhir bila halaman penuh (mungkin masih ada lanjutan), 0 bila daftar sudah habis.
+int ambil_halaman(int mulai, int batas, int hanya_tersedia, int *posisi, int *kursor) {
+    int n = siapkan_tampilan(), jumlah = 0;
+    if (hanya_tersedia && urutan_tampilan == 0) {
+        for (int i = tersedia_berikutnya(mulai); i < n && jumlah < batas; i = tersedia_berikutnya(i + 1)) posisi[jumlah++] = i;
+    } else if (hanya_tersedia && tersedia_jarang()) {
+        int *letak, m = letak_tersedia(mulai, &letak);
+        for (int j = 0; j < m && jumlah < batas; j++) posisi[jumlah++] = posisi_tampilan(letak[j]);
+        free(letak);
+    } else {
+        for (int k = mulai; k < n && jumlah < batas; k++) {
+            int i = posisi_tampilan(k);
+            if (tiket_lolos(i, hanya_tersedia)) posisi[jumlah++] = i;
+        }
+    }
+    *kursor = jumlah > 0 && jumlah == batas ? kolom_id[posisi[jumlah - 1]] : 0;
+    return jumlah;
+}
+
+void termahal_naik(int *heap, int i) {
+    while (i > 0) {
+        int induk = (i - 1) / 2;
+        if (banding_urut_harga(&heap[i], &heap[induk]) <= 0) break;
+        int t = heap[i]; heap[i] = heap[induk]; heap[induk] = t;
+        i = induk;
+    }
+}
+
+void termahal_turun(int *heap, int n, int i) {
+    for (;;) {
+        int besar = i, kiri = 2 * i + 1, kanan = 2 * i + 2;
+        if (kiri < n && banding_urut_harga(&heap[kiri], &heap[besar]) > 0) besar = kiri;
+        if (kanan < n && banding_urut_harga(&heap[kanan], &heap[besar]) > 0) besar = kanan;
+        if (besar == i) return;
+        int t = heap[i]; heap[i] = heap[besar]; heap[besar] = t;
+        i = besar;
+    }
+}
+
+// k tiket termurah yang stoknya > 0, urut (harga, id); `posisi` harus muat k entri. Bila indeks
+// harga sedang rapi (dan tiket bersetok tidak jarang) cukup dijalani dari depan, selain itu bit peta
+// tersedia disapu dengan max-heap berukuran k (O(m log k)) agar indeks tidak perlu dirapikan hanya untuk k tiket.
+int ambil_termurah(int k, int *posisi) {
+    int jumlah = 0;
+    if (k <= 0) return 0;
+    if (urut_harga.terurut == urut_harga.jumlah && urut_harga.lubang == 0 && !tersedia_jarang()) {
+        for (int j = 0; j < urut_harga.jumlah && jumlah < k; j++) {
+            if (kolom_stok[urut_harga.isi[j]] > 0) posisi[jumlah++] = urut_harga.isi[j];
+        }
+        return jumlah;
+    }
+    for (int w = 0; w < (jumlah_tiket + 63) >> 6; w++) {
+        for (uint64_t bit = peta_tersedia[w]; bit; bit &= bit - 1) {
+            int i = w * 64 + __builtin_ctzll(bit);
+            if (jumlah < k) { posisi[jumlah] = i; termahal_naik(posisi, jumlah++); }
+            else if (banding_urut_harga(&i, &posisi[0]) < 0) { posisi[0] = i; termahal_turun(posisi, k, 0); }
+        }
+    }
+    // Puncak (termahal) dipindah ke belakang satu per satu: hasilnya urut naik
+    for (int sisa = jumlah - 1; sisa > 0; sisa--) {
+        int t = posisi[0]; posisi[0] = posisi[sisa]; posisi[sisa] = t;
+        termahal_turun(posisi, sisa, 0);
+    }
+    return jumlah;
+}
+
+// Enter = tampilkan halaman berikutnya, jawaban lain = berhenti
+int lanjut_halaman() {
+    char jawaban[16];
+    printf("-- Enter: halaman berikutnya, q: selesai -- ");
+    if (fgets(jawaban, sizeof(jawaban), stdin) == NULL) return 0;
+    if (strchr(jawaban, '\n') == NULL) bersihkan_buffer();
+    return jawaban[0] == '\n';
+}
+
+// ----------------------------------------------------------------------------------
+// POHON HARGA (B+tree): kunci (harga, id) urut naik di simpul lebar, daun dirantai kiri-kanan. Rentang
+// harga cukup turun sekali ke daun pertama lalu menyusuri daun: O(log n + k), tanpa merapikan indeks
+// urutan. Daun menyimpan ID, bukan posisi, jadi pemadatan tidak menyentuh pohon (posisi dicari lewat
+// indeks ID). Pohon baru dibangun saat rentang pertama diminta, lalu dirawat setiap tiket masuk, dihapus,
+// atau harganya berubah. Penghapusan tidak menggabung simpul; simpul yang kosong langsung dilepas.
+// ----------------------------------------------------------------------------------
+#define CABANG_POHON 32 // kunci per simpul; 32 x (harga + id) = 256 byte, beberapa cache line
+
+typedef struct SimpulHarga {
+    int jumlah;
+    int daun;
+    float harga[CABANG_POHON]; // simpul dalam: kunci terkecil (atau lebih kecil) di anak[i]
+    int id[CABANG_POHON];
+    struct SimpulHarga *anak[CABANG_POHON];  // hanya simpul dalam
+    struct SimpulHarga *kiri, *kanan;        // hanya daun
+} SimpulHarga;
+SimpulHarga *akar_harga = NULL;
+int pohon_harga_aktif = 0; // 0 = belum dibangun; perubahan tiket belum perlu dicatat
+
+int banding_kunci_harga(float harga_a, int id_a, float harga_b, int id_b) {
+    if (harga_a != harga_b) return harga_a < harga_b ? -1 : 1;
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+// Indeks kunci pertama di simpul yang > (harga, id) bila `lebih`, atau >= bila tidak
+int cari_kunci_simpul(const SimpulHarga *s, float harga, int id, int lebih) {
+    int kiri = 0, kanan = s->jumlah;
+    while (kiri < kanan) {
+        int tengah = (kiri + kanan) / 2, b = banding_kunci_harga(s->harga[tengah], s->id[tengah], harga, id);
+        if (b < 0 || (lebih && b == 0)) kiri = tengah + 1; else kanan = tengah;
+    }
+    return kiri;
+}
+
+// Anak yang memuat (harga, id): kunci terakhir yang <= kunci itu (anak pertama bila semua lebih besar)
+int cari_anak_simpul(const SimpulHarga *s, float harga, int id) {
+    int i = cari_kunci_simpul(s, harga, id, 1) - 1;
+    return i < 0 ? 0 : i;
+}
+
+SimpulHarga *simpul_harga_baru(int daun) {
+    SimpulHarga *s = (SimpulHarga *)calloc(1, sizeof(SimpulHarga));
+    if (s == NULL) { perror("Gagal alokasi pohon harga"); exit(EXIT_FAILURE); }
+    s->daun = daun;
+    return s;
+}
+
+// Belah anak[i] yang penuh menjadi dua; separuh kanan masuk induk sebagai anak[i + 1]
+void belah_simpul_harga(SimpulHarga *induk, int i) {
+    SimpulHarga *a = induk->anak[i], *b = simpul_harga_baru(a->daun);
+    int separuh = CABANG_POHON / 2;
+    b->jumlah = a->jumlah - separuh;
+    memcpy(b->harga, a->harga + separuh, b->jumlah * sizeof(float));
+    memcpy(b->id, a->id + separuh, b->jumlah * sizeof(int));
+    if (!a->daun) memcpy(b->anak, a->anak + separuh, b->jumlah * sizeof(SimpulHarga *));
+    a->jumlah = separuh;
+    if (a->daun) {
+        b->kiri = a; b->kanan = a->kanan;
+        if (a->kanan != NULL) a->kanan->kiri = b;
+        a->kanan = b;
+    }
+    int geser = induk->jumlah - i - 1;
+    memmove(induk->harga + i + 2, induk->harga + i + 1, geser * sizeof(float));
+    memmove(induk->id + i + 2, induk->id + i + 1, geser * sizeof(int));
+    memmove(induk->anak + i + 2, induk->anak + i + 1, geser * sizeof(SimpulHarga *));
+    induk->harga[i + 1] = b->harga[0]; induk->id[i + 1] = b->id[0]; induk->anak[i + 1] = b;
+    induk->jumlah++;
+}
+
+// Sisipkan kunci; simpul penuh dibelah sambil turun sehingga induknya selalu masih muat
+void pohon_harga_tambah(float harga, int id) {
+    if (!pohon_harga_aktif) return;
+    if (akar_harga == NULL) akar_harga = simpul_harga_baru(1);
+    if (akar_harga->jumlah == CABANG_POHON) {
+        SimpulHarga *akar = simpul_harga_baru(0);
+        akar->harga[0] = akar_harga->harga[0]; akar->id[0] = akar_harga->id[0]; akar->anak[0] = akar_harga; akar->jumlah = 1;
+        akar_harga = akar;
+        belah_simpul_harga(akar, 0);
+    }
+    SimpulHarga *s = akar_harga;
+    while (!s->daun) {
+        int i = cari_anak_simpul(s, harga, id);
+        if (banding_kunci_harga(harga, id, s->harga[i], s->id[i]) < 0) { s->harga[i] = harga; s->id[i] = id; } // kunci terkecil baru
+        if (s->anak[i]->jumlah == CABANG_POHON) {
+            belah_simpul_harga(s, i);
+            if (banding_kunci_harga(harga, id, s->harga[i + 1], s->id[i + 1]) >= 0) i++;
+        }
+        s = s->anak[i];
+    }
+    int i = cari_kunci_simpul(s, harga, id, 0), geser = s->jumlah - i;
+    memmove(s->harga + i + 1, s->harga + i, geser * sizeof(float));
+    memmove(s->id + i + 1, s->id + i, geser * sizeof(int));
+    s->harga[i] = harga; s->id[i] = id;
+    s->jumlah++;
+}
+
+// Hapus kunci dari subpohon `s`; 1 bila `s` jadi kosong (dilepas oleh induknya)
+int hapus_dari_simpul_harga(SimpulHarga *s, float harga, int id) {
+    int i;
+    if (s->daun) {
+        i = cari_kunci_simpul(s, harga, id, 0);
+        if (i == s->jumlah || s->harga[i] != harga || s->id[i] != id) return 0;
+    } else {
+        i = cari_anak_simpul(s, harga, id);
+        if (!hapus_dari_simpul_harga(s->anak[i], harga, id)) return 0;
+        SimpulHarga *kosong = s->anak[i];
+        if (kosong->daun) {
+            if (kosong->kiri != NULL) kosong->kiri->kanan = kosong->kanan;
+            if (kosong->kanan != NULL) kosong->kanan->kiri = kosong->kiri;
+        }
+        free(kosong);
+        memmove(s->anak + i, s->anak + i + 1, (s->jumlah - i - 1) * sizeof(SimpulHarga *));
+    }
+    // Kunci sesudahnya digeser; kunci simpul dalam yang kini lebih kecil dari isi anaknya tetap sah
+    memmove(s->harga + i, s->harga + i + 1, (s->jumlah - i - 1) * sizeof(float));
+    memmove(s->id + i, s->id + i + 1, (s->jumlah - i - 1) * sizeof(int));
+    return --s->jumlah == 0;
+}
+
+void pohon_harga_lepas(float harga, int id) {
+    if (!pohon_harga_aktif || akar_harga == NULL) return;
+    if (hapus_dari_simpul_harga(akar_harga, harga, id)) { free(akar_harga); akar_harga = NULL; return; }
+    while (!akar_harga->daun && akar_harga->jumlah == 1) { // akar dengan satu anak tidak berguna
+        SimpulHarga *lama = akar_harga;
+        akar_harga = lama->anak[0];
+        free(lama);
+    }
+}
+
+void bebaskan_simpul_harga(SimpulHarga *s) {
+    if (!s->daun) for (int i = 0; i < s->jumlah; i++) bebaskan_simpul_harga(s->anak[i]);
+    free(s);
+}
+
+void kosongkan_pohon_harga() {
+    if (akar_harga != NULL) bebaskan_simpul_harga(akar_harga);
+    akar_harga = NULL;
+    pohon_harga_aktif = 0;
+}
+
+// Bangun dari bawah ke atas memakai urutan indeks harga (sudah urut (harga, id)): daun diisi 3/4
+// agar tiket baru jarang langsung membelah, lalu setiap tingkat di atasnya memegang 3/4 anak.
+void bangun_pohon_harga() {
+    kosongkan_pohon_harga();
+    pohon_harga_aktif = 1;
+    rapikan_urutan(&urut_harga);
+    int n = urut_harga.jumlah, isi = CABANG_POHON * 3 / 4;
+    if (n == 0) return;
+    int jumlah_simpul = (n + isi - 1) / isi;
+    SimpulHarga **lapis = (SimpulHarga **)malloc(jumlah_simpul * sizeof(SimpulHarga *)), *kiri = NULL;
+    if (lapis == NULL) { perror("Gagal alokasi pohon harga"); exit(EXIT_FAILURE); }
+    for (int j = 0; j < jumlah_simpul; j++) {
+        SimpulHarga *s = simpul_harga_baru(1);
+        for (int k = j * isi; k < n && s->jumlah < isi; k++) {
+            int posisi = urut_harga.isi[k];
+            s->harga[s->jumlah] = kolom_harga[posisi]; s->id[s->jumlah++] = kolom_id[posisi];
+        }
+        s->kiri = kiri;
+        if (kiri != NULL) kiri->kanan = s;
+        lapis[j] = kiri = s;
+    }
+    while (jumlah_simpul > 1) { // lapis[j] boleh ditimpa: anak yang dibaca selalu di indeks >= j * isi
+        int atas = (jumlah_simpul + isi - 1) / isi;
+        for (int j = 0; j < atas; j++) {
+            SimpulHarga *s = simpul_harga_baru(0);
+            for (int k = j * isi; k < jumlah_simpul && s->jumlah < isi; k++) {
+                s->harga[s->jumlah] = lapis[k]->harga[0]; s->id[s->jumlah] = lapis[k]->id[0]; s->anak[s->jumlah++] = lapis[k];
+            }
+            lapis[j] = s;
+        }
+        jumlah_simpul = atas;
+    }
+    akar_harga = lapis[0];
+    free(lapis);
+}
+
+// Paling banyak `batas` tiket dengan harga_min <= harga <= harga_max, urut (harga, id), mulai sesudah
+// tiket `setelah` (0 = dari awal rentang). Saringan stok dan kategori (NULL = semua, sudah di-casefold)
+// diperiksa sambil menyusuri daun. *kursor = ID terakhir bila halaman penuh, 0 bila rentang habis.
+// Mengembalikan jumlah tiket, atau -1 bila tiket `setelah` sudah tidak ada.
+int ambil_rentang_harga(float harga_min, float harga_max, int setelah, int hanya_tersedia, const char *kategori_lipat, int *posisi, int batas, int *kursor) {
+    float harga_mulai = harga_min;
+    int id_mulai = INT_MIN, lewati = 0, jumlah = 0;
+    *kursor = 0;
+    if (setelah != 0) {
+        int p = cari_indeks_id(setelah);
+        if (p < 0) return -1;
+        if (banding_kunci_harga(kolom_harga[p], setelah, harga_min, INT_MIN) > 0) { harga_mulai = kolom_harga[p]; id_mulai = setelah; lewati = 1; }
+    }
+    if (!pohon_harga_aktif) bangun_pohon_harga();
+    if (akar_harga == NULL || batas <= 0) return 0;
+    int kode = kategori_lipat != NULL ? kode_kategori(kategori_lipat, 0) : 0;
+    SimpulHarga *s = akar_harga;
+    while (!s->daun) s = s->anak[cari_anak_simpul(s, harga_mulai, id_mulai)];
+    for (int i = cari_kunci_simpul(s, harga_mulai, id_mulai, lewati); s != NULL; s = s->kanan, i = 0) {
+        for (; i < s->jumlah; i++) {
+            if (s->harga[i] > harga_max) return jumlah;
+            int p = cari_indeks_id(s->id[i]);
+            if (hanya_tersedia && kolom_stok[p] <= 0) continue;
+            if (kategori_lipat != NULL && !tiket_berkategori(p, kode, kategori_lipat)) continue;
+            posisi[jumlah++] = p;
+            if (jumlah == batas) { *kursor = s->id[i]; return jumlah; }
+        }
+    }
+    return jumlah;
+}
+
+// ----------------------------------------------------------------------------------
+// INDEKS KADALUARSA: min-heap berdasarkan waktu kadaluarsa, sehingga pemeriksaan hanya
+// menyentuh tiket yang benar-benar kadaluarsa (O(k log n)) dan cukup murah untuk
+// dijalankan berkala di setiap putaran menu. Entri memakai ID, bukan posisi, jadi
+// tetap berlaku setelah sorting dan pemadatan.
+// ----------------------------------------------------------------------------------
+void heap_tukar(int a, int b) {
+    EntriKadaluarsa t = heap_kadaluarsa[a]; heap_kadaluarsa[a] = heap_kadaluarsa[b]; heap_kadaluarsa[b] = t;
+}
+
+void heap_naik(int i) {
+    while (i > 0 && heap_kadaluarsa[(i - 1) / 2].waktu > heap_kadaluarsa[i].waktu) {
+        heap_tukar(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void heap_turun(int i) {
+    while (1) {
+        int terkecil = i, kiri = 2 * i + 1, kanan = 2 * i + 2;
+        if (kiri < ukuran_heap && heap_kadaluarsa[kiri].waktu < heap_kadaluarsa[terkecil].waktu) terkecil = kiri;
+        if (kanan < ukuran_heap && heap_kadaluarsa[kanan].waktu < heap_kadaluarsa[terkecil].waktu) terkecil = kanan;
+        if (terkecil == i) return;
+        heap_tukar(i, terkecil);
+        i = terkecil;
+    }
+}
+
+void cadangkan_heap(int minimal) {
+    if (minimal <= kapasitas_heap) return;
+    int kapasitas = kapasitas_heap < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_heap;
+    while (kapasitas < minimal) kapasitas *= 2;
+    EntriKadaluarsa *baru = (EntriKadaluarsa *)realloc(heap_kadaluarsa, kapasitas * sizeof(EntriKadaluarsa));
+    if (baru == NULL) { perror("Gagal mengalokasikan indeks kadaluarsa"); exit(EXIT_FAILURE); }
+    heap_kadaluarsa = baru;
+    kapasitas_heap = kapasitas;
+}
+
+// Bangun ulang dari semua tiket aktif dalam O(n) (heapify); sekaligus membuang entri basi
+void bangun_heap_kadaluarsa() {
+    cadangkan_heap(jumlah_tiket_aktif());
+    ukuran_heap = 0;
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) continue;
+        heap_kadaluarsa[ukuran_heap].waktu = kolom_waktu[i] + KADALUARSA_DETIK;
+        heap_kadaluarsa[ukuran_heap].id = kolom_id[i];
+        ukuran_heap++;
+    }
+    for (int i = ukuran_heap / 2 - 1; i >= 0; i--) heap_turun(i);
+}
+
+void kadaluarsa_tambah(int posisi) {
+    // Bila entri basi sudah menumpuk, bangun ulang (tiket baru ikut masuk di sana)
+    if (ukuran_heap >= 2 * jumlah_tiket_aktif() + KAPASITAS_AWAL) { bangun_heap_kadaluarsa(); return; }
+    cadangkan_heap(ukuran_heap + 1);
+    heap_kadaluarsa[ukuran_heap].waktu = kolom_waktu[posisi] + KADALUARSA_DETIK;
+    heap_kadaluarsa[ukuran_heap].id = kolom_id[posisi];
+    heap_naik(ukuran_heap++);
+}
+
+void heap_buang_puncak() {
+    heap_kadaluarsa[0] = heap_kadaluarsa[--ukuran_heap];
+    heap_turun(0);
+}
+
+// Apakah ada tiket aktif yang kadaluarsa pada `sekarang`? Entri basi di puncak dibuang di sini.
+int ada_tiket_kadaluarsa(time_t sekarang) {
+    while (ukuran_heap > 0 && heap_kadaluarsa[0].waktu < sekarang) {
+        int posisi = cari_indeks_id(heap_kadaluarsa[0].id);
+        if (posisi >= 0 && kolom_waktu[posisi] + KADALUARSA_DETIK == heap_kadaluarsa[0].waktu) return 1;
+        heap_buang_puncak();
+    }
+    return 0;
+}
+
+// Keluarkan tiket kadaluarsa berikutnya dari heap; mengembalikan posisinya, atau -1 jika tidak ada
+int ambil_tiket_kadaluarsa(time_t sekarang) {
+    if (!ada_tiket_kadaluarsa(sekarang)) return -1;
+    int posisi = cari_indeks_id(heap_kadaluarsa[0].id);
+    heap_buang_puncak();
+    return posisi;
+}
+
+// ----------------------------------------------------------------------------------
+// TEKS CASEFOLD (KOLOM BAYANGAN): nama & kategori dilipat ke huruf kecil sekali saat tiket
+// masuk/berubah (kategori lalu di-intern ke kamus), sehingga pencarian tanpa tolower per karakter.
+// Tabel lipat hanya memetakan A-Z (tidak bergantung locale), sama seperti tolower di locale "C".
+// ----------------------------------------------------------------------------------
+#define LIPAT_1(c) ((c) >= 'A' && (c) <= 'Z' ? (c) + ('a' - 'A') : (c))
+#define LIPAT_4(c) LIPAT_1(c), LIPAT_1((c) + 1), LIPAT_1((c) + 2), LIPAT_1((c) + 3)
+#define LIPAT_16(c) LIPAT_4(c), LIPAT_4((c) + 4), LIPAT_4((c) + 8), LIPAT_4((c) + 12)
+#define LIPAT_64(c) LIPAT_16(c), LIPAT_16((c) + 16), LIPAT_16((c) + 32), LIPAT_16((c) + 48)
+const unsigned char tabel_lipat[256] = { LIPAT_64(0), LIPAT_64(64), LIPAT_64(128), LIPAT_64(192) };
+
+// Salin `asal` ke `tujuan` dalam huruf kecil (boleh tujuan == asal), selalu diakhiri '\0'; hasilnya panjang teks
+size_t lipat_teks(char *tujuan, const char *asal, size_t ukuran) {
+    size_t i = 0;
+    for (; i + 1 < ukuran && asal[i]; i++) tujuan[i] = (char)tabel_lipat[(unsigned char)asal[i]];
+    tujuan[i] = '\0';
+    return i;
+}
+
+void cadangkan_lipat(int minimal) {
+    if (minimal <= kapasitas_lipat) return;
+    int kapasitas = kapasitas_lipat < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_lipat;
+    while (kapasitas < minimal) kapasitas *= 2;
+    TeksLipat *baru = (TeksLipat *)realloc(teks_lipat, kapasitas * sizeof(TeksLipat));
+    if (baru == NULL) { perror("Gagal alokasi teks casefold"); exit(EXIT_FAILURE); }
+    teks_lipat = baru; kapasitas_lipat = kapasitas;
+    perbesar_bitmap_kategori(kapasitas);
+}
+
+// Lipat nama dan intern kategori tiket di `posisi`; bitmap kategori diurus pemanggil
+void lipat_tiket(int posisi) {
+    char kategori[MAX_KATEGORI];
+    cadangkan_lipat(posisi + 1);
+    teks_lipat[posisi].panjang_nama = (unsigned char)lipat_teks(teks_lipat[posisi].nama, daftar_tiket[posisi].nama_konser, MAX_NAMA);
+    lipat_teks(kategori, daftar_tiket[posisi].kategori, MAX_KATEGORI);
+    teks_lipat[posisi].kode_kategori = (unsigned char)kode_kategori(kategori, 1);
+}
+
+void bangun_teks_lipat() {
+    cadangkan_lipat(jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) lipat_tiket(i);
+    bangun_bitmap_kategori();
+}
+
+// ----------------------------------------------------------------------------------
+// KAMUS KATEGORI: filter kategori cukup menelusuri bit yang menyala di bitmap kodenya, dan
+// jumlah tiket per kategori didapat dari popcount. Kode tidak pernah dihapus selama data
+// dimuat, jadi kode di teks_lipat tetap sah. Slot berkode 0 dicocokkan lewat teks aslinya.
+// ----------------------------------------------------------------------------------
+uint32_t hash_teks(const char *teks) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (; *teks; teks++) h = (h ^ (unsigned char)*teks) * 16777619u;
+    return h;
+}
+
+// Kode untuk kategori `nama_lipat` (sudah di-casefold). Bila belum ada: dibuat jika `buat`,
+// selain itu (atau bila kamus penuh) hasilnya 0.
+int kode_kategori(const char *nama_lipat, int buat) {
+    unsigned int i = hash_teks(nama_lipat) & (SLOT_KAMUS_KATEGORI - 1);
+    for (; slot_kamus_kategori[i] != 0; i = (i + 1) & (SLOT_KAMUS_KATEGORI - 1)) {
+        if (strcmp(kamus_kategori[slot_kamus_kategori[i]].nama, nama_lipat) == 0) return slot_kamus_kategori[i];
+    }
+    if (!buat || jumlah_kode_kategori == MAX_KODE_KATEGORI) return 0;
+    int kode = jumlah_kode_kategori;
+    uint64_t *bitmap = (uint64_t *)calloc(kata_bitmap_kategori > 0 ? kata_bitmap_kategori : 1, sizeof(uint64_t));
+    if (bitmap == NULL) { perror("Gagal alokasi bitmap kategori"); exit(EXIT_FAILURE); }
+    snprintf(kamus_kategori[kode].nama, MAX_KATEGORI, "%s", nama_lipat);
+    kamus_kategori[kode].bitmap = bitmap;
+    slot_kamus_kategori[i] = (unsigned char)kode;
+    jumlah_kode_kategori++;
+    return kode;
+}
+
+// Semua bitmap selalu muat `kapasitas_slot` slot (mengikuti kapasitas teks_lipat)
+void perbesar_bitmap_kategori(int kapasitas_slot) {
+    int kata = (kapasitas_slot + 63) / 64;
+    if (kata <= kata_bitmap_kategori) return;
+    for (int k = 0; k < jumlah_kode_kategori; k++) {
+        uint64_t *baru = (uint64_t *)realloc(kamus_kategori[k].bitmap, kata * sizeof(uint64_t));
+        if (baru == NULL) { perror("Gagal alokasi bitmap kategori"); exit(EXIT_FAILURE); }
+        memset(baru + kata_bitmap_kategori, 0, (kata - kata_bitmap_kategori) * sizeof(uint64_t));
+        kamus_kategori[k].bitmap = baru;
+    }
+    kata_bitmap_kategori = kata;
+}
+
+void kategori_pasang(int posisi) { kamus_kategori[teks_lipat[posisi].kode_kategori].bitmap[posisi >> 6] |= 1ULL << (posisi & 63); }
+void kategori_lepas(int posisi) { kamus_kategori[teks_lipat[posisi].kode_kategori].bitmap[posisi >> 6] &= ~(1ULL << (posisi & 63)); }
+
+// Isi ulang semua bitmap dari kode di teks_lipat (setelah muat data atau pemadatan)
+void bangun_bitmap_kategori() {
+    if (kata_bitmap_kategori == 0) return; // belum ada slot sama sekali
+    for (int k = 0; k < jumlah_kode_kategori; k++) memset(kamus_kategori[k].bitmap, 0, kata_bitmap_kategori * sizeof(uint64_t));
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (daftar_tiket[i].id != ID_NISAN) kategori_pasang(i);
+    }
+}
+
+void kosongkan_kamus_kategori() {
+    for (int k = 0; k < jumlah_kode_kategori; k++) { free(kamus_kategori[k].bitmap); kamus_kategori[k].bitmap = NULL; }
+    memset(slot_kamus_kategori, 0, sizeof(slot_kamus_kategori));
+    jumlah_kode_kategori = 1; kata_bitmap_kategori = 0;
+}
+
+// Jumlah tiket aktif berkode `kode` (popcount bitmap)
+int hitung_kategori(int kode) {
+    int jumlah = 0;
+    for (int w = 0; w < kata_bitmap_kategori; w++) jumlah += __builtin_popcountll(kamus_kategori[kode].bitmap[w]);
+    return jumlah;
+}
+
+// Kategori tiket di `posisi` sama dengan `kriteria_lipat` (kode = kode_kategori(kriteria_lipat, 0));
+// tiket berkode 0 (di luar kamus) dibandingkan lewat teksnya
+int tiket_berkategori(int posisi, int kode, const char *kriteria_lipat) {
+    if (teks_lipat[posisi].kode_kategori != 0) return teks_lipat[posisi].kode_kategori == kode;
+    char kategori[MAX_KATEGORI];
+    lipat_teks(kategori, daftar_tiket[posisi].kategori, MAX_KATEGORI);
+    return strcmp(kategori, kriteria_lipat) == 0;
+}
+
+// Posisi tiket aktif yang kategorinya sama dengan `kriteria_lipat` (sudah di-casefold), urut naik;
+// hanya_tersedia = bitmap kategori di-AND dengan peta tersedia. `*posisi` dibebaskan pemanggil.
+int cari_posisi_kategori(const char *kriteria_lipat, int hanya_tersedia, int **posisi) {
+    int kode = kode_kategori(kriteria_lipat, 0), jumlah = 0;
+    if ((*posisi = (int *)malloc((jumlah_tiket + 1) * sizeof(int))) == NULL) return 0;
+    if (kata_bitmap_kategori == 0) return 0;
+    const uint64_t *bitmap = kamus_kategori[kode].bitmap, *lain = kamus_kategori[0].bitmap;
+    int kata_terpakai = (jumlah_tiket + 63) >> 6; // bit kategori di atas jumlah_tiket selalu 0
+    for (int w = 0; w < kata_bitmap_kategori && w < kata_terpakai; w++) {
+        uint64_t saring = hanya_tersedia ? peta_tersedia[w] : ~0ULL;
+        for (uint64_t bit = ((kode ? bitmap[w] : 0) | lain[w]) & saring; bit; bit &= bit - 1) {
+            int i = w * 64 + __builtin_ctzll(bit);
+            if (tiket_berkategori(i, kode, kriteria_lipat)) (*posisi)[jumlah++] = i;
+        }
+    }
+    urutkan_hasil_tampilan(*posisi, jumlah);
+    return jumlah;
+}
+
+
+// ----------------------------------------------------------------------------------
+// PENCOCOK SUBSTRING TANPA BEDA HURUF: memuat_lipat(teks, panjang, kapasitas, jarum, panjang_jarum)
+// bernilai 1 bila `jarum` (sudah di-casefold) muncul di `teks`. Versi SIMD membandingkan byte
+// pertama dan terakhir jarum di 16/32 posisi awal sekaligus, lalu hanya memverifikasi posisi
+// yang keduanya cocok. Teks di-casefold di dalam kernel sehingga teks asli pun boleh dipakai.
+// Blok boleh membaca melewati '\0' selama masih di dalam `kapasitas` byte buffer teks;
+// posisi di luar `panjang` dibuang dari mask, sisanya diteruskan ke versi skalar.
+// ----------------------------------------------------------------------------------
+int cocok_lipat_di(const char *teks, const char *jarum, size_t panjang_jarum) {
+    for (size_t j = 0; j < panjang_jarum; j++) {
+        if (tabel_lipat[(unsigned char)teks[j]] != (unsigned char)jarum[j]) return 0;
+    }
+    return 1;
+}
+
+int memuat_lipat_dari(const char *teks, size_t mulai, size_t panjang, const char *jarum, size_t panjang_jarum) {
+    for (size_t i = mulai; i + panjang_jarum <= panjang; i++) {
+        if (cocok_lipat_di(teks + i, jarum, panjang_jarum)) return 1;
+    }
+    return 0;
+}
+
+int memuat_lipat_skalar(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    (void)kapasitas;
+    return memuat_lipat_dari(teks, 0, panjang, jarum, panjang_jarum);
+}
+
+#if PAKAI_SIMD_X86
+// 'A'..'Z' digeser ke -128..-103 agar cukup satu perbandingan bertanda, lalu di-OR 0x20
+__attribute__((target("sse2"))) static inline __m128i lipat_sse2(__m128i v) {
+    __m128i geser = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A')));
+    __m128i besar = _mm_cmpgt_epi8(_mm_set1_epi8((char)(0x80 + 26)), geser);
+    return _mm_or_si128(v, _mm_and_si128(besar, _mm_set1_epi8(0x20)));
+}
+
+__attribute__((target("sse2")))
+int memuat_lipat_sse2(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    if (panjang_jarum == 0) return 1;
+    const __m128i awal = _mm_set1_epi8(jarum[0]), akhir = _mm_set1_epi8(jarum[panjang_jarum - 1]);
+    size_t i = 0;
+    for (; i + panjang_jarum <= panjang && i + panjang_jarum - 1 + 16 <= kapasitas; i += 16) {
+        __m128i blok_awal = lipat_sse2(_mm_loadu_si128((const __m128i *)(teks + i)));
+        __m128i blok_akhir = lipat_sse2(_mm_loadu_si128((const __m128i *)(teks + i + panjang_jarum - 1)));
+        unsigned int kandidat = (unsigned int)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blok_awal, awal), _mm_cmpeq_epi8(blok_akhir, akhir)));
+        size_t sah = panjang - panjang_jarum - i + 1; // posisi awal yang masih di dalam teks
+        if (sah < 16) kandidat &= (1u << sah) - 1;
+        for (; kandidat; kandidat &= kandidat - 1) {
+            if (cocok_lipat_di(teks + i + __builtin_ctz(kandidat), jarum, panjang_jarum)) return 1;
+        }
+    }
+    return memuat_lipat_dari(teks, i, panjang, jarum, panjang_jarum);
+}
+
+__attribute__((target("avx2"))) static inline __m256i lipat_avx2(__m256i v) {
+    __m256i geser = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'A')));
+    __m256i besar = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), geser);
+    return _mm256_or_si256(v, _mm256_and_si256(besar, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+int memuat_lipat_avx2(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    if (panjang_jarum == 0) return 1;
+    // Buffer yang tidak muat satu blok 32 byte langsung memakai blok 16 byte
+    if (panjang_jarum - 1 + 32 > kapasitas) return memuat_lipat_sse2(teks, panjang, kapasitas, jarum, panjang_jarum);
+    const __m256i awal = _mm256_set1_epi8(jarum[0]), akhir = _mm256_set1_epi8(jarum[panjang_jarum - 1]);
+    size_t i = 0;
+    for (; i + panjang_jarum <= panjang && i + panjang_jarum - 1 + 32 <= kapasitas; i += 32) {
+        __m256i blok_awal = lipat_avx2(_mm256_loadu_si256((const __m256i *)(teks + i)));
+        __m256i blok_akhir = lipat_avx2(_mm256_loadu_si256((const __m256i *)(teks + i + panjang_jarum - 1)));
+        unsigned int kandidat = (unsigned int)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blok_awal, awal), _mm256_cmpeq_epi8(blok_akhir, akhir)));
+        size_t sah = panjang - panjang_jarum - i + 1;
+        if (sah < 32) kandidat &= (1u << sah) - 1;
+        for (; kandidat; kandidat &= kandidat - 1) {
+            if (cocok_lipat_di(teks + i + __builtin_ctz(kandidat), jarum, panjang_jarum)) return 1;
+        }
+    }
+    if (i + panjang_jarum > panjang) return 0;
+    // Sisa ekor memakai blok 16 byte; vzeroupper dulu agar kode SSE tidak terkena penalti transisi AVX
+    _mm256_zeroupper();
+    return memuat_lipat_sse2(teks + i, panjang - i, kapasitas - i, jarum, panjang_jarum);
+}
+#endif
+
+typedef int (*PencocokLipat)(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum);
+
+PencocokLipat pilih_pencocok_lipat() {
+#if PAKAI_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return memuat_lipat_avx2;
+    if (__builtin_cpu_supports("sse2")) return memuat_lipat_sse2;
+#endif
+    return memuat_lipat_skalar;
+}
+
+// Panggilan pertama memilih kernel sesuai CPU lalu mengganti pointer ini
+int memuat_lipat_pertama(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum);
+PencocokLipat memuat_lipat = memuat_lipat_pertama;
+int memuat_lipat_pertama(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    memuat_lipat = pilih_pencocok_lipat();
+    return memuat_lipat(teks, panjang, kapasitas, jarum, panjang_jarum);
+}
+
+int nama_memuat(int posisi, const char *kriteria_lipat, size_t panjang_kriteria) {
+    return memuat_lipat(teks_lipat[posisi].nama, teks_lipat[posisi].panjang_nama, MAX_NAMA, kriteria_lipat, panjang_kriteria);
+}
+
+// ----------------------------------------------------------------------------------
+// INDEKS TRIGRAM NAMA KONSER: pencarian substring nama cukup memotong posting list dari
+// setiap trigram kriteria lalu memverifikasi kandidatnya, tanpa memindai semua tiket.
+// ID tiket yang dihapus dibiarkan basi (tersaring saat verifikasi), seperti heap kadaluarsa,
+// dan indeks dibangun ulang bila yang basi sudah lebih banyak dari tiket aktif.
+// ----------------------------------------------------------------------------------
+uint32_t kode_trigram(const char *p) {
+    return ((uint32_t)tabel_lipat[(unsigned char)p[0]] << 16) | ((uint32_t)tabel_lipat[(unsigned char)p[1]] << 8) | (uint32_t)tabel_lipat[(unsigned char)p[2]];
+}
+
+void kosongkan_indeks_trigram() {
+    for (int i = 0; i < kapasitas_trigram; i++) free(tabel_trigram[i].id);
+    free(tabel_trigram);
+    tabel_trigram = NULL; kapasitas_trigram = 0; jumlah_trigram = 0; tiket_basi_trigram = 0;
+}
+
+// Posting list untuk `kode`; bila belum ada dibuat jika `buat`, atau NULL jika tidak
+PostingTrigram *slot_trigram(uint32_t kode, int buat) {
+    if (buat && (jumlah_trigram + 1) * 2 > kapasitas_trigram) {
+        int kapasitas = kapasitas_trigram ? kapasitas_trigram * 2 : 1024;
+        PostingTrigram *baru = (PostingTrigram *)calloc(kapasitas, sizeof(PostingTrigram));
+        if (baru == NULL) { perror("Gagal mengalokasikan indeks trigram"); exit(EXIT_FAILURE); }
+        for (int i = 0; i < kapasitas_trigram; i++) {
+            if (tabel_trigram[i].kode == 0) continue;
+            unsigned int j = hash_id((int)tabel_trigram[i].kode) & (kapasitas - 1);
+            while (baru[j].kode != 0) j = (j + 1) & (kapasitas - 1);
+            baru[j] = tabel_trigram[i];
+        }
+        free(tabel_trigram);
+        tabel_trigram = baru; kapasitas_trigram = kapasitas;
+    }
+    if (kapasitas_trigram == 0) return NULL;
+
+    unsigned int mask = kapasitas_trigram - 1;
+    unsigned int i = hash_id((int)kode) & mask;
+    while (tabel_trigram[i].kode != 0) {
+        if (tabel_trigram[i].kode == kode) return &tabel_trigram[i];
+        i = (i + 1) & mask;
+    }
+    if (!buat) return NULL;
+    tabel_trigram[i].kode = kode;
+    jumlah_trigram++;
+    return &tabel_trigram[i];
+}
+
+// Posisi pertama di posting list yang ID-nya >= `id` (pencarian biner)
+int posting_batas_bawah(const PostingTrigram *p, int id) {
+    int kiri = 0, kanan = p->jumlah;
+    while (kiri < kanan) {
+        int tengah = (kiri + kanan) / 2;
+        if (p->id[tengah] < id) kiri = tengah + 1; else kanan = tengah;
+    }
+    return kiri;
+}
+
+// Dengan `urut` list dijaga urut naik (ID baru selalu terbesar, jadi biasanya cukup ditempel di akhir);
+// tanpa `urut` ID ditempel saja dan list dirapikan oleh bangun_indeks_trigram()
+void posting_sisip(PostingTrigram *p, int id, int urut) {
+    int letak = p->jumlah;
+    if (urut && p->jumlah > 0 && p->id[p->jumlah - 1] >= id) {
+        letak = posting_batas_bawah(p, id);
+        if (p->id[letak] == id) return; // trigram muncul lebih dari sekali di nama yang sama
+    } else if (p->jumlah > 0 && p->id[p->jumlah - 1] == id) {
+        return;
+    }
+    if (p->jumlah == p->kapasitas) {
+        int kapasitas = p->kapasitas ? p->kapasitas * 2 : 4;
+        int *baru = (int *)realloc(p->id, kapasitas * sizeof(int));
+        if (baru == NULL) { perror("Gagal mengalokasikan indeks trigram"); exit(EXIT_FAILURE); }
+        p->id = baru; p->kapasitas = kapasitas;
+    }
+    memmove(p->id + letak + 1, p->id + letak, (p->jumlah - letak) * sizeof(int));
+    p->id[letak] = id;
+    p->jumlah++;
+}
+
+void trigram_tambah(int id, const char *nama, int urut) {
+    size_t panjang = strlen(nama);
+    for (size_t i = 0; i + 3 <= panjang; i++) posting_sisip(slot_trigram(kode_trigram(nama + i), 1), id, urut);
+}
+
+int bandingkan_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Bangun ulang dari semua tiket aktif; sekaligus membuang ID basi
+void bangun_indeks_trigram() {
+    kosongkan_indeks_trigram();
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (daftar_tiket[i].id != ID_NISAN) trigram_tambah(daftar_tiket[i].id, daftar_tiket[i].nama_konser, 0);
+    }
+    // Urutan di file belum tentu urut ID (misal setelah sorting), jadi posting list dirapikan di sini
+    for (int i = 0; i < kapasitas_trigram; i++) {
+        PostingTrigram *p = &tabel_trigram[i];
+        if (p->kode == 0) continue;
+        qsort(p->id, p->jumlah, sizeof(int), bandingkan_int);
+        int unik = 0;
+        for (int j = 0; j < p->jumlah; j++) {
+            if (unik == 0 || p->id[unik - 1] != p->id[j]) p->id[unik++] = p->id[j];
+        }
+        p->jumlah = unik;
+    }
+}
+
+void trigram_catat_basi() {
+    if (++tiket_basi_trigram > jumlah_tiket_aktif() + KAPASITAS_AWAL) bangun_indeks_trigram();
+}
+
+// Posisi tiket aktif yang namanya memuat `kriteria` (tanpa membedakan huruf besar/kecil), urut naik.
+// `*posisi` dibebaskan pemanggil. Kriteria < 3 huruf tidak punya trigram, jadi dipindai biasa.
+int cari_posisi_nama(const char *kriteria_asli, int **posisi) {
+    char kriteria[MAX_NAMA];
+    size_t panjang = lipat_teks(kriteria, kriteria_asli, sizeof(kriteria)); // di-casefold sekali untuk seluruh pencarian
+    int jumlah = 0;
+    *posisi = NULL;
+
+    if (panjang < 3) {
+        if ((*posisi = (int *)malloc((jumlah_tiket + 1) * sizeof(int))) == NULL) return 0;
+        for (int i = 0; i < jumlah_tiket; i++) {
+            if (daftar_tiket[i].id != ID_NISAN && nama_memuat(i, kriteria, panjang)) (*posisi)[jumlah++] = i;
+        }
+        urutkan_hasil_tampilan(*posisi, jumlah);
+        return jumlah;
+    }
+
+    // Posting list setiap trigram kriteria; satu saja yang tidak ada berarti tidak ada hasil
+    PostingTrigram *daftar[MAX_NAMA];
+    int jumlah_daftar = 0, terpendek = 0;
+    for (size_t i = 0; i + 3 <= panjang && jumlah_daftar < MAX_NAMA; i++) {
+        PostingTrigram *p = slot_trigram(kode_trigram(kriteria + i), 0);
+        if (p == NULL) return 0;
+        int sudah = 0;
+        for (int j = 0; j < jumlah_daftar; j++) sudah |= daftar[j] == p;
+        if (!sudah) daftar[jumlah_daftar++] = p;
+    }
+    for (int j = 1; j < jumlah_daftar; j++) {
+        if (daftar[j]->jumlah < daftar[terpendek]->jumlah) terpendek = j;
+    }
+
+    // Mulai dari posting list terpendek, saring dengan list lainnya lalu verifikasi kandidat
+    if ((*posisi = (int *)malloc((daftar[terpendek]->jumlah + 1) * sizeof(int))) == NULL) return 0;
+    for (int k = 0; k < daftar[terpendek]->jumlah; k++) {
+        int id = daftar[terpendek]->id[k], cocok = 1;
+        for (int j = 0; j < jumlah_daftar && cocok; j++) {
+            if (j == terpendek) continue;
+            int letak = posting_batas_bawah(daftar[j], id);
+            cocok = letak < daftar[j]->jumlah && daftar[j]->id[letak] == id;
+        }
+        if (!cocok) continue;
+        int i = cari_indeks_id(id);
+        if (i >= 0 && nama_memuat(i, kriteria, panjang)) (*posisi)[jumlah++] = i;
+    }
+    qsort(*posisi, jumlah, sizeof(int), bandingkan_int);
+    urutkan_hasil_tampilan(*posisi, jumlah);
+    return jumlah;
+}
+
+// ----------------------------------------------------------------------------------
+// OPERASI INTI: tanpa prompt dan tanpa simpan otomatis, dipakai menu maupun mode batch
+// ----------------------------------------------------------------------------------
+// Tambahkan tiket (ID sudah terisi) ke akhir daftar beserta indeksnya; 0 jika alokasi gagal
+int masukkan_tiket(const Tiket *baru) {
+    if (!cadangkan_kapasitas(jumlah_tiket + 1)) return 0;
+    daftar_tiket[jumlah_tiket] = *baru;
+    jumlah_tiket++;
+    isi_kolom(jumlah_tiket - 1);
+    indeks_tambah(jumlah_tiket - 1);
+    urutan_tambah(&urut_harga, jumlah_tiket - 1); urutan_tambah(&urut_nama, jumlah_tiket - 1);
+    lipat_tiket(jumlah_tiket - 1);
+    kategori_pasang(jumlah_tiket - 1);
+    kadaluarsa_tambah(jumlah_tiket - 1);
+    pohon_harga_tambah(baru->harga, baru->id);
+    trigram_tambah(baru->id, baru->nama_konser, 1);
+    return 1;
+}
+
+// Hapus tiket berdasarkan ID (ditandai nisan); 0 jika tidak ditemukan
+int hapus_tiket_id(int id) {
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) return 0;
+    tandai_nisan(posisi);
+    padatkan_jika_perlu();
+    return 1;
+}
+
+// kriteria 1 = harga (termurah dulu), 2 = nama konser (A-Z). Tiket tidak dipindah: indeks urutannya
+// cukup dirapikan (O(n) bila hanya sedikit yang berubah sejak terakhir) dan pilihannya disimpan di header.
+void urutkan_tiket(int kriteria) {
+    if (kriteria != 1 && kriteria != 2) return;
+    urutan_tampilan = kriteria;
+    header_data()->urutan_tampilan = (uint32_t)kriteria;
+    siapkan_tampilan();
+}
+
+// ==========================================================
+// 2. FUNGSI KHUSUS PELANGGAN (PEMBELI)
+// ==========================================================
+
+// Kurangi stok tiket `id` sebanyak `jumlah` dengan compare-and-swap, tanpa kunci global:
+// pembelian serentak dari banyak utas tidak pernah menjual melebihi stok. Aman dipanggil
+// bersamaan selama struktur katalog tidak sedang diubah (tambah/hapus/pemadatan/remap).
+// Jurnal tidak dicatat di sini; pemanggil mencatatnya dari satu utas.
+int beli_stok_atomik(int id, int jumlah, int *stok_sesudah) {
+    if (jumlah <= 0) return BELI_JUMLAH_TIDAK_VALID;
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) return BELI_TIDAK_DITEMUKAN;
+
+    int *stok = &daftar_tiket[posisi].jumlah_stok;
+    int lama = __atomic_load_n(stok, __ATOMIC_ACQUIRE);
+    do {
+        if (lama < jumlah) {
+            if (stok_sesudah != NULL) *stok_sesudah = lama;
+            return BELI_STOK_KURANG;
+        }
+        // Gagal berarti utas lain lebih dulu mengubah stok; `lama` terisi nilai terbaru lalu dicoba lagi
+    } while (!__atomic_compare_exchange_n(stok, &lama, lama - jumlah, 1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    tandai_kotor(posisi); // bukan atomik: pembelian dari katalog yang dimuat hanya berjalan di satu utas
+    // Kolom stok ikut dikurangi; pengurangan atomik membuatnya tetap sama dengan Tiket setelah semua utas selesai
+    __atomic_fetch_sub(&kolom_stok[posisi], jumlah, __ATOMIC_RELAXED);
+    // Hanya satu utas yang membuat stok tepat habis (stok tidak bertambah selama pembelian serentak)
+    if (lama == jumlah) {
+        __atomic_fetch_and(&peta_tersedia[posisi >> 6], ~(1ULL << (posisi & 63)), __ATOMIC_RELAXED);
+        __atomic_fetch_sub(&jumlah_tersedia, 1, __ATOMIC_RELAXED);
+    }
+    if (stok_sesudah != NULL) *stok_sesudah = lama - jumlah;
+    return BELI_BERHASIL;
+}
+
+// FUNGSI INI DIUBAH: Hanya menampilkan tiket dengan stok > 0
+// Baris tabel "| %-2d | %-20s | %-18s | %-12.2f | %-3d |" ke buffer tampilan
+void susun_baris_pelanggan(int posisi) {
+    const Tiket *t = &daftar_tiket[posisi];
+    char angka[64];
+    tampil_ke(stdout);
+    tampil_str("| "); tampil_kiri(angka, format_int(angka, t->id), 2);
+    tampil_str(" | "); tampil_kiri(t->nama_konser, strlen(t->nama_konser), 20);
+    tampil_str(" | "); tampil_kiri(t->kategori, strlen(t->kategori), 18);
+    tampil_str(" | "); tampil_kiri(angka, format_harga(angka, t->harga), 12);
+    tampil_str(" | "); tampil_kiri(angka, format_int(angka, t->jumlah_stok), 3);
+    tampil_str(" |\n");
+}
+
+// Per halaman, HANYA tiket dengan STOK > 0; ada-tidaknya stok cukup dibaca dari hitungan peta tersedia
+void lihat_tiket_pelanggan() {
+    printf("\n🛍️ --- DAFTAR TIKET TERSEDIA ---\n");
+    if (jumlah_tersedia == 0) {
+        printf("⚠️ Saat ini tidak ada tiket yang tersedia untuk dijual.\n");
+        return;
+    }
+    int posisi[UKURAN_HALAMAN], mulai = 0, kursor;
+    int jumlah = ambil_halaman(mulai, UKURAN_HALAMAN, 1, posisi, &kursor);
+
+    printf("------------------------------------------------------------------------\n");
+    printf("| ID | Nama Konser          | Kategori           | Harga (Rp)   | Stk |\n");
+    printf("------------------------------------------------------------------------\n");
+    for (;;) {
+        for (int k = 0; k < jumlah; k++) susun_baris_pelanggan(posisi[k]);
+        tampil_siram();
+        if (kursor == 0) break;
+        mulai = letak_kursor(kursor);
+        if (mulai < 0 || mulai >= siapkan_tampilan() || !lanjut_halaman()) break;
+        jumlah = ambil_halaman(mulai, UKURAN_HALAMAN, 1, posisi, &kursor);
+    }
+    printf("------------------------------------------------------------------------\n");
+}
+
+void lihat_tiket_termurah() {
+    int posisi[UKURAN_HALAMAN];
+    int jumlah = ambil_termurah(UKURAN_HALAMAN, posisi);
+    printf("\n💸 --- %d TIKET TERMURAH ---\n", UKURAN_HALAMAN);
+    if (jumlah == 0) { printf("⚠️ Saat ini tidak ada tiket yang tersedia untuk dijual.\n"); return; }
+    printf("------------------------------------------------------------------------\n");
+    printf("| ID | Nama Konser          | Kategori           | Harga (Rp)   | Stk |\n");
+    printf("------------------------------------------------------------------------\n");
+    for (int k = 0; k < jumlah; k++) susun_baris_pelanggan(posisi[k]);
+    tampil_siram();
+    printf("------------------------------------------------------------------------\n");
+}
+
+// Harga minimum dan maksimum dari pengguna; 0 bila tidak valid
+int baca_rentang_harga(float *harga_min, float *harga_max) {
+    printf("Harga minimum: Rp");
+    if (scanf("%f", harga_min) != 1 || !(*harga_min >= 0)) { printf("❌ Harga tidak valid.\n"); bersihkan_buffer(); return 0; }
+    bersihkan_buffer();
+    printf("Harga maksimum: Rp");
+    if (scanf("%f", harga_max) != 1 || !(*harga_max >= *harga_min)) { printf("❌ Harga maksimum harus >= harga minimum.\n"); bersihkan_buffer(); return 0; }
+    bersihkan_buffer();
+    return 1;
+}
+
+// Tiket bersetok di rentang harga, termurah dulu, per halaman lewat kursor rentang
+void cari_rentang_pelanggan() {
+    float harga_min, harga_max;
+    printf("\n💰 --- CARI TIKET PER RENTANG HARGA ---\n");
+    if (!baca_rentang_harga(&harga_min, &harga_max)) return;
+    int posisi[UKURAN_HALAMAN], kursor;
+    int jumlah = ambil_rentang_harga(harga_min, harga_max, 0, 1, NULL, posisi, UKURAN_HALAMAN, &kursor);
+    if (jumlah <= 0) { printf("⚠️ Tidak ada tiket tersedia di rentang harga ini.\n"); return; }
+    printf("------------------------------------------------------------------------\n");
+    printf("| ID | Nama Konser          | Kategori           | Harga (Rp)   | Stk |\n");
+    printf("------------------------------------------------------------------------\n");
+    for (;;) {
+        for (int k = 0; k < jumlah; k++) susun_baris_pelanggan(posisi[k]);
+        tampil_siram();
+        if (kursor == 0 || !lanjut_halaman()) break;
+        jumlah = ambil_rentang_harga(harga_min, harga_max, kursor, 1, NULL, posisi, UKURAN_HALAMAN, &kursor);
+        if (jumlah <= 0) break;
+    }
+    printf("------------------------------------------------------------------------\n");
+}
+
+void beli_tiket() {
+    int id_beli, jumlah_beli, index_tiket = -1;
+
+    printf("\n🛒 --- BELI TIKET ---\n");
+
+    if (jumlah_tiket_aktif() == 0) { printf("⚠️ Saat ini tidak ada tiket yang tersedia.\n"); return; }
+
+    printf("Masukkan ID Tiket yang akan dibeli: ");
+    if (scanf("%d", &id_beli) != 1) { printf("❌ ID tidak valid.\n"); bersihkan_buffer(); return; }
+    bersihkan_buffer();
+
+    index_tiket = cari_indeks_id(id_beli);
 
     // Penambahan: Memastikan stok > 0 saat proses pembelian
     if (index_tiket == -1 || daftar_tiket[index_tiket].jumlah_stok == 0) {
@@ -190,23 +2648,28 @@ void beli_tiket() {
     if (scanf("%d", &jumlah_beli) != 1 || jumlah_beli <= 0) { printf("❌ Jumlah pembelian tidak valid.\n"); bersihkan_buffer(); return; }
     bersihkan_buffer();
 
-    if (jumlah_beli > daftar_tiket[index_tiket].jumlah_stok) {
-        printf("❌ Stok tidak cukup. Stok yang tersedia: %d\n", daftar_tiket[index_tiket].jumlah_stok);
+    // Lakukan Transaksi & UPDATE STOK OTOMATIS (stok dicek dan dikurangi dalam satu langkah atomik)
+    int stok_sesudah = 0;
+    if (beli_stok_atomik(id_beli, jumlah_beli, &stok_sesudah) != BELI_BERHASIL) {
+        printf("❌ Stok tidak cukup. Stok yang tersedia: %d\n", stok_sesudah);
         return;
     }
-
-    // Lakukan Transaksi & UPDATE STOK OTOMATIS
     float total_harga = jumlah_beli * daftar_tiket[index_tiket].harga;
-    daftar_tiket[index_tiket].jumlah_stok -= jumlah_beli;
+
+    // Catat ke jurnal (O(1)) alih-alih menulis ulang seluruh katalog. Pembelian interaktif
+    // tidak punya tetangga untuk dikelompokkan, jadi langsung dikomit sebelum struk tampil.
+    if (!catat_jurnal(id_beli, -jumlah_beli, stok_sesudah)) {
+        perror("⚠️ Peringatan: Gagal mencatat jurnal, menyimpan seluruh data");
+        simpan_data_latar();
+    }
+    if (!komit_jurnal()) printf("⚠️ Transaksi tercatat, tetapi belum tahan crash sampai komit atau simpan berikutnya berhasil.\n");
 
     printf("\n🎉 Transaksi berhasil!\n");
     printf("  | Tiket: %s\n", daftar_tiket[index_tiket].nama_konser);
     printf("  | Jumlah Beli: %d\n", jumlah_beli);
     printf("  | **TOTAL HARGA: Rp%.2f**\n", total_harga);
-    printf("  | Stok Tersisa: %d\n", daftar_tiket[index_tiket].jumlah_stok);
+    printf("  | Stok Tersisa: %d\n", stok_sesudah);
     printf("-----------------------------------\n");
-
-    simpan_data(); // Simpan perubahan stok ke file segera
 }
 
 void tampilkan_menu_pelanggan() {
@@ -215,9 +2678,11 @@ void tampilkan_menu_pelanggan() {
     printf("====================================\n");
     printf("1. Lihat Daftar Tiket (Harga, Kategori & Stok)\n");
     printf("2. Beli Tiket\n");
-    printf("3. Keluar ke Menu Utama\n");
+    printf("3. Lihat %d Tiket Termurah\n", UKURAN_HALAMAN);
+    printf("4. Cari Tiket per Rentang Harga\n");
+    printf("5. Keluar ke Menu Utama\n");
     printf("------------------------------------\n");
-    printf("Pilih opsi (1-3): ");
+    printf("Pilih opsi (1-5): ");
 }
 
 void mode_pelanggan() {
@@ -226,14 +2691,17 @@ void mode_pelanggan() {
         tampilkan_menu_pelanggan();
         if (scanf("%d", &pilihan) != 1) { bersihkan_buffer(); continue; }
         bersihkan_buffer();
+        periksa_kadaluarsa_berkala(); // sesi bisa berjalan lama; tiket yang lewat batas dihapus sebelum dilayani
 
         switch (pilihan) {
             case 1: lihat_tiket_pelanggan(); break;
             case 2: beli_tiket(); break;
-            case 3: printf("\nKeluar dari mode Pelanggan.\n"); break;
+            case 3: lihat_tiket_termurah(); break;
+            case 4: cari_rentang_pelanggan(); break;
+            case 5: printf("\nKeluar dari mode Pelanggan.\n"); break;
             default: printf("\n❌ Pilihan tidak valid.\n"); break;
         }
-    } while (pilihan != 3);
+    } while (pilihan != 5);
 }
 
 // ==========================================================
@@ -271,22 +2739,27 @@ void tambah_tiket() {
     
     baru.waktu_dibuat = time(NULL);
 
-    Tiket *temp = (Tiket *)realloc(daftar_tiket, (jumlah_tiket + 1) * sizeof(Tiket));
-    if (temp == NULL) { perror("❌ Gagal realloc"); return; }
-    daftar_tiket = temp;
-    daftar_tiket[jumlah_tiket] = baru;
-    jumlah_tiket++;
+    if (!masukkan_tiket(&baru)) { perror("❌ Gagal realloc"); return; }
     printf("\n🎉 Tiket berhasil ditambahkan:\n");
     tampilkan_tiket_detail(&baru);
-    simpan_data();
+    simpan_data_latar();
 }
 
 void lihat_semua_tiket_admin() {
-    printf("\n📚 --- SEMUA DAFTAR TIKET (%d Tiket) ---\n", jumlah_tiket);
-    if (jumlah_tiket == 0) { printf("⚠️ Saat ini tidak ada tiket dalam sistem.\n"); return; }
-    for (int i = 0; i < jumlah_tiket; i++) {
-        printf("--- Tiket #%d ---\n", i + 1);
-        tampilkan_tiket_detail(&daftar_tiket[i]);
+    printf("\n📚 --- SEMUA DAFTAR TIKET (%d Tiket) ---\n", jumlah_tiket_aktif());
+    if (jumlah_tiket_aktif() == 0) { printf("⚠️ Saat ini tidak ada tiket dalam sistem.\n"); return; }
+    int posisi[UKURAN_HALAMAN], mulai = 0, nomor = 0, kursor;
+    for (;;) {
+        int jumlah = ambil_halaman(mulai, UKURAN_HALAMAN, 0, posisi, &kursor);
+        for (int k = 0; k < jumlah; k++) {
+            tampil_ke(stdout);
+            tampil_str("--- Tiket #"); tampil_int(++nomor); tampil_str(" ---\n");
+            susun_tiket_detail(&daftar_tiket[posisi[k]]);
+        }
+        tampil_siram();
+        if (kursor == 0) break;
+        mulai = letak_kursor(kursor);
+        if (mulai < 0 || mulai >= siapkan_tampilan() || !lanjut_halaman()) break;
     }
     printf("--------------------------------------\n");
 }
@@ -294,30 +2767,41 @@ void lihat_semua_tiket_admin() {
 void cari_tiket_admin() {
     int pilihan_cari, id_cari, ditemukan = 0; char kriteria_cari[MAX_NAMA];
     printf("\n🔍 --- CARI TIKET ---\n");
-    printf("Cari berdasarkan:\n1. ID Tiket\n2. Nama Konser\n3. Kategori\nPilih opsi (1-3): ");
+    printf("Cari berdasarkan:\n1. ID Tiket\n2. Nama Konser\n3. Kategori\n4. Rentang Harga\nPilih opsi (1-4): ");
     if (scanf("%d", &pilihan_cari) != 1) { printf("❌ Input tidak valid.\n"); bersihkan_buffer(); return; } bersihkan_buffer();
-    if (jumlah_tiket == 0) { printf("⚠️ Tidak ada tiket dalam sistem.\n"); return; }
+    if (jumlah_tiket_aktif() == 0) { printf("⚠️ Tidak ada tiket dalam sistem.\n"); return; }
 
     switch (pilihan_cari) {
         case 1:
             printf("Masukkan ID Tiket yang dicari: "); if (scanf("%d", &id_cari) != 1) { printf("❌ ID tidak valid.\n"); bersihkan_buffer(); return; } bersihkan_buffer();
-            for (int i = 0; i < jumlah_tiket; i++) { if (daftar_tiket[i].id == id_cari) { tampilkan_tiket_detail(&daftar_tiket[i]); ditemukan = 1; break; } } break;
+            { int posisi = cari_indeks_id(id_cari); if (posisi >= 0) { tampilkan_tiket_detail(&daftar_tiket[posisi]); ditemukan = 1; } } break;
         case 2:
             printf("Masukkan Nama Konser: "); if (fgets(kriteria_cari, sizeof(kriteria_cari), stdin) == NULL) return; kriteria_cari[strcspn(kriteria_cari, "\n")] = 0;
-            for (int i = 0; i < jumlah_tiket; i++) { 
-                char temp_nama[MAX_NAMA], temp_kriteria[MAX_NAMA]; strcpy(temp_nama, daftar_tiket[i].nama_konser); strcpy(temp_kriteria, kriteria_cari);
-                for(int j = 0; temp_nama[j]; j++){ temp_nama[j] = tolower(temp_nama[j]); }
-                for(int j = 0; temp_kriteria[j]; j++){ temp_kriteria[j] = tolower(temp_kriteria[j]); }
-                if (strstr(temp_nama, temp_kriteria) != NULL) { printf("--- Hasil #%d ---\n", ++ditemukan); tampilkan_tiket_detail(&daftar_tiket[i]); } 
-            } break;
+            { int *posisi, jumlah = cari_posisi_nama(kriteria_cari, &posisi);
+              for (int k = 0; k < jumlah; k++) { tampil_ke(stdout); tampil_str("--- Hasil #"); tampil_int(++ditemukan); tampil_str(" ---\n"); susun_tiket_detail(&daftar_tiket[posisi[k]]); }
+              tampil_siram();
+              free(posisi); } break;
         case 3:
             printf("Masukkan Kategori: "); if (fgets(kriteria_cari, sizeof(kriteria_cari), stdin) == NULL) return; kriteria_cari[strcspn(kriteria_cari, "\n")] = 0;
-             for (int i = 0; i < jumlah_tiket; i++) { 
-                char temp_kategori[MAX_KATEGORI], temp_kriteria[MAX_KATEGORI]; strcpy(temp_kategori, daftar_tiket[i].kategori); strcpy(temp_kriteria, kriteria_cari);
-                for(int j = 0; temp_kategori[j]; j++){ temp_kategori[j] = tolower(temp_kategori[j]); }
-                for(int j = 0; temp_kriteria[j]; j++){ temp_kriteria[j] = tolower(temp_kriteria[j]); }
-                if (strcmp(temp_kategori, temp_kriteria) == 0) { printf("--- Hasil #%d ---\n", ++ditemukan); tampilkan_tiket_detail(&daftar_tiket[i]); } 
-            } break;
+            lipat_teks(kriteria_cari, kriteria_cari, sizeof(kriteria_cari));
+            { int *posisi, jumlah = cari_posisi_kategori(kriteria_cari, 0, &posisi);
+              for (int k = 0; k < jumlah; k++) { tampil_ke(stdout); tampil_str("--- Hasil #"); tampil_int(++ditemukan); tampil_str(" ---\n"); susun_tiket_detail(&daftar_tiket[posisi[k]]); }
+              tampil_siram();
+              free(posisi); } break;
+        case 4: {
+            float harga_min, harga_max;
+            if (!baca_rentang_harga(&harga_min, &harga_max)) return;
+            printf("Kategori (kosongkan untuk semua): "); if (fgets(kriteria_cari, sizeof(kriteria_cari), stdin) == NULL) return; kriteria_cari[strcspn(kriteria_cari, "\n")] = 0;
+            lipat_teks(kriteria_cari, kriteria_cari, sizeof(kriteria_cari));
+            const char *kategori = kriteria_cari[0] != '\0' ? kriteria_cari : NULL;
+            int posisi[UKURAN_HALAMAN], kursor, jumlah = ambil_rentang_harga(harga_min, harga_max, 0, 0, kategori, posisi, UKURAN_HALAMAN, &kursor);
+            while (jumlah > 0) {
+                for (int k = 0; k < jumlah; k++) { tampil_ke(stdout); tampil_str("--- Hasil #"); tampil_int(++ditemukan); tampil_str(" ---\n"); susun_tiket_detail(&daftar_tiket[posisi[k]]); }
+                tampil_siram();
+                if (kursor == 0 || !lanjut_halaman()) break;
+                jumlah = ambil_rentang_harga(harga_min, harga_max, kursor, 0, kategori, posisi, UKURAN_HALAMAN, &kursor);
+            }
+        } break;
         default: printf("❌ Pilihan pencarian tidak valid.\n"); return;
     }
     if (!ditemukan) { printf("⚠️ Tiket tidak ditemukan.\n"); }
@@ -332,15 +2816,13 @@ void update_tiket() {
     int stok_baru;
 
     printf("\n📝 --- UPDATE TIKET ---\n");
-    if (jumlah_tiket == 0) { printf("⚠️ Tidak ada tiket dalam sistem.\n"); return; }
+    if (jumlah_tiket_aktif() == 0) { printf("⚠️ Tidak ada tiket dalam sistem.\n"); return; }
 
     printf("Masukkan ID Tiket yang akan diupdate: ");
     if (scanf("%d", &id_update) != 1) { printf("❌ ID tidak valid.\n"); bersihkan_buffer(); return; }
     bersihkan_buffer();
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id == id_update) { index_tiket = i; break; }
-    }
+    index_tiket = cari_indeks_id(id_update);
 
     if (index_tiket == -1) { printf("❌ Tiket dengan ID %d tidak ditemukan.\n", id_update); return; }
 
@@ -358,7 +2840,7 @@ void update_tiket() {
                 printf("❌ Harga baru tidak valid.\n"); 
                 bersihkan_buffer(); return; 
             }
-            daftar_tiket[index_tiket].harga = harga_baru;
+            atur_harga(index_tiket, harga_baru);
             printf("✅ Harga berhasil diupdate menjadi Rp%.2f\n", harga_baru);
             break;
         case 2:
@@ -367,7 +2849,7 @@ void update_tiket() {
                 printf("❌ Jumlah stok baru tidak valid.\n"); 
                 bersihkan_buffer(); return; 
             }
-            daftar_tiket[index_tiket].jumlah_stok = stok_baru;
+            atur_stok(index_tiket, stok_baru);
             printf("✅ Stok berhasil diupdate menjadi %d\n", stok_baru);
             break;
         default:
@@ -375,80 +2857,44 @@ void update_tiket() {
             return;
     }
     bersihkan_buffer();
-    simpan_data();
+    simpan_data_latar();
 }
 
 // ----------------------------------------------------------------------------------
 // FUNGSI HAPUS LENGKAP: Menghapus tiket berdasarkan ID
 // ----------------------------------------------------------------------------------
 void hapus_tiket() {
-    int id_hapus, index_hapus = -1;
+    int id_hapus;
     printf("\n🗑️ --- HAPUS TIKET ---\n");
-    if (jumlah_tiket == 0) { printf("⚠️ Tidak ada tiket dalam sistem.\n"); return; }
+    if (jumlah_tiket_aktif() == 0) { printf("⚠️ Tidak ada tiket dalam sistem.\n"); return; }
     
     printf("Masukkan ID Tiket yang akan dihapus: ");
     if (scanf("%d", &id_hapus) != 1) { printf("❌ ID tidak valid.\n"); bersihkan_buffer(); return; }
     bersihkan_buffer();
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id == id_hapus) { index_hapus = i; break; }
-    }
-
-    if (index_hapus == -1) {
+    // Cukup tandai sebagai nisan; elemen lain tidak digeser
+    if (!hapus_tiket_id(id_hapus)) {
         printf("❌ Tiket dengan ID %d tidak ditemukan.\n", id_hapus);
         return;
     }
 
-    // Geser elemen setelah index_hapus ke kiri
-    for (int i = index_hapus; i < jumlah_tiket - 1; i++) {
-        daftar_tiket[i] = daftar_tiket[i + 1];
-    }
-    jumlah_tiket--;
-
-    // Reallocate memori (opsional, tapi disarankan)
-    if (jumlah_tiket > 0) {
-        Tiket *temp = (Tiket *)realloc(daftar_tiket, jumlah_tiket * sizeof(Tiket));
-        if (temp == NULL) { 
-            // Jika realloc gagal, biarkan saja (memori masih teralokasi lebih), tapi beri peringatan
-            perror("⚠️ Peringatan: Gagal realloc setelah hapus."); 
-        } else {
-            daftar_tiket = temp;
-        }
-    } else {
-        // Jika tiket habis, bebaskan semua memori
-        free(daftar_tiket);
-        daftar_tiket = NULL;
-    }
-
     printf("✅ Tiket dengan ID %d berhasil dihapus.\n", id_hapus);
-    simpan_data();
+    simpan_data_latar();
 }
 
 // ----------------------------------------------------------------------------------
 // FUNGSI SORTING
 // ----------------------------------------------------------------------------------
-int bandingkan_harga(const void *a, const void *b) {
-    const Tiket *tiket_a = (const Tiket *)a;
-    const Tiket *tiket_b = (const Tiket *)b;
-    if (tiket_a->harga < tiket_b->harga) return -1;
-    if (tiket_a->harga > tiket_b->harga) return 1;
-    return 0;
-}
-int bandingkan_nama(const void *a, const void *b) {
-    const Tiket *tiket_a = (const Tiket *)a;
-    const Tiket *tiket_b = (const Tiket *)b;
-    return strcmp(tiket_a->nama_konser, tiket_b->nama_konser);
-}
 void sorting_tiket() {
     int pilihan_sort;
     printf("\n➡️ --- URUTKAN TIKET ---\n");
-    if (jumlah_tiket < 2) { printf("⚠️ Minimal diperlukan 2 tiket.\n"); return; }
+    if (jumlah_tiket_aktif() < 2) { printf("⚠️ Minimal diperlukan 2 tiket.\n"); return; }
     printf("Urutkan berdasarkan:\n1. Harga (Termurah ke Termahal)\n2. Nama Konser (A-Z)\nPilih opsi (1-2): ");
     if (scanf("%d", &pilihan_sort) != 1) { printf("❌ Input tidak valid.\n"); bersihkan_buffer(); return; } bersihkan_buffer();
 
     switch (pilihan_sort) {
-        case 1: qsort(daftar_tiket, jumlah_tiket, sizeof(Tiket), bandingkan_harga); printf("✅ Tiket berhasil diurutkan berdasarkan Harga.\n"); lihat_semua_tiket_admin(); break;
-        case 2: qsort(daftar_tiket, jumlah_tiket, sizeof(Tiket), bandingkan_nama); printf("✅ Tiket berhasil diurutkan berdasarkan Nama Konser.\n"); lihat_semua_tiket_admin(); break;
+        case 1: urutkan_tiket(1); printf("✅ Tiket berhasil diurutkan berdasarkan Harga.\n"); lihat_semua_tiket_admin(); break;
+        case 2: urutkan_tiket(2); printf("✅ Tiket berhasil diurutkan berdasarkan Nama Konser.\n"); lihat_semua_tiket_admin(); break;
         default: printf("❌ Pilihan pengurutan tidak valid.\n"); break;
     }
 }
@@ -457,47 +2903,32 @@ void sorting_tiket() {
 // FUNGSI HAPUS KADALUARSA LENGKAP: Hapus tiket yang sudah lebih dari 7 hari
 // ----------------------------------------------------------------------------------
 void update_otomatis_kadaluarsa() {
-    if (jumlah_tiket == 0) return;
+    if (jumlah_tiket_aktif() == 0) return;
     time_t waktu_sekarang = time(NULL);
     int tiket_dihapus = 0; 
-    int i = 0;
-
-    // Gunakan loop while untuk menghandle pergeseran index setelah penghapusan
-    while (i < jumlah_tiket) {
-        if (waktu_sekarang - daftar_tiket[i].waktu_dibuat > KADALUARSA_DETIK) {
-             // Geser elemen setelah index i ke kiri (menghapus elemen di index i)
-             for (int j = i; j < jumlah_tiket - 1; j++) {
-                 daftar_tiket[j] = daftar_tiket[j + 1];
-             }
-             jumlah_tiket--;
-             tiket_dihapus++;
-             // TIDAK perlu menaikkan i, karena elemen baru sudah mengisi posisi i
-        } else { 
-            i++; // Lanjut ke elemen berikutnya
-        }
+
+    // Hanya tiket yang kadaluarsa yang diambil dari heap dan ditandai nisan; array dipadatkan sekali di akhir
+    int posisi;
+    while ((posisi = ambil_tiket_kadaluarsa(waktu_sekarang)) >= 0) {
+        tandai_nisan(posisi);
+        tiket_dihapus++;
     }
     
     if (tiket_dihapus > 0) {
-        // Reallocate memori setelah penghapusan massal
-        if (jumlah_tiket > 0) {
-            Tiket *temp = (Tiket *)realloc(daftar_tiket, jumlah_tiket * sizeof(Tiket));
-            if (temp == NULL) { 
-                perror("⚠️ Peringatan: Gagal realloc setelah hapus kadaluarsa."); 
-            } else {
-                daftar_tiket = temp;
-            }
-        } else {
-            free(daftar_tiket);
-            daftar_tiket = NULL;
-        }
+        padatkan_jika_perlu();
 
         printf("✅ Total %d tiket kadaluarsa (lebih dari 7 hari) dihapus secara otomatis.\n", tiket_dihapus);
-        simpan_data();
+        simpan_data_latar();
     } else {
         // Notifikasi dihapus
     }
 }
 
+// Dipanggil di setiap putaran menu: O(1) selama belum ada tiket yang kadaluarsa
+void periksa_kadaluarsa_berkala() {
+    if (ada_tiket_kadaluarsa(time(NULL))) update_otomatis_kadaluarsa();
+}
+
 
 void tampilkan_menu_admin() {
     printf("\n====================================\n");
@@ -523,12 +2954,12 @@ int login_admin() {
     if (scanf("%19s", username) != 1) { bersihkan_buffer(); return 0; }
     bersihkan_buffer();
 
-    if (strcmp(username, "NabilahArkanKey") == 0) {
+    if (strcmp(username, ADMIN_USERNAME) == 0) {
         printf("Masukkan password: ");
         if (scanf("%d", &password) != 1) { bersihkan_buffer(); return 0; }
         bersihkan_buffer();
 
-        if (password == 2025) {
+        if (password == ADMIN_PASSWORD) {
             printf("✅ Akses diterima! Selamat datang, Administrator.\n");
             return 1;
         } else {
@@ -547,6 +2978,7 @@ void mode_administrator() {
         tampilkan_menu_admin();
         if (scanf("%d", &pilihan) != 1) { bersihkan_buffer(); continue; }
         bersihkan_buffer();
+        periksa_kadaluarsa_berkala();
 
         switch (pilihan) {
             case 1: tambah_tiket(); break;
@@ -563,10 +2995,1090 @@ void mode_administrator() {
 
 
 // ==========================================================
-// 4. FUNGSI MAIN
+// 4. MODE BATCH (tanpa prompt, untuk impor massal, job malam, dan uji beban)
+// ==========================================================
+// ./program --batch [file]   (tanpa file atau "-": perintah dibaca dari stdin)
+// Satu perintah per baris; baris kosong dan baris berawalan '#' dilewati:
+//   ADD nama;kategori;harga;stok      BUY id jumlah       DELETE id
+//   UPDATE id HARGA|STOK nilai         SORT HARGA|NAMA     LIST
+//   SEARCH ID|NAMA|KATEGORI teks       SAVE                TERSEDIA [kategori] (hanya stok > 0)
+//   KATEGORI (jumlah tiket per kategori)                   TERMURAH k (k tiket termurah, stok > 0)
+//   LIST|TERSEDIA offset batas         LIST|TERSEDIA SETELAH id batas (satu halaman)
+//   RENTANG min max batas [SETELAH id] [TERSEDIA] [KATEGORI nama] (harga min..max, urut harga)
+// Setiap perintah menghasilkan tepat satu baris "OK <PERINTAH> ..." atau "ERR <baris> <alasan>".
+// Halaman diakhiri "OK LIST|TERSEDIA|RENTANG jumlah kursor": kursor = ID untuk SETELAH berikutnya, 0 = habis.
+// LIST, TERSEDIA, TERMURAH, RENTANG dan SEARCH didahului baris "TIKET id;nama;kategori;harga;stok;waktu_dibuat";
+// KATEGORI didahului baris "KATEGORI nama_casefold;jumlah" (nama "*" = kategori di luar kamus).
+// SAVE hanya mengantre snapshot ke utas penulis; di akhir masukan data disimpan seperti
+// "Keluar Program & Simpan Data", yang menunggu semua penulisan selesai.
+// Seperti di server, jawaban ditahan selama ada pembelian yang belum dikomit: "OK BUY" (dan baris
+// sesudahnya) baru sampai ke stdout setelah pembelian itu tahan crash.
+FILE *keluaran_batch = NULL; // stdout asli; pesan biasa dialihkan ke stderr selama mode batch
+
+int gagal_batch(int nomor_baris, const char *alasan) {
+    fprintf(keluaran_batch, "ERR %d %s\n", nomor_baris, alasan);
+    return 0;
+}
+
+// "TIKET id;nama;kategori;harga;stok;waktu" lewat buffer tampilan; siram sebelum baris OK
+void tulis_tiket_batch(const Tiket *t) {
+    tampil_ke(keluaran_batch);
+    tampil_str("TIKET "); tampil_int(t->id);
+    tampil_str(";"); tampil_str(t->nama_konser);
+    tampil_str(";"); tampil_str(t->kategori);
+    tampil_str(";"); tampil_harga(t->harga);
+    tampil_str(";"); tampil_int(t->jumlah_stok);
+    tampil_str(";"); tampil_int((long)t->waktu_dibuat);
+    tampil_str("\n");
+}
+
+// Field teks ADD: tidak kosong dan muat di `ukuran` (tanpa dipotong diam-diam)
+int field_teks_valid(const char *teks, size_t ukuran) {
+    return teks[0] != '\0' && strlen(teks) < ukuran;
+}
+
+int batch_add(char *arg, int nomor_baris) {
+    char *p1 = strchr(arg, ';');
+    char *p2 = p1 ? strchr(p1 + 1, ';') : NULL;
+    char *p3 = p2 ? strchr(p2 + 1, ';') : NULL;
+    if (p3 == NULL) return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    *p1 = *p2 = *p3 = '\0';
+
+    Tiket baru; int n = 0;
+    memset(&baru, 0, sizeof(baru));
+    if (!field_teks_valid(arg, MAX_NAMA) || !field_teks_valid(p1 + 1, MAX_KATEGORI) ||
+        sscanf(p2 + 1, "%f %n", &baru.harga, &n) != 1 || p2[1 + n] != '\0' || !(baru.harga >= 0) ||
+        sscanf(p3 + 1, "%d %n", &baru.jumlah_stok, &n) != 1 || p3[1 + n] != '\0' || baru.jumlah_stok < 0) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    strcpy(baru.nama_konser, arg);
+    strcpy(baru.kategori, p1 + 1);
+    baru.id = buat_id_unik();
+    baru.waktu_dibuat = time(NULL);
+    if (!masukkan_tiket(&baru)) return gagal_batch(nomor_baris, "gagal_alokasi");
+    fprintf(keluaran_batch, "OK ADD %d\n", baru.id);
+    return 1;
+}
+
+int batch_buy(char *arg, int nomor_baris) {
+    int id, jumlah, stok_sesudah = 0, n = 0;
+    if (sscanf(arg, "%d %d %n", &id, &jumlah, &n) != 2 || arg[n] != '\0') return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    switch (beli_stok_atomik(id, jumlah, &stok_sesudah)) {
+        case BELI_TIDAK_DITEMUKAN: return gagal_batch(nomor_baris, "tidak_ditemukan");
+        case BELI_STOK_KURANG: return gagal_batch(nomor_baris, "stok_kurang");
+        case BELI_JUMLAH_TIDAK_VALID: return gagal_batch(nomor_baris, "jumlah_tidak_valid");
+    }
+    if (!catat_jurnal(id, -jumlah, stok_sesudah)) {
+        perror("⚠️ Peringatan: Gagal mencatat jurnal, menyimpan seluruh data");
+        simpan_data_latar();
+    }
+#ifdef _WIN32
+    komit_jurnal(); // tanpa open_memstream jawaban tidak bisa ditahan: komit per pembelian sebelum OK
+#endif
+    fprintf(keluaran_batch, "OK BUY %d %d %d\n", id, jumlah, stok_sesudah);
+    return 1;
+}
+
+int batch_update(char *arg, int nomor_baris) {
+    int id, n = 0; char kolom[16];
+    if (sscanf(arg, "%d %15s %n", &id, kolom, &n) != 2) return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) return gagal_batch(nomor_baris, "tidak_ditemukan");
+
+    char *nilai = arg + n; int m = 0;
+    if (strcmp(kolom, "HARGA") == 0) {
+        float harga;
+        if (sscanf(nilai, "%f %n", &harga, &m) != 1 || nilai[m] != '\0' || !(harga >= 0)) return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        atur_harga(posisi, harga);
+    } else if (strcmp(kolom, "STOK") == 0) {
+        int stok;
+        if (sscanf(nilai, "%d %n", &stok, &m) != 1 || nilai[m] != '\0' || stok < 0) return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        atur_stok(posisi, stok);
+    } else {
+        return gagal_batch(nomor_baris, "kolom_tidak_dikenal");
+    }
+    fprintf(keluaran_batch, "OK UPDATE %d\n", id);
+    return 1;
+}
+
+int batch_search(char *arg, int nomor_baris) {
+    char mode[16]; int n = 0, ditemukan = 0;
+    if (sscanf(arg, "%15s %n", mode, &n) != 1 || arg[n] == '\0') return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    char *kriteria = arg + n;
+    if (strcmp(mode, "ID") == 0) {
+        int id, m = 0;
+        if (sscanf(kriteria, "%d %n", &id, &m) != 1 || kriteria[m] != '\0') return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        int posisi = cari_indeks_id(id);
+        if (posisi >= 0) { tulis_tiket_batch(&daftar_tiket[posisi]); ditemukan = 1; }
+    } else if (strcmp(mode, "NAMA") == 0) {
+        int *posisi;
+        ditemukan = cari_posisi_nama(kriteria, &posisi);
+        for (int k = 0; k < ditemukan; k++) tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+        free(posisi);
+    } else if (strcmp(mode, "KATEGORI") == 0) {
+        int *posisi;
+        lipat_teks(kriteria, kriteria, strlen(kriteria) + 1);
+        ditemukan = cari_posisi_kategori(kriteria, 0, &posisi);
+        for (int k = 0; k < ditemukan; k++) tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+        free(posisi);
+    } else {
+        return gagal_batch(nomor_baris, "mode_tidak_dikenal");
+    }
+    tampil_siram();
+    fprintf(keluaran_batch, "OK SEARCH %d\n", ditemukan);
+    return 1;
+}
+
+// Bentuk halaman: 1 = "offset batas", 2 = "SETELAH id batas", 0 = arg bukan keduanya
+int baca_argumen_halaman(const char *arg, int *offset, int *kursor, int *batas) {
+    int n = 0;
+    if (sscanf(arg, "SETELAH %d %d %n", kursor, batas, &n) == 2 && arg[n] == '\0') return 2;
+    n = 0;
+    return sscanf(arg, "%d %d %n", offset, batas, &n) == 2 && arg[n] == '\0';
+}
+
+int batch_halaman(const char *perintah, const char *arg, int hanya_tersedia, int nomor_baris) {
+    int offset = 0, kursor = 0, batas = 0, mulai;
+    int bentuk = baca_argumen_halaman(arg, &offset, &kursor, &batas);
+    if (bentuk == 0 || offset < 0 || batas <= 0) return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    if (bentuk == 2) {
+        mulai = letak_kursor(kursor);
+        if (mulai < 0) return gagal_batch(nomor_baris, "kursor_tidak_valid");
+    } else {
+        mulai = letak_offset(offset, hanya_tersedia);
+    }
+    if (batas > jumlah_tiket_aktif()) batas = jumlah_tiket_aktif();
+    int *posisi = (int *)malloc((batas + 1) * sizeof(int));
+    if (posisi == NULL) { perror("Gagal alokasi halaman"); exit(EXIT_FAILURE); }
+    int jumlah = ambil_halaman(mulai, batas, hanya_tersedia, posisi, &kursor);
+    for (int k = 0; k < jumlah; k++) tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK %s %d %d\n", perintah, jumlah, kursor);
+    return 1;
+}
+
+// RENTANG min max batas [SETELAH id] [TERSEDIA] [KATEGORI nama]: satu halaman tiket berharga min..max
+int batch_rentang(char *arg, int nomor_baris) {
+    float harga_min, harga_max;
+    int batas, setelah = 0, hanya_tersedia = 0, kursor, n = 0;
+    char *kategori = NULL;
+    if (sscanf(arg, "%f %f %d %n", &harga_min, &harga_max, &batas, &n) != 3 || !(harga_min >= 0) || !(harga_max >= harga_min) || batas <= 0)
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    arg += n; n = 0;
+    if (sscanf(arg, "SETELAH %d %n", &setelah, &n) == 1) arg += n;
+    if (strncmp(arg, "TERSEDIA", 8) == 0 && (arg[8] == '\0' || arg[8] == ' ')) { hanya_tersedia = 1; arg += 8; while (*arg == ' ') arg++; }
+    if (strncmp(arg, "KATEGORI ", 9) == 0 && arg[9] != '\0') { kategori = arg + 9; lipat_teks(kategori, kategori, strlen(kategori) + 1); arg += strlen(arg); }
+    if (*arg != '\0') return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    if (batas > jumlah_tiket_aktif()) batas = jumlah_tiket_aktif();
+    int *posisi = (int *)malloc((batas + 1) * sizeof(int));
+    if (posisi == NULL) { perror("Gagal alokasi halaman"); exit(EXIT_FAILURE); }
+    int jumlah = ambil_rentang_harga(harga_min, harga_max, setelah, hanya_tersedia, kategori, posisi, batas, &kursor);
+    if (jumlah < 0) { free(posisi); return gagal_batch(nomor_baris, "kursor_tidak_valid"); }
+    for (int k = 0; k < jumlah; k++) tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK RENTANG %d %d\n", jumlah, kursor);
+    return 1;
+}
+
+// Jalankan satu baris perintah; 1 jika berhasil, 0 jika menghasilkan ERR
+int jalankan_perintah_batch(char *baris, int nomor_baris) {
+    char perintah[16]; int n = 0, id;
+    if (sscanf(baris, "%15s %n", perintah, &n) != 1) return gagal_batch(nomor_baris, "perintah_kosong");
+    char *arg = baris + n;
+
+    if (strcmp(perintah, "ADD") == 0) return batch_add(arg, nomor_baris);
+    if (strcmp(perintah, "BUY") == 0) return batch_buy(arg, nomor_baris);
+    if (strcmp(perintah, "UPDATE") == 0) return batch_update(arg, nomor_baris);
+    if (strcmp(perintah, "SEARCH") == 0) return batch_search(arg, nomor_baris);
+    if (strcmp(perintah, "DELETE") == 0) {
+        if (sscanf(arg, "%d %n", &id, &n) != 1 || arg[n] != '\0') return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        if (!hapus_tiket_id(id)) return gagal_batch(nomor_baris, "tidak_ditemukan");
+        fprintf(keluaran_batch, "OK DELETE %d\n", id);
+        return 1;
+    }
+    if (strcmp(perintah, "SORT") == 0) {
+        if (strcmp(arg, "HARGA") == 0) urutkan_tiket(1);
+        else if (strcmp(arg, "NAMA") == 0) urutkan_tiket(2);
+        else return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        fprintf(keluaran_batch, "OK SORT %s\n", arg);
+        return 1;
+    }
+    if (strcmp(perintah, "LIST") == 0) {
+        if (*arg != '\0') return batch_halaman(perintah, arg, 0, nomor_baris);
+        int n = siapkan_tampilan();
+        for (int k = 0; k < n; k++) {
+            int i = posisi_tampilan(k);
+            if (daftar_tiket[i].id != ID_NISAN) tulis_tiket_batch(&daftar_tiket[i]);
+        }
+        tampil_siram();
+        fprintf(keluaran_batch, "OK LIST %d\n", jumlah_tiket_aktif());
+        return 1;
+    }
+    if (strcmp(perintah, "TERSEDIA") == 0) {
+        int tersedia = 0, offset, kursor, batas;
+        if (*arg != '\0' && baca_argumen_halaman(arg, &offset, &kursor, &batas)) return batch_halaman(perintah, arg, 1, nomor_baris);
+        if (*arg != '\0') { // hanya satu kategori: bitmap kategorinya AND peta tersedia
+            int *posisi;
+            lipat_teks(arg, arg, strlen(arg) + 1);
+            tersedia = cari_posisi_kategori(arg, 1, &posisi);
+            for (int k = 0; k < tersedia; k++) tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+            free(posisi);
+        } else if (urutan_tampilan == 0 || tersedia_jarang()) {
+            int *letak;
+            tersedia = letak_tersedia(0, &letak);
+            for (int k = 0; k < tersedia; k++) tulis_tiket_batch(&daftar_tiket[posisi_tampilan(letak[k])]);
+            free(letak);
+        } else {
+            int n = siapkan_tampilan();
+            for (int k = 0; k < n; k++) {
+                int i = posisi_tampilan(k);
+                if (kolom_id[i] != ID_NISAN && kolom_stok[i] > 0) { tulis_tiket_batch(&daftar_tiket[i]); tersedia++; }
+            }
+        }
+        tampil_siram();
+        fprintf(keluaran_batch, "OK TERSEDIA %d\n", tersedia);
+        return 1;
+    }
+    if (strcmp(perintah, "RENTANG") == 0) return batch_rentang(arg, nomor_baris);
+    if (strcmp(perintah, "TERMURAH") == 0) {
+        int k;
+        if (sscanf(arg, "%d %n", &k, &n) != 1 || arg[n] != '\0' || k <= 0) return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        if (k > jumlah_tiket_aktif()) k = jumlah_tiket_aktif();
+        int *posisi = (int *)malloc((k + 1) * sizeof(int));
+        if (posisi == NULL) { perror("Gagal alokasi halaman"); exit(EXIT_FAILURE); }
+        int jumlah = ambil_termurah(k, posisi);
+        for (int j = 0; j < jumlah; j++) tulis_tiket_batch(&daftar_tiket[posisi[j]]);
+        free(posisi);
+        tampil_siram();
+        fprintf(keluaran_batch, "OK TERMURAH %d\n", jumlah);
+        return 1;
+    }
+    if (strcmp(perintah, "KATEGORI") == 0) {
+        int jumlah = 0;
+        for (int k = 1; k < jumlah_kode_kategori; k++) {
+            int isi = hitung_kategori(k);
+            if (isi > 0) { fprintf(keluaran_batch, "KATEGORI %s;%d\n", kamus_kategori[k].nama, isi); jumlah++; }
+        }
+        if (hitung_kategori(0) > 0) { fprintf(keluaran_batch, "KATEGORI *;%d\n", hitung_kategori(0)); jumlah++; }
+        fprintf(keluaran_batch, "OK KATEGORI %d\n", jumlah);
+        return 1;
+    }
+    if (strcmp(perintah, "SAVE") == 0) {
+        simpan_data_latar(); // ditulis di latar belakang; akhir masukan menunggu semuanya selesai
+        fprintf(keluaran_batch, "OK SAVE %d\n", jumlah_tiket_aktif());
+        return 1;
+    }
+    return gagal_batch(nomor_baris, "perintah_tidak_dikenal");
+}
+
+// 1 bila baris berikutnya bisa dibaca, menunggu paling lama `tunggu_ms` (file biasa selalu siap)
+int masukan_siap(FILE *masukan, int tunggu_ms) {
+#ifdef _WIN32
+    (void)masukan; (void)tunggu_ms;
+    return 1;
+#else
+    struct pollfd p;
+    p.fd = fileno(masukan); p.events = POLLIN; p.revents = 0;
+    return poll(&p, 1, tunggu_ms) > 0;
+#endif
+}
+
+#ifndef _WIN32
+// Kirim jawaban yang ditahan di `aliran` (open_memstream) ke `tujuan`, lalu aliran dipakai ulang dari awal
+void lepas_keluaran_batch(FILE *aliran, char **isi, FILE *tujuan) {
+    fflush(aliran);
+    long panjang = ftell(aliran);
+    if (panjang <= 0) return;
+    fwrite(*isi, 1, (size_t)panjang, tujuan);
+    fseek(aliran, 0, SEEK_SET);
+}
+#endif
+
+// Mengembalikan status keluar proses: gagal bila ada perintah yang menghasilkan ERR
+int mode_batch(const char *nama_file) {
+    FILE *masukan = (nama_file == NULL || strcmp(nama_file, "-") == 0) ? stdin : fopen(nama_file, "r");
+    if (masukan == NULL) { perror("Gagal membuka file perintah"); return EXIT_FAILURE; }
+
+    // Hasil batch tetap di stdout asli, sedangkan printf biasa (muat/simpan data) pindah ke stderr
+    fflush(stdout);
+    int fd_keluaran = dup(fileno(stdout));
+    keluaran_batch = fd_keluaran >= 0 ? fdopen(fd_keluaran, "w") : NULL;
+    if (keluaran_batch == NULL || dup2(fileno(stderr), fileno(stdout)) < 0) { perror("Gagal menyiapkan keluaran batch"); return EXIT_FAILURE; }
+
+    muat_data();
+    update_otomatis_kadaluarsa();
+
+    char baris[512];
+    int nomor_baris = 0, jumlah_gagal = 0;
+#ifndef _WIN32
+    FILE *keluaran_asli = keluaran_batch;
+    char *tahanan = NULL; size_t panjang_tahanan = 0;
+    keluaran_batch = open_memstream(&tahanan, &panjang_tahanan);
+    if (keluaran_batch == NULL) { perror("Gagal menyiapkan keluaran batch"); return EXIT_FAILURE; }
+#endif
+    for (;;) {
+        // Pembelian dikomit bersama: saat jendela komit habis, atau lebih awal bila masukan berikutnya belum datang.
+        // Komit yang gagal diulang setiap JEDA_ULANG_KOMIT_MS selama masukan masih kosong.
+        while (sisa_jendela_komit() >= 0 && !masukan_siap(masukan, komit_gagal ? sisa_jendela_komit() : 0)) komit_jurnal();
+#ifndef _WIN32
+        if (lsn_tahan_crash >= lsn_terakhir) lepas_keluaran_batch(keluaran_batch, &tahanan, keluaran_asli);
+#endif
+        if (fgets(baris, sizeof(baris), masukan) == NULL) break;
+        nomor_baris++;
+        if (strchr(baris, '\n') == NULL && !feof(masukan)) {
+            int c; while ((c = fgetc(masukan)) != '\n' && c != EOF);
+            jumlah_gagal += !gagal_batch(nomor_baris, "baris_terlalu_panjang");
+            continue;
+        }
+        baris[strcspn(baris, "\r\n")] = '\0';
+        if (baris[0] == '\0' || baris[0] == '#') continue;
+        periksa_kadaluarsa_berkala();
+        jumlah_gagal += !jalankan_perintah_batch(baris, nomor_baris);
+        if (sisa_jendela_komit() == 0) komit_jurnal();
+    }
+    if (masukan != stdin) fclose(masukan);
+
+    // Snapshot akhir mencakup semua pembelian; bila gagal, jawaban tetap dikirim tetapi status keluar gagal
+    if (!simpan_data()) jumlah_gagal++;
+#ifndef _WIN32
+    lepas_keluaran_batch(keluaran_batch, &tahanan, keluaran_asli);
+    fclose(keluaran_batch);
+    free(tahanan);
+    keluaran_batch = keluaran_asli;
+#endif
+    tutup_data();
+    fclose(keluaran_batch);
+    return jumlah_gagal > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// ==========================================================
+// 5. MODE SERVER (soket Unix + epoll, khusus Linux)
+// ==========================================================
+// ./program --server [path_soket] [jendela_komit_ms]
+// ./program --klien-beban [koneksi] [perintah_per_koneksi] [kedalaman_pipeline] [path_soket]
+// Katalog tetap di memori dan dilayani satu utas dengan epoll non-blocking. Protokolnya sama
+// dengan mode batch (satu perintah per baris, satu baris OK/ERR per perintah), ditambah
+// LOGIN username password dan QUIT. TERSEDIA, TERMURAH, RENTANG, KATEGORI, LIST, SEARCH dan BUY bebas dipakai; ADD,
+// UPDATE, DELETE, SORT dan SAVE butuh LOGIN di koneksi tersebut. Klien boleh mengirim
+// banyak perintah tanpa menunggu jawaban (pipelining); jawaban selalu datang berurutan
+// dan nomor pada ERR adalah nomor perintah di koneksi itu. SIGINT/SIGTERM: simpan lalu berhenti.
+// Jawaban ditahan sampai jurnal yang mencakup transaksinya di-fsync. Semua BUY yang sudah masuk saat
+// server menganggur berbagi satu fsync; selama event terus berdatangan komit paling lambat setiap
+// jendela_komit_ms (bawaan JENDELA_KOMIT_MS, 0 = setiap putaran epoll).
+#if PAKAI_EPOLL
+#define NAMA_SOKET "tiket.sock"
+#define UKURAN_BUFFER_KONEKSI 4096 // satu baris perintah harus muat di sini
+#define BATAS_KELUARAN (1 << 20) // berhenti mengeksekusi perintah bila jawaban tertunda melebihi 1 MB
+#define MAKS_EVENT 64
+
+typedef struct Koneksi {
+    int fd;
+    int admin;              // sudah LOGIN
+    int nomor_perintah;
+    int tutup_setelah_kirim; // klien selesai mengirim (EOF/QUIT/baris rusak): kirim sisa jawaban lalu tutup
+    uint32_t minat;         // event epoll yang sedang didaftarkan
+    char masuk[UKURAN_BUFFER_KONEKSI];
+    size_t isi_masuk;
+    char *keluar;           // jawaban yang belum terkirim seluruhnya
+    size_t panjang_keluar;
+    size_t terkirim;
+    uint64_t lsn_jawaban;   // antrean jawaban baru boleh dikirim setelah jurnal sampai lsn ini dikomit
+    int tertahan;           // terdaftar di koneksi_tertahan
+    struct Koneksi *sebelum_tertahan, *berikut_tertahan;
+} Koneksi;
+
+volatile sig_atomic_t server_berhenti = 0;
+Koneksi *koneksi_tertahan = NULL; // koneksi yang jawabannya menunggu group commit
+
+void tangani_sinyal_server(int sinyal) { (void)sinyal; server_berhenti = 1; }
+
+size_t keluaran_tertunda(const Koneksi *k) { return k->panjang_keluar - k->terkirim; }
+
+// Jawaban tidak boleh sampai ke klien sebelum transaksi yang mungkin dilihatnya tahan crash
+int jawaban_tertahan(const Koneksi *k) { return k->lsn_jawaban > lsn_tahan_crash; }
+
+void tahan_jawaban(Koneksi *k) {
+    k->lsn_jawaban = lsn_terakhir;
+    if (k->tertahan) return;
+    k->tertahan = 1;
+    k->sebelum_tertahan = NULL;
+    k->berikut_tertahan = koneksi_tertahan;
+    if (koneksi_tertahan != NULL) koneksi_tertahan->sebelum_tertahan = k;
+    koneksi_tertahan = k;
+}
+
+void lepas_tahanan(Koneksi *k) {
+    if (!k->tertahan) return;
+    if (k->sebelum_tertahan != NULL) k->sebelum_tertahan->berikut_tertahan = k->berikut_tertahan;
+    else koneksi_tertahan = k->berikut_tertahan;
+    if (k->berikut_tertahan != NULL) k->berikut_tertahan->sebelum_tertahan = k->sebelum_tertahan;
+    k->tertahan = 0;
+    k->sebelum_tertahan = k->berikut_tertahan = NULL;
+}
+
+// LOGIN/QUIT ditangani di sini; sisanya diteruskan ke pelaksana perintah batch
+int jalankan_perintah_server(Koneksi *k, char *baris) {
+    char perintah[16], username[32]; int password, n = 0;
+    if (sscanf(baris, "%15s", perintah) == 1) {
+        if (strcmp(perintah, "LOGIN") == 0) {
+            if (sscanf(baris, "%*s %31s %d %n", username, &password, &n) != 2 || baris[n] != '\0' ||
+                strcmp(username, ADMIN_USERNAME) != 0 || password != ADMIN_PASSWORD) return gagal_batch(k->nomor_perintah, "login_gagal");
+            k->admin = 1;
+            fprintf(keluaran_batch, "OK LOGIN\n");
+            return 1;
+        }
+        if (strcmp(perintah, "QUIT") == 0) {
+            k->tutup_setelah_kirim = 1;
+            fprintf(keluaran_batch, "OK QUIT\n");
+            return 1;
+        }
+        int khusus_admin = strcmp(perintah, "ADD") == 0 || strcmp(perintah, "UPDATE") == 0 || strcmp(perintah, "DELETE") == 0 ||
+                           strcmp(perintah, "SORT") == 0 || strcmp(perintah, "SAVE") == 0;
+        if (khusus_admin && !k->admin) return gagal_batch(k->nomor_perintah, "butuh_login");
+    }
+    return jalankan_perintah_batch(baris, k->nomor_perintah);
+}
+
+// Tambahkan `hasil` (milik pemanggil, dibebaskan di sini) ke antrean jawaban koneksi
+int tambah_keluaran(Koneksi *k, char *hasil, size_t panjang) {
+    if (panjang == 0) { free(hasil); return 1; }
+    if (keluaran_tertunda(k) == 0) {
+        free(k->keluar);
+        k->keluar = hasil; k->panjang_keluar = panjang; k->terkirim = 0;
+        return 1;
+    }
+    size_t sisa = keluaran_tertunda(k);
+    memmove(k->keluar, k->keluar + k->terkirim, sisa);
+    char *baru = (char *)realloc(k->keluar, sisa + panjang);
+    if (baru == NULL) { free(hasil); return 0; }
+    memcpy(baru + sisa, hasil, panjang);
+    free(hasil);
+    k->keluar = baru; k->panjang_keluar = sisa + panjang; k->terkirim = 0;
+    return 1;
+}
+
+// Eksekusi semua baris lengkap di buffer masuk, berhenti lebih awal bila jawaban tertunda sudah terlalu banyak
+int proses_masukan_koneksi(Koneksi *k) {
+    char *hasil = NULL; size_t panjang = 0;
+    FILE *aliran = open_memstream(&hasil, &panjang);
+    if (aliran == NULL) return 0;
+    keluaran_batch = aliran;
+
+    char *awal = k->masuk, *akhir = k->masuk + k->isi_masuk;
+    while (awal < akhir && !(k->tutup_setelah_kirim && k->isi_masuk == 0) && keluaran_tertunda(k) + (size_t)ftell(aliran) < BATAS_KELUARAN) {
+        char *akhir_baris = memchr(awal, '\n', akhir - awal);
+        if (akhir_baris == NULL) {
+            if (awal == k->masuk && k->isi_masuk == sizeof(k->masuk)) {
+                gagal_batch(++k->nomor_perintah, "baris_terlalu_panjang");
+                k->tutup_setelah_kirim = 1;
+                awal = akhir;
+            }
+            break;
+        }
+        *akhir_baris = '\0';
+        if (akhir_baris > awal && akhir_baris[-1] == '\r') akhir_baris[-1] = '\0';
+        if (awal[0] != '\0' && awal[0] != '#') {
+            k->nomor_perintah++;
+            periksa_kadaluarsa_berkala();
+            jalankan_perintah_server(k, awal);
+        }
+        awal = akhir_baris + 1;
+        if (k->tutup_setelah_kirim) awal = akhir; // perintah setelah QUIT diabaikan
+    }
+    k->isi_masuk = akhir - awal;
+    memmove(k->masuk, awal, k->isi_masuk);
+
+    fclose(aliran);
+    keluaran_batch = NULL;
+    if (panjang > 0 && lsn_terakhir > lsn_tahan_crash) tahan_jawaban(k);
+    return tambah_keluaran(k, hasil, panjang);
+}
+
+// 0 jika koneksi harus ditutup karena error
+int baca_koneksi(Koneksi *k) {
+    while (!k->tutup_setelah_kirim && k->isi_masuk < sizeof(k->masuk) && keluaran_tertunda(k) < BATAS_KELUARAN) {
+        ssize_t n = recv(k->fd, k->masuk + k->isi_masuk, sizeof(k->masuk) - k->isi_masuk, 0);
+        if (n > 0) {
+            k->isi_masuk += n;
+            if (!proses_masukan_koneksi(k)) return 0;
+        } else if (n == 0) {
+            k->tutup_setelah_kirim = 1; // klien sudah selesai mengirim; jawaban yang tersisa tetap dikirim
+        } else if (errno == EINTR) {
+            continue;
+        } else {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+    return 1;
+}
+
+int kirim_koneksi(Koneksi *k) {
+    if (jawaban_tertahan(k)) return 1; // dikirim oleh lepaskan_jawaban_tertahan() setelah komit
+    while (keluaran_tertunda(k) > 0) {
+        ssize_t n = send(k->fd, k->keluar + k->terkirim, keluaran_tertunda(k), MSG_NOSIGNAL);
+        if (n > 0) { k->terkirim += n; continue; }
+        if (n < 0 && errno == EINTR) continue;
+        return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+    // Antrean kosong: lanjutkan perintah yang tertahan karena batas keluaran
+    if (k->isi_masuk > 0 && !k->tutup_setelah_kirim) return proses_masukan_koneksi(k) && (keluaran_tertunda(k) == 0 || kirim_koneksi(k));
+    return 1;
+}
+
+void tutup_koneksi(int fd_epoll, Koneksi *k) {
+    lepas_tahanan(k);
+    epoll_ctl(fd_epoll, EPOLL_CTL_DEL, k->fd, NULL);
+    close(k->fd);
+    free(k->keluar);
+    free(k);
+}
+
+// Daftarkan ulang minat epoll sesuai keadaan buffer; 0 jika koneksi sudah selesai
+int perbarui_minat(int fd_epoll, Koneksi *k) {
+    if (k->tutup_setelah_kirim && keluaran_tertunda(k) == 0) return 0;
+    uint32_t minat = 0;
+    if (!k->tutup_setelah_kirim && keluaran_tertunda(k) < BATAS_KELUARAN) minat |= EPOLLIN;
+    if (keluaran_tertunda(k) > 0 && !jawaban_tertahan(k)) minat |= EPOLLOUT;
+    if (minat != k->minat) {
+        struct epoll_event ev;
+        ev.events = minat; ev.data.ptr = k;
+        if (epoll_ctl(fd_epoll, EPOLL_CTL_MOD, k->fd, &ev) < 0) return 0;
+        k->minat = minat;
+    }
+    return 1;
+}
+
+void terima_koneksi(int fd_epoll, int fd_server) {
+    for (;;) {
+        int fd = accept(fd_server, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("⚠️ Gagal menerima koneksi");
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        Koneksi *k = (Koneksi *)calloc(1, sizeof(Koneksi));
+        struct epoll_event ev;
+        ev.events = EPOLLIN; ev.data.ptr = k;
+        if (k == NULL || epoll_ctl(fd_epoll, EPOLL_CTL_ADD, fd, &ev) < 0) { perror("⚠️ Gagal mendaftarkan koneksi"); free(k); close(fd); continue; }
+        k->fd = fd; k->minat = EPOLLIN;
+    }
+}
+
+// Group commit: satu fsync untuk semua transaksi yang terkumpul, lalu jawaban yang menunggunya dikirim.
+// Bila fsync gagal semua jawaban tetap ditahan sampai percobaan ulang berhasil.
+void lepaskan_jawaban_tertahan(int fd_epoll) {
+    if (!komit_jurnal()) return;
+    Koneksi *daftar = koneksi_tertahan;
+    koneksi_tertahan = NULL; // jawaban yang tertahan lagi selama pengiriman menunggu komit berikutnya
+    while (daftar != NULL) {
+        Koneksi *k = daftar;
+        daftar = k->berikut_tertahan;
+        k->tertahan = 0;
+        k->sebelum_tertahan = k->berikut_tertahan = NULL;
+        if (!kirim_koneksi(k) || !perbarui_minat(fd_epoll, k)) tutup_koneksi(fd_epoll, k);
+    }
+}
+
+int mode_server(const char *path_soket) {
+    struct sockaddr_un alamat;
+    memset(&alamat, 0, sizeof(alamat));
+    alamat.sun_family = AF_UNIX;
+    if (strlen(path_soket) >= sizeof(alamat.sun_path)) { fprintf(stderr, "❌ Path soket terlalu panjang: %s\n", path_soket); return EXIT_FAILURE; }
+    strcpy(alamat.sun_path, path_soket);
+
+    muat_data();
+    update_otomatis_kadaluarsa();
+
+    int fd_server = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_server < 0) { perror("❌ Gagal membuat soket"); tutup_data(); return EXIT_FAILURE; }
+    unlink(path_soket); // sisa soket dari server sebelumnya
+    if (bind(fd_server, (struct sockaddr *)&alamat, sizeof(alamat)) < 0 || listen(fd_server, SOMAXCONN) < 0) {
+        perror("❌ Gagal membuka soket server"); close(fd_server); tutup_data(); return EXIT_FAILURE;
+    }
+    int fd_epoll = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event ev;
+    ev.events = EPOLLIN; ev.data.ptr = NULL; // data NULL menandai soket server
+    if (fd_epoll < 0 || epoll_ctl(fd_epoll, EPOLL_CTL_ADD, fd_server, &ev) < 0) {
+        perror("❌ Gagal menyiapkan epoll"); close(fd_server); unlink(path_soket); tutup_data(); return EXIT_FAILURE;
+    }
+
+    struct sigaction aksi;
+    memset(&aksi, 0, sizeof(aksi));
+    aksi.sa_handler = tangani_sinyal_server; // tanpa SA_RESTART agar epoll_wait terbangun
+    sigaction(SIGINT, &aksi, NULL);
+    sigaction(SIGTERM, &aksi, NULL);
+
+    printf("🖧 Server tiket aktif di %s (%d tiket). Tekan Ctrl+C untuk simpan & berhenti.\n", path_soket, jumlah_tiket_aktif());
+    fflush(stdout);
+
+    struct epoll_event event[MAKS_EVENT];
+    while (!server_berhenti) {
+        // Dengan transaksi tertunda hanya intip event yang sudah siap: bila tidak ada, tidak ada lagi
+        // yang bisa bergabung ke grup (klien menunggu jawabannya), jadi komit sekarang. Setelah komit
+        // gagal, tunggu sampai jadwal percobaan ulang.
+        int tunggu = sisa_jendela_komit() < 0 ? -1 : komit_gagal ? sisa_jendela_komit() : 0;
+        int jumlah_event = epoll_wait(fd_epoll, event, MAKS_EVENT, tunggu);
+        if (jumlah_event == 0) { lepaskan_jawaban_tertahan(fd_epoll); continue; }
+        if (jumlah_event < 0) {
+            if (errno == EINTR) continue;
+            perror("❌ epoll_wait gagal");
+            break;
+        }
+        for (int i = 0; i < jumlah_event; i++) {
+            Koneksi *k = (Koneksi *)event[i].data.ptr;
+            if (k == NULL) { terima_koneksi(fd_epoll, fd_server); continue; }
+
+            int hidup = 1;
+            if (event[i].events & EPOLLIN) hidup = baca_koneksi(k);
+            else if (event[i].events & (EPOLLERR | EPOLLHUP)) hidup = 0;
+            if (hidup && (event[i].events & EPOLLOUT)) hidup = kirim_koneksi(k);
+            if (hidup && keluaran_tertunda(k) > 0) hidup = kirim_koneksi(k); // coba langsung tanpa menunggu EPOLLOUT
+            if (!hidup || !perbarui_minat(fd_epoll, k)) tutup_koneksi(fd_epoll, k);
+        }
+        if (sisa_jendela_komit() == 0 || (koneksi_tertahan != NULL && sisa_jendela_komit() < 0)) lepaskan_jawaban_tertahan(fd_epoll);
+    }
+
+    printf("\n🛑 Server berhenti.\n");
+    close(fd_epoll);
+    close(fd_server);
+    unlink(path_soket);
+    simpan_data();
+    tutup_data();
+    return EXIT_SUCCESS;
+}
+
+// --- Klien pembangkit beban: beberapa koneksi paralel, masing-masing mengirim perintah BUY/SEARCH
+// dalam rombongan sebesar kedalaman pipeline lalu menunggu semua jawabannya ---
+typedef struct {
+    const char *path_soket;
+    int jumlah_perintah;
+    int kedalaman;
+    const int *daftar_id;
+    int jumlah_id;
+    unsigned int benih;
+    long jawaban_ok, jawaban_err;
+    int gagal;
+} DataKlienBeban;
+
+int hubungkan_soket(const char *path_soket) {
+    struct sockaddr_un alamat;
+    memset(&alamat, 0, sizeof(alamat));
+    alamat.sun_family = AF_UNIX;
+    snprintf(alamat.sun_path, sizeof(alamat.sun_path), "%s", path_soket);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&alamat, sizeof(alamat)) < 0) { close(fd); fd = -1; }
+    return fd;
+}
+
+int kirim_semua(int fd, const char *data, size_t panjang) {
+    while (panjang > 0) {
+        ssize_t n = send(fd, data, panjang, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return 0;
+        data += n; panjang -= n;
+    }
+    return 1;
+}
+
+void *jalankan_klien_beban(void *arg) {
+    DataKlienBeban *d = (DataKlienBeban *)arg;
+    int fd = hubungkan_soket(d->path_soket);
+    char *kirim = (char *)malloc((size_t)d->kedalaman * 32);
+    if (fd < 0 || kirim == NULL) { d->gagal = 1; free(kirim); if (fd >= 0) close(fd); return NULL; }
+
+    char terima[8192];
+    int awal_baris = 1; // jawaban dihitung dari huruf pertama tiap baris: 'O'K, 'E'RR, atau 'T'IKET (data)
+    long terkirim = 0, dijawab = 0;
+    while (dijawab < d->jumlah_perintah) {
+        size_t panjang = 0;
+        for (int i = 0; i < d->kedalaman && terkirim < d->jumlah_perintah; i++, terkirim++) {
+            d->benih = d->benih * 1103515245u + 12345u;
+            int id = d->daftar_id[(d->benih >> 8) % d->jumlah_id];
+            panjang += sprintf(kirim + panjang, (d->benih >> 16) & 1 ? "BUY %d 1\n" : "SEARCH ID %d\n", id);
+        }
+        if (panjang > 0 && !kirim_semua(fd, kirim, panjang)) { d->gagal = 1; break; }
+
+        while (dijawab < terkirim) {
+            ssize_t n = recv(fd, terima, sizeof(terima), 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) { d->gagal = 1; break; }
+            for (ssize_t j = 0; j < n; j++) {
+                if (awal_baris) {
+                    if (terima[j] == 'O') { d->jawaban_ok++; dijawab++; }
+                    else if (terima[j] == 'E') { d->jawaban_err++; dijawab++; }
+                }
+                awal_baris = terima[j] == '\n';
+            }
+        }
+        if (d->gagal) break;
+    }
+    kirim_semua(fd, "QUIT\n", 5);
+    close(fd);
+    free(kirim);
+    return NULL;
+}
+
+int klien_beban(int jumlah_koneksi, int perintah_per_koneksi, int kedalaman, const char *path_soket) {
+    // Ambil ID tiket yang masih tersedia sebagai target perintah
+    int fd = hubungkan_soket(path_soket);
+    FILE *aliran = fd >= 0 ? fdopen(fd, "r+") : NULL;
+    if (aliran == NULL) { fprintf(stderr, "❌ Tidak dapat terhubung ke server di %s\n", path_soket); if (fd >= 0) close(fd); return EXIT_FAILURE; }
+    fprintf(aliran, "TERSEDIA\n");
+    fflush(aliran);
+
+    int *daftar_id = NULL, jumlah_id = 0, kapasitas_id = 0;
+    char baris[256];
+    while (fgets(baris, sizeof(baris), aliran) != NULL && strncmp(baris, "TIKET ", 6) == 0) {
+        if (jumlah_id == kapasitas_id) {
+            kapasitas_id = kapasitas_id ? kapasitas_id * 2 : KAPASITAS_AWAL;
+            int *baru = (int *)realloc(daftar_id, kapasitas_id * sizeof(int));
+            if (baru == NULL) break;
+            daftar_id = baru;
+        }
+        daftar_id[jumlah_id++] = atoi(baris + 6);
+    }
+    fclose(aliran);
+    if (jumlah_id == 0) { fprintf(stderr, "❌ Tidak ada tiket tersedia di server untuk diuji.\n"); free(daftar_id); return EXIT_FAILURE; }
+
+    pthread_t *utas = (pthread_t *)malloc(jumlah_koneksi * sizeof(pthread_t));
+    DataKlienBeban *data = (DataKlienBeban *)calloc(jumlah_koneksi, sizeof(DataKlienBeban));
+    if (utas == NULL || data == NULL) { perror("Gagal mengalokasikan klien"); free(utas); free(data); free(daftar_id); return EXIT_FAILURE; }
+
+    printf("🧪 Klien beban: %d koneksi x %d perintah, pipeline %d, %d tiket target\n", jumlah_koneksi, perintah_per_koneksi, kedalaman, jumlah_id);
+    struct timespec mulai, selesai;
+    clock_gettime(CLOCK_MONOTONIC, &mulai);
+    int dibuat = 0;
+    for (; dibuat < jumlah_koneksi; dibuat++) {
+        data[dibuat].path_soket = path_soket;
+        data[dibuat].jumlah_perintah = perintah_per_koneksi;
+        data[dibuat].kedalaman = kedalaman;
+        data[dibuat].daftar_id = daftar_id;
+        data[dibuat].jumlah_id = jumlah_id;
+        data[dibuat].benih = 2025u + (unsigned int)dibuat * 7919u;
+        if (pthread_create(&utas[dibuat], NULL, jalankan_klien_beban, &data[dibuat]) != 0) break;
+    }
+    for (int i = 0; i < dibuat; i++) pthread_join(utas[i], NULL);
+    clock_gettime(CLOCK_MONOTONIC, &selesai);
+
+    long total_ok = 0, total_err = 0; int koneksi_gagal = 0;
+    for (int i = 0; i < dibuat; i++) { total_ok += data[i].jawaban_ok; total_err += data[i].jawaban_err; koneksi_gagal += data[i].gagal; }
+    double detik = (selesai.tv_sec - mulai.tv_sec) + (selesai.tv_nsec - mulai.tv_nsec) / 1e9;
+    printf("  Jawaban: %ld OK, %ld ERR dalam %.3f detik (%.0f perintah/detik)\n",
+           total_ok, total_err, detik, detik > 0 ? (total_ok + total_err) / detik : 0.0);
+    if (koneksi_gagal > 0) printf("  ❌ %d koneksi terputus sebelum selesai.\n", koneksi_gagal);
+
+    free(utas); free(data); free(daftar_id);
+    return koneksi_gagal > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
+
+// ==========================================================
+// 6. FUNGSI MAIN
 // ==========================================================
 
-int main() {
+// Uji beban pembelian serentak (./program --uji-beli [jumlah_utas]). Memakai katalog
+// sementara di memori, tidak menyentuh file data. Semua utas berebut beberapa tiket
+// populer; di akhir total terjual harus sama dengan stok awal dikurangi stok akhir.
+#if PAKAI_MMAP
+#define UJI_JUMLAH_TIKET 4
+#define UJI_STOK_AWAL 100000
+
+typedef struct {
+    unsigned int benih;
+    long terjual[UJI_JUMLAH_TIKET];
+} DataUtasUji;
+
+void *jalankan_pembeli_uji(void *arg) {
+    DataUtasUji *data = (DataUtasUji *)arg;
+    int habis = 0;
+    while (habis < UJI_JUMLAH_TIKET * 4) {
+        data->benih = data->benih * 1103515245u + 12345u;
+        int indeks = (data->benih >> 16) % UJI_JUMLAH_TIKET;
+        int jumlah = 1 + (data->benih >> 8) % 3;
+        int hasil = beli_stok_atomik(indeks + 1, jumlah, NULL);
+        if (hasil == BELI_BERHASIL) data->terjual[indeks] += jumlah;
+        else if (hasil == BELI_STOK_KURANG) habis++;
+    }
+    // Habiskan sisa stok satu per satu agar semua tiket benar-benar terjual habis
+    for (int i = 0; i < UJI_JUMLAH_TIKET; i++) {
+        while (beli_stok_atomik(i + 1, 1, NULL) == BELI_BERHASIL) data->terjual[i]++;
+    }
+    return NULL;
+}
+
+int uji_beli_serentak(int jumlah_utas) {
+    Tiket katalog[UJI_JUMLAH_TIKET];
+    memset(katalog, 0, sizeof(katalog));
+    for (int i = 0; i < UJI_JUMLAH_TIKET; i++) {
+        katalog[i].id = i + 1;
+        snprintf(katalog[i].nama_konser, MAX_NAMA, "Uji %d", i + 1);
+        katalog[i].jumlah_stok = UJI_STOK_AWAL;
+    }
+    daftar_tiket = katalog;
+    jumlah_tiket = UJI_JUMLAH_TIKET;
+    bangun_kolom();
+    bangun_indeks_id();
+
+    pthread_t *utas = (pthread_t *)malloc(jumlah_utas * sizeof(pthread_t));
+    DataUtasUji *data = (DataUtasUji *)calloc(jumlah_utas, sizeof(DataUtasUji));
+    if (utas == NULL || data == NULL) { perror("Gagal mengalokasikan utas uji"); return EXIT_FAILURE; }
+
+    printf("🧪 Uji beli serentak: %d utas, %d tiket x stok %d\n", jumlah_utas, UJI_JUMLAH_TIKET, UJI_STOK_AWAL);
+    int dibuat = 0;
+    for (; dibuat < jumlah_utas; dibuat++) {
+        data[dibuat].benih = 2025u + (unsigned int)dibuat * 7919u;
+        if (pthread_create(&utas[dibuat], NULL, jalankan_pembeli_uji, &data[dibuat]) != 0) break;
+    }
+    for (int i = 0; i < dibuat; i++) pthread_join(utas[i], NULL);
+
+    int gagal = 0;
+    for (int t = 0; t < UJI_JUMLAH_TIKET; t++) {
+        long terjual = 0;
+        for (int i = 0; i < dibuat; i++) terjual += data[i].terjual[t];
+        int sisa = katalog[t].jumlah_stok;
+        int cocok = terjual <= UJI_STOK_AWAL && sisa >= 0 && terjual + sisa == UJI_STOK_AWAL && kolom_stok[t] == sisa
+                    && (int)(peta_tersedia[0] >> t & 1) == (sisa > 0);
+        printf("  %s Tiket %d: terjual %ld, sisa %d\n", cocok ? "✅" : "❌", t + 1, terjual, sisa);
+        if (!cocok) gagal = 1;
+    }
+    if (jumlah_tersedia != __builtin_popcountll(peta_tersedia[0])) gagal = 1;
+    free(utas); free(data);
+    free(indeks_id);
+    indeks_id = NULL; kapasitas_indeks = 0;
+    kosongkan_kolom();
+    daftar_tiket = NULL; jumlah_tiket = 0;
+
+    printf(gagal ? "❌ Uji gagal: terjadi penjualan melebihi stok.\n" : "✅ Uji berhasil: tidak ada penjualan melebihi stok.\n");
+    return gagal ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
+
+// Mikrobenchmark pencocok nama (./program --uji-cari [jumlah_tiket] [ulang]). Memakai katalog
+// nama acak di memori dan membandingkan loop lama (salin + tolower + strstr per tiket) dengan
+// strstr pada salinan casefold serta kernel skalar/SSE2/AVX2. Jumlah hasil semua varian harus sama.
+#define UJI_CARI_KRITERIA 8
+
+// Cara lama: salin teks & kriteria, tolower keduanya, lalu strstr
+int teks_memuat_tolower(const char *teks, const char *kriteria) {
+    char temp_teks[MAX_NAMA], temp_kriteria[MAX_NAMA];
+    snprintf(temp_teks, sizeof(temp_teks), "%s", teks); snprintf(temp_kriteria, sizeof(temp_kriteria), "%s", kriteria);
+    for (int j = 0; temp_teks[j]; j++) { temp_teks[j] = tolower((unsigned char)temp_teks[j]); }
+    for (int j = 0; temp_kriteria[j]; j++) { temp_kriteria[j] = tolower((unsigned char)temp_kriteria[j]); }
+    return strstr(temp_teks, temp_kriteria) != NULL;
+}
+
+// varian 0 = tolower+strstr pada nama asli, 1 = strstr pada salinan casefold,
+// 2 = `kernel` pada nama asli (casefold di dalam kernel), 3 = `kernel` pada salinan casefold
+long hitung_cocok_uji(int varian, PencocokLipat kernel, char (*nama)[MAX_NAMA], const TeksLipat *lipat, int jumlah,
+                      const char *kriteria, const char *kriteria_lipat, size_t panjang) {
+    long cocok = 0;
+    for (int i = 0; i < jumlah; i++) {
+        switch (varian) {
+            case 0: cocok += teks_memuat_tolower(nama[i], kriteria); break;
+            case 1: cocok += strstr(lipat[i].nama, kriteria_lipat) != NULL; break;
+            case 2: cocok += kernel(nama[i], strlen(nama[i]), MAX_NAMA, kriteria_lipat, panjang); break;
+            default: cocok += kernel(lipat[i].nama, lipat[i].panjang_nama, MAX_NAMA, kriteria_lipat, panjang); break;
+        }
+    }
+    return cocok;
+}
+
+int uji_cari(int jumlah, int ulang) {
+    static const char *kata[] = {"Konser", "Rock", "Jazz", "Festival", "Dangdut", "Pop", "Malam", "Akustik",
+                                 "Sheila", "Noah", "Dewa", "Tulus", "Raisa", "Band", "Live", "Tour"};
+    static const char *kriteria[UJI_CARI_KRITERIA] = {"rock", "Noah", "a", "zzz", "ser ro", "AKUSTIK", "al", "tour live band"};
+    char (*nama)[MAX_NAMA] = (char (*)[MAX_NAMA])malloc(jumlah * sizeof(*nama));
+    TeksLipat *lipat = (TeksLipat *)malloc(jumlah * sizeof(TeksLipat));
+    if (nama == NULL || lipat == NULL) { perror("Gagal mengalokasikan katalog uji"); return EXIT_FAILURE; }
+
+    unsigned int benih = 2025u;
+    for (int i = 0; i < jumlah; i++) {
+        int isi = 0, banyak_kata;
+        benih = benih * 1103515245u + 12345u;
+        banyak_kata = 1 + (benih >> 16) % 4;
+        nama[i][0] = '\0';
+        for (int k = 0; k < banyak_kata; k++) {
+            benih = benih * 1103515245u + 12345u;
+            isi += snprintf(nama[i] + isi, MAX_NAMA - isi, "%s%s", k ? " " : "", kata[(benih >> 16) % 16]);
+        }
+        if ((benih >> 8) % 4 == 0) { for (int j = 0; nama[i][j]; j++) nama[i][j] = (char)toupper((unsigned char)nama[i][j]); }
+        lipat[i].panjang_nama = (unsigned char)lipat_teks(lipat[i].nama, nama[i], MAX_NAMA);
+    }
+
+    struct { const char *judul; int varian; PencocokLipat kernel; } daftar_uji[8];
+    int jumlah_uji = 0;
+    daftar_uji[jumlah_uji].judul = "tolower + strstr (cara lama)"; daftar_uji[jumlah_uji].varian = 0; daftar_uji[jumlah_uji++].kernel = NULL;
+    daftar_uji[jumlah_uji].judul = "strstr salinan casefold"; daftar_uji[jumlah_uji].varian = 1; daftar_uji[jumlah_uji++].kernel = NULL;
+    daftar_uji[jumlah_uji].judul = "kernel skalar"; daftar_uji[jumlah_uji].varian = 3; daftar_uji[jumlah_uji++].kernel = memuat_lipat_skalar;
+#if PAKAI_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        daftar_uji[jumlah_uji].judul = "kernel SSE2"; daftar_uji[jumlah_uji].varian = 3; daftar_uji[jumlah_uji++].kernel = memuat_lipat_sse2;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        daftar_uji[jumlah_uji].judul = "kernel AVX2"; daftar_uji[jumlah_uji].varian = 3; daftar_uji[jumlah_uji++].kernel = memuat_lipat_avx2;
+    }
+#endif
+    daftar_uji[jumlah_uji].judul = "kernel terpilih, nama asli"; daftar_uji[jumlah_uji].varian = 2; daftar_uji[jumlah_uji++].kernel = pilih_pencocok_lipat();
+
+    printf("🧪 Uji cari nama: %d tiket x %d kriteria x %d ulang\n", jumlah, UJI_CARI_KRITERIA, ulang);
+    long acuan = -1;
+    int gagal = 0;
+    for (int u = 0; u < jumlah_uji; u++) {
+        long cocok = 0;
+        clock_t mulai = clock();
+        for (int r = 0; r < ulang; r++) {
+            for (int k = 0; k < UJI_CARI_KRITERIA; k++) {
+                char kriteria_lipat[MAX_NAMA];
+                size_t panjang = lipat_teks(kriteria_lipat, kriteria[k], sizeof(kriteria_lipat));
+                cocok += hitung_cocok_uji(daftar_uji[u].varian, daftar_uji[u].kernel, nama, lipat, jumlah, kriteria[k], kriteria_lipat, panjang);
+            }
+        }
+        double detik = (double)(clock() - mulai) / CLOCKS_PER_SEC;
+        if (acuan < 0) acuan = cocok;
+        if (cocok != acuan) gagal = 1;
+        printf("  %s %-28s %8.3f detik  %6.1f ns/tiket  (%ld cocok)\n", cocok == acuan ? "✅" : "❌", daftar_uji[u].judul,
+               detik, detik * 1e9 / ((double)jumlah * UJI_CARI_KRITERIA * ulang), cocok);
+    }
+    free(nama); free(lipat);
+
+    printf(gagal ? "❌ Uji gagal: hasil pencocok berbeda.\n" : "✅ Uji berhasil: semua pencocok memberi hasil yang sama.\n");
+    return gagal ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#if PAKAI_MMAP
+// Uji simpan-muat setelah pemadatan (./program --uji-padat). Skenario batch dijalankan di direktori sementara,
+// jadi file data di direktori kerja tidak tersentuh. Setiap tahap diakhiri simpan lalu muat ulang dari disk:
+// simpan penuh, snapshot sesudah DELETE yang memicu pemadatan (record bergeser ke slot lain), lalu snapshot
+// sebagian yang hanya menulis satu slot kotor.
+#define UJI_PADAT_AWAL 40   // tiket yang sudah ada di file sebelum pemadatan
+#define UJI_PADAT_TAMBAH 60 // tiket yang ditambahkan sesudah muat ulang
+#define UJI_PADAT_HAPUS 25  // tiket tambahan pertama yang dihapus (bersama tiket pertama -> pemadatan)
+
+int uji_padat_perintah(const char *perintah) {
+    char baris[512];
+    snprintf(baris, sizeof(baris), "%s", perintah);
+    return jalankan_perintah_batch(baris, 0);
+}
+
+// Katalog yang baru dimuat harus berisi tepat tiket ke-k dengan hidup[k] != 0, masing-masing ditemukan lewat id-nya
+// sendiri dengan nama dan stok yang diharapkan. Mengembalikan jumlah ketidakcocokan.
+int uji_padat_periksa(const int *id, const int *hidup, const int *stok, int jumlah, const char *tahap) {
+    int salah = 0, aktif = 0;
+    for (int k = 0; k < jumlah; k++) {
+        int posisi = cari_indeks_id(id[k]);
+        if (!hidup[k]) { salah += posisi >= 0; continue; }
+        aktif++;
+        char nama[MAX_NAMA]; snprintf(nama, sizeof(nama), "Uji Padat %d", k);
+        if (posisi < 0 || strcmp(daftar_tiket[posisi].nama_konser, nama) != 0 || kolom_stok[posisi] != stok[k]) salah++;
+    }
+    if (jumlah_tiket_aktif() != aktif) salah++;
+    if (salah > 0) printf("❌ %s: %d ketidakcocokan (%d tiket dimuat, %d diharapkan).\n", tahap, salah, jumlah_tiket_aktif(), aktif);
+    else printf("✅ %s: %d tiket cocok.\n", tahap, aktif);
+    return salah;
+}
+
+int uji_padat() {
+    char direktori[] = "/tmp/uji_padat_XXXXXX";
+    if (mkdtemp(direktori) == NULL || chdir(direktori) != 0) { perror("Gagal membuat direktori uji"); return EXIT_FAILURE; }
+    keluaran_batch = tmpfile(); // jawaban OK/ERR tidak dicetak; keberhasilan dilihat dari nilai kembali
+    if (keluaran_batch == NULL) { perror("Gagal menyiapkan keluaran batch"); return EXIT_FAILURE; }
+
+    int id[UJI_PADAT_AWAL + UJI_PADAT_TAMBAH], hidup[UJI_PADAT_AWAL + UJI_PADAT_TAMBAH], stok[UJI_PADAT_AWAL + UJI_PADAT_TAMBAH];
+    int jumlah = 0, salah = 0;
+    char perintah[128];
+
+    muat_data();
+    for (; jumlah < UJI_PADAT_AWAL; jumlah++) {
+        stok[jumlah] = jumlah % 50; hidup[jumlah] = 1;
+        snprintf(perintah, sizeof(perintah), "ADD Uji Padat %d;VIP;%d;%d", jumlah, 1000 + jumlah, stok[jumlah]);
+        salah += !uji_padat_perintah(perintah);
+        id[jumlah] = kolom_id[jumlah_tiket - 1];
+    }
+    salah += !simpan_data();
+    tutup_data(); muat_data();
+    salah += uji_padat_periksa(id, hidup, stok, jumlah, "Simpan penuh");
+
+    for (; jumlah < UJI_PADAT_AWAL + UJI_PADAT_TAMBAH; jumlah++) {
+        stok[jumlah] = jumlah % 50; hidup[jumlah] = 1;
+        snprintf(perintah, sizeof(perintah), "ADD Uji Padat %d;Tribun;%d;%d", jumlah, 2000 + jumlah, stok[jumlah]);
+        salah += !uji_padat_perintah(perintah);
+        id[jumlah] = kolom_id[jumlah_tiket - 1];
+    }
+    for (int k = -1; k < UJI_PADAT_HAPUS; k++) {
+        int korban = k < 0 ? 0 : UJI_PADAT_AWAL + k;
+        snprintf(perintah, sizeof(perintah), "DELETE %d", id[korban]);
+        salah += !uji_padat_perintah(perintah);
+        hidup[korban] = 0;
+    }
+    salah += !uji_padat_perintah("SAVE"); // snapshot lewat utas penulis; tutup_data menunggu sampai selesai
+    tutup_data(); muat_data();
+    salah += uji_padat_periksa(id, hidup, stok, jumlah, "Snapshot setelah pemadatan");
+
+    stok[jumlah - 1] = 7;
+    snprintf(perintah, sizeof(perintah), "UPDATE %d STOK 7", id[jumlah - 1]);
+    salah += !uji_padat_perintah(perintah);
+    salah += !simpan_data();
+    tutup_data(); muat_data();
+    salah += uji_padat_periksa(id, hidup, stok, jumlah, "Snapshot sebagian setelah pemadatan");
+    tutup_data();
+
+    fclose(keluaran_batch); keluaran_batch = NULL;
+    remove(NAMA_FILE); remove(NAMA_FILE_SEMENTARA); remove(NAMA_FILE_UBAH); remove(NAMA_FILE_JURNAL); remove(NAMA_FILE_JURNAL_LAMA);
+    if (chdir("/") != 0 || rmdir(direktori) != 0) fprintf(stderr, "⚠️ Direktori uji %s tidak bisa dihapus.\n", direktori);
+    printf(salah > 0 ? "❌ Uji pemadatan gagal.\n" : "✅ Uji pemadatan berhasil: katalog di disk selalu utuh.\n");
+    return salah > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
+
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        return mode_batch(argc > 2 ? argv[2] : NULL);
+    }
+    if (argc > 1 && (strcmp(argv[1], "--server") == 0 || strcmp(argv[1], "--klien-beban") == 0)) {
+#if PAKAI_EPOLL
+        if (strcmp(argv[1], "--server") == 0) {
+            if (argc > 3 && atoi(argv[3]) >= 0) jendela_komit_ms = atoi(argv[3]);
+            return mode_server(argc > 2 ? argv[2] : NAMA_SOKET);
+        }
+        int koneksi = argc > 2 ? atoi(argv[2]) : 4;
+        int perintah = argc > 3 ? atoi(argv[3]) : 100000;
+        int kedalaman = argc > 4 ? atoi(argv[4]) : 32;
+        return klien_beban(koneksi > 0 ? koneksi : 4, perintah > 0 ? perintah : 100000, kedalaman > 0 ? kedalaman : 32,
+                           argc > 5 ? argv[5] : NAMA_SOKET);
+#else
+        fprintf(stderr, "Mode server membutuhkan epoll dan soket Unix (Linux) dan tidak tersedia di platform ini.\n");
+        return EXIT_FAILURE;
+#endif
+    }
+    if (argc > 1 && strcmp(argv[1], "--uji-beli") == 0) {
+#if PAKAI_MMAP
+        int jumlah_utas = argc > 2 ? atoi(argv[2]) : 8;
+        return uji_beli_serentak(jumlah_utas > 0 ? jumlah_utas : 8);
+#else
+        fprintf(stderr, "Uji beli serentak membutuhkan pthread dan tidak tersedia di platform ini.\n");
+        return EXIT_FAILURE;
+#endif
+    }
+
+    if (argc > 1 && strcmp(argv[1], "--uji-padat") == 0) {
+#if PAKAI_MMAP
+        return uji_padat();
+#else
+        fprintf(stderr, "Uji pemadatan membutuhkan direktori sementara POSIX dan tidak tersedia di platform ini.\n");
+        return EXIT_FAILURE;
+#endif
+    }
+    if (argc > 1 && strcmp(argv[1], "--uji-cari") == 0) {
+        int jumlah = argc > 2 ? atoi(argv[2]) : 200000;
+        int ulang = argc > 3 ? atoi(argv[3]) : 5;
+        return uji_cari(jumlah > 0 ? jumlah : 200000, ulang > 0 ? ulang : 5);
+    }
+
     muat_data();
     update_otomatis_kadaluarsa(); 
 
@@ -589,6 +4101,7 @@ int main() {
             continue;
         }
         bersihkan_buffer();
+        periksa_kadaluarsa_berkala();
 
         switch (pilihan_mode) {
             case 1:
@@ -608,7 +4121,7 @@ int main() {
         }
     }
 
-    if (daftar_tiket != NULL) { free(daftar_tiket); }
+    tutup_data();
 
     return 0;
 }
\ No newline at end of file
@@ -1,13 +1,50 @@
+// Deklarasi POSIX (fdopen, fileno) juga saat dikompilasi -std=c11
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <limits.h>
+#include <stdint.h>
+#ifdef _WIN32
+#include <io.h> // dup, dup2
+#define PAKAI_PENULIS 0 // tanpa pthread: simpan ditulis langsung
+#else
+#include <unistd.h> // dup, dup2, fsync
+#include <fcntl.h> // open, untuk fsync direktori
+#include <pthread.h>
+#define PAKAI_PENULIS 1 // simpan ditulis oleh utas penulis di latar belakang
+#endif
+// Pencocok substring SIMD (SSE2/AVX2) dipilih saat runtime; selain x86 + GCC/Clang hanya versi skalar
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PAKAI_SIMD_X86 1
+#else
+#define PAKAI_SIMD_X86 0
+#endif
 
 // --- KONFIGURASI ---
 #define NAMA_FILE "data_tiket.txt"
+#define NAMA_FILE_SEMENTARA "data_tiket.txt.tmp" // ditulis penuh dulu, baru di-rename ke NAMA_FILE
+#define NAMA_FILE_ID "data_tiket.id" // menyimpan urutan ID berikutnya
+#define NAMA_FILE_ID_SEMENTARA "data_tiket.id.tmp"
 #define MAX_NAMA 50
 #define MAX_KATEGORI 20
 #define KADALUARSA_DETIK (7 * 24 * 60 * 60) // 7 hari dalam detik
+#define KAPASITAS_AWAL 16 // kapasitas minimum array tiket
+#define ID_NISAN 0 // id slot tiket yang sudah dihapus (ID asli selalu mulai dari 1)
+#define RASIO_NISAN 4 // padatkan array bila lebih dari 1/RASIO_NISAN slot berisi nisan
+#define UKURAN_BLOK_BACA (1 << 16) // file data dibaca per blok 64 KB; satu baris tidak boleh lebih panjang
+#define MAKS_LAPORAN_BARIS 10 // baris rusak yang dilaporkan satu per satu saat muat data
+#define MAKS_BARIS_BATCH 512 // panjang maksimum satu baris perintah mode batch
+
+// Hasil beli_stok
+#define BELI_BERHASIL 0
+#define BELI_TIDAK_DITEMUKAN 1
+#define BELI_STOK_KURANG 2
+#define BELI_JUMLAH_TIDAK_VALID 3
 
 // --- STRUKTUR DATA TIKET ---
 typedef struct {
@@ -21,13 +58,168 @@ typedef struct {
 
 // --- GLOBAL VARIABLES (untuk manajemen memori) ---
 Tiket *daftar_tiket = NULL;
-int jumlah_tiket = 0;
+int jumlah_tiket = 0; // jumlah slot terpakai, termasuk nisan
+int jumlah_nisan = 0; // slot yang ditandai terhapus dan menunggu pemadatan
+int kapasitas_tiket = 0; // jumlah tiket yang muat di daftar_tiket (>= jumlah_tiket)
+int id_berikutnya = 1; // urutan ID, tidak pernah mundur walau tiket dihapus
+
+// Indeks hash (open addressing) dari ID tiket ke posisinya di daftar_tiket
+typedef struct {
+    int id;
+    int posisi; // -1 jika slot kosong
+} SlotIndeks;
+SlotIndeks *indeks_id = NULL;
+int kapasitas_indeks = 0; // selalu pangkat dua, minimal dua kali jumlah tiket
+
+// Indeks kadaluarsa: min-heap (waktu kadaluarsa, id). Entri milik tiket yang sudah
+// dihapus dibiarkan basi dan baru dibuang ketika sampai di puncak heap.
+typedef struct {
+    time_t waktu; // waktu_dibuat + KADALUARSA_DETIK
+    int id;
+} EntriKadaluarsa;
+EntriKadaluarsa *heap_kadaluarsa = NULL;
+int ukuran_heap = 0;
+int kapasitas_heap = 0;
+
+// Salinan casefold (huruf kecil ASCII) dari nama dan kode kategori, sejajar dengan daftar_tiket
+// (teks_lipat[i] milik daftar_tiket[i]); pencarian membandingkan langsung ke sini
+typedef struct {
+    char nama[MAX_NAMA];
+    unsigned char panjang_nama; // strlen(nama), agar pencocok tidak mencari '\0'
+    unsigned char kode_kategori; // indeks kamus_kategori
+} TeksLipat;
+TeksLipat *teks_lipat = NULL;
+int kapasitas_lipat = 0;
+
+// Kolom panas (structure-of-arrays): id, harga, stok dan waktu_dibuat disalin ke array per kolom,
+// sejajar dengan daftar_tiket (kolom_x[i] milik daftar_tiket[i]). Indeks ID, heap kadaluarsa dan
+// sorting cukup membaca 4-8 byte per tiket, bukan seluruh Tiket beserta teksnya. daftar_tiket tetap
+// sumber kebenaran; perubahan harga/stok harus lewat atur_harga/atur_stok agar kolomnya ikut.
+int *kolom_id = NULL; // ID_NISAN untuk slot yang dihapus
+float *kolom_harga = NULL;
+int *kolom_stok = NULL;
+time_t *kolom_waktu = NULL;
+int kapasitas_kolom = 0;
+
+// Indeks urutan: posisi tiket terurut menurut (harga, id) dan (nama, id), dirawat setiap tiket
+// ditambah, diubah atau dihapus. Sorting hanya memilih indeks yang dijalani daftar; Tiket tidak dipindah.
+typedef struct {
+    int *isi;           // posisi tiket; -1 = lubang (tiket dihapus atau kuncinya berubah)
+    int jumlah;         // entri terpakai, termasuk lubang
+    int terurut;        // isi[0..terurut) sudah urut, sisanya ekor tiket baru/berubah
+    int lubang;
+    int kapasitas;
+    int *letak;         // letak[posisi] = indeks entri tiket itu di isi, -1 jika tidak ada
+    int kapasitas_letak;
+    int (*banding)(const void *a, const void *b); // membandingkan dua posisi (int *)
+    uint64_t (*kunci)(int posisi, int kedalaman); // kunci radix yang urutannya sama dengan `banding`
+    int kunci_awalan;   // 1 = kunci hanya 8 byte nama mulai byte ke-8*kedalaman, seri dipecah lagi
+} IndeksUrut;
+int banding_urut_harga(const void *a, const void *b);
+int banding_urut_nama(const void *a, const void *b);
+uint64_t kunci_urut_harga(int posisi, int kedalaman);
+uint64_t kunci_urut_nama(int posisi, int kedalaman);
+IndeksUrut urut_harga = { NULL, 0, 0, 0, 0, NULL, 0, banding_urut_harga, kunci_urut_harga, 0 };
+IndeksUrut urut_nama = { NULL, 0, 0, 0, 0, NULL, 0, banding_urut_nama, kunci_urut_nama, 1 };
+int urutan_tampilan = 0; // 0 = urutan simpan, 1 = harga termurah, 2 = harga termahal, 3 = nama A-Z
+
+// Kamus kategori: setiap kategori (casefold) di-intern menjadi kode kecil yang punya bitmap
+// slot daftar_tiket aktif berkategori itu. Kode 0 menampung kategori yang tidak muat lagi di kamus.
+#define MAX_KODE_KATEGORI 256
+#define SLOT_KAMUS_KATEGORI 512 // tabel hash nama -> kode, pangkat dua dan > 2 * MAX_KODE_KATEGORI
+typedef struct {
+    char nama[MAX_KATEGORI];
+    uint64_t *bitmap; // bit i menyala = daftar_tiket[i] aktif dan berkategori ini
+} EntriKategori;
+EntriKategori kamus_kategori[MAX_KODE_KATEGORI];
+int jumlah_kode_kategori = 1; // kode 0 selalu ada
+unsigned char slot_kamus_kategori[SLOT_KAMUS_KATEGORI]; // 0 = slot kosong
+int kata_bitmap_kategori = 0; // panjang setiap bitmap dalam uint64_t
+
+// Indeks trigram nama konser: setiap potongan 3 huruf (casefold) menunjuk ke posting list,
+// yaitu ID tiket (urut naik) yang namanya memuat potongan itu
+typedef struct {
+    unsigned int kode; // 3 byte casefold; 0 = slot tabel kosong
+    int jumlah;
+    int kapasitas;
+    int *id;
+} PostingTrigram;
+PostingTrigram *tabel_trigram = NULL;
+int kapasitas_trigram = 0; // selalu pangkat dua
+int jumlah_trigram = 0;
+int tiket_basi_trigram = 0; // tiket dihapus/diganti nama sejak indeks terakhir dibangun
 
 // --- PROTOTIPE FUNGSI ---
 void muat_data();
 void simpan_data();
+void simpan_data_latar();
+int tunggu_simpan();
+void hentikan_penulis();
+int cadangkan_kapasitas(int minimal);
+int susutkan_kapasitas();
 void tampilkan_tiket_detail(const Tiket *t);
 int buat_id_unik();
+int pesan_blok_id(int jumlah);
+void bangun_indeks_id();
+void indeks_tambah(int posisi);
+void indeks_hapus(int id);
+int cari_indeks_id(int id);
+int jumlah_tiket_aktif();
+void tandai_nisan(int posisi);
+void padatkan_tiket();
+void padatkan_jika_perlu();
+void bangun_kolom();
+void isi_kolom(int posisi);
+void kosongkan_kolom();
+void atur_harga(int posisi, float harga);
+void atur_stok(int posisi, int stok);
+void bangun_urutan(IndeksUrut *x);
+void kosongkan_urutan(IndeksUrut *x);
+void urutan_tambah(IndeksUrut *x, int posisi);
+void urutan_lepas(IndeksUrut *x, int posisi);
+void urutan_ubah(IndeksUrut *x, int posisi);
+void urutan_pindah(IndeksUrut *x, int dari, int ke);
+int siapkan_tampilan();
+int posisi_tampilan(int k);
+void urutkan_hasil_tampilan(int *posisi, int jumlah);
+int letak_kursor(int id);
+int letak_offset(int offset, int hanya_tersedia);
+int ambil_halaman(int mulai, int batas, int hanya_tersedia, int *posisi, int *kursor);
+int ambil_termurah(int k, int *posisi);
+int lanjut_halaman();
+void pohon_harga_tambah(float harga, int id);
+void pohon_harga_lepas(float harga, int id);
+void kosongkan_pohon_harga();
+int ambil_rentang_harga(float harga_min, float harga_max, int setelah, int hanya_tersedia, const char *kategori_lipat, int *posisi, int batas, int *kursor);
+int bandingkan_int(const void *a, const void *b);
+void bangun_heap_kadaluarsa();
+void kadaluarsa_tambah(int posisi);
+int ada_tiket_kadaluarsa(time_t sekarang);
+int ambil_tiket_kadaluarsa(time_t sekarang);
+void periksa_kadaluarsa_berkala();
+size_t lipat_teks(char *tujuan, const char *asal, size_t ukuran);
+void lipat_tiket(int posisi);
+void bangun_teks_lipat();
+int nama_memuat(int posisi, const char *keyword_lower, size_t panjang);
+int kode_kategori(const char *nama_lipat, int buat);
+void perbesar_bitmap_kategori(int kapasitas_slot);
+void kategori_pasang(int posisi);
+void kategori_lepas(int posisi);
+void bangun_bitmap_kategori();
+void kosongkan_kamus_kategori();
+int hitung_kategori(int kode);
+int tiket_berkategori(int posisi, int kode, const char *kriteria_lipat);
+void bangun_indeks_trigram();
+void trigram_tambah(int id, const char *nama, int urut);
+void trigram_catat_basi();
+int cari_posisi_nama(const char *keyword_lower, int **posisi);
+void ganti_nama_tiket(int posisi, const char *nama);
+int masukkan_tiket(const Tiket *t);
+int hapus_tiket_id(int id);
+void urutkan_tiket(int kriteria);
+int beli_stok(int id, int jumlah, int *stok_sesudah);
+int cari_posisi_keyword(const char *keyword, int **posisi);
+int mode_batch(const char *nama_file);
 
 // CRUD & Utility
 void tambah_tiket();
@@ -36,114 +228,2560 @@ void cari_tiket();
 void update_tiket();
 void hapus_tiket();
 void sorting_tiket();
+void cari_rentang_harga();
 void update_otomatis_kadaluarsa();
 
-// --- FUNGSI UTILITY ---
+// --- FUNGSI UTILITY ---
+
+// --- PENYUSUN TAMPILAN ---
+// Banyak tiket disusun ke satu buffer besar lalu ditulis dengan satu fwrite, bukan tujuh printf per
+// tiket. Angka dan harga diformat sendiri (hasilnya sama persis dengan %d dan %.2f), dan teks waktu
+// disimpan per detik karena banyak tiket dibuat pada detik yang sama. Isi buffer harus disiram
+// sebelum printf/fprintf lain ke aliran yang sama.
+#define UKURAN_BUFFER_TAMPIL (64 * 1024)
+#define SLOT_CACHE_WAKTU 64
+
+char buffer_tampil[UKURAN_BUFFER_TAMPIL];
+size_t isi_tampil = 0;
+FILE *tujuan_tampil = NULL;
+
+typedef struct {
+    time_t detik;
+    int panjang; // 0 = slot kosong
+    char teks[40];
+} CacheWaktu;
+CacheWaktu cache_waktu[SLOT_CACHE_WAKTU];
+
+void tampil_siram() {
+    if (isi_tampil > 0 && tujuan_tampil != NULL) {
+        fwrite(buffer_tampil, 1, isi_tampil, tujuan_tampil);
+    }
+    isi_tampil = 0;
+}
+
+// Memilih aliran tujuan; isi milik aliran sebelumnya disiram dulu
+void tampil_ke(FILE *tujuan) {
+    if (tujuan != tujuan_tampil) {
+        tampil_siram();
+        tujuan_tampil = tujuan;
+    }
+}
+
+void tampil_teks(const char *teks, size_t panjang) {
+    if (isi_tampil + panjang > UKURAN_BUFFER_TAMPIL) {
+        tampil_siram();
+    }
+    if (panjang > UKURAN_BUFFER_TAMPIL) {
+        fwrite(teks, 1, panjang, tujuan_tampil);
+        return;
+    }
+    memcpy(buffer_tampil + isi_tampil, teks, panjang);
+    isi_tampil += panjang;
+}
+
+void tampil_str(const char *teks) {
+    tampil_teks(teks, strlen(teks));
+}
+
+// Sama dengan "%lld"; mengembalikan panjang teks (tanpa NUL) di `tujuan` (muat 24 byte)
+int format_int(char *tujuan, long long nilai) {
+    char balik[24];
+    int n = 0;
+    int panjang = 0;
+    unsigned long long u = nilai < 0 ? 0ULL - (unsigned long long)nilai : (unsigned long long)nilai;
+    do {
+        balik[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+    if (nilai < 0) {
+        tujuan[panjang++] = '-';
+    }
+    while (n > 0) {
+        tujuan[panjang++] = balik[--n];
+    }
+    return panjang;
+}
+
+// Sama dengan "%.2f" untuk float (muat 64 byte). float * 100 selalu eksak di double (24 + 7 bit),
+// jadi pembulatan ke sen cukup half-even seperti printf; NaN/inf/nilai raksasa diserahkan ke snprintf.
+int format_harga(char *tujuan, float harga) {
+    double sen = (double)harga * 100.0;
+    if (!(sen > -1e17 && sen < 1e17)) {
+        return snprintf(tujuan, 64, "%.2f", harga);
+    }
+    uint32_t bit;
+    memcpy(&bit, &harga, sizeof(bit));
+    if (sen < 0) {
+        sen = -sen;
+    }
+    unsigned long long bulat = (unsigned long long)sen;
+    double sisa = sen - (double)bulat;
+    if (sisa > 0.5 || (sisa == 0.5 && (bulat & 1))) {
+        bulat++;
+    }
+    int panjang = 0;
+    if (bit & 0x80000000u) {
+        tujuan[panjang++] = '-'; // -0.0 dan -0.001 pun tercetak "-0.00" oleh printf
+    }
+    panjang += format_int(tujuan + panjang, (long long)(bulat / 100));
+    tujuan[panjang++] = '.';
+    tujuan[panjang++] = (char)('0' + bulat % 100 / 10);
+    tujuan[panjang++] = (char)('0' + bulat % 10);
+    return panjang;
+}
+
+void tampil_int(long long nilai) {
+    char teks[24];
+    tampil_teks(teks, format_int(teks, nilai));
+}
+
+void tampil_harga(float harga) {
+    char teks[64];
+    tampil_teks(teks, format_harga(teks, harga));
+}
+
+// "%Y-%m-%d %H:%M:%S"; localtime + strftime hanya saat detik itu belum ada di cache
+void tampil_waktu(time_t waktu) {
+    CacheWaktu *c = &cache_waktu[(unsigned long long)waktu % SLOT_CACHE_WAKTU];
+    if (c->panjang == 0 || c->detik != waktu) {
+        struct tm *info_waktu = localtime(&waktu);
+        c->detik = waktu;
+        c->panjang = info_waktu != NULL ? (int)strftime(c->teks, sizeof(c->teks), "%Y-%m-%d %H:%M:%S", info_waktu) : 0;
+    }
+    tampil_teks(c->teks, c->panjang);
+}
+
+// Detail satu tiket ke buffer; pemanggil menyiram setelah satu atau banyak tiket
+void susun_tiket_detail(const Tiket *t) {
+    tampil_ke(stdout);
+    tampil_str("---------------------------------\n  ID Tiket    : ");
+    tampil_int(t->id);
+    tampil_str("\n  Nama Konser : ");
+    tampil_str(t->nama_konser);
+    tampil_str("\n  Kategori    : ");
+    tampil_str(t->kategori);
+    tampil_str("\n  Harga       : Rp ");
+    tampil_harga(t->harga);
+    tampil_str("\n  Jumlah      : ");
+    tampil_int(t->jumlah_stok);
+    tampil_str("\n  Tgl Dibuat  : ");
+    tampil_waktu(t->waktu_dibuat);
+    tampil_str("\n");
+}
+
+// Menampilkan detail satu tiket
+void tampilkan_tiket_detail(const Tiket *t) {
+    susun_tiket_detail(t);
+    tampil_siram();
+}
+
+// Memesan `jumlah` ID berurutan sekaligus (O(1)), mengembalikan ID pertama.
+// ID tiket yang sudah dihapus tidak pernah dipakai ulang.
+int pesan_blok_id(int jumlah) {
+    int id_awal = id_berikutnya;
+    id_berikutnya += jumlah;
+    return id_awal;
+}
+
+// ID unik baru dari urutan ID
+int buat_id_unik() {
+    return pesan_blok_id(1);
+}
+
+// --- KAPASITAS ARRAY TIKET ---
+
+// Mengubah kapasitas daftar_tiket menjadi tepat `kapasitas` tiket
+int ubah_kapasitas(int kapasitas) {
+    Tiket *temp = (Tiket *)realloc(daftar_tiket, kapasitas * sizeof(Tiket));
+    if (temp == NULL) {
+        return 0;
+    }
+    daftar_tiket = temp;
+    kapasitas_tiket = kapasitas;
+    return 1;
+}
+
+// Memastikan daftar_tiket muat minimal `minimal` tiket. Kapasitas tumbuh dua kali lipat
+// sehingga tambah satu per satu tetap O(1) teramortisasi; muat data memesan tempat sekaligus.
+int cadangkan_kapasitas(int minimal) {
+    if (minimal <= kapasitas_tiket) {
+        return 1;
+    }
+    int baru = kapasitas_tiket < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_tiket;
+    while (baru < minimal) {
+        baru *= 2;
+    }
+    return ubah_kapasitas(baru);
+}
+
+// Memperkecil array setelah hapus, hanya jika terisi <= 1/4 dan tetap menyisakan ruang
+// dua kali lipat (histeresis) agar hapus/tambah bergantian tidak realokasi terus-menerus
+int susutkan_kapasitas() {
+    if (kapasitas_tiket <= KAPASITAS_AWAL || jumlah_tiket > kapasitas_tiket / 4) {
+        return 1;
+    }
+    int baru = kapasitas_tiket / 2;
+    while (baru / 2 >= KAPASITAS_AWAL && jumlah_tiket <= baru / 4) {
+        baru /= 2;
+    }
+    if (baru < KAPASITAS_AWAL) {
+        baru = KAPASITAS_AWAL;
+    }
+    return ubah_kapasitas(baru);
+}
+
+// --- INDEKS HASH ID ---
+
+// Fungsi hash untuk ID tiket (mencampur bit agar ID berurutan tersebar rata)
+unsigned int hash_id(int id) {
+    unsigned int x = (unsigned int)id;
+    x ^= x >> 16;
+    x *= 0x45d9f3bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Memasang pasangan id -> posisi ke tabel indeks (linear probing)
+void indeks_pasang(int id, int posisi) {
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0 && indeks_id[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    indeks_id[i].id = id;
+    indeks_id[i].posisi = posisi;
+}
+
+// Membangun ulang seluruh indeks (O(n)), dipakai setelah muat data dan pemadatan.
+// Nisan tidak dimasukkan ke indeks dan sekaligus dihitung ulang di sini.
+void bangun_indeks_id() {
+    int kapasitas = 16;
+    while (kapasitas < jumlah_tiket * 2) {
+        kapasitas *= 2;
+    }
+    if (kapasitas != kapasitas_indeks) {
+        SlotIndeks *baru = (SlotIndeks *)realloc(indeks_id, kapasitas * sizeof(SlotIndeks));
+        if (baru == NULL) {
+            perror("Error alokasi indeks");
+            exit(EXIT_FAILURE);
+        }
+        indeks_id = baru;
+        kapasitas_indeks = kapasitas;
+    }
+
+    for (int i = 0; i < kapasitas_indeks; i++) {
+        indeks_id[i].posisi = -1;
+    }
+    jumlah_nisan = 0;
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) {
+            jumlah_nisan++;
+        } else {
+            indeks_pasang(kolom_id[i], i);
+        }
+    }
+}
+
+// Mendaftarkan tiket baru di `posisi` (jumlah_tiket sudah termasuk tiket ini)
+void indeks_tambah(int posisi) {
+    if (jumlah_tiket * 2 > kapasitas_indeks) {
+        bangun_indeks_id();
+    } else {
+        indeks_pasang(daftar_tiket[posisi].id, posisi);
+    }
+}
+
+// Mengeluarkan `id` dari indeks. Slot sesudahnya digeser mundur (backward shift)
+// agar rantai linear probing tetap utuh tanpa penanda hapus di tabel indeks.
+void indeks_hapus(int id) {
+    if (kapasitas_indeks == 0) {
+        return;
+    }
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0 && indeks_id[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    if (indeks_id[i].posisi < 0) {
+        return;
+    }
+    for (unsigned int j = (i + 1) & mask; indeks_id[j].posisi >= 0; j = (j + 1) & mask) {
+        unsigned int asal = hash_id(indeks_id[j].id) & mask;
+        // Slot j boleh mengisi lubang i hanya jika posisi asalnya tidak berada di antara i (eksklusif) dan j
+        if (((j - asal) & mask) >= ((j - i) & mask)) {
+            indeks_id[i] = indeks_id[j];
+            i = j;
+        }
+    }
+    indeks_id[i].posisi = -1;
+}
+
+// Mencari posisi tiket berdasarkan ID, -1 jika tidak ditemukan
+int cari_indeks_id(int id) {
+    if (kapasitas_indeks == 0) {
+        return -1;
+    }
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0) {
+        if (indeks_id[i].id == id) {
+            return indeks_id[i].posisi;
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// --- PENGHAPUSAN DENGAN NISAN ---
+
+// Jumlah tiket yang masih berlaku (slot terpakai dikurangi nisan)
+int jumlah_tiket_aktif() {
+    return jumlah_tiket - jumlah_nisan;
+}
+
+// Hapus tiket di `posisi` dalam O(1): cukup ditandai nisan, tiket lain tidak digeser
+void tandai_nisan(int posisi) {
+    pohon_harga_lepas(kolom_harga[posisi], kolom_id[posisi]);
+    indeks_hapus(daftar_tiket[posisi].id);
+    kategori_lepas(posisi);
+    urutan_lepas(&urut_harga, posisi);
+    urutan_lepas(&urut_nama, posisi);
+    daftar_tiket[posisi].id = ID_NISAN;
+    kolom_id[posisi] = ID_NISAN;
+    jumlah_nisan++;
+    trigram_catat_basi();
+}
+
+// Buang semua nisan dalam satu sapuan linear, lalu bangun ulang indeks
+void padatkan_tiket() {
+    if (jumlah_nisan == 0) {
+        return;
+    }
+    int tujuan = 0;
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) {
+            continue;
+        }
+        if (tujuan != i) {
+            daftar_tiket[tujuan] = daftar_tiket[i];
+            teks_lipat[tujuan] = teks_lipat[i];
+            kolom_id[tujuan] = kolom_id[i];
+            kolom_harga[tujuan] = kolom_harga[i];
+            kolom_stok[tujuan] = kolom_stok[i];
+            kolom_waktu[tujuan] = kolom_waktu[i];
+            urutan_pindah(&urut_harga, i, tujuan);
+            urutan_pindah(&urut_nama, i, tujuan);
+        }
+        tujuan++;
+    }
+    jumlah_tiket = tujuan;
+    bangun_indeks_id(); // sekaligus mengembalikan jumlah_nisan ke 0
+    bangun_bitmap_kategori(); // posisi tiket bergeser
+
+    // Perkecil array bila sudah jauh lebih besar dari isinya
+    if (!susutkan_kapasitas()) {
+        perror("Error re-alokasi memori setelah pemadatan");
+    }
+}
+
+// Padatkan hanya jika nisan sudah melebihi 1/RASIO_NISAN dari slot terpakai
+void padatkan_jika_perlu() {
+    if (jumlah_nisan * RASIO_NISAN > jumlah_tiket) {
+        padatkan_tiket();
+    }
+}
+
+// --- KOLOM PANAS (STRUCTURE-OF-ARRAYS) ---
+
+// Memastikan keempat kolom muat minimal `minimal` tiket (tumbuh dua kali lipat)
+void cadangkan_kolom(int minimal) {
+    if (minimal <= kapasitas_kolom) {
+        return;
+    }
+    int kapasitas = kapasitas_kolom < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_kolom;
+    while (kapasitas < minimal) {
+        kapasitas *= 2;
+    }
+    int *id = (int *)realloc(kolom_id, kapasitas * sizeof(int));
+    if (id != NULL) {
+        kolom_id = id;
+    }
+    float *harga = (float *)realloc(kolom_harga, kapasitas * sizeof(float));
+    if (harga != NULL) {
+        kolom_harga = harga;
+    }
+    int *stok = (int *)realloc(kolom_stok, kapasitas * sizeof(int));
+    if (stok != NULL) {
+        kolom_stok = stok;
+    }
+    time_t *waktu = (time_t *)realloc(kolom_waktu, kapasitas * sizeof(time_t));
+    if (waktu != NULL) {
+        kolom_waktu = waktu;
+    }
+    if (id == NULL || harga == NULL || stok == NULL || waktu == NULL) {
+        perror("Error alokasi kolom tiket");
+        exit(EXIT_FAILURE);
+    }
+    kapasitas_kolom = kapasitas;
+}
+
+// Salin field numerik daftar_tiket[posisi] ke kolomnya
+void isi_kolom(int posisi) {
+    cadangkan_kolom(posisi + 1);
+    kolom_id[posisi] = daftar_tiket[posisi].id;
+    kolom_harga[posisi] = daftar_tiket[posisi].harga;
+    kolom_stok[posisi] = daftar_tiket[posisi].jumlah_stok;
+    kolom_waktu[posisi] = daftar_tiket[posisi].waktu_dibuat;
+}
+
+// Bangun ulang semua kolom dari daftar_tiket (setelah muat data)
+void bangun_kolom() {
+    cadangkan_kolom(jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) {
+        isi_kolom(i);
+    }
+}
+
+void kosongkan_kolom() {
+    free(kolom_id);
+    free(kolom_harga);
+    free(kolom_stok);
+    free(kolom_waktu);
+    kolom_id = NULL;
+    kolom_harga = NULL;
+    kolom_stok = NULL;
+    kolom_waktu = NULL;
+    kapasitas_kolom = 0;
+}
+
+void atur_harga(int posisi, float harga) {
+    daftar_tiket[posisi].harga = harga;
+    if (kolom_harga[posisi] != harga) {
+        pohon_harga_lepas(kolom_harga[posisi], kolom_id[posisi]);
+        pohon_harga_tambah(harga, kolom_id[posisi]);
+        kolom_harga[posisi] = harga;
+        urutan_ubah(&urut_harga, posisi);
+    }
+}
+
+void atur_stok(int posisi, int stok) {
+    daftar_tiket[posisi].jumlah_stok = stok;
+    kolom_stok[posisi] = stok;
+}
+
+// --- INDEKS URUTAN (HARGA & NAMA) ---
+// Tiket baru/berubah cukup masuk ekor (O(1)) dan entri lamanya dijadikan lubang lewat `letak` (O(1)).
+// Saat urutan dibutuhkan, hanya ekor yang di-qsort lalu digabung dengan bagian yang sudah urut dalam
+// satu sapuan linear: O(n + m log m) untuk m perubahan, dan tanpa kerja sama sekali bila tidak ada.
+
+int banding_urut_harga(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    if (kolom_harga[x] != kolom_harga[y]) {
+        return kolom_harga[x] < kolom_harga[y] ? -1 : 1;
+    }
+    return (kolom_id[x] > kolom_id[y]) - (kolom_id[x] < kolom_id[y]);
+}
+
+int banding_urut_nama(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    int hasil = strcmp(daftar_tiket[x].nama_konser, daftar_tiket[y].nama_konser);
+    if (hasil != 0) {
+        return hasil;
+    }
+    return (kolom_id[x] > kolom_id[y]) - (kolom_id[x] < kolom_id[y]);
+}
+
+// --- RADIX SORT KUNCI URUTAN ---
+// Untuk pengurutan penuh (indeks baru dibangun saat muat, ekor yang besar) qsort memanggil pembanding
+// lewat pointer fungsi di setiap perbandingan. Di sini setiap tiket diwakili pasangan 16 byte
+// (kunci, id, posisi) yang diurutkan LSD 8 bit per lintasan, lalu posisinya disalin sekali ke indeks.
+// Pada data besar setiap lintasan (isi kunci, hitung ember, sebar) dibagi ke beberapa utas.
+#define AMBANG_RADIX 2048          // di bawah ini qsort lebih murah dari 256 ember per lintasan
+#define AMBANG_RADIX_PARALEL 65536 // di bawah ini membuat utas lebih mahal dari sortingnya
+#define MAKS_UTAS_SORTIR 8
+
+typedef struct {
+    uint64_t kunci;
+    uint32_t id;    // id dengan bit tanda dibalik; 0 jika id sudah tercakup di kunci
+    int posisi;
+} KunciUrut;
+
+typedef struct {
+    KunciUrut *sumber, *tujuan;
+    const int *isi;       // tahap 0: posisi yang diurutkan
+    const IndeksUrut *indeks;
+    int awal, akhir;      // potongan milik utas ini
+    int lintasan, tahap;  // tahap 0 = isi kunci, 1 = hitung ember, 2 = sebar
+    int hitungan[256];    // hasil tahap 1, lalu offset tulis untuk tahap 2
+} TugasRadix;
+
+// Kunci lengkap harga: bit float diatur agar urutan bilangan = urutan bit, id di 32 bit bawah
+uint64_t kunci_urut_harga(int posisi, int kedalaman) {
+    (void)kedalaman;
+    float harga = kolom_harga[posisi];
+    if (harga == 0.0f) {
+        harga = 0.0f; // -0.0 sama dengan 0.0 bagi pembanding
+    }
+    uint32_t bit;
+    memcpy(&bit, &harga, sizeof(bit));
+    bit = (bit & 0x80000000u) ? ~bit : bit | 0x80000000u;
+    return ((uint64_t)bit << 32) | ((uint32_t)kolom_id[posisi] ^ 0x80000000u);
+}
+
+// Kunci awalan nama: byte ke-8*kedalaman..+7 big-endian (sesudah akhir nama diisi 0), urutannya = strcmp
+uint64_t kunci_urut_nama(int posisi, int kedalaman) {
+    const unsigned char *nama = (const unsigned char *)daftar_tiket[posisi].nama_konser;
+    uint64_t kunci = 0;
+    int habis = 0;
+    for (int i = 8 * kedalaman; i < 8 * kedalaman + 8; i++) {
+        if (i >= MAX_NAMA || nama[i] == '\0') {
+            habis = 1;
+        }
+        kunci = (kunci << 8) | (habis ? 0 : nama[i]);
+    }
+    return kunci;
+}
+
+int banding_kunci_nama(const void *a, const void *b) {
+    return banding_urut_nama(&((const KunciUrut *)a)->posisi, &((const KunciUrut *)b)->posisi);
+}
+
+void kerjakan_radix(TugasRadix *t) {
+    int geser = 8 * (t->lintasan < 4 ? t->lintasan : t->lintasan - 4);
+    if (t->tahap == 0) {
+        for (int i = t->awal; i < t->akhir; i++) {
+            int posisi = t->isi[i];
+            t->sumber[i].kunci = t->indeks->kunci(posisi, 0);
+            t->sumber[i].id = t->indeks->kunci_awalan ? (uint32_t)kolom_id[posisi] ^ 0x80000000u : 0;
+            t->sumber[i].posisi = posisi;
+        }
+    } else if (t->tahap == 1) {
+        memset(t->hitungan, 0, sizeof(t->hitungan));
+        for (int i = t->awal; i < t->akhir; i++) {
+            uint64_t nilai = t->lintasan < 4 ? t->sumber[i].id : t->sumber[i].kunci;
+            t->hitungan[(nilai >> geser) & 0xFF]++;
+        }
+    } else {
+        for (int i = t->awal; i < t->akhir; i++) {
+            uint64_t nilai = t->lintasan < 4 ? t->sumber[i].id : t->sumber[i].kunci;
+            t->tujuan[t->hitungan[(nilai >> geser) & 0xFF]++] = t->sumber[i];
+        }
+    }
+}
+
+#if PAKAI_PENULIS
+void *jalankan_radix(void *arg) {
+    kerjakan_radix((TugasRadix *)arg);
+    return NULL;
+}
+#endif
+
+// Utas 0 dikerjakan pemanggil; potongan yang utasnya gagal dibuat juga dikerjakan di sini
+void jalankan_tahap_radix(TugasRadix *tugas, int jumlah_utas, int tahap) {
+    int dibuat[MAKS_UTAS_SORTIR] = { 0 };
+    for (int t = 0; t < jumlah_utas; t++) {
+        tugas[t].tahap = tahap;
+    }
+#if PAKAI_PENULIS
+    pthread_t utas[MAKS_UTAS_SORTIR];
+    for (int t = 1; t < jumlah_utas; t++) {
+        dibuat[t] = pthread_create(&utas[t], NULL, jalankan_radix, &tugas[t]) == 0;
+    }
+#endif
+    for (int t = 0; t < jumlah_utas; t++) {
+        if (!dibuat[t]) {
+            kerjakan_radix(&tugas[t]);
+        }
+    }
+#if PAKAI_PENULIS
+    for (int t = 1; t < jumlah_utas; t++) {
+        if (dibuat[t]) {
+            pthread_join(utas[t], NULL);
+        }
+    }
+#endif
+}
+
+// LSD stabil atas 4 byte id lalu 8 byte kunci; lintasan yang semuanya jatuh di satu ember dilewati.
+// Mengembalikan a atau b, mana yang berisi hasil.
+KunciUrut *radix_kunci(TugasRadix *tugas, int jumlah_utas, KunciUrut *a, KunciUrut *b, int n) {
+    for (int lintasan = 0; lintasan < 12; lintasan++) {
+        for (int t = 0; t < jumlah_utas; t++) {
+            tugas[t].sumber = a;
+            tugas[t].tujuan = b;
+            tugas[t].lintasan = lintasan;
+        }
+        jalankan_tahap_radix(tugas, jumlah_utas, 1);
+        int satu_ember = 0;
+        for (int d = 0; d < 256 && !satu_ember; d++) {
+            int isi_ember = 0;
+            for (int t = 0; t < jumlah_utas; t++) {
+                isi_ember += tugas[t].hitungan[d];
+            }
+            satu_ember = isi_ember == n;
+        }
+        if (satu_ember) {
+            continue;
+        }
+        // Offset tulis per (ember, utas): utas dengan potongan lebih awal menulis lebih dulu -> stabil
+        int total = 0;
+        for (int d = 0; d < 256; d++) {
+            for (int t = 0; t < jumlah_utas; t++) {
+                int c = tugas[t].hitungan[d];
+                tugas[t].hitungan[d] = total;
+                total += c;
+            }
+        }
+        jalankan_tahap_radix(tugas, jumlah_utas, 2);
+        KunciUrut *tukar = a;
+        a = b;
+        b = tukar;
+    }
+    return a;
+}
+
+// a[0..n) urut menurut nama sampai byte 8*(kedalaman+1) lalu id; kelompok berkunci sama yang namanya
+// belum habis dipecah dengan 8 byte berikutnya (kelompok kecil cukup di-qsort)
+void urutkan_kelompok_nama(KunciUrut *a, KunciUrut *bantu, int n, int kedalaman) {
+    for (int k = 0; k < n;) {
+        int j = k + 1;
+        while (j < n && a[j].kunci == a[k].kunci) {
+            j++;
+        }
+        if (j - k > 1 && (a[k].kunci & 0xFF) != 0) {
+            if (j - k < AMBANG_RADIX) {
+                qsort(a + k, j - k, sizeof(KunciUrut), banding_kunci_nama);
+            } else {
+                // Kelompok ini sudah urut id, jadi cukup lintasan kunci (id dinolkan agar dilewati)
+                for (int i = k; i < j; i++) {
+                    a[i].kunci = kunci_urut_nama(a[i].posisi, kedalaman + 1);
+                    a[i].id = 0;
+                }
+                TugasRadix tugas = { 0 };
+                tugas.akhir = j - k;
+                KunciUrut *hasil = radix_kunci(&tugas, 1, a + k, bantu + k, j - k);
+                if (hasil != a + k) {
+                    memcpy(a + k, hasil, (j - k) * sizeof(KunciUrut));
+                }
+                urutkan_kelompok_nama(a + k, bantu + k, j - k, kedalaman + 1);
+            }
+        }
+        k = j;
+    }
+}
+
+// Urutkan n posisi menurut indeks x; hasilnya sama persis dengan qsort(isi, n, sizeof(int), x->banding)
+void urutkan_posisi(IndeksUrut *x, int *isi, int n) {
+    if (n < AMBANG_RADIX) {
+        qsort(isi, n, sizeof(int), x->banding);
+        return;
+    }
+    KunciUrut *a = (KunciUrut *)malloc(n * sizeof(KunciUrut));
+    KunciUrut *b = (KunciUrut *)malloc(n * sizeof(KunciUrut));
+    if (a == NULL || b == NULL) {
+        perror("Gagal mengalokasikan kunci sorting");
+        exit(EXIT_FAILURE);
+    }
+    int jumlah_utas = 1;
+#if PAKAI_PENULIS
+    if (n >= AMBANG_RADIX_PARALEL) {
+        long cpu = sysconf(_SC_NPROCESSORS_ONLN);
+        jumlah_utas = cpu < 1 ? 1 : cpu > MAKS_UTAS_SORTIR ? MAKS_UTAS_SORTIR : (int)cpu;
+    }
+#endif
+    TugasRadix tugas[MAKS_UTAS_SORTIR] = { 0 };
+    for (int t = 0; t < jumlah_utas; t++) {
+        tugas[t].sumber = a;
+        tugas[t].isi = isi;
+        tugas[t].indeks = x;
+        tugas[t].awal = (int)((long)n * t / jumlah_utas);
+        tugas[t].akhir = (int)((long)n * (t + 1) / jumlah_utas);
+    }
+    jalankan_tahap_radix(tugas, jumlah_utas, 0);
+    KunciUrut *hasil = radix_kunci(tugas, jumlah_utas, a, b, n);
+    if (x->kunci_awalan) {
+        urutkan_kelompok_nama(hasil, hasil == a ? b : a, n, 0);
+    }
+    for (int i = 0; i < n; i++) {
+        isi[i] = hasil[i].posisi;
+    }
+    free(a);
+    free(b);
+}
+
+// Memastikan isi muat `minimal_isi` entri dan letak muat `minimal_letak` posisi
+void cadangkan_urutan(IndeksUrut *x, int minimal_isi, int minimal_letak) {
+    if (minimal_isi > x->kapasitas) {
+        int kapasitas = x->kapasitas < KAPASITAS_AWAL ? KAPASITAS_AWAL : x->kapasitas;
+        while (kapasitas < minimal_isi) {
+            kapasitas *= 2;
+        }
+        int *baru = (int *)realloc(x->isi, kapasitas * sizeof(int));
+        if (baru == NULL) {
+            perror("Error alokasi indeks urutan");
+            exit(EXIT_FAILURE);
+        }
+        x->isi = baru;
+        x->kapasitas = kapasitas;
+    }
+    if (minimal_letak > x->kapasitas_letak) {
+        int kapasitas = x->kapasitas_letak < KAPASITAS_AWAL ? KAPASITAS_AWAL : x->kapasitas_letak;
+        while (kapasitas < minimal_letak) {
+            kapasitas *= 2;
+        }
+        int *baru = (int *)realloc(x->letak, kapasitas * sizeof(int));
+        if (baru == NULL) {
+            perror("Error alokasi indeks urutan");
+            exit(EXIT_FAILURE);
+        }
+        x->letak = baru;
+        x->kapasitas_letak = kapasitas;
+    }
+}
+
+void urutan_tambah(IndeksUrut *x, int posisi) {
+    cadangkan_urutan(x, x->jumlah + 1, posisi + 1);
+    x->letak[posisi] = x->jumlah;
+    x->isi[x->jumlah++] = posisi;
+}
+
+void urutan_lepas(IndeksUrut *x, int posisi) {
+    int k = x->letak[posisi];
+    if (k < 0) {
+        return;
+    }
+    x->isi[k] = -1;
+    x->letak[posisi] = -1;
+    x->lubang++;
+}
+
+// Kunci tiket di `posisi` berubah: entrinya dipindah dari bagian urut ke ekor
+void urutan_ubah(IndeksUrut *x, int posisi) {
+    int k = x->letak[posisi];
+    if (k >= 0 && k < x->terurut) {
+        urutan_lepas(x, posisi);
+        urutan_tambah(x, posisi);
+    }
+}
+
+// Tiket pindah dari posisi `dari` ke `ke` saat pemadatan (ke <= dari); urutan entri tidak berubah
+void urutan_pindah(IndeksUrut *x, int dari, int ke) {
+    int k = x->letak[dari];
+    if (k >= 0) {
+        x->isi[k] = ke;
+    }
+    x->letak[ke] = k;
+}
+
+// Isi ulang dari semua tiket aktif; semuanya masuk ekor dan diurutkan saat pertama dibutuhkan
+void bangun_urutan(IndeksUrut *x) {
+    x->jumlah = 0;
+    x->terurut = 0;
+    x->lubang = 0;
+    cadangkan_urutan(x, jumlah_tiket, jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) {
+            x->letak[i] = -1;
+        } else {
+            urutan_tambah(x, i);
+        }
+    }
+}
+
+// Urutkan ekor lalu gabungkan dengan bagian yang sudah urut; sesudahnya tidak ada lubang
+void rapikan_urutan(IndeksUrut *x) {
+    if (x->terurut == x->jumlah && x->lubang == 0) {
+        return;
+    }
+    int awal_ekor = x->terurut;
+    int akhir_ekor = awal_ekor;
+    for (int k = awal_ekor; k < x->jumlah; k++) {
+        if (x->isi[k] >= 0) {
+            x->isi[akhir_ekor++] = x->isi[k];
+        }
+    }
+    urutkan_posisi(x, x->isi + awal_ekor, akhir_ekor - awal_ekor);
+
+    int *baru = (int *)malloc((x->kapasitas > 0 ? x->kapasitas : 1) * sizeof(int));
+    if (baru == NULL) {
+        perror("Error alokasi indeks urutan");
+        exit(EXIT_FAILURE);
+    }
+    int i = 0, j = awal_ekor, n = 0;
+    while (i < awal_ekor || j < akhir_ekor) {
+        if (i < awal_ekor && x->isi[i] < 0) {
+            i++;
+            continue;
+        }
+        int posisi;
+        if (j >= akhir_ekor || (i < awal_ekor && x->banding(&x->isi[i], &x->isi[j]) <= 0)) {
+            posisi = x->isi[i++];
+        } else {
+            posisi = x->isi[j++];
+        }
+        baru[n] = posisi;
+        x->letak[posisi] = n;
+        n++;
+    }
+    free(x->isi);
+    x->isi = baru;
+    x->jumlah = n;
+    x->terurut = n;
+    x->lubang = 0;
+}
+
+void kosongkan_urutan(IndeksUrut *x) {
+    free(x->isi);
+    free(x->letak);
+    x->isi = NULL;
+    x->letak = NULL;
+    x->jumlah = 0;
+    x->terurut = 0;
+    x->lubang = 0;
+    x->kapasitas = 0;
+    x->kapasitas_letak = 0;
+}
+
+IndeksUrut *indeks_tampilan() {
+    return urutan_tampilan == 3 ? &urut_nama : &urut_harga;
+}
+
+// Siapkan urutan tampilan aktif; mengembalikan banyaknya k yang dijalani posisi_tampilan(k)
+int siapkan_tampilan() {
+    if (urutan_tampilan == 0) {
+        return jumlah_tiket;
+    }
+    rapikan_urutan(indeks_tampilan());
+    return indeks_tampilan()->jumlah;
+}
+
+// Posisi tiket ke-k menurut urutan tampilan (sesudah siapkan_tampilan). Pada urutan simpan (0)
+// hasilnya bisa nisan; harga termahal adalah kebalikan persis harga termurah (seri: ID terbesar dulu).
+int posisi_tampilan(int k) {
+    switch (urutan_tampilan) {
+        case 1:
+        case 3:
+            return indeks_tampilan()->isi[k];
+        case 2:
+            return urut_harga.isi[urut_harga.jumlah - 1 - k];
+        default:
+            return k;
+    }
+}
+
+// Susun ulang posisi hasil pencarian (urut naik) mengikuti urutan tampilan, lewat letak di indeksnya
+void urutkan_hasil_tampilan(int *posisi, int jumlah) {
+    if (urutan_tampilan == 0 || jumlah < 2) {
+        return;
+    }
+    siapkan_tampilan();
+    IndeksUrut *x = indeks_tampilan();
+    for (int k = 0; k < jumlah; k++) {
+        posisi[k] = x->letak[posisi[k]];
+    }
+    qsort(posisi, jumlah, sizeof(int), bandingkan_int);
+    for (int k = 0; urutan_tampilan == 2 && k < jumlah / 2; k++) {
+        int sementara = posisi[k];
+        posisi[k] = posisi[jumlah - 1 - k];
+        posisi[jumlah - 1 - k] = sementara;
+    }
+    for (int k = 0; k < jumlah; k++) {
+        posisi[k] = x->isi[posisi[k]];
+    }
+}
+
+// --- HALAMAN & TOP-K ---
+// Daftar dibaca per halaman menurut urutan tampilan. Kursor halaman = ID tiket terakhir di halaman
+// sebelumnya; letaknya di urutan didapat lewat indeks ID dan `letak`, jadi halaman berikutnya cukup
+// O(halaman) walau katalog berubah di antaranya. Tiket termurah dicari dengan max-heap berukuran k.
+#define UKURAN_HALAMAN 10 // tiket per halaman di menu interaktif
+
+int tiket_lolos(int posisi, int hanya_tersedia) {
+    return kolom_id[posisi] != ID_NISAN && (!hanya_tersedia || kolom_stok[posisi] > 0);
+}
+
+// Letak (k untuk posisi_tampilan) tepat sesudah tiket `id`; -1 jika tiket sudah tidak ada
+int letak_kursor(int id) {
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) {
+        return -1;
+    }
+    siapkan_tampilan();
+    switch (urutan_tampilan) {
+        case 1:
+        case 3:
+            return indeks_tampilan()->letak[posisi] + 1;
+        case 2:
+            return urut_harga.jumlah - urut_harga.letak[posisi]; // kebalikan: k = jumlah - 1 - letak
+        default:
+            return posisi + 1;
+    }
+}
+
+// Letak tiket lolos ke-`offset` (mulai 0); tanpa saringan stok dan tanpa nisan di urutan langsung O(1)
+int letak_offset(int offset, int hanya_tersedia) {
+    int n = siapkan_tampilan();
+    if (!hanya_tersedia && (urutan_tampilan != 0 || jumlah_nisan == 0)) {
+        return offset < n ? offset : n;
+    }
+    for (int k = 0; k < n; k++) {
+        if (tiket_lolos(posisi_tampilan(k), hanya_tersedia) && offset-- == 0) {
+            return k;
+        }
+    }
+    return n;
+}
+
+// Isi `posisi` dengan paling banyak `batas` tiket lolos mulai letak `mulai`. *kursor = ID tiket
+// terakhir bila halaman penuh (mungkin masih ada lanjutan), 0 bila daftar sudah habis.
+int ambil_halaman(int mulai, int batas, int hanya_tersedia, int *posisi, int *kursor) {
+    int n = siapkan_tampilan();
+    int jumlah = 0;
+    for (int k = mulai; k < n && jumlah < batas; k++) {
+        int i = posisi_tampilan(k);
+        if (tiket_lolos(i, hanya_tersedia)) {
+            posisi[jumlah++] = i;
+        }
+    }
+    *kursor = jumlah > 0 && jumlah == batas ? kolom_id[posisi[jumlah - 1]] : 0;
+    return jumlah;
+}
+
+void termahal_naik(int *heap, int i) {
+    while (i > 0) {
+        int induk = (i - 1) / 2;
+        if (banding_urut_harga(&heap[i], &heap[induk]) <= 0) {
+            break;
+        }
+        int sementara = heap[i];
+        heap[i] = heap[induk];
+        heap[induk] = sementara;
+        i = induk;
+    }
+}
+
+void termahal_turun(int *heap, int n, int i) {
+    while (1) {
+        int besar = i;
+        int kiri = 2 * i + 1;
+        int kanan = 2 * i + 2;
+        if (kiri < n && banding_urut_harga(&heap[kiri], &heap[besar]) > 0) {
+            besar = kiri;
+        }
+        if (kanan < n && banding_urut_harga(&heap[kanan], &heap[besar]) > 0) {
+            besar = kanan;
+        }
+        if (besar == i) {
+            return;
+        }
+        int sementara = heap[i];
+        heap[i] = heap[besar];
+        heap[besar] = sementara;
+        i = besar;
+    }
+}
+
+// k tiket termurah yang stoknya > 0, urut (harga, id); `posisi` harus muat k entri. Bila indeks harga
+// sedang rapi cukup dijalani dari depan, selain itu satu sapuan kolom dengan max-heap berukuran k
+// (O(n log k)), jadi indeks tidak dirapikan hanya demi k tiket.
+int ambil_termurah(int k, int *posisi) {
+    int jumlah = 0;
+    if (k <= 0) {
+        return 0;
+    }
+    if (urut_harga.terurut == urut_harga.jumlah && urut_harga.lubang == 0) {
+        for (int j = 0; j < urut_harga.jumlah && jumlah < k; j++) {
+            if (kolom_stok[urut_harga.isi[j]] > 0) {
+                posisi[jumlah++] = urut_harga.isi[j];
+            }
+        }
+        return jumlah;
+    }
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (!tiket_lolos(i, 1)) {
+            continue;
+        }
+        if (jumlah < k) {
+            posisi[jumlah] = i;
+            termahal_naik(posisi, jumlah++);
+        } else if (banding_urut_harga(&i, &posisi[0]) < 0) {
+            posisi[0] = i;
+            termahal_turun(posisi, k, 0);
+        }
+    }
+    // Puncak (termahal) dipindah ke belakang satu per satu, sehingga hasilnya urut naik
+    for (int sisa = jumlah - 1; sisa > 0; sisa--) {
+        int sementara = posisi[0];
+        posisi[0] = posisi[sisa];
+        posisi[sisa] = sementara;
+        termahal_turun(posisi, sisa, 0);
+    }
+    return jumlah;
+}
+
+// Enter saja = tampilkan halaman berikutnya; jawaban lain atau EOF = berhenti
+int lanjut_halaman() {
+    char jawaban[16];
+    printf("-- Enter: halaman berikutnya, q: selesai -- ");
+    if (fgets(jawaban, sizeof(jawaban), stdin) == NULL) {
+        return 0;
+    }
+    if (strchr(jawaban, '\n') == NULL) {
+        int c;
+        while ((c = getchar()) != '\n' && c != EOF);
+    }
+    return jawaban[0] == '\n';
+}
+
+// --- POHON HARGA ---
+// B+tree berkunci (harga, id) dengan simpul lebar dan daun yang dirantai kiri-kanan. Rentang harga
+// cukup turun sekali ke daun pertama lalu menyusuri daun: O(log n + k), tanpa merapikan indeks
+// urutan. Daun menyimpan ID, bukan posisi, jadi pemadatan tidak menyentuh pohon. Pohon dibangun
+// saat rentang pertama diminta, lalu dirawat setiap tiket masuk, dihapus, atau harganya berubah.
+// Penghapusan tidak menggabung simpul; simpul yang kosong langsung dilepas.
+#define CABANG_POHON 32 // kunci per simpul; 32 x (harga + id) = 256 byte
+
+typedef struct SimpulHarga {
+    int jumlah;
+    int daun;
+    float harga[CABANG_POHON]; // simpul dalam: kunci terkecil (atau lebih kecil) di anak[i]
+    int id[CABANG_POHON];
+    struct SimpulHarga *anak[CABANG_POHON]; // hanya simpul dalam
+    struct SimpulHarga *kiri, *kanan;       // hanya daun
+} SimpulHarga;
+
+SimpulHarga *akar_harga = NULL;
+int pohon_harga_aktif = 0; // 0 = belum dibangun; perubahan tiket belum perlu dicatat
+
+// Bandingkan dua kunci (harga, id); hasilnya seperti strcmp
+int banding_kunci_harga(float harga_a, int id_a, float harga_b, int id_b) {
+    if (harga_a != harga_b) {
+        return harga_a < harga_b ? -1 : 1;
+    }
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+// Indeks kunci pertama di simpul `s` yang > (harga, id) bila `lebih`, atau >= bila tidak.
+int cari_kunci_simpul(const SimpulHarga *s, float harga, int id, int lebih) {
+    int kiri = 0;
+    int kanan = s->jumlah;
+    while (kiri < kanan) {
+        int tengah = (kiri + kanan) / 2;
+        int b = banding_kunci_harga(s->harga[tengah], s->id[tengah], harga, id);
+        if (b < 0 || (lebih && b == 0)) {
+            kiri = tengah + 1;
+        } else {
+            kanan = tengah;
+        }
+    }
+    return kiri;
+}
+
+// Anak simpul dalam `s` yang memuat (harga, id): kunci terakhir yang <= kunci itu
+// (anak pertama bila semua kunci lebih besar).
+int cari_anak_simpul(const SimpulHarga *s, float harga, int id) {
+    int i = cari_kunci_simpul(s, harga, id, 1) - 1;
+    return i < 0 ? 0 : i;
+}
+
+// Mengalokasikan simpul kosong; program berhenti bila memori habis.
+SimpulHarga *simpul_harga_baru(int daun) {
+    SimpulHarga *s = (SimpulHarga *)calloc(1, sizeof(SimpulHarga));
+    if (s == NULL) {
+        perror("Gagal mengalokasikan pohon harga");
+        exit(EXIT_FAILURE);
+    }
+    s->daun = daun;
+    return s;
+}
+
+// Membelah anak[i] yang penuh menjadi dua; separuh kanan masuk induk sebagai anak[i + 1].
+void belah_simpul_harga(SimpulHarga *induk, int i) {
+    SimpulHarga *a = induk->anak[i];
+    SimpulHarga *b = simpul_harga_baru(a->daun);
+    int separuh = CABANG_POHON / 2;
+    b->jumlah = a->jumlah - separuh;
+    memcpy(b->harga, a->harga + separuh, b->jumlah * sizeof(float));
+    memcpy(b->id, a->id + separuh, b->jumlah * sizeof(int));
+    if (!a->daun) {
+        memcpy(b->anak, a->anak + separuh, b->jumlah * sizeof(SimpulHarga *));
+    }
+    a->jumlah = separuh;
+    if (a->daun) {
+        b->kiri = a;
+        b->kanan = a->kanan;
+        if (a->kanan != NULL) {
+            a->kanan->kiri = b;
+        }
+        a->kanan = b;
+    }
+    int geser = induk->jumlah - i - 1;
+    memmove(induk->harga + i + 2, induk->harga + i + 1, geser * sizeof(float));
+    memmove(induk->id + i + 2, induk->id + i + 1, geser * sizeof(int));
+    memmove(induk->anak + i + 2, induk->anak + i + 1, geser * sizeof(SimpulHarga *));
+    induk->harga[i + 1] = b->harga[0];
+    induk->id[i + 1] = b->id[0];
+    induk->anak[i + 1] = b;
+    induk->jumlah++;
+}
+
+// Menyisipkan kunci (harga, id). Simpul penuh dibelah sambil turun, jadi induknya selalu masih muat.
+void pohon_harga_tambah(float harga, int id) {
+    if (!pohon_harga_aktif) {
+        return;
+    }
+    if (akar_harga == NULL) {
+        akar_harga = simpul_harga_baru(1);
+    }
+    if (akar_harga->jumlah == CABANG_POHON) {
+        SimpulHarga *akar = simpul_harga_baru(0);
+        akar->harga[0] = akar_harga->harga[0];
+        akar->id[0] = akar_harga->id[0];
+        akar->anak[0] = akar_harga;
+        akar->jumlah = 1;
+        akar_harga = akar;
+        belah_simpul_harga(akar, 0);
+    }
+    SimpulHarga *s = akar_harga;
+    while (!s->daun) {
+        int i = cari_anak_simpul(s, harga, id);
+        if (banding_kunci_harga(harga, id, s->harga[i], s->id[i]) < 0) { // kunci terkecil baru
+            s->harga[i] = harga;
+            s->id[i] = id;
+        }
+        if (s->anak[i]->jumlah == CABANG_POHON) {
+            belah_simpul_harga(s, i);
+            if (banding_kunci_harga(harga, id, s->harga[i + 1], s->id[i + 1]) >= 0) {
+                i++;
+            }
+        }
+        s = s->anak[i];
+    }
+    int i = cari_kunci_simpul(s, harga, id, 0);
+    int geser = s->jumlah - i;
+    memmove(s->harga + i + 1, s->harga + i, geser * sizeof(float));
+    memmove(s->id + i + 1, s->id + i, geser * sizeof(int));
+    s->harga[i] = harga;
+    s->id[i] = id;
+    s->jumlah++;
+}
+
+// Hapus kunci dari subpohon `s`; 1 bila `s` menjadi kosong (dilepas oleh induknya)
+int hapus_dari_simpul_harga(SimpulHarga *s, float harga, int id) {
+    int i;
+    if (s->daun) {
+        i = cari_kunci_simpul(s, harga, id, 0);
+        if (i == s->jumlah || s->harga[i] != harga || s->id[i] != id) {
+            return 0;
+        }
+    } else {
+        i = cari_anak_simpul(s, harga, id);
+        if (!hapus_dari_simpul_harga(s->anak[i], harga, id)) {
+            return 0;
+        }
+        SimpulHarga *kosong = s->anak[i];
+        if (kosong->daun) {
+            if (kosong->kiri != NULL) {
+                kosong->kiri->kanan = kosong->kanan;
+            }
+            if (kosong->kanan != NULL) {
+                kosong->kanan->kiri = kosong->kiri;
+            }
+        }
+        free(kosong);
+        memmove(s->anak + i, s->anak + i + 1, (s->jumlah - i - 1) * sizeof(SimpulHarga *));
+    }
+    // Kunci simpul dalam yang kini lebih kecil dari isi anaknya tetap sah sebagai pemandu
+    memmove(s->harga + i, s->harga + i + 1, (s->jumlah - i - 1) * sizeof(float));
+    memmove(s->id + i, s->id + i + 1, (s->jumlah - i - 1) * sizeof(int));
+    return --s->jumlah == 0;
+}
+
+// Melepas kunci (harga, id) dari pohon; akar yang tinggal punya satu anak diganti anaknya.
+void pohon_harga_lepas(float harga, int id) {
+    if (!pohon_harga_aktif || akar_harga == NULL) {
+        return;
+    }
+    if (hapus_dari_simpul_harga(akar_harga, harga, id)) {
+        free(akar_harga);
+        akar_harga = NULL;
+        return;
+    }
+    while (!akar_harga->daun && akar_harga->jumlah == 1) {
+        SimpulHarga *lama = akar_harga;
+        akar_harga = lama->anak[0];
+        free(lama);
+    }
+}
+
+// Membebaskan subpohon `s`.
+void bebaskan_simpul_harga(SimpulHarga *s) {
+    if (!s->daun) {
+        for (int i = 0; i < s->jumlah; i++) {
+            bebaskan_simpul_harga(s->anak[i]);
+        }
+    }
+    free(s);
+}
+
+// Membebaskan pohon harga; pohon dibangun lagi saat rentang berikutnya diminta.
+void kosongkan_pohon_harga() {
+    if (akar_harga != NULL) {
+        bebaskan_simpul_harga(akar_harga);
+    }
+    akar_harga = NULL;
+    pohon_harga_aktif = 0;
+}
+
+// Membangun pohon dari bawah ke atas memakai indeks harga (sudah urut (harga, id)).
+// Daun dan simpul dalam diisi 3/4 agar tiket baru tidak langsung membelah.
+void bangun_pohon_harga() {
+    kosongkan_pohon_harga();
+    pohon_harga_aktif = 1;
+    rapikan_urutan(&urut_harga);
+    int n = urut_harga.jumlah;
+    int isi = CABANG_POHON * 3 / 4;
+    if (n == 0) {
+        return;
+    }
+    int jumlah_simpul = (n + isi - 1) / isi;
+    SimpulHarga **lapis = (SimpulHarga **)malloc(jumlah_simpul * sizeof(SimpulHarga *));
+    SimpulHarga *kiri = NULL;
+    if (lapis == NULL) {
+        perror("Gagal mengalokasikan pohon harga");
+        exit(EXIT_FAILURE);
+    }
+    for (int j = 0; j < jumlah_simpul; j++) {
+        SimpulHarga *s = simpul_harga_baru(1);
+        for (int k = j * isi; k < n && s->jumlah < isi; k++) {
+            int posisi = urut_harga.isi[k];
+            s->harga[s->jumlah] = kolom_harga[posisi];
+            s->id[s->jumlah] = kolom_id[posisi];
+            s->jumlah++;
+        }
+        s->kiri = kiri;
+        if (kiri != NULL) {
+            kiri->kanan = s;
+        }
+        lapis[j] = kiri = s;
+    }
+    while (jumlah_simpul > 1) {
+        // lapis[j] boleh ditimpa: anak yang dibaca selalu di indeks >= j * isi
+        int atas = (jumlah_simpul + isi - 1) / isi;
+        for (int j = 0; j < atas; j++) {
+            SimpulHarga *s = simpul_harga_baru(0);
+            for (int k = j * isi; k < jumlah_simpul && s->jumlah < isi; k++) {
+                s->harga[s->jumlah] = lapis[k]->harga[0];
+                s->id[s->jumlah] = lapis[k]->id[0];
+                s->anak[s->jumlah] = lapis[k];
+                s->jumlah++;
+            }
+            lapis[j] = s;
+        }
+        jumlah_simpul = atas;
+    }
+    akar_harga = lapis[0];
+    free(lapis);
+}
+
+// Mengambil paling banyak `batas` tiket dengan harga_min <= harga <= harga_max, urut
+// (harga, id), mulai sesudah tiket `setelah` (0 = dari awal rentang). Saringan stok dan
+// kategori (NULL = semua, sudah di-casefold) diperiksa sambil menyusuri daun.
+// *kursor = ID tiket terakhir bila halaman penuh, 0 bila rentang sudah habis.
+// Mengembalikan jumlah tiket, atau -1 bila tiket `setelah` sudah tidak ada.
+int ambil_rentang_harga(float harga_min, float harga_max, int setelah, int hanya_tersedia, const char *kategori_lipat, int *posisi, int batas, int *kursor) {
+    float harga_mulai = harga_min;
+    int id_mulai = INT_MIN;
+    int lewati = 0;
+    int jumlah = 0;
+    *kursor = 0;
+    if (setelah != 0) {
+        int p = cari_indeks_id(setelah);
+        if (p < 0) {
+            return -1;
+        }
+        if (banding_kunci_harga(kolom_harga[p], setelah, harga_min, INT_MIN) > 0) {
+            harga_mulai = kolom_harga[p];
+            id_mulai = setelah;
+            lewati = 1;
+        }
+    }
+    if (!pohon_harga_aktif) {
+        bangun_pohon_harga();
+    }
+    if (akar_harga == NULL || batas <= 0) {
+        return 0;
+    }
+    int kode = kategori_lipat != NULL ? kode_kategori(kategori_lipat, 0) : 0;
+    SimpulHarga *s = akar_harga;
+    while (!s->daun) {
+        s = s->anak[cari_anak_simpul(s, harga_mulai, id_mulai)];
+    }
+    for (int i = cari_kunci_simpul(s, harga_mulai, id_mulai, lewati); s != NULL; s = s->kanan, i = 0) {
+        for (; i < s->jumlah; i++) {
+            if (s->harga[i] > harga_max) {
+                return jumlah;
+            }
+            int p = cari_indeks_id(s->id[i]);
+            if (hanya_tersedia && kolom_stok[p] <= 0) {
+                continue;
+            }
+            if (kategori_lipat != NULL && !tiket_berkategori(p, kode, kategori_lipat)) {
+                continue;
+            }
+            posisi[jumlah++] = p;
+            if (jumlah == batas) {
+                *kursor = s->id[i];
+                return jumlah;
+            }
+        }
+    }
+    return jumlah;
+}
+
+// --- INDEKS KADALUARSA (MIN-HEAP) ---
+// Pemeriksaan kadaluarsa hanya menyentuh tiket yang benar-benar lewat batas, sehingga
+// cukup murah untuk dijalankan di setiap putaran menu. Entri memakai ID, bukan posisi,
+// jadi tetap berlaku setelah sorting dan pemadatan.
+
+void heap_tukar(int a, int b) {
+    EntriKadaluarsa sementara = heap_kadaluarsa[a];
+    heap_kadaluarsa[a] = heap_kadaluarsa[b];
+    heap_kadaluarsa[b] = sementara;
+}
+
+void heap_naik(int i) {
+    while (i > 0 && heap_kadaluarsa[(i - 1) / 2].waktu > heap_kadaluarsa[i].waktu) {
+        heap_tukar(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void heap_turun(int i) {
+    while (1) {
+        int terkecil = i;
+        int kiri = 2 * i + 1;
+        int kanan = 2 * i + 2;
+        if (kiri < ukuran_heap && heap_kadaluarsa[kiri].waktu < heap_kadaluarsa[terkecil].waktu) {
+            terkecil = kiri;
+        }
+        if (kanan < ukuran_heap && heap_kadaluarsa[kanan].waktu < heap_kadaluarsa[terkecil].waktu) {
+            terkecil = kanan;
+        }
+        if (terkecil == i) {
+            return;
+        }
+        heap_tukar(i, terkecil);
+        i = terkecil;
+    }
+}
+
+void cadangkan_heap(int minimal) {
+    if (minimal <= kapasitas_heap) {
+        return;
+    }
+    int kapasitas = kapasitas_heap < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_heap;
+    while (kapasitas < minimal) {
+        kapasitas *= 2;
+    }
+    EntriKadaluarsa *baru = (EntriKadaluarsa *)realloc(heap_kadaluarsa, kapasitas * sizeof(EntriKadaluarsa));
+    if (baru == NULL) {
+        perror("Error alokasi indeks kadaluarsa");
+        exit(EXIT_FAILURE);
+    }
+    heap_kadaluarsa = baru;
+    kapasitas_heap = kapasitas;
+}
+
+// Bangun ulang dari semua tiket aktif dalam O(n) (heapify); sekaligus membuang entri basi
+void bangun_heap_kadaluarsa() {
+    cadangkan_heap(jumlah_tiket_aktif());
+    ukuran_heap = 0;
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) {
+            continue;
+        }
+        heap_kadaluarsa[ukuran_heap].waktu = kolom_waktu[i] + KADALUARSA_DETIK;
+        heap_kadaluarsa[ukuran_heap].id = kolom_id[i];
+        ukuran_heap++;
+    }
+    for (int i = ukuran_heap / 2 - 1; i >= 0; i--) {
+        heap_turun(i);
+    }
+}
+
+// Daftarkan tiket baru di `posisi`; bila entri basi sudah menumpuk, heap dibangun ulang
+void kadaluarsa_tambah(int posisi) {
+    if (ukuran_heap >= 2 * jumlah_tiket_aktif() + KAPASITAS_AWAL) {
+        bangun_heap_kadaluarsa();
+        return;
+    }
+    cadangkan_heap(ukuran_heap + 1);
+    heap_kadaluarsa[ukuran_heap].waktu = kolom_waktu[posisi] + KADALUARSA_DETIK;
+    heap_kadaluarsa[ukuran_heap].id = kolom_id[posisi];
+    heap_naik(ukuran_heap);
+    ukuran_heap++;
+}
+
+void heap_buang_puncak() {
+    ukuran_heap--;
+    heap_kadaluarsa[0] = heap_kadaluarsa[ukuran_heap];
+    heap_turun(0);
+}
+
+// Apakah ada tiket aktif yang kadaluarsa pada `sekarang`? Entri basi di puncak dibuang di sini.
+int ada_tiket_kadaluarsa(time_t sekarang) {
+    while (ukuran_heap > 0 && heap_kadaluarsa[0].waktu < sekarang) {
+        int posisi = cari_indeks_id(heap_kadaluarsa[0].id);
+        if (posisi >= 0 && kolom_waktu[posisi] + KADALUARSA_DETIK == heap_kadaluarsa[0].waktu) {
+            return 1;
+        }
+        heap_buang_puncak();
+    }
+    return 0;
+}
+
+// Keluarkan tiket kadaluarsa berikutnya dari heap; mengembalikan posisinya, atau -1 jika tidak ada
+int ambil_tiket_kadaluarsa(time_t sekarang) {
+    if (!ada_tiket_kadaluarsa(sekarang)) {
+        return -1;
+    }
+    int posisi = cari_indeks_id(heap_kadaluarsa[0].id);
+    heap_buang_puncak();
+    return posisi;
+}
+
+// --- TEKS CASEFOLD (KOLOM BAYANGAN) ---
+// Nama dan kategori di-casefold sekali saat muat data dan saat diubah (kategori lalu di-intern
+// ke kamus), bukan di setiap pencarian. Tabel ASCII tetap sehingga hasilnya tidak bergantung pada locale (beda dengan tolower).
+
+#define LIPAT_1(c) ((c) >= 'A' && (c) <= 'Z' ? (c) + ('a' - 'A') : (c))
+#define LIPAT_4(c) LIPAT_1(c), LIPAT_1((c) + 1), LIPAT_1((c) + 2), LIPAT_1((c) + 3)
+#define LIPAT_16(c) LIPAT_4(c), LIPAT_4((c) + 4), LIPAT_4((c) + 8), LIPAT_4((c) + 12)
+#define LIPAT_64(c) LIPAT_16(c), LIPAT_16((c) + 16), LIPAT_16((c) + 32), LIPAT_16((c) + 48)
+const unsigned char tabel_lipat[256] = { LIPAT_64(0), LIPAT_64(64), LIPAT_64(128), LIPAT_64(192) };
+
+// Salin `asal` ke `tujuan` (dipotong agar muat di `ukuran`) sambil di-casefold; mengembalikan panjangnya
+size_t lipat_teks(char *tujuan, const char *asal, size_t ukuran) {
+    size_t i = 0;
+    for (; i + 1 < ukuran && asal[i]; i++) {
+        tujuan[i] = (char)tabel_lipat[(unsigned char)asal[i]];
+    }
+    tujuan[i] = '\0';
+    return i;
+}
+
+void cadangkan_lipat(int minimal) {
+    if (minimal <= kapasitas_lipat) {
+        return;
+    }
+    int kapasitas = kapasitas_lipat < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_lipat;
+    while (kapasitas < minimal) {
+        kapasitas *= 2;
+    }
+    TeksLipat *baru = (TeksLipat *)realloc(teks_lipat, kapasitas * sizeof(TeksLipat));
+    if (baru == NULL) {
+        perror("Error alokasi teks casefold");
+        exit(EXIT_FAILURE);
+    }
+    teks_lipat = baru;
+    kapasitas_lipat = kapasitas;
+    perbesar_bitmap_kategori(kapasitas);
+}
+
+// Perbarui salinan casefold nama dan kode kategori tiket di `posisi` (setelah ditambah atau
+// nama/kategorinya diubah). Bitmap kategori diurus pemanggil.
+void lipat_tiket(int posisi) {
+    char kategori[MAX_KATEGORI];
+    cadangkan_lipat(posisi + 1);
+    teks_lipat[posisi].panjang_nama = (unsigned char)lipat_teks(teks_lipat[posisi].nama, daftar_tiket[posisi].nama_konser, MAX_NAMA);
+    lipat_teks(kategori, daftar_tiket[posisi].kategori, MAX_KATEGORI);
+    teks_lipat[posisi].kode_kategori = (unsigned char)kode_kategori(kategori, 1);
+}
+
+// Bangun ulang semua salinan casefold dan bitmap kategori, dipakai setelah muat data
+void bangun_teks_lipat() {
+    cadangkan_lipat(jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) {
+        lipat_tiket(i);
+    }
+    bangun_bitmap_kategori();
+}
+
+// --- KAMUS KATEGORI ---
+// Pencarian kategori cukup mencocokkan kata kunci dengan setiap entri kamus (sedikit), lalu
+// menggabungkan bitmap entri yang cocok; jumlah tiket per kategori didapat dari popcount.
+// Kode tidak pernah dihapus selama data dimuat, jadi kode di teks_lipat tetap sah.
+// Slot berkode 0 dicocokkan lewat teks kategori aslinya.
+
+uint32_t hash_teks(const char *teks) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (; *teks; teks++) {
+        h = (h ^ (unsigned char)*teks) * 16777619u;
+    }
+    return h;
+}
+
+// Kode untuk kategori `nama_lipat` (sudah di-casefold). Bila belum ada: dibuat jika `buat`,
+// selain itu (atau bila kamus penuh) hasilnya 0.
+int kode_kategori(const char *nama_lipat, int buat) {
+    unsigned int i = hash_teks(nama_lipat) & (SLOT_KAMUS_KATEGORI - 1);
+    for (; slot_kamus_kategori[i] != 0; i = (i + 1) & (SLOT_KAMUS_KATEGORI - 1)) {
+        if (strcmp(kamus_kategori[slot_kamus_kategori[i]].nama, nama_lipat) == 0) {
+            return slot_kamus_kategori[i];
+        }
+    }
+    if (!buat || jumlah_kode_kategori == MAX_KODE_KATEGORI) {
+        return 0;
+    }
+    int kode = jumlah_kode_kategori;
+    uint64_t *bitmap = (uint64_t *)calloc(kata_bitmap_kategori > 0 ? kata_bitmap_kategori : 1, sizeof(uint64_t));
+    if (bitmap == NULL) {
+        perror("Error alokasi bitmap kategori");
+        exit(EXIT_FAILURE);
+    }
+    snprintf(kamus_kategori[kode].nama, MAX_KATEGORI, "%s", nama_lipat);
+    kamus_kategori[kode].bitmap = bitmap;
+    slot_kamus_kategori[i] = (unsigned char)kode;
+    jumlah_kode_kategori++;
+    return kode;
+}
+
+// Semua bitmap selalu muat `kapasitas_slot` slot (mengikuti kapasitas teks_lipat)
+void perbesar_bitmap_kategori(int kapasitas_slot) {
+    int kata = (kapasitas_slot + 63) / 64;
+    if (kata <= kata_bitmap_kategori) {
+        return;
+    }
+    for (int k = 0; k < jumlah_kode_kategori; k++) {
+        uint64_t *baru = (uint64_t *)realloc(kamus_kategori[k].bitmap, kata * sizeof(uint64_t));
+        if (baru == NULL) {
+            perror("Error alokasi bitmap kategori");
+            exit(EXIT_FAILURE);
+        }
+        memset(baru + kata_bitmap_kategori, 0, (kata - kata_bitmap_kategori) * sizeof(uint64_t));
+        kamus_kategori[k].bitmap = baru;
+    }
+    kata_bitmap_kategori = kata;
+}
+
+void kategori_pasang(int posisi) {
+    kamus_kategori[teks_lipat[posisi].kode_kategori].bitmap[posisi >> 6] |= 1ULL << (posisi & 63);
+}
+
+void kategori_lepas(int posisi) {
+    kamus_kategori[teks_lipat[posisi].kode_kategori].bitmap[posisi >> 6] &= ~(1ULL << (posisi & 63));
+}
+
+// Isi ulang semua bitmap dari kode di teks_lipat (setelah muat data atau pemadatan)
+void bangun_bitmap_kategori() {
+    if (kata_bitmap_kategori == 0) {
+        return; // belum ada slot sama sekali
+    }
+    for (int k = 0; k < jumlah_kode_kategori; k++) {
+        memset(kamus_kategori[k].bitmap, 0, kata_bitmap_kategori * sizeof(uint64_t));
+    }
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (daftar_tiket[i].id != ID_NISAN) {
+            kategori_pasang(i);
+        }
+    }
+}
+
+void kosongkan_kamus_kategori() {
+    for (int k = 0; k < jumlah_kode_kategori; k++) {
+        free(kamus_kategori[k].bitmap);
+        kamus_kategori[k].bitmap = NULL;
+    }
+    memset(slot_kamus_kategori, 0, sizeof(slot_kamus_kategori));
+    jumlah_kode_kategori = 1;
+    kata_bitmap_kategori = 0;
+}
+
+// Jumlah tiket aktif berkode `kode` (popcount bitmap)
+int hitung_kategori(int kode) {
+    int jumlah = 0;
+    for (int w = 0; w < kata_bitmap_kategori; w++) {
+        jumlah += __builtin_popcountll(kamus_kategori[kode].bitmap[w]);
+    }
+    return jumlah;
+}
+
+// Kategori tiket di `posisi` sama dengan `kriteria_lipat` (kode = kode_kategori(kriteria_lipat, 0));
+// tiket berkode 0 (di luar kamus) dibandingkan lewat teksnya
+int tiket_berkategori(int posisi, int kode, const char *kriteria_lipat) {
+    if (teks_lipat[posisi].kode_kategori != 0) {
+        return teks_lipat[posisi].kode_kategori == kode;
+    }
+    char kategori[MAX_KATEGORI];
+    lipat_teks(kategori, daftar_tiket[posisi].kategori, MAX_KATEGORI);
+    return strcmp(kategori, kriteria_lipat) == 0;
+}
+
+// --- PENCOCOK SUBSTRING TANPA BEDA HURUF ---
+// memuat_lipat(teks, panjang, kapasitas, jarum, panjang_jarum) bernilai 1 bila `jarum` (sudah
+// di-casefold) muncul di `teks`. Versi SIMD membandingkan byte pertama dan terakhir jarum di
+// 16/32 posisi awal sekaligus dan hanya memverifikasi posisi yang keduanya cocok; teks ikut
+// di-casefold di dalam kernel. Blok boleh membaca melewati '\0' selama masih di dalam
+// `kapasitas` byte buffer teks; posisi di luar `panjang` dibuang dari mask.
+
+int cocok_lipat_di(const char *teks, const char *jarum, size_t panjang_jarum) {
+    for (size_t j = 0; j < panjang_jarum; j++) {
+        if (tabel_lipat[(unsigned char)teks[j]] != (unsigned char)jarum[j]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int memuat_lipat_dari(const char *teks, size_t mulai, size_t panjang, const char *jarum, size_t panjang_jarum) {
+    for (size_t i = mulai; i + panjang_jarum <= panjang; i++) {
+        if (cocok_lipat_di(teks + i, jarum, panjang_jarum)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int memuat_lipat_skalar(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    (void)kapasitas;
+    return memuat_lipat_dari(teks, 0, panjang, jarum, panjang_jarum);
+}
+
+#if PAKAI_SIMD_X86
+// 'A'..'Z' digeser ke -128..-103 agar cukup satu perbandingan bertanda, lalu di-OR 0x20
+__attribute__((target("sse2"))) static inline __m128i lipat_sse2(__m128i v) {
+    __m128i geser = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A')));
+    __m128i besar = _mm_cmpgt_epi8(_mm_set1_epi8((char)(0x80 + 26)), geser);
+    return _mm_or_si128(v, _mm_and_si128(besar, _mm_set1_epi8(0x20)));
+}
+
+__attribute__((target("sse2")))
+int memuat_lipat_sse2(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    if (panjang_jarum == 0) {
+        return 1;
+    }
+    const __m128i awal = _mm_set1_epi8(jarum[0]);
+    const __m128i akhir = _mm_set1_epi8(jarum[panjang_jarum - 1]);
+    size_t i = 0;
+    for (; i + panjang_jarum <= panjang && i + panjang_jarum - 1 + 16 <= kapasitas; i += 16) {
+        __m128i blok_awal = lipat_sse2(_mm_loadu_si128((const __m128i *)(teks + i)));
+        __m128i blok_akhir = lipat_sse2(_mm_loadu_si128((const __m128i *)(teks + i + panjang_jarum - 1)));
+        unsigned int kandidat = (unsigned int)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blok_awal, awal), _mm_cmpeq_epi8(blok_akhir, akhir)));
+        size_t sah = panjang - panjang_jarum - i + 1; // posisi awal yang masih di dalam teks
+        if (sah < 16) {
+            kandidat &= (1u << sah) - 1;
+        }
+        for (; kandidat; kandidat &= kandidat - 1) {
+            if (cocok_lipat_di(teks + i + __builtin_ctz(kandidat), jarum, panjang_jarum)) {
+                return 1;
+            }
+        }
+    }
+    return memuat_lipat_dari(teks, i, panjang, jarum, panjang_jarum);
+}
+
+__attribute__((target("avx2"))) static inline __m256i lipat_avx2(__m256i v) {
+    __m256i geser = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'A')));
+    __m256i besar = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), geser);
+    return _mm256_or_si256(v, _mm256_and_si256(besar, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+int memuat_lipat_avx2(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    if (panjang_jarum == 0) {
+        return 1;
+    }
+    // Buffer yang tidak muat satu blok 32 byte langsung memakai blok 16 byte
+    if (panjang_jarum - 1 + 32 > kapasitas) {
+        return memuat_lipat_sse2(teks, panjang, kapasitas, jarum, panjang_jarum);
+    }
+    const __m256i awal = _mm256_set1_epi8(jarum[0]);
+    const __m256i akhir = _mm256_set1_epi8(jarum[panjang_jarum - 1]);
+    size_t i = 0;
+    for (; i + panjang_jarum <= panjang && i + panjang_jarum - 1 + 32 <= kapasitas; i += 32) {
+        __m256i blok_awal = lipat_avx2(_mm256_loadu_si256((const __m256i *)(teks + i)));
+        __m256i blok_akhir = lipat_avx2(_mm256_loadu_si256((const __m256i *)(teks + i + panjang_jarum - 1)));
+        unsigned int kandidat = (unsigned int)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blok_awal, awal), _mm256_cmpeq_epi8(blok_akhir, akhir)));
+        size_t sah = panjang - panjang_jarum - i + 1;
+        if (sah < 32) {
+            kandidat &= (1u << sah) - 1;
+        }
+        for (; kandidat; kandidat &= kandidat - 1) {
+            if (cocok_lipat_di(teks + i + __builtin_ctz(kandidat), jarum, panjang_jarum)) {
+                return 1;
+            }
+        }
+    }
+    if (i + panjang_jarum > panjang) {
+        return 0;
+    }
+    // Sisa ekor memakai blok 16 byte; vzeroupper dulu agar kode SSE tidak terkena penalti transisi AVX
+    _mm256_zeroupper();
+    return memuat_lipat_sse2(teks + i, panjang - i, kapasitas - i, jarum, panjang_jarum);
+}
+#endif
+
+typedef int (*PencocokLipat)(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum);
+
+PencocokLipat pilih_pencocok_lipat() {
+#if PAKAI_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return memuat_lipat_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return memuat_lipat_sse2;
+    }
+#endif
+    return memuat_lipat_skalar;
+}
+
+// Panggilan pertama memilih kernel sesuai CPU lalu mengganti pointer ini
+int memuat_lipat_pertama(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum);
+PencocokLipat memuat_lipat = memuat_lipat_pertama;
+int memuat_lipat_pertama(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    memuat_lipat = pilih_pencocok_lipat();
+    return memuat_lipat(teks, panjang, kapasitas, jarum, panjang_jarum);
+}
+
+// Nama tiket di `posisi` memuat kata kunci yang sudah di-casefold
+int nama_memuat(int posisi, const char *keyword_lower, size_t panjang) {
+    return memuat_lipat(teks_lipat[posisi].nama, teks_lipat[posisi].panjang_nama, MAX_NAMA, keyword_lower, panjang);
+}
+
+// --- INDEKS TRIGRAM NAMA KONSER ---
+// Pencarian substring nama cukup memotong posting list dari setiap trigram kata kunci,
+// lalu memverifikasi kandidatnya, tanpa memindai semua tiket. Seperti heap kadaluarsa,
+// ID tiket yang dihapus atau diganti namanya dibiarkan basi di posting list (tersaring saat
+// verifikasi), dan indeks dibangun ulang bila yang basi sudah lebih banyak dari tiket aktif.
+
+unsigned int kode_trigram(const char *p) {
+    return ((unsigned int)tabel_lipat[(unsigned char)p[0]] << 16) |
+           ((unsigned int)tabel_lipat[(unsigned char)p[1]] << 8) |
+           (unsigned int)tabel_lipat[(unsigned char)p[2]];
+}
+
+void kosongkan_indeks_trigram() {
+    for (int i = 0; i < kapasitas_trigram; i++) {
+        free(tabel_trigram[i].id);
+    }
+    free(tabel_trigram);
+    tabel_trigram = NULL;
+    kapasitas_trigram = 0;
+    jumlah_trigram = 0;
+    tiket_basi_trigram = 0;
+}
+
+// Posting list untuk `kode`; bila belum ada dibuat jika `buat`, atau NULL jika tidak
+PostingTrigram *slot_trigram(unsigned int kode, int buat) {
+    if (buat && (jumlah_trigram + 1) * 2 > kapasitas_trigram) {
+        int kapasitas = kapasitas_trigram ? kapasitas_trigram * 2 : 1024;
+        PostingTrigram *baru = (PostingTrigram *)calloc(kapasitas, sizeof(PostingTrigram));
+        if (baru == NULL) {
+            perror("Error alokasi indeks trigram");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < kapasitas_trigram; i++) {
+            if (tabel_trigram[i].kode == 0) {
+                continue;
+            }
+            unsigned int j = hash_id((int)tabel_trigram[i].kode) & (kapasitas - 1);
+            while (baru[j].kode != 0) {
+                j = (j + 1) & (kapasitas - 1);
+            }
+            baru[j] = tabel_trigram[i];
+        }
+        free(tabel_trigram);
+        tabel_trigram = baru;
+        kapasitas_trigram = kapasitas;
+    }
+    if (kapasitas_trigram == 0) {
+        return NULL;
+    }
+
+    unsigned int mask = kapasitas_trigram - 1;
+    unsigned int i = hash_id((int)kode) & mask;
+    while (tabel_trigram[i].kode != 0) {
+        if (tabel_trigram[i].kode == kode) {
+            return &tabel_trigram[i];
+        }
+        i = (i + 1) & mask;
+    }
+    if (!buat) {
+        return NULL;
+    }
+    tabel_trigram[i].kode = kode;
+    jumlah_trigram++;
+    return &tabel_trigram[i];
+}
+
+// Sisipkan `id` ke posting list. Dengan `urut`, list dijaga urut naik (ID baru selalu terbesar,
+// jadi biasanya cukup ditempel di akhir); tanpa `urut` ditempel saja dan dirapikan setelah bangun ulang.
+void posting_sisip(PostingTrigram *p, int id, int urut) {
+    int letak = p->jumlah;
+    if (urut && p->jumlah > 0 && p->id[p->jumlah - 1] >= id) {
+        int kiri = 0, kanan = p->jumlah;
+        while (kiri < kanan) {
+            int tengah = (kiri + kanan) / 2;
+            if (p->id[tengah] < id) {
+                kiri = tengah + 1;
+            } else {
+                kanan = tengah;
+            }
+        }
+        if (p->id[kiri] == id) {
+            return; // trigram muncul lebih dari sekali di nama yang sama
+        }
+        letak = kiri;
+    } else if (p->jumlah > 0 && p->id[p->jumlah - 1] == id) {
+        return;
+    }
+
+    if (p->jumlah == p->kapasitas) {
+        int kapasitas = p->kapasitas ? p->kapasitas * 2 : 4;
+        int *baru = (int *)realloc(p->id, kapasitas * sizeof(int));
+        if (baru == NULL) {
+            perror("Error alokasi indeks trigram");
+            exit(EXIT_FAILURE);
+        }
+        p->id = baru;
+        p->kapasitas = kapasitas;
+    }
+    memmove(p->id + letak + 1, p->id + letak, (p->jumlah - letak) * sizeof(int));
+    p->id[letak] = id;
+    p->jumlah++;
+}
+
+// Daftarkan semua trigram `nama` untuk tiket `id`
+void trigram_tambah(int id, const char *nama, int urut) {
+    size_t panjang = strlen(nama);
+    for (size_t i = 0; i + 3 <= panjang; i++) {
+        posting_sisip(slot_trigram(kode_trigram(nama + i), 1), id, urut);
+    }
+}
+
+int bandingkan_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Bangun ulang dari semua tiket aktif; sekaligus membuang ID basi
+void bangun_indeks_trigram() {
+    kosongkan_indeks_trigram();
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (daftar_tiket[i].id != ID_NISAN) {
+            trigram_tambah(daftar_tiket[i].id, daftar_tiket[i].nama_konser, 0);
+        }
+    }
+    // Urutan array belum tentu urut ID (misal setelah sorting), jadi posting list dirapikan di sini
+    for (int i = 0; i < kapasitas_trigram; i++) {
+        PostingTrigram *p = &tabel_trigram[i];
+        if (p->kode == 0) {
+            continue;
+        }
+        qsort(p->id, p->jumlah, sizeof(int), bandingkan_int);
+        int unik = 0;
+        for (int j = 0; j < p->jumlah; j++) {
+            if (unik == 0 || p->id[unik - 1] != p->id[j]) {
+                p->id[unik++] = p->id[j];
+            }
+        }
+        p->jumlah = unik;
+    }
+}
+
+// Dipanggil setiap kali nama tiket tidak lagi berlaku (dihapus atau diganti)
+void trigram_catat_basi() {
+    tiket_basi_trigram++;
+    if (tiket_basi_trigram > jumlah_tiket_aktif() + KAPASITAS_AWAL) {
+        bangun_indeks_trigram();
+    }
+}
+
+int id_ada_di_posting(const PostingTrigram *p, int id) {
+    int kiri = 0, kanan = p->jumlah;
+    while (kiri < kanan) {
+        int tengah = (kiri + kanan) / 2;
+        if (p->id[tengah] < id) {
+            kiri = tengah + 1;
+        } else {
+            kanan = tengah;
+        }
+    }
+    return kiri < p->jumlah && p->id[kiri] == id;
+}
+
+// Posisi semua tiket aktif yang namanya memuat `keyword_lower`, urut menurut posisi di array.
+// `*posisi` dialokasikan di sini dan dibebaskan pemanggil. Kata kunci pendek (< 3 huruf) tidak
+// punya trigram sehingga jatuh ke pemindaian biasa.
+int cari_posisi_nama(const char *keyword_lower, int **posisi) {
+    size_t panjang = strlen(keyword_lower);
+    *posisi = NULL;
+
+    if (panjang < 3) {
+        *posisi = (int *)malloc((jumlah_tiket + 1) * sizeof(int));
+        if (*posisi == NULL) {
+            return 0;
+        }
+        int jumlah = 0;
+        for (int i = 0; i < jumlah_tiket; i++) {
+            if (daftar_tiket[i].id != ID_NISAN && nama_memuat(i, keyword_lower, panjang)) {
+                (*posisi)[jumlah++] = i;
+            }
+        }
+        return jumlah;
+    }
+
+    // Ambil posting list setiap trigram; satu saja yang tidak ada berarti tidak ada hasil
+    PostingTrigram *daftar[MAX_NAMA];
+    int jumlah_daftar = 0;
+    for (size_t i = 0; i + 3 <= panjang && jumlah_daftar < MAX_NAMA; i++) {
+        PostingTrigram *p = slot_trigram(kode_trigram(keyword_lower + i), 0);
+        if (p == NULL) {
+            return 0;
+        }
+        int sudah = 0;
+        for (int j = 0; j < jumlah_daftar; j++) {
+            sudah |= daftar[j] == p;
+        }
+        if (!sudah) {
+            daftar[jumlah_daftar++] = p;
+        }
+    }
+
+    // Mulai dari posting list terpendek, saring dengan list lainnya (pencarian biner)
+    int terpendek = 0;
+    for (int j = 1; j < jumlah_daftar; j++) {
+        if (daftar[j]->jumlah < daftar[terpendek]->jumlah) {
+            terpendek = j;
+        }
+    }
+    *posisi = (int *)malloc((daftar[terpendek]->jumlah + 1) * sizeof(int));
+    if (*posisi == NULL) {
+        return 0;
+    }
+    int jumlah = 0;
+    for (int k = 0; k < daftar[terpendek]->jumlah; k++) {
+        int id = daftar[terpendek]->id[k];
+        int cocok = 1;
+        for (int j = 0; j < jumlah_daftar && cocok; j++) {
+            cocok = j == terpendek || id_ada_di_posting(daftar[j], id);
+        }
+        if (!cocok) {
+            continue;
+        }
+        // Verifikasi: tiket masih ada dan trigramnya memang berurutan membentuk kata kunci
+        int i = cari_indeks_id(id);
+        if (i >= 0 && nama_memuat(i, keyword_lower, panjang)) {
+            (*posisi)[jumlah++] = i;
+        }
+    }
+    qsort(*posisi, jumlah, sizeof(int), bandingkan_int);
+    return jumlah;
+}
+
+// --- FUNGSI I/O FILE (MEMBACA/MENYIMPAN) ---
+
+// Urutan ID disimpan di file pendamping agar tetap berlanjut antar sesi
+void muat_urutan_id() {
+    FILE *file = fopen(NAMA_FILE_ID, "r");
+    if (file == NULL) {
+        return;
+    }
+    int tersimpan;
+    if (fscanf(file, "%d", &tersimpan) == 1 && tersimpan > id_berikutnya) {
+        id_berikutnya = tersimpan;
+    }
+    fclose(file);
+}
+
+// Paksa isi file sampai ke disk, bukan hanya ke buffer stdio / page cache
+int sinkronkan_file(FILE *file) {
+    if (fflush(file) != 0) {
+        return 0;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// fsync direktori kerja agar hasil rename ikut tahan crash (hanya POSIX)
+void sinkronkan_direktori() {
+#ifndef _WIN32
+    int fd = open(".", O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    fsync(fd);
+    close(fd);
+#endif
+}
+
+// Ganti file `tujuan` dengan `sementara` yang sudah ditulis penuh; file ditutup di sini
+int ganti_file(FILE *file, const char *sementara, const char *tujuan) {
+    int berhasil = sinkronkan_file(file);
+    if (fclose(file) != 0 || !berhasil) {
+        remove(sementara);
+        return 0;
+    }
+#ifdef _WIN32
+    remove(tujuan); // rename di Windows gagal jika file tujuan sudah ada
+#endif
+    return rename(sementara, tujuan) == 0;
+}
+
+// Direktori tidak di-fsync di sini; pemanggil melakukannya sekali setelah semua rename
+void simpan_urutan_id(int id) {
+    FILE *file = fopen(NAMA_FILE_ID_SEMENTARA, "w");
+    if (file == NULL) {
+        perror("Error menyimpan urutan ID");
+        return;
+    }
+    fprintf(file, "%d\n", id);
+    if (!ganti_file(file, NAMA_FILE_ID_SEMENTARA, NAMA_FILE_ID)) {
+        perror("Error menyimpan urutan ID");
+    }
+}
+
+// --- PARSER FILE DATA ---
+// Field diurai langsung dari blok baca tanpa fscanf dan tanpa alokasi per baris.
+// Angka diurai manual sehingga tidak bergantung pada locale (pemisah desimal selalu '.').
+
+// Bilangan bulat bertanda; gagal bila tidak ada digit atau melampaui long long
+int urai_bulat(char **p, char *akhir, long long *hasil) {
+    char *q = *p;
+    int negatif = 0;
+    if (q < akhir && (*q == '-' || *q == '+')) {
+        negatif = (*q == '-');
+        q++;
+    }
+    if (q >= akhir || *q < '0' || *q > '9') {
+        return 0;
+    }
+    long long nilai = 0;
+    while (q < akhir && *q >= '0' && *q <= '9') {
+        int digit = *q - '0';
+        if (nilai > (LLONG_MAX - digit) / 10) {
+            return 0;
+        }
+        nilai = nilai * 10 + digit;
+        q++;
+    }
+    *hasil = negatif ? -nilai : nilai;
+    *p = q;
+    return 1;
+}
+
+// Bilangan desimal seperti "150000.50" (format yang ditulis simpan_data dengan %.2f)
+int urai_desimal(char **p, char *akhir, float *hasil) {
+    char *q = *p;
+    int negatif = 0;
+    if (q < akhir && (*q == '-' || *q == '+')) {
+        negatif = (*q == '-');
+        q++;
+    }
+    double nilai = 0;
+    int ada_digit = 0;
+    while (q < akhir && *q >= '0' && *q <= '9') {
+        nilai = nilai * 10 + (*q - '0');
+        ada_digit = 1;
+        q++;
+    }
+    if (q < akhir && *q == '.') {
+        q++;
+        long long pecahan = 0, pembagi = 1;
+        while (q < akhir && *q >= '0' && *q <= '9') {
+            if (pembagi < 1000000000LL) { // digit di luar presisi float diabaikan
+                pecahan = pecahan * 10 + (*q - '0');
+                pembagi *= 10;
+            }
+            ada_digit = 1;
+            q++;
+        }
+        nilai += (double)pecahan / pembagi;
+    }
+    if (!ada_digit) {
+        return 0;
+    }
+    *hasil = (float)(negatif ? -nilai : nilai);
+    *p = q;
+    return 1;
+}
+
+// Salin field teks sampai ';' berikutnya; gagal bila kosong atau tidak muat di `ukuran`
+int salin_field(char **p, char *akhir, char *tujuan, size_t ukuran) {
+    char *pemisah = memchr(*p, ';', akhir - *p);
+    if (pemisah == NULL) {
+        return 0;
+    }
+    size_t panjang = pemisah - *p;
+    if (panjang == 0 || panjang >= ukuran) {
+        return 0;
+    }
+    memcpy(tujuan, *p, panjang);
+    tujuan[panjang] = '\0';
+    *p = pemisah + 1;
+    return 1;
+}
+
+// Mengurai satu baris ID;Nama;Kategori;Harga;Stok;Timestamp ke `t`.
+// Mengembalikan NULL jika berhasil, atau alasan baris dianggap rusak.
+const char *urai_baris_tiket(char *baris, char *akhir, Tiket *t) {
+    char *p = baris;
+    long long nilai;
+
+    if (!urai_bulat(&p, akhir, &nilai) || nilai <= ID_NISAN || nilai > INT_MAX) {
+        return "ID tidak valid";
+    }
+    t->id = (int)nilai;
+    if (p >= akhir || *p++ != ';') {
+        return "pemisah ';' setelah ID tidak ditemukan";
+    }
+    if (!salin_field(&p, akhir, t->nama_konser, MAX_NAMA)) {
+        return "nama konser kosong atau terlalu panjang";
+    }
+    if (!salin_field(&p, akhir, t->kategori, MAX_KATEGORI)) {
+        return "kategori kosong atau terlalu panjang";
+    }
+    if (!urai_desimal(&p, akhir, &t->harga) || p >= akhir || *p++ != ';') {
+        return "harga tidak valid";
+    }
+    if (!urai_bulat(&p, akhir, &nilai) || nilai < 0 || nilai > INT_MAX || p >= akhir || *p++ != ';') {
+        return "stok tidak valid";
+    }
+    t->jumlah_stok = (int)nilai;
+    if (!urai_bulat(&p, akhir, &nilai)) {
+        return "timestamp tidak valid";
+    }
+    t->waktu_dibuat = (time_t)nilai;
+    if (p != akhir) {
+        return "ada karakter tambahan di akhir baris";
+    }
+    return NULL;
+}
+
+void laporkan_baris_rusak(int nomor_baris, const char *alasan, int *jumlah_rusak) {
+    (*jumlah_rusak)++;
+    if (*jumlah_rusak <= MAKS_LAPORAN_BARIS) {
+        printf("⚠️ Baris %d di %s dilewati: %s.\n", nomor_baris, NAMA_FILE, alasan);
+    }
+}
+
+// Urai satu baris (tanpa '\n') langsung ke slot berikutnya di daftar_tiket
+void proses_baris(char *baris, char *akhir, int nomor_baris, int *jumlah_rusak) {
+    if (akhir > baris && akhir[-1] == '\r') {
+        akhir--; // file yang disimpan dengan akhir baris Windows
+    }
+    if (akhir == baris) {
+        return; // baris kosong
+    }
+
+    // Array tumbuh geometris seiring pembacaan, tanpa perlu menghitung baris lebih dulu
+    if (!cadangkan_kapasitas(jumlah_tiket + 1)) {
+        perror("Error alokasi memori");
+        exit(EXIT_FAILURE);
+    }
+    const char *alasan = urai_baris_tiket(baris, akhir, &daftar_tiket[jumlah_tiket]);
+    if (alasan != NULL) {
+        laporkan_baris_rusak(nomor_baris, alasan, jumlah_rusak);
+        return;
+    }
+
+    // Jaga-jaga jika file data berisi ID di luar urutan tersimpan (misal diedit manual)
+    if (daftar_tiket[jumlah_tiket].id >= id_berikutnya) {
+        id_berikutnya = daftar_tiket[jumlah_tiket].id + 1;
+    }
+    jumlah_tiket++;
+}
+
+void muat_data() {
+    muat_urutan_id();
+
+    FILE *file = fopen(NAMA_FILE, "rb");
+    if (file == NULL) {
+        printf("File %s tidak ditemukan. Membuat data baru.\n", NAMA_FILE);
+        return;
+    }
+
+    // File dibaca per blok; baris yang terpotong di ujung blok digeser ke awal blok berikutnya
+    static char blok[UKURAN_BLOK_BACA];
+    size_t isi = 0;
+    int nomor_baris = 0;
+    int jumlah_rusak = 0;
+    int lewati_baris = 0; // sedang membuang sisa baris yang lebih panjang dari blok
+    int selesai = 0;
+
+    while (!selesai) {
+        size_t terbaca = fread(blok + isi, 1, UKURAN_BLOK_BACA - isi, file);
+        isi += terbaca;
+        if (terbaca == 0) {
+            selesai = 1; // sisa isi blok adalah baris terakhir tanpa '\n'
+        }
+
+        char *p = blok;
+        char *akhir_isi = blok + isi;
+        while (p < akhir_isi) {
+            char *akhir_baris = memchr(p, '\n', akhir_isi - p);
+            if (akhir_baris == NULL) {
+                if (!selesai) {
+                    break;
+                }
+                akhir_baris = akhir_isi;
+            }
+            if (lewati_baris) {
+                lewati_baris = 0;
+            } else {
+                proses_baris(p, akhir_baris, ++nomor_baris, &jumlah_rusak);
+            }
+            p = akhir_baris + 1;
+        }
+        if (p > akhir_isi) {
+            p = akhir_isi;
+        }
+
+        isi = akhir_isi - p;
+        memmove(blok, p, isi);
+        if (isi == UKURAN_BLOK_BACA) {
+            if (!lewati_baris) {
+                laporkan_baris_rusak(++nomor_baris, "baris terlalu panjang", &jumlah_rusak);
+            }
+            lewati_baris = 1;
+            isi = 0;
+        }
+    }
+
+    if (ferror(file)) {
+        perror("Error membaca file data");
+    }
+    fclose(file);
+
+    if (jumlah_rusak > 0) {
+        printf("⚠️ Total %d baris tidak valid dilewati dan tidak akan ikut tersimpan.\n", jumlah_rusak);
+    }
+    if (jumlah_tiket == 0) {
+        return;
+    }
+    bangun_kolom();
+    bangun_indeks_id();
+    bangun_heap_kadaluarsa();
+    bangun_teks_lipat();
+    bangun_indeks_trigram();
+    bangun_urutan(&urut_harga);
+    bangun_urutan(&urut_nama);
+    printf("✅ %d tiket berhasil dimuat dari %s.\n", jumlah_tiket, NAMA_FILE);
+}
+
+// --- PENULIS LATAR BELAKANG ---
+// simpan_data_latar() hanya menyalin tiket aktif (urut tampilan) ke penyangga lalu kembali;
+// utas penulis memformat teks ke NAMA_FILE_SEMENTARA lalu rename ke NAMA_FILE, sehingga file
+// lama tetap utuh sampai file baru selesai. Ada dua penyangga: satu sedang ditulis penulis,
+// satu diisi utas utama. Permintaan yang datang selagi penulis sibuk menimpa penyangga yang
+// menunggu, jadi hanya snapshot terbaru yang ditulis. simpan_data() = minta + tunggu.
+typedef struct {
+    Tiket *isi;
+    int jumlah;
+    int kapasitas;
+    int id_berikutnya;
+} PenyanggaSimpan;
+PenyanggaSimpan penyangga_simpan[2];
+int penyangga_antre = -1;  // penyangga yang menunggu ditulis, -1 = tidak ada
+int penyangga_ditulis = -1; // penyangga yang sedang ditulis penulis
+int simpan_gagal = 0;       // ada penulisan yang gagal sejak tunggu_simpan() terakhir
+#if PAKAI_PENULIS
+pthread_mutex_t kunci_simpan = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t sinyal_simpan = PTHREAD_COND_INITIALIZER; // ada permintaan baru, atau penulis selesai
+pthread_t utas_penulis;
+int penulis_hidup = 0;
+int penulis_berhenti = 0;
+#endif
+
+// Tulis isi penyangga sebagai file data utuh lewat file sementara + fsync + rename + fsync direktori,
+// sehingga setelah crash yang ada di disk selalu file lama atau file baru yang lengkap; 1 jika berhasil
+int tulis_penyangga(const PenyanggaSimpan *p) {
+    FILE *file = fopen(NAMA_FILE_SEMENTARA, "w");
+    if (file == NULL) {
+        perror("Error membuka file untuk menyimpan");
+        return 0;
+    }
+    for (int k = 0; k < p->jumlah; k++) {
+        const Tiket *t = &p->isi[k];
+        // Format: ID;NamaKonser;Kategori;Harga;Stok;Timestamp
+        fprintf(file, "%d;%s;%s;%.2f;%d;%ld\n",
+                t->id, t->nama_konser, t->kategori, t->harga, t->jumlah_stok, (long)t->waktu_dibuat);
+    }
+    if (!ganti_file(file, NAMA_FILE_SEMENTARA, NAMA_FILE)) {
+        perror("Error menulis file data");
+        return 0;
+    }
+    simpan_urutan_id(p->id_berikutnya);
+    sinkronkan_direktori();
+    return 1;
+}
+
+// Salin tiket aktif menurut urutan tampilan (urutan hasil sorting ikut tersimpan); 0 jika gagal alokasi
+int isi_penyangga(PenyanggaSimpan *p) {
+    int n = siapkan_tampilan();
+    if (n > p->kapasitas) {
+        Tiket *baru = (Tiket *)realloc(p->isi, n * sizeof(Tiket));
+        if (baru == NULL) {
+            return 0;
+        }
+        p->isi = baru;
+        p->kapasitas = n;
+    }
+    p->jumlah = 0;
+    for (int k = 0; k < n; k++) {
+        int i = posisi_tampilan(k);
+        if (kolom_id[i] != ID_NISAN) {
+            p->isi[p->jumlah++] = daftar_tiket[i];
+        }
+    }
+    p->id_berikutnya = id_berikutnya;
+    return 1;
+}
+
+#if PAKAI_PENULIS
+void *jalankan_penulis(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&kunci_simpan);
+    for (;;) {
+        while (penyangga_antre < 0 && !penulis_berhenti) {
+            pthread_cond_wait(&sinyal_simpan, &kunci_simpan);
+        }
+        if (penyangga_antre < 0) {
+            break;
+        }
+        penyangga_ditulis = penyangga_antre;
+        penyangga_antre = -1;
+        pthread_mutex_unlock(&kunci_simpan);
+        int berhasil = tulis_penyangga(&penyangga_simpan[penyangga_ditulis]);
+        pthread_mutex_lock(&kunci_simpan);
+        if (!berhasil) {
+            simpan_gagal = 1;
+        }
+        penyangga_ditulis = -1;
+        pthread_cond_broadcast(&sinyal_simpan);
+    }
+    pthread_mutex_unlock(&kunci_simpan);
+    return NULL;
+}
+#endif
+
+// Ambil snapshot dan serahkan ke utas penulis tanpa menunggu disk
+void simpan_data_latar() {
+#if PAKAI_PENULIS
+    pthread_mutex_lock(&kunci_simpan);
+    PenyanggaSimpan *p = &penyangga_simpan[penyangga_ditulis == 0 ? 1 : 0];
+    if (!isi_penyangga(p)) {
+        perror("Error menyiapkan data untuk disimpan");
+        simpan_gagal = 1;
+        pthread_mutex_unlock(&kunci_simpan);
+        return;
+    }
+    penyangga_antre = (int)(p - penyangga_simpan);
+    if (!penulis_hidup) {
+        penulis_berhenti = 0;
+        penulis_hidup = pthread_create(&utas_penulis, NULL, jalankan_penulis, NULL) == 0;
+    }
+    if (penulis_hidup) {
+        pthread_cond_broadcast(&sinyal_simpan);
+        pthread_mutex_unlock(&kunci_simpan);
+        return;
+    }
+    penyangga_antre = -1; // utas tidak bisa dibuat: tulis langsung di utas ini
+    pthread_mutex_unlock(&kunci_simpan);
+#else
+    PenyanggaSimpan *p = &penyangga_simpan[0];
+    if (!isi_penyangga(p)) {
+        perror("Error menyiapkan data untuk disimpan");
+        simpan_gagal = 1;
+        return;
+    }
+#endif
+    if (!tulis_penyangga(p)) {
+        simpan_gagal = 1;
+    }
+}
 
-// Konversi time_t ke string format
-void time_to_str(time_t t, char *buffer, size_t buf_size) {
-    strftime(buffer, buf_size, "%Y-%m-%d %H:%M:%S", localtime(&t));
+// Penghalang: kembali setelah semua simpan yang sudah diminta selesai ditulis; 1 jika semuanya berhasil
+int tunggu_simpan() {
+#if PAKAI_PENULIS
+    pthread_mutex_lock(&kunci_simpan);
+    while (penyangga_antre >= 0 || penyangga_ditulis >= 0) {
+        pthread_cond_wait(&sinyal_simpan, &kunci_simpan);
+    }
+#endif
+    int berhasil = !simpan_gagal;
+    simpan_gagal = 0;
+#if PAKAI_PENULIS
+    pthread_mutex_unlock(&kunci_simpan);
+#endif
+    return berhasil;
 }
 
-// Menampilkan detail satu tiket
-void tampilkan_tiket_detail(const Tiket *t) {
-    char tgl_str[30];
-    time_to_str(t->waktu_dibuat, tgl_str, sizeof(tgl_str));
-    
-    printf("---------------------------------\n");
-    printf("  ID Tiket    : %d\n", t->id);
-    printf("  Nama Konser : %s\n", t->nama_konser);
-    printf("  Kategori    : %s\n", t->kategori);
-    printf("  Harga       : Rp %.2f\n", t->harga);
-    printf("  Jumlah      : %d\n", t->jumlah_stok);
-    printf("  Tgl Dibuat  : %s\n", tgl_str);
+// Hentikan utas penulis (setelah antrean habis) dan lepas kedua penyangga
+void hentikan_penulis() {
+#if PAKAI_PENULIS
+    if (penulis_hidup) {
+        pthread_mutex_lock(&kunci_simpan);
+        penulis_berhenti = 1;
+        pthread_cond_broadcast(&sinyal_simpan);
+        pthread_mutex_unlock(&kunci_simpan);
+        pthread_join(utas_penulis, NULL);
+        penulis_hidup = 0;
+    }
+#endif
+    for (int b = 0; b < 2; b++) {
+        free(penyangga_simpan[b].isi);
+        penyangga_simpan[b].isi = NULL;
+        penyangga_simpan[b].jumlah = 0;
+        penyangga_simpan[b].kapasitas = 0;
+    }
 }
 
-// Mencari ID tertinggi untuk ID unik baru
-int buat_id_unik() {
-    int max_id = 0;
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id > max_id) {
-            max_id = daftar_tiket[i].id;
-        }
+// Simpan sinkron (keluar dari program): minta snapshot lalu tunggu sampai selesai di disk
+void simpan_data() {
+    simpan_data_latar();
+    if (tunggu_simpan()) {
+        printf("\n✅ Data berhasil disimpan ke %s.\n", NAMA_FILE);
     }
-    return max_id + 1;
 }
 
-// --- FUNGSI I/O FILE (MEMBACA/MENYIMPAN) ---
+// --- OPERASI INTI ---
+// Dipakai bersama oleh menu interaktif dan mode batch; tidak mencetak apa pun.
 
-void muat_data() {
-    FILE *file = fopen(NAMA_FILE, "r");
-    if (file == NULL) {
-        printf("File %s tidak ditemukan. Membuat data baru.\n", NAMA_FILE);
-        return;
+// Tambahkan salinan `t` (ID sudah terisi) ke akhir array beserta indeksnya. 0 jika gagal alokasi.
+int masukkan_tiket(const Tiket *t) {
+    if (!cadangkan_kapasitas(jumlah_tiket + 1)) {
+        return 0;
     }
+    daftar_tiket[jumlah_tiket] = *t;
+    jumlah_tiket++;
+    isi_kolom(jumlah_tiket - 1);
+    indeks_tambah(jumlah_tiket - 1);
+    urutan_tambah(&urut_harga, jumlah_tiket - 1);
+    urutan_tambah(&urut_nama, jumlah_tiket - 1);
+    kadaluarsa_tambah(jumlah_tiket - 1);
+    pohon_harga_tambah(t->harga, t->id);
+    lipat_tiket(jumlah_tiket - 1);
+    kategori_pasang(jumlah_tiket - 1);
+    trigram_tambah(t->id, t->nama_konser, 1);
+    return 1;
+}
 
-    int count = 0;
-    Tiket temp_tiket;
+// Ganti nama tiket di `posisi` (sudah divalidasi muat di MAX_NAMA) dan perbarui indeks trigram
+void ganti_nama_tiket(int posisi, const char *nama) {
+    strcpy(daftar_tiket[posisi].nama_konser, nama);
+    urutan_ubah(&urut_nama, posisi);
+    lipat_tiket(posisi);
+    trigram_tambah(daftar_tiket[posisi].id, nama, 1);
+    trigram_catat_basi();
+}
 
-    // Hitung jumlah baris/tiket
-    while (fscanf(file, "%d;%[^;];%[^;];%f;%d;%ld\n", 
-                  &temp_tiket.id, 
-                  temp_tiket.nama_konser, 
-                  temp_tiket.kategori, 
-                  &temp_tiket.harga, 
-                  &temp_tiket.jumlah_stok, 
-                  &temp_tiket.waktu_dibuat) == 6) {
-        count++;
+// Hapus tiket berdasarkan ID (ditandai nisan). 0 jika ID tidak ditemukan.
+int hapus_tiket_id(int id) {
+    int i = cari_indeks_id(id);
+    if (i < 0) {
+        return 0;
     }
+    tandai_nisan(i);
+    padatkan_jika_perlu();
+    return 1;
+}
 
-    if (count == 0) {
-        fclose(file);
+// Pilih urutan daftar: 1 = harga termurah, 2 = harga termahal, 3 = nama konser A-Z.
+// Tiket tidak dipindah; indeksnya cukup dirapikan (O(n) bila hanya sedikit yang berubah sejak terakhir).
+void urutkan_tiket(int kriteria) {
+    if (kriteria < 1 || kriteria > 3) {
         return;
     }
+    urutan_tampilan = kriteria;
+    siapkan_tampilan();
+}
 
-    // Alokasi memori
-    daftar_tiket = (Tiket *)malloc(count * sizeof(Tiket));
-    if (daftar_tiket == NULL) {
-        perror("Error alokasi memori");
-        exit(EXIT_FAILURE);
+// Kurangi stok tiket `id` sebanyak `jumlah`; stok akhir ditulis ke `stok_sesudah`.
+// Mengembalikan salah satu BELI_*.
+int beli_stok(int id, int jumlah, int *stok_sesudah) {
+    if (jumlah <= 0) {
+        return BELI_JUMLAH_TIDAK_VALID;
+    }
+    int i = cari_indeks_id(id);
+    if (i < 0) {
+        return BELI_TIDAK_DITEMUKAN;
     }
-    jumlah_tiket = count;
+    if (kolom_stok[i] < jumlah) {
+        return BELI_STOK_KURANG;
+    }
+    atur_stok(i, kolom_stok[i] - jumlah);
+    *stok_sesudah = kolom_stok[i];
+    return BELI_BERHASIL;
+}
 
-    // Reset pointer file ke awal
-    fseek(file, 0, SEEK_SET);
+// Aturan pencarian: ID sama persis, atau keyword ada di nama/kategori (tanpa membedakan huruf besar/kecil).
+// Mengisi `*posisi` (dibebaskan pemanggil) dengan posisi tiket yang cocok, mengikuti urutan tampilan.
+int cari_posisi_keyword(const char *keyword, int **posisi) {
+    int posisi_id = cari_indeks_id(atoi(keyword));
+    
+    // Keyword di-casefold sekali; nama dan kategori tiket sudah tersedia dalam bentuk casefold
+    char lower_keyword[MAX_NAMA];
+    size_t panjang_keyword = lipat_teks(lower_keyword, keyword, sizeof(lower_keyword));
 
-    // Baca data ke memori
-    for (int i = 0; i < jumlah_tiket; i++) {
-        fscanf(file, "%d;%[^;];%[^;];%f;%d;%ld\n", 
-               &daftar_tiket[i].id, 
-               daftar_tiket[i].nama_konser, 
-               daftar_tiket[i].kategori, 
-               &daftar_tiket[i].harga, 
-               &daftar_tiket[i].jumlah_stok, 
-               &daftar_tiket[i].waktu_dibuat);
+    // Semua yang cocok ditandai di satu bitmap slot: kategori, nama, lalu ID
+    uint64_t *cocok = (uint64_t *)calloc(kata_bitmap_kategori + 1, sizeof(uint64_t));
+    *posisi = (int *)malloc((jumlah_tiket + 1) * sizeof(int));
+    if (cocok == NULL || *posisi == NULL) {
+        free(cocok);
+        return 0;
     }
-    
-    fclose(file);
-    printf("✅ %d tiket berhasil dimuat dari %s.\n", jumlah_tiket, NAMA_FILE);
-}
 
-void simpan_data() {
-    FILE *file = fopen(NAMA_FILE, "w");
-    if (file == NULL) {
-        perror("Error membuka file untuk menyimpan");
-        return;
+    // Kategori: cukup mencocokkan setiap entri kamus lalu menggabungkan bitmap-nya
+    for (int kode = 1; kode < jumlah_kode_kategori; kode++) {
+        const char *nama = kamus_kategori[kode].nama;
+        if (!memuat_lipat(nama, strlen(nama), MAX_KATEGORI, lower_keyword, panjang_keyword)) {
+            continue;
+        }
+        for (int w = 0; w < kata_bitmap_kategori; w++) {
+            cocok[w] |= kamus_kategori[kode].bitmap[w];
+        }
+    }
+    // Kategori di luar kamus (kode 0) dicocokkan langsung dari teks aslinya; kernel ikut casefold
+    for (int w = 0; w < kata_bitmap_kategori; w++) {
+        for (uint64_t bit = kamus_kategori[0].bitmap[w]; bit; bit &= bit - 1) {
+            int i = w * 64 + __builtin_ctzll(bit);
+            const char *kategori = daftar_tiket[i].kategori;
+            if (memuat_lipat(kategori, strlen(kategori), MAX_KATEGORI, lower_keyword, panjang_keyword)) {
+                cocok[w] |= bit & -bit;
+            }
+        }
     }
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        // Format: ID;NamaKonser;Kategori;Harga;Stok;Timestamp
-        fprintf(file, "%d;%s;%s;%.2f;%d;%ld\n", 
-                daftar_tiket[i].id, 
-                daftar_tiket[i].nama_konser, 
-                daftar_tiket[i].kategori, 
-                daftar_tiket[i].harga, 
-                daftar_tiket[i].jumlah_stok, 
-                (long)daftar_tiket[i].waktu_dibuat);
+    // Nama lewat indeks trigram
+    int *posisi_nama;
+    int jumlah_nama = cari_posisi_nama(lower_keyword, &posisi_nama);
+    for (int k = 0; k < jumlah_nama; k++) {
+        cocok[posisi_nama[k] >> 6] |= 1ULL << (posisi_nama[k] & 63);
+    }
+    free(posisi_nama);
+    if (posisi_id >= 0) {
+        cocok[posisi_id >> 6] |= 1ULL << (posisi_id & 63);
     }
 
-    fclose(file);
-    printf("\n✅ Data berhasil disimpan ke %s.\n", NAMA_FILE);
+    int jumlah = 0;
+    for (int w = 0; w < kata_bitmap_kategori; w++) {
+        for (uint64_t bit = cocok[w]; bit; bit &= bit - 1) {
+            (*posisi)[jumlah++] = w * 64 + __builtin_ctzll(bit);
+        }
+    }
+    free(cocok);
+    urutkan_hasil_tampilan(*posisi, jumlah);
+    return jumlah;
 }
 
 // --- FUNGSI CRUD & TAMBAHAN ---
@@ -152,17 +2790,9 @@ void simpan_data() {
 void tambah_tiket() {
     printf("\n--- Tambah Tiket Baru ---\n");
     
-    // Alokasi ulang memori untuk tiket baru
-    Tiket *temp = (Tiket *)realloc(daftar_tiket, (jumlah_tiket + 1) * sizeof(Tiket));
-    if (temp == NULL) {
-        perror("Error re-alokasi memori");
-        return;
-    }
-    daftar_tiket = temp;
+    Tiket baru;
+    Tiket *new_tiket = &baru;
 
-    Tiket *new_tiket = &daftar_tiket[jumlah_tiket];
-
-    new_tiket->id = buat_id_unik();
     printf("Nama Konser: ");
     scanf(" %49[^\n]", new_tiket->nama_konser);
     printf("Kategori (e.g., VIP, Reguler): ");
@@ -191,26 +2821,45 @@ void tambah_tiket() {
     
     new_tiket->waktu_dibuat = time(NULL); // Catat waktu saat dibuat
 
-    jumlah_tiket++;
+    // ID baru diambil setelah input lengkap, tepat sebelum tiket dimasukkan
+    new_tiket->id = buat_id_unik();
+    if (!masukkan_tiket(new_tiket)) {
+        perror("Error re-alokasi memori");
+        return;
+    }
     printf("\n✅ Tiket ID %d berhasil ditambahkan.\n", new_tiket->id);
 }
 
 // 2. READ
 void lihat_semua_tiket() {
     printf("\n--- Daftar Semua Tiket ---\n");
-    if (jumlah_tiket == 0) {
+    if (jumlah_tiket_aktif() == 0) {
         printf("Belum ada data tiket.\n");
         return;
     }
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        tampilkan_tiket_detail(&daftar_tiket[i]);
+    int posisi[UKURAN_HALAMAN];
+    int mulai = 0;
+    int kursor;
+    while (1) {
+        int jumlah = ambil_halaman(mulai, UKURAN_HALAMAN, 0, posisi, &kursor);
+        for (int k = 0; k < jumlah; k++) {
+            susun_tiket_detail(&daftar_tiket[posisi[k]]);
+        }
+        tampil_siram();
+        if (kursor == 0) {
+            break;
+        }
+        mulai = letak_kursor(kursor);
+        if (mulai < 0 || mulai >= siapkan_tampilan() || !lanjut_halaman()) {
+            break;
+        }
     }
 }
 
 // 3. SEARCH
 void cari_tiket() {
-    if (jumlah_tiket == 0) {
+    if (jumlah_tiket_aktif() == 0) {
         printf("\nBelum ada data tiket untuk dicari.\n");
         return;
     }
@@ -220,34 +2869,13 @@ void cari_tiket() {
     printf("Masukkan ID, Nama Konser, atau Kategori: ");
     scanf(" %49[^\n]", keyword);
     
-    int ditemukan = 0;
-    
-    // Konversi keyword ke lowercase untuk pencarian non-case-sensitive
-    char lower_keyword[MAX_NAMA];
-    strcpy(lower_keyword, keyword);
-    for(int i = 0; lower_keyword[i]; i++){
-        lower_keyword[i] = tolower(lower_keyword[i]);
-    }
-
-    for (int i = 0; i < jumlah_tiket; i++) {
-        char nama_lower[MAX_NAMA], kategori_lower[MAX_KATEGORI];
-        
-        // Konversi nama & kategori tiket ke lowercase
-        strcpy(nama_lower, daftar_tiket[i].nama_konser);
-        for(int j = 0; nama_lower[j]; j++) nama_lower[j] = tolower(nama_lower[j]);
-
-        strcpy(kategori_lower, daftar_tiket[i].kategori);
-        for(int j = 0; kategori_lower[j]; j++) kategori_lower[j] = tolower(kategori_lower[j]);
-
-        // Cek
-        if (daftar_tiket[i].id == atoi(keyword) || 
-            strstr(nama_lower, lower_keyword) != NULL ||
-            strstr(kategori_lower, lower_keyword) != NULL) 
-        {
-            tampilkan_tiket_detail(&daftar_tiket[i]);
-            ditemukan++;
-        }
+    int *posisi;
+    int ditemukan = cari_posisi_keyword(keyword, &posisi);
+    for (int k = 0; k < ditemukan; k++) {
+        susun_tiket_detail(&daftar_tiket[posisi[k]]);
     }
+    tampil_siram();
+    free(posisi);
 
     if (ditemukan == 0) {
         printf("\n❌ Tiket tidak ditemukan.\n");
@@ -267,48 +2895,50 @@ void update_tiket() {
         return;
     }
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id == id_update) {
-            printf("\n--- Update Tiket ID %d ---\n", id_update);
-            tampilkan_tiket_detail(&daftar_tiket[i]);
-            
-            // Nama Konser
-            printf("Nama Konser baru (%s, ketik ENTER untuk skip): ", daftar_tiket[i].nama_konser);
-            char temp_nama[MAX_NAMA];
-            while (getchar() != '\n'); // Bersihkan buffer
-            if (fgets(temp_nama, MAX_NAMA, stdin) != NULL && strlen(temp_nama) > 1) {
-                temp_nama[strcspn(temp_nama, "\n")] = 0; // Hapus newline
-                strcpy(daftar_tiket[i].nama_konser, temp_nama);
-            }
+    int i = cari_indeks_id(id_update);
+    if (i < 0) {
+        printf("\n❌ Tiket dengan ID %d tidak ditemukan.\n", id_update);
+        return;
+    }
 
-            // Kategori
-            printf("Kategori baru (%s, ketik ENTER untuk skip): ", daftar_tiket[i].kategori);
-            char temp_kategori[MAX_KATEGORI];
-            if (fgets(temp_kategori, MAX_KATEGORI, stdin) != NULL && strlen(temp_kategori) > 1) {
-                temp_kategori[strcspn(temp_kategori, "\n")] = 0;
-                strcpy(daftar_tiket[i].kategori, temp_kategori);
-            }
-            
-            // Harga
-            float new_harga;
-            printf("Harga baru (%.2f, ketik 0 dan ENTER untuk skip): ", daftar_tiket[i].harga);
-            if (scanf("%f", &new_harga) == 1 && new_harga > 0) {
-                daftar_tiket[i].harga = new_harga;
-            }
-            
-            // Stok
-            int new_stok;
-            printf("Jumlah Stok baru (%d, ketik -1 dan ENTER untuk skip): ", daftar_tiket[i].jumlah_stok);
-            if (scanf("%d", &new_stok) == 1 && new_stok >= 0) {
-                daftar_tiket[i].jumlah_stok = new_stok;
-            }
-            
-            printf("\n✅ Tiket ID %d berhasil di-update.\n", id_update);
-            return;
-        }
+    printf("\n--- Update Tiket ID %d ---\n", id_update);
+    tampilkan_tiket_detail(&daftar_tiket[i]);
+    
+    // Nama Konser
+    printf("Nama Konser baru (%s, ketik ENTER untuk skip): ", daftar_tiket[i].nama_konser);
+    char temp_nama[MAX_NAMA];
+    while (getchar() != '\n'); // Bersihkan buffer
+    if (fgets(temp_nama, MAX_NAMA, stdin) != NULL && strlen(temp_nama) > 1) {
+        temp_nama[strcspn(temp_nama, "\n")] = 0; // Hapus newline
+        ganti_nama_tiket(i, temp_nama);
+    }
+
+    // Kategori
+    printf("Kategori baru (%s, ketik ENTER untuk skip): ", daftar_tiket[i].kategori);
+    char temp_kategori[MAX_KATEGORI];
+    if (fgets(temp_kategori, MAX_KATEGORI, stdin) != NULL && strlen(temp_kategori) > 1) {
+        temp_kategori[strcspn(temp_kategori, "\n")] = 0;
+        strcpy(daftar_tiket[i].kategori, temp_kategori);
+        kategori_lepas(i);
+        lipat_tiket(i);
+        kategori_pasang(i);
+    }
+    
+    // Harga
+    float new_harga;
+    printf("Harga baru (%.2f, ketik 0 dan ENTER untuk skip): ", daftar_tiket[i].harga);
+    if (scanf("%f", &new_harga) == 1 && new_harga > 0) {
+        atur_harga(i, new_harga);
     }
     
-    printf("\n❌ Tiket dengan ID %d tidak ditemukan.\n", id_update);
+    // Stok
+    int new_stok;
+    printf("Jumlah Stok baru (%d, ketik -1 dan ENTER untuk skip): ", daftar_tiket[i].jumlah_stok);
+    if (scanf("%d", &new_stok) == 1 && new_stok >= 0) {
+        atur_stok(i, new_stok);
+    }
+    
+    printf("\n✅ Tiket ID %d berhasil di-update.\n", id_update);
 }
 
 // 5. DELETE
@@ -322,40 +2952,18 @@ void hapus_tiket() {
         return;
     }
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id == id_hapus) {
-            // Geser semua elemen setelah indeks i ke depan
-            for (int j = i; j < jumlah_tiket - 1; j++) {
-                daftar_tiket[j] = daftar_tiket[j + 1];
-            }
-            
-            jumlah_tiket--;
-            
-            // Alokasi ulang memori (memperkecil ukuran array)
-            if (jumlah_tiket == 0) {
-                free(daftar_tiket);
-                daftar_tiket = NULL;
-            } else {
-                Tiket *temp = (Tiket *)realloc(daftar_tiket, jumlah_tiket * sizeof(Tiket));
-                if (temp == NULL) {
-                    perror("Error re-alokasi memori setelah hapus");
-                    // Sebaiknya program diakhiri atau ditangani lebih lanjut
-                } else {
-                    daftar_tiket = temp;
-                }
-            }
-
-            printf("\n✅ Tiket ID %d berhasil dihapus.\n", id_hapus);
-            return;
-        }
+    // Cukup tandai sebagai nisan; elemen setelah indeks i tidak digeser
+    if (!hapus_tiket_id(id_hapus)) {
+        printf("\n❌ Tiket dengan ID %d tidak ditemukan.\n", id_hapus);
+        return;
     }
 
-    printf("\n❌ Tiket dengan ID %d tidak ditemukan.\n", id_hapus);
+    printf("\n✅ Tiket ID %d berhasil dihapus.\n", id_hapus);
 }
 
-// 6. SORTING (Menggunakan Bubble Sort sebagai contoh)
+// 6. SORTING (memilih indeks urutan; data tidak dipindah)
 void sorting_tiket() {
-    if (jumlah_tiket < 2) {
+    if (jumlah_tiket_aktif() < 2) {
         printf("\nMinimal 2 tiket untuk melakukan sorting.\n");
         return;
     }
@@ -372,22 +2980,7 @@ void sorting_tiket() {
         return;
     }
     
-    for (int i = 0; i < jumlah_tiket - 1; i++) {
-        for (int j = 0; j < jumlah_tiket - i - 1; j++) {
-            int tukar = 0;
-            
-            if (pilihan == 1 && daftar_tiket[j].harga > daftar_tiket[j+1].harga) tukar = 1;
-            if (pilihan == 2 && daftar_tiket[j].harga < daftar_tiket[j+1].harga) tukar = 1;
-            if (pilihan == 3 && strcmp(daftar_tiket[j].nama_konser, daftar_tiket[j+1].nama_konser) > 0) tukar = 1;
-            
-            if (tukar) {
-                Tiket temp = daftar_tiket[j];
-                daftar_tiket[j] = daftar_tiket[j+1];
-                daftar_tiket[j+1] = temp;
-            }
-        }
-    }
-    
+    urutkan_tiket(pilihan);
     printf("\n✅ Data berhasil diurutkan.\n");
     lihat_semua_tiket();
 }
@@ -397,13 +2990,12 @@ void update_otomatis_kadaluarsa() {
     time_t sekarang = time(NULL);
     int tiket_diupdate = 0;
     
-    for (int i = 0; i < jumlah_tiket; i++) {
-        // Jika waktu sekarang dikurangi waktu dibuat lebih dari batas kadaluarsa
-        if (sekarang - daftar_tiket[i].waktu_dibuat > KADALUARSA_DETIK) {
-            if (daftar_tiket[i].jumlah_stok > 0) {
-                daftar_tiket[i].jumlah_stok = 0;
-                tiket_diupdate++;
-            }
+    // Heap hanya mengeluarkan tiket yang waktu dibuatnya sudah lewat batas kadaluarsa
+    int i;
+    while ((i = ambil_tiket_kadaluarsa(sekarang)) >= 0) {
+        if (kolom_stok[i] > 0) {
+            atur_stok(i, 0);
+            tiket_diupdate++;
         }
     }
 
@@ -412,6 +3004,472 @@ void update_otomatis_kadaluarsa() {
     }
 }
 
+// Dipanggil di setiap putaran menu agar sesi yang lama tetap mengikuti batas kadaluarsa.
+// O(1) selama belum ada tiket yang lewat batas.
+void periksa_kadaluarsa_berkala() {
+    if (ada_tiket_kadaluarsa(time(NULL))) {
+        update_otomatis_kadaluarsa();
+    }
+}
+
+// 8. CARI RENTANG HARGA (urut harga, per halaman; kategori boleh dikosongkan)
+void cari_rentang_harga() {
+    float harga_min, harga_max;
+    char kategori[MAX_KATEGORI];
+    printf("\n--- Cari Tiket per Rentang Harga ---\n");
+    printf("Harga minimum: Rp");
+    if (scanf("%f", &harga_min) != 1 || !(harga_min >= 0)) {
+        printf("\n❌ Harga tidak valid.\n");
+        while (getchar() != '\n');
+        return;
+    }
+    while (getchar() != '\n');
+    printf("Harga maksimum: Rp");
+    if (scanf("%f", &harga_max) != 1 || !(harga_max >= harga_min)) {
+        printf("\n❌ Harga maksimum harus >= harga minimum.\n");
+        while (getchar() != '\n');
+        return;
+    }
+    while (getchar() != '\n');
+    printf("Kategori (kosongkan untuk semua): ");
+    if (fgets(kategori, sizeof(kategori), stdin) == NULL) {
+        return;
+    }
+    if (strchr(kategori, '\n') == NULL) {
+        int c;
+        while ((c = getchar()) != '\n' && c != EOF);
+    }
+    kategori[strcspn(kategori, "\n")] = 0;
+    lipat_teks(kategori, kategori, sizeof(kategori));
+    const char *saring = kategori[0] != '\0' ? kategori : NULL;
+
+    int posisi[UKURAN_HALAMAN];
+    int kursor;
+    int ditemukan = 0;
+    int jumlah = ambil_rentang_harga(harga_min, harga_max, 0, 0, saring, posisi, UKURAN_HALAMAN, &kursor);
+    while (jumlah > 0) {
+        for (int k = 0; k < jumlah; k++) {
+            susun_tiket_detail(&daftar_tiket[posisi[k]]);
+        }
+        tampil_siram();
+        ditemukan += jumlah;
+        if (kursor == 0 || !lanjut_halaman()) {
+            break;
+        }
+        jumlah = ambil_rentang_harga(harga_min, harga_max, kursor, 0, saring, posisi, UKURAN_HALAMAN, &kursor);
+    }
+
+    if (ditemukan == 0) {
+        printf("\n❌ Tidak ada tiket di rentang harga ini.\n");
+    } else {
+        printf("\n✅ Ditampilkan %d tiket.\n", ditemukan);
+    }
+}
+
+// --- MODE BATCH ---
+// ./tiket --batch [file]   (tanpa file atau "-": perintah dibaca dari stdin)
+// Satu perintah per baris; baris kosong dan baris berawalan '#' dilewati:
+//   ADD nama;kategori;harga;stok      BUY id jumlah      DELETE id
+//   UPDATE id NAMA|KATEGORI|HARGA|STOK nilai
+//   SEARCH keyword (aturan sama dengan menu Cari Tiket)
+//   SORT HARGA|HARGA_TURUN|NAMA       LIST               SAVE
+//   LIST offset batas                 LIST SETELAH id batas (satu halaman)
+//   KATEGORI (jumlah tiket per kategori)                  TERMURAH k (k tiket termurah, stok > 0)
+//   RENTANG min max batas [SETELAH id] [TERSEDIA] [KATEGORI nama] (harga min..max, urut harga)
+// Setiap perintah menghasilkan tepat satu baris "OK <PERINTAH> ..." atau "ERR <baris> <alasan>";
+// halaman diakhiri "OK LIST|RENTANG jumlah kursor" (kursor = ID untuk SETELAH berikutnya, 0 = sudah habis).
+// LIST, TERMURAH, RENTANG dan SEARCH didahului baris "TIKET id;nama;kategori;harga;stok;timestamp", dan KATEGORI
+// didahului baris "KATEGORI nama_casefold;jumlah" (nama "*" = kategori di luar kamus).
+// SAVE hanya mengantre snapshot ke utas penulis; di akhir masukan data disimpan seperti pilihan
+// "Simpan & Keluar", yang menunggu semua penulisan selesai.
+
+FILE *keluaran_batch = NULL; // stdout asli; pesan biasa dialihkan ke stderr selama mode batch
+
+int gagal_batch(int nomor_baris, const char *alasan) {
+    fprintf(keluaran_batch, "ERR %d %s\n", nomor_baris, alasan);
+    return 0;
+}
+
+// Baris TIKET lewat buffer tampilan; pemanggil menyiram sebelum baris OK
+void tulis_tiket_batch(const Tiket *t) {
+    tampil_ke(keluaran_batch);
+    tampil_str("TIKET ");
+    tampil_int(t->id);
+    tampil_str(";");
+    tampil_str(t->nama_konser);
+    tampil_str(";");
+    tampil_str(t->kategori);
+    tampil_str(";");
+    tampil_harga(t->harga);
+    tampil_str(";");
+    tampil_int(t->jumlah_stok);
+    tampil_str(";");
+    tampil_int((long)t->waktu_dibuat);
+    tampil_str("\n");
+}
+
+// Nilai teks untuk UPDATE: tidak kosong, muat di `ukuran`, dan tanpa ';' (pemisah file data)
+int teks_batch_valid(const char *teks, size_t ukuran) {
+    return teks[0] != '\0' && strlen(teks) < ukuran && strchr(teks, ';') == NULL;
+}
+
+// ADD nama;kategori;harga;stok (diurai dengan parser yang sama seperti file data)
+int batch_add(char *arg, int nomor_baris) {
+    char *p = arg;
+    char *akhir = arg + strlen(arg);
+    long long stok;
+    Tiket baru;
+
+    if (!salin_field(&p, akhir, baru.nama_konser, MAX_NAMA) ||
+        !salin_field(&p, akhir, baru.kategori, MAX_KATEGORI) ||
+        !urai_desimal(&p, akhir, &baru.harga) || baru.harga < 0 || p >= akhir || *p++ != ';' ||
+        !urai_bulat(&p, akhir, &stok) || stok < 0 || stok > INT_MAX || p != akhir) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    baru.jumlah_stok = (int)stok;
+    baru.id = buat_id_unik();
+    baru.waktu_dibuat = time(NULL);
+    if (!masukkan_tiket(&baru)) {
+        return gagal_batch(nomor_baris, "gagal_alokasi");
+    }
+    fprintf(keluaran_batch, "OK ADD %d\n", baru.id);
+    return 1;
+}
+
+// BUY id jumlah
+int batch_buy(char *arg, int nomor_baris) {
+    int id, jumlah, stok_sesudah = 0, n = 0;
+    if (sscanf(arg, "%d %d %n", &id, &jumlah, &n) != 2 || arg[n] != '\0') {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    switch (beli_stok(id, jumlah, &stok_sesudah)) {
+        case BELI_TIDAK_DITEMUKAN: return gagal_batch(nomor_baris, "tidak_ditemukan");
+        case BELI_STOK_KURANG: return gagal_batch(nomor_baris, "stok_kurang");
+        case BELI_JUMLAH_TIDAK_VALID: return gagal_batch(nomor_baris, "jumlah_tidak_valid");
+    }
+    fprintf(keluaran_batch, "OK BUY %d %d %d\n", id, jumlah, stok_sesudah);
+    return 1;
+}
+
+// UPDATE id NAMA|KATEGORI|HARGA|STOK nilai
+int batch_update(char *arg, int nomor_baris) {
+    int id, n = 0, m = 0;
+    char kolom[16];
+    if (sscanf(arg, "%d %15s %n", &id, kolom, &n) != 2) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    int i = cari_indeks_id(id);
+    if (i < 0) {
+        return gagal_batch(nomor_baris, "tidak_ditemukan");
+    }
+
+    char *nilai = arg + n;
+    if (strcmp(kolom, "NAMA") == 0) {
+        if (!teks_batch_valid(nilai, MAX_NAMA)) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        ganti_nama_tiket(i, nilai);
+    } else if (strcmp(kolom, "KATEGORI") == 0) {
+        if (!teks_batch_valid(nilai, MAX_KATEGORI)) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        strcpy(daftar_tiket[i].kategori, nilai);
+        kategori_lepas(i);
+        lipat_tiket(i);
+        kategori_pasang(i);
+    } else if (strcmp(kolom, "HARGA") == 0) {
+        float harga;
+        if (sscanf(nilai, "%f %n", &harga, &m) != 1 || nilai[m] != '\0' || !(harga >= 0)) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        atur_harga(i, harga);
+    } else if (strcmp(kolom, "STOK") == 0) {
+        int stok;
+        if (sscanf(nilai, "%d %n", &stok, &m) != 1 || nilai[m] != '\0' || stok < 0) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        atur_stok(i, stok);
+    } else {
+        return gagal_batch(nomor_baris, "kolom_tidak_dikenal");
+    }
+    fprintf(keluaran_batch, "OK UPDATE %d\n", id);
+    return 1;
+}
+
+// SEARCH keyword
+int batch_search(char *arg, int nomor_baris) {
+    if (arg[0] == '\0' || strlen(arg) >= MAX_NAMA) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    int *posisi;
+    int ditemukan = cari_posisi_keyword(arg, &posisi);
+    for (int k = 0; k < ditemukan; k++) {
+        tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+    }
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK SEARCH %d\n", ditemukan);
+    return 1;
+}
+
+// LIST "offset batas" atau "SETELAH id batas": satu halaman menurut urutan tampilan
+int batch_halaman(const char *arg, int nomor_baris) {
+    int offset = 0, kursor = -1, batas = 0, mulai, n = 0;
+    if (sscanf(arg, "SETELAH %d %d %n", &kursor, &batas, &n) == 2 && arg[n] == '\0') {
+        mulai = letak_kursor(kursor);
+        if (mulai < 0) {
+            return gagal_batch(nomor_baris, "kursor_tidak_valid");
+        }
+    } else {
+        n = 0;
+        if (sscanf(arg, "%d %d %n", &offset, &batas, &n) != 2 || arg[n] != '\0' || offset < 0) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        mulai = letak_offset(offset, 0);
+    }
+    if (batas <= 0) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    if (batas > jumlah_tiket_aktif()) {
+        batas = jumlah_tiket_aktif();
+    }
+    int *posisi = (int *)malloc((batas + 1) * sizeof(int));
+    if (posisi == NULL) {
+        perror("Gagal mengalokasikan halaman");
+        exit(EXIT_FAILURE);
+    }
+    int jumlah = ambil_halaman(mulai, batas, 0, posisi, &kursor);
+    for (int k = 0; k < jumlah; k++) {
+        tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+    }
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK LIST %d %d\n", jumlah, kursor);
+    return 1;
+}
+
+// RENTANG min max batas [SETELAH id] [TERSEDIA] [KATEGORI nama]: satu halaman tiket berharga min..max
+int batch_rentang(char *arg, int nomor_baris) {
+    float harga_min, harga_max;
+    int batas, kursor;
+    int setelah = 0, hanya_tersedia = 0, n = 0;
+    char *kategori = NULL;
+    if (sscanf(arg, "%f %f %d %n", &harga_min, &harga_max, &batas, &n) != 3 || !(harga_min >= 0) || !(harga_max >= harga_min) || batas <= 0) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    arg += n;
+    n = 0;
+    if (sscanf(arg, "SETELAH %d %n", &setelah, &n) == 1) {
+        arg += n;
+    }
+    if (strncmp(arg, "TERSEDIA", 8) == 0 && (arg[8] == '\0' || arg[8] == ' ')) {
+        hanya_tersedia = 1;
+        arg += 8;
+        while (*arg == ' ') {
+            arg++;
+        }
+    }
+    if (strncmp(arg, "KATEGORI ", 9) == 0 && arg[9] != '\0') {
+        kategori = arg + 9;
+        lipat_teks(kategori, kategori, strlen(kategori) + 1);
+        arg += strlen(arg);
+    }
+    if (*arg != '\0') {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    if (batas > jumlah_tiket_aktif()) {
+        batas = jumlah_tiket_aktif();
+    }
+    int *posisi = (int *)malloc((batas + 1) * sizeof(int));
+    if (posisi == NULL) {
+        perror("Gagal mengalokasikan halaman");
+        exit(EXIT_FAILURE);
+    }
+    int jumlah = ambil_rentang_harga(harga_min, harga_max, setelah, hanya_tersedia, kategori, posisi, batas, &kursor);
+    if (jumlah < 0) {
+        free(posisi);
+        return gagal_batch(nomor_baris, "kursor_tidak_valid");
+    }
+    for (int j = 0; j < jumlah; j++) {
+        tulis_tiket_batch(&daftar_tiket[posisi[j]]);
+    }
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK RENTANG %d %d\n", jumlah, kursor);
+    return 1;
+}
+
+int batch_termurah(char *arg, int nomor_baris) {
+    int k, n = 0;
+    if (sscanf(arg, "%d %n", &k, &n) != 1 || arg[n] != '\0' || k <= 0) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    if (k > jumlah_tiket_aktif()) {
+        k = jumlah_tiket_aktif();
+    }
+    int *posisi = (int *)malloc((k + 1) * sizeof(int));
+    if (posisi == NULL) {
+        perror("Gagal mengalokasikan halaman");
+        exit(EXIT_FAILURE);
+    }
+    int jumlah = ambil_termurah(k, posisi);
+    for (int j = 0; j < jumlah; j++) {
+        tulis_tiket_batch(&daftar_tiket[posisi[j]]);
+    }
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK TERMURAH %d\n", jumlah);
+    return 1;
+}
+
+// Menjalankan satu baris perintah; 1 jika berhasil, 0 jika menghasilkan ERR
+int jalankan_perintah_batch(char *baris, int nomor_baris) {
+    char perintah[16];
+    int n = 0, id;
+    if (sscanf(baris, "%15s %n", perintah, &n) != 1) {
+        return gagal_batch(nomor_baris, "perintah_kosong");
+    }
+    char *arg = baris + n;
+
+    if (strcmp(perintah, "ADD") == 0) {
+        return batch_add(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "BUY") == 0) {
+        return batch_buy(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "UPDATE") == 0) {
+        return batch_update(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "SEARCH") == 0) {
+        return batch_search(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "DELETE") == 0) {
+        if (sscanf(arg, "%d %n", &id, &n) != 1 || arg[n] != '\0') {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        if (!hapus_tiket_id(id)) {
+            return gagal_batch(nomor_baris, "tidak_ditemukan");
+        }
+        fprintf(keluaran_batch, "OK DELETE %d\n", id);
+        return 1;
+    }
+    if (strcmp(perintah, "SORT") == 0) {
+        if (strcmp(arg, "HARGA") == 0) {
+            urutkan_tiket(1);
+        } else if (strcmp(arg, "HARGA_TURUN") == 0) {
+            urutkan_tiket(2);
+        } else if (strcmp(arg, "NAMA") == 0) {
+            urutkan_tiket(3);
+        } else {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        fprintf(keluaran_batch, "OK SORT %s\n", arg);
+        return 1;
+    }
+    if (strcmp(perintah, "RENTANG") == 0) {
+        return batch_rentang(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "TERMURAH") == 0) {
+        return batch_termurah(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "LIST") == 0) {
+        if (*arg != '\0') {
+            return batch_halaman(arg, nomor_baris);
+        }
+        int n = siapkan_tampilan();
+        for (int k = 0; k < n; k++) {
+            int i = posisi_tampilan(k);
+            if (daftar_tiket[i].id != ID_NISAN) {
+                tulis_tiket_batch(&daftar_tiket[i]);
+            }
+        }
+        tampil_siram();
+        fprintf(keluaran_batch, "OK LIST %d\n", jumlah_tiket_aktif());
+        return 1;
+    }
+    if (strcmp(perintah, "KATEGORI") == 0) {
+        int jumlah = 0;
+        for (int kode = 1; kode < jumlah_kode_kategori; kode++) {
+            int isi = hitung_kategori(kode);
+            if (isi > 0) {
+                fprintf(keluaran_batch, "KATEGORI %s;%d\n", kamus_kategori[kode].nama, isi);
+                jumlah++;
+            }
+        }
+        if (hitung_kategori(0) > 0) {
+            fprintf(keluaran_batch, "KATEGORI *;%d\n", hitung_kategori(0));
+            jumlah++;
+        }
+        fprintf(keluaran_batch, "OK KATEGORI %d\n", jumlah);
+        return 1;
+    }
+    if (strcmp(perintah, "SAVE") == 0) {
+        simpan_data_latar(); // ditulis di latar belakang; akhir masukan menunggu semuanya selesai
+        fprintf(keluaran_batch, "OK SAVE %d\n", jumlah_tiket_aktif());
+        return 1;
+    }
+    return gagal_batch(nomor_baris, "perintah_tidak_dikenal");
+}
+
+// Menjalankan perintah dari file (atau stdin) tanpa prompt.
+// Mengembalikan status keluar: EXIT_FAILURE bila ada perintah yang menghasilkan ERR.
+int mode_batch(const char *nama_file) {
+    FILE *masukan = (nama_file == NULL || strcmp(nama_file, "-") == 0) ? stdin : fopen(nama_file, "r");
+    if (masukan == NULL) {
+        perror("Error membuka file perintah");
+        return EXIT_FAILURE;
+    }
+
+    // Hasil batch tetap di stdout asli, sedangkan printf biasa (muat/simpan data) pindah ke stderr
+    fflush(stdout);
+    int fd_keluaran = dup(fileno(stdout));
+    keluaran_batch = fd_keluaran >= 0 ? fdopen(fd_keluaran, "w") : NULL;
+    if (keluaran_batch == NULL || dup2(fileno(stderr), fileno(stdout)) < 0) {
+        perror("Error menyiapkan keluaran batch");
+        return EXIT_FAILURE;
+    }
+
+    muat_data();
+    update_otomatis_kadaluarsa();
+
+    char baris[MAKS_BARIS_BATCH];
+    int nomor_baris = 0;
+    int jumlah_gagal = 0;
+    while (fgets(baris, sizeof(baris), masukan) != NULL) {
+        nomor_baris++;
+        if (strchr(baris, '\n') == NULL && !feof(masukan)) {
+            int c;
+            while ((c = fgetc(masukan)) != '\n' && c != EOF);
+            jumlah_gagal += !gagal_batch(nomor_baris, "baris_terlalu_panjang");
+            continue;
+        }
+        baris[strcspn(baris, "\r\n")] = '\0';
+        if (baris[0] == '\0' || baris[0] == '#') {
+            continue;
+        }
+        periksa_kadaluarsa_berkala();
+        jumlah_gagal += !jalankan_perintah_batch(baris, nomor_baris);
+    }
+    if (masukan != stdin) {
+        fclose(masukan);
+    }
+
+    simpan_data();
+    hentikan_penulis();
+    fclose(keluaran_batch);
+    free(daftar_tiket);
+    free(indeks_id);
+    free(heap_kadaluarsa);
+    kosongkan_indeks_trigram();
+    free(teks_lipat);
+    kosongkan_kamus_kategori();
+    kosongkan_kolom();
+    kosongkan_urutan(&urut_harga);
+    kosongkan_urutan(&urut_nama);
+    kosongkan_pohon_harga();
+    return jumlah_gagal > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
 // --- FUNGSI MENU UTAMA ---
 
 void tampilkan_menu() {
@@ -425,11 +3483,16 @@ void tampilkan_menu() {
     printf("5. Hapus Tiket (Delete)\n");
     printf("6. Sorting Tiket\n");
     printf("7. Simpan & Keluar\n");
+    printf("8. Cari Tiket per Rentang Harga\n");
     printf("-----------------------------------\n");
     printf("Pilihan Anda: ");
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        return mode_batch(argc > 2 ? argv[2] : NULL);
+    }
+
     muat_data();
     update_otomatis_kadaluarsa(); // Jalankan update otomatis saat program dimulai
 
@@ -439,12 +3502,13 @@ int main() {
         tampilkan_menu();
         
         if (scanf("%d", &pilihan) != 1) {
-            printf("\n❌ Input tidak valid. Masukkan angka 1-7.\n");
+            printf("\n❌ Input tidak valid. Masukkan angka 1-8.\n");
             while (getchar() != '\n'); // Bersihkan buffer input
             continue;
         }
 
         while (getchar() != '\n'); // Bersihkan buffer setelah scanf integer
+        periksa_kadaluarsa_berkala();
 
         switch (pilihan) {
             case 1: tambah_tiket(); break;
@@ -453,6 +3517,7 @@ int main() {
             case 4: update_tiket(); break;
             case 5: hapus_tiket(); break;
             case 6: sorting_tiket(); break;
+            case 8: cari_rentang_harga(); break;
             case 7: 
                 simpan_data(); 
                 printf("Terima kasih, program diakhiri.\n");
@@ -464,9 +3529,19 @@ int main() {
     } while (pilihan != 7);
 
     // Bebaskan memori sebelum keluar
+    hentikan_penulis();
     if (daftar_tiket != NULL) {
         free(daftar_tiket);
     }
+    free(indeks_id);
+    free(heap_kadaluarsa);
+    kosongkan_indeks_trigram();
+    free(teks_lipat);
+    kosongkan_kamus_kategori();
+    kosongkan_kolom();
+    kosongkan_urutan(&urut_harga);
+    kosongkan_urutan(&urut_nama);
+    kosongkan_pohon_harga();
 
     return 0;
 }
\ No newline at end of file
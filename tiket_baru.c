@@ -1,13 +1,54 @@
+// Deklarasi POSIX (fdopen, fileno, ftruncate) juga saat dikompilasi -std=c11
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#include <ctype.h>
+#include <stdint.h>
+#include <limits.h>
+
+// mmap hanya tersedia di sistem POSIX; di Windows (MinGW) data dibaca ke memori biasa
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <pthread.h>
+#define PAKAI_MMAP 1
+#else
+#include <io.h> // dup/dup2 untuk mode batch
+#define PAKAI_MMAP 0
+#endif
+
+// Pencocok substring SIMD (SSE2/AVX2) dipilih saat runtime; selain x86 + GCC/Clang hanya versi skalar
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PAKAI_SIMD_X86 1
+#else
+#define PAKAI_SIMD_X86 0
+#endif
 
 #define NAMA_FILE "data_tiket.txt"
+#define NAMA_FILE_SEMENTARA "data_tiket.txt.tmp"
+#define NAMA_FILE_UBAH "data_tiket.txt.ubah" // record yang sedang ditimpa di tempat (double write)
+#define MAGIC_UBAH "UBH"
+#define MAGIC_FILE "TKT"
+#define VERSI_FILE 2 // versi 2: header menyimpan urutan ID (id_berikutnya)
 #define MAX_NAMA 50
 #define MAX_KATEGORI 20
 #define KADALUARSA_DETIK (7 * 24 * 60 * 60) // 7 hari dalam detik
+#define KAPASITAS_AWAL 16 // kapasitas minimum blok tiket
+#define ID_NISAN 0 // id slot tiket yang sudah dihapus (ID asli selalu mulai dari 1)
+#define RASIO_NISAN 4 // padatkan array bila lebih dari 1/RASIO_NISAN slot berisi nisan
+#define RASIO_KOTOR 4 // tulis ulang file utuh bila lebih dari 1/RASIO_KOTOR record berubah sejak simpan terakhir
+
+// Hasil beli_stok()
+#define BELI_BERHASIL 0
+#define BELI_TIDAK_DITEMUKAN 1
+#define BELI_STOK_KURANG 2
+#define BELI_JUMLAH_TIDAK_VALID 3
 
 // Struktur Tiket (sama seperti kode Anda)
 typedef struct {
@@ -19,15 +60,171 @@ typedef struct {
     time_t waktu_dibuat;
 } Tiket;
 
+// Header di awal file data, diikuti langsung oleh array Tiket.
+// Ukurannya kelipatan 8 agar array Tiket sesudahnya tetap rata (aligned) saat di-mmap.
+typedef struct {
+    char magic[4];          // "TKT\0"
+    uint32_t versi;
+    uint32_t jumlah_record; // jumlah slot tiket di file, termasuk nisan (id 0)
+    uint32_t ukuran_record; // sizeof(Tiket) saat file ditulis
+    uint64_t lsn_snapshot;  // dipakai jurnal pembelian program pelanggan ("tiket baru.c")
+    uint32_t id_berikutnya; // ID untuk tiket baru berikutnya; tidak pernah mundur
+    uint32_t urutan_tampilan; // hasil sorting terakhir (0 = urutan simpan, 1 = harga, 2 = nama)
+} HeaderFile;
+
 // Variabel global
 Tiket *daftar_tiket = NULL;
-int jumlah_tiket = 0;
+int jumlah_tiket = 0; // jumlah slot terpakai, termasuk nisan
+int jumlah_nisan = 0; // slot yang ditandai terhapus dan menunggu pemadatan
+
+// Header file ubah (NAMA_FILE_UBAH), diikuti HeaderFile baru, posisi[jumlah] dan Tiket[jumlah]
+typedef struct {
+    char magic[4];      // "UBH\0"
+    uint32_t jumlah;    // jumlah record yang ditimpa
+    uint32_t checksum;  // FNV-1a atas semua byte sesudah header ini
+    uint32_t cadangan;
+} HeaderUbah;
+
+// Blok penyimpanan: HeaderFile + array Tiket dalam satu blok memori.
+// Dengan PAKAI_MMAP file data dipetakan MAP_PRIVATE (copy-on-write): muat tetap O(1), tetapi
+// perubahan di memori tidak pernah sampai ke file dengan sendirinya. Tanpa mmap blok ini hasil malloc.
+// Di kedua kasus file hanya diubah oleh tulis_penyangga(), sehingga setelah crash isinya selalu
+// keadaan salah satu simpan yang lengkap.
+char *blok_data = NULL;
+size_t ukuran_blok = 0;
+
+// Record kotor: posisi di file data yang berubah sejak simpan terakhir. Bit di peta_kotor
+// mencegah posisi yang sama masuk daftar dua kali.
+int jumlah_record_disk = 0; // record yang sudah ada di file data; di belakangnya ekor baru
+uint64_t *peta_kotor = NULL;
+int *posisi_kotor = NULL;
+int jumlah_kotor = 0;
+int kapasitas_kotor = 0; // jumlah record yang bisa dilacak peta_kotor
+int tulis_ulang_penuh = 1; // setelah pemadatan (record bergeser) atau terlalu banyak perubahan
+
+// Penyangga simpan: utas utama menyalin perubahan sejak simpan terakhir ke penyangga, lalu utas
+// penulis menulisnya tanpa menyentuh blok_data. Penyangga penuh berisi semua record dan ditulis
+// ulang lewat file sementara + rename; penyangga sebagian hanya berisi record kotor dan ekor baru.
+// Ada dua penyangga: satu sedang ditulis, satu diisi utas utama. Permintaan yang datang selagi
+// penulis sibuk digabung ke penyangga yang menunggu.
+typedef struct {
+    HeaderFile header;
+    int penuh;
+    int jumlah;
+    int kapasitas;
+    int *posisi; // penyangga sebagian: posisi isi[k] di file data
+    Tiket *isi;
+} PenyanggaSimpan;
+PenyanggaSimpan penyangga_simpan[2];
+int penyangga_antre = -1;   // penyangga yang menunggu ditulis, -1 = tidak ada
+int penyangga_ditulis = -1; // penyangga yang sedang ditulis penulis
+int simpan_gagal = 0;       // file data tertinggal dari memori: penyangga sebagian dilewati, simpan berikutnya penuh
+
+#if PAKAI_MMAP
+// Utas penulis: file ditulis di latar belakang, utas utama hanya mengisi penyangga
+pthread_mutex_t kunci_simpan = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t sinyal_simpan = PTHREAD_COND_INITIALIZER; // ada permintaan baru, atau penulis selesai
+pthread_t utas_penulis;
+int penulis_hidup = 0;
+int penulis_berhenti = 0;
+#endif
+
+// Indeks hash (open addressing) dari ID tiket ke posisinya di daftar_tiket
+typedef struct {
+    int id;
+    int posisi; // -1 jika slot kosong
+} SlotIndeks;
+SlotIndeks *indeks_id = NULL;
+int kapasitas_indeks = 0; // selalu pangkat dua, minimal dua kali jumlah tiket
+
+// Indeks kadaluarsa: min-heap (waktu kadaluarsa, id). Entri milik tiket yang sudah
+// dihapus dibiarkan basi dan baru dibuang ketika sampai di puncak heap.
+typedef struct {
+    time_t waktu; // waktu_dibuat + KADALUARSA_DETIK
+    int id;
+} EntriKadaluarsa;
+EntriKadaluarsa *heap_kadaluarsa = NULL;
+int ukuran_heap = 0;
+int kapasitas_heap = 0;
+
+// Salinan casefold (huruf kecil ASCII) dari nama dan kode kategori, sejajar dengan daftar_tiket
+// (teks_lipat[i] milik daftar_tiket[i]). Hanya di memori; format file tidak berubah.
+typedef struct {
+    char nama[MAX_NAMA];
+    unsigned char panjang_nama; // strlen(nama), agar pencocok tidak perlu mencari '\0'
+    unsigned char kode_kategori; // indeks kamus_kategori
+} TeksLipat;
+TeksLipat *teks_lipat = NULL;
+int kapasitas_lipat = 0;
+
+// Kolom panas (structure-of-arrays): id, harga, stok dan waktu_dibuat disalin ke array per kolom,
+// sejajar dengan daftar_tiket (kolom_x[i] milik daftar_tiket[i]). Heap kadaluarsa, indeks ID dan
+// sorting harga cukup membaca 4-8 byte per tiket. Blok tiket tetap sumber kebenaran dan format
+// file; perubahan harga/stok/waktu harus lewat atur_harga/atur_stok/atur_waktu.
+int *kolom_id = NULL; // ID_NISAN untuk slot yang dihapus
+float *kolom_harga = NULL;
+int *kolom_stok = NULL;
+time_t *kolom_waktu = NULL;
+int kapasitas_kolom = 0;
+
+// Indeks urutan: posisi tiket terurut menurut (harga, id) dan (nama, id), dirawat setiap tiket
+// ditambah, diubah atau dihapus. Sorting hanya memilih indeks yang dijalani daftar; Tiket tidak dipindah.
+typedef struct {
+    int *isi;           // posisi tiket; -1 = lubang (tiket dihapus atau kuncinya berubah)
+    int jumlah;         // entri terpakai, termasuk lubang
+    int terurut;        // isi[0..terurut) sudah urut, sisanya ekor tiket baru/berubah
+    int lubang;
+    int kapasitas;
+    int *letak;         // letak[posisi] = indeks entri tiket itu di isi, -1 jika tidak ada
+    int kapasitas_letak;
+    int (*banding)(const void *a, const void *b); // membandingkan dua posisi (int *)
+    uint64_t (*kunci)(int posisi, int kedalaman); // kunci radix yang urutannya sama dengan `banding`
+    int kunci_awalan;   // 1 = kunci hanya 8 byte nama mulai byte ke-8*kedalaman, seri dipecah lagi
+} IndeksUrut;
+int banding_urut_harga(const void *a, const void *b);
+int banding_urut_nama(const void *a, const void *b);
+uint64_t kunci_urut_harga(int posisi, int kedalaman);
+uint64_t kunci_urut_nama(int posisi, int kedalaman);
+IndeksUrut urut_harga = { NULL, 0, 0, 0, 0, NULL, 0, banding_urut_harga, kunci_urut_harga, 0 };
+IndeksUrut urut_nama = { NULL, 0, 0, 0, 0, NULL, 0, banding_urut_nama, kunci_urut_nama, 1 };
+int urutan_tampilan = 0; // 0 = urutan simpan, 1 = harga termurah, 2 = nama A-Z; disimpan di header
+
+// Kamus kategori: setiap kategori (casefold) di-intern menjadi kode kecil yang punya bitmap
+// slot daftar_tiket aktif berkategori itu. Kode 0 menampung kategori yang tidak muat lagi di kamus.
+#define MAX_KODE_KATEGORI 256
+#define SLOT_KAMUS_KATEGORI 512 // tabel hash nama -> kode, pangkat dua dan > 2 * MAX_KODE_KATEGORI
+typedef struct {
+    char nama[MAX_KATEGORI];
+    uint64_t *bitmap; // bit i menyala = daftar_tiket[i] aktif dan berkategori ini
+} EntriKategori;
+EntriKategori kamus_kategori[MAX_KODE_KATEGORI];
+int jumlah_kode_kategori = 1; // kode 0 selalu ada
+unsigned char slot_kamus_kategori[SLOT_KAMUS_KATEGORI]; // 0 = slot kosong
+int kata_bitmap_kategori = 0; // panjang setiap bitmap dalam uint64_t
+
+// Indeks trigram nama konser: setiap potongan 3 huruf (casefold) menunjuk ke posting list,
+// yaitu ID tiket (urut naik) yang namanya memuat potongan itu
+typedef struct {
+    uint32_t kode; // 3 byte casefold; 0 = slot tabel kosong
+    int jumlah;
+    int kapasitas;
+    int *id;
+} PostingTrigram;
+PostingTrigram *tabel_trigram = NULL;
+int kapasitas_trigram = 0; // selalu pangkat dua
+int jumlah_trigram = 0;
+int tiket_basi_trigram = 0; // tiket dihapus/diganti nama sejak indeks terakhir dibangun
 
 // Fungsi prototipe (tetap)
 void muat_data();
 void simpan_data();
+void simpan_data_latar();
+void tunggu_simpan();
+void hentikan_penulis();
+int pulihkan_ubah();
 void tampilkan_tiket_detail(const Tiket *t);
 int buat_id_unik();
+int pesan_blok_id(int jumlah);
 void tambah_tiket();
 void lihat_semua_tiket();
 void cari_tiket();
@@ -36,6 +233,74 @@ void hapus_tiket();
 void sorting_tiket();
 void update_otomatis_kadaluarsa();
 void tampilkan_menu();
+int ubah_kapasitas(int kapasitas);
+int cadangkan_kapasitas(int minimal);
+int susutkan_kapasitas();
+void tutup_data();
+void bangun_indeks_id();
+void indeks_tambah(int posisi);
+void indeks_hapus(int id);
+int cari_indeks_id(int id);
+int jumlah_tiket_aktif();
+void tandai_nisan(int posisi);
+void padatkan_tiket();
+void padatkan_jika_perlu();
+void bangun_kolom();
+void isi_kolom(int posisi);
+void kosongkan_kolom();
+void atur_harga(int posisi, float harga);
+void atur_stok(int posisi, int stok);
+void atur_waktu(int posisi, time_t waktu);
+void tandai_kotor(int posisi);
+void reset_kotor(int jumlah);
+void bangun_urutan(IndeksUrut *x);
+void kosongkan_urutan(IndeksUrut *x);
+void urutan_tambah(IndeksUrut *x, int posisi);
+void urutan_lepas(IndeksUrut *x, int posisi);
+void urutan_ubah(IndeksUrut *x, int posisi);
+void urutan_pindah(IndeksUrut *x, int dari, int ke);
+int siapkan_tampilan();
+int posisi_tampilan(int k);
+void urutkan_hasil_tampilan(int *posisi, int jumlah);
+int letak_kursor(int id);
+int letak_offset(int offset, int hanya_tersedia);
+int ambil_halaman(int mulai, int batas, int hanya_tersedia, int *posisi, int *kursor);
+int ambil_termurah(int k, int *posisi);
+int lanjut_halaman();
+void pohon_harga_tambah(float harga, int id);
+void pohon_harga_lepas(float harga, int id);
+void kosongkan_pohon_harga();
+int ambil_rentang_harga(float harga_min, float harga_max, int setelah, int hanya_tersedia, const char *kategori_lipat, int *posisi, int batas, int *kursor);
+int bandingkan_int(const void *a, const void *b);
+void bangun_heap_kadaluarsa();
+void kadaluarsa_tambah(int posisi);
+int ada_tiket_kadaluarsa(time_t sekarang);
+int ambil_tiket_kadaluarsa(time_t sekarang);
+void periksa_kadaluarsa_berkala();
+void bangun_indeks_trigram();
+void kosongkan_indeks_trigram();
+void trigram_tambah(int id, const char *nama, int urut);
+void trigram_catat_basi();
+int cari_posisi_nama(const char *kriteria, int **posisi);
+void ganti_nama_tiket(int posisi, const char *nama);
+int masukkan_tiket(const Tiket *baru);
+int hapus_tiket_id(int id);
+void urutkan_tiket(int kriteria);
+int beli_stok(int id, int jumlah, int *stok_sesudah);
+size_t lipat_teks(char *tujuan, const char *asal, size_t ukuran);
+void lipat_tiket(int posisi);
+void bangun_teks_lipat();
+int nama_memuat(int posisi, const char *kriteria_lipat, size_t panjang_kriteria);
+int kode_kategori(const char *nama_lipat, int buat);
+void perbesar_bitmap_kategori(int kapasitas_slot);
+void kategori_pasang(int posisi);
+void kategori_lepas(int posisi);
+void bangun_bitmap_kategori();
+void kosongkan_kamus_kategori();
+int hitung_kategori(int kode);
+int tiket_berkategori(int posisi, int kode, const char *kriteria_lipat);
+int cari_posisi_kategori(const char *kriteria_lipat, int **posisi);
+int mode_batch(const char *nama_file);
 
 // --- IMPLEMENTASI FUNGSI ---
 
@@ -50,106 +315,3084 @@ void bersihkan_buffer() {
 
 // Implementasi fungsi-fungsi sebelumnya (hanya menampilkan yang diperbaiki di sini)
 
+// --- PENYUSUN TAMPILAN ---
+// Daftar tiket disusun ke satu buffer lalu ditulis dengan satu fwrite, bukan tujuh printf per tiket.
+// Angka dan harga diformat sendiri (hasilnya sama persis dengan %d dan %.2f) dan teks waktu disimpan
+// per detik. Isi buffer harus disiram sebelum printf/fprintf lain ke aliran yang sama.
+
+#define UKURAN_BUFFER_TAMPIL (64 * 1024)
+#define SLOT_CACHE_WAKTU 64
+
+char buffer_tampil[UKURAN_BUFFER_TAMPIL];
+size_t isi_tampil = 0;
+FILE *tujuan_tampil = NULL;
+
+typedef struct {
+    time_t detik;
+    int panjang; // 0 = slot kosong
+    char teks[40];
+} CacheWaktu;
+CacheWaktu cache_waktu[SLOT_CACHE_WAKTU];
+
+/**
+ * @brief Menulis isi buffer tampilan ke aliran tujuannya dengan satu fwrite.
+ */
+void tampil_siram() {
+    if (isi_tampil > 0 && tujuan_tampil != NULL) {
+        fwrite(buffer_tampil, 1, isi_tampil, tujuan_tampil);
+    }
+    isi_tampil = 0;
+}
+
+/**
+ * @brief Memilih aliran tujuan; isi milik aliran sebelumnya disiram dulu.
+ */
+void tampil_ke(FILE *tujuan) {
+    if (tujuan != tujuan_tampil) {
+        tampil_siram();
+        tujuan_tampil = tujuan;
+    }
+}
+
+/**
+ * @brief Menambahkan `panjang` byte ke buffer, menyiram dulu bila tidak muat.
+ */
+void tampil_teks(const char *teks, size_t panjang) {
+    if (isi_tampil + panjang > UKURAN_BUFFER_TAMPIL) {
+        tampil_siram();
+    }
+    if (panjang > UKURAN_BUFFER_TAMPIL) {
+        fwrite(teks, 1, panjang, tujuan_tampil);
+        return;
+    }
+    memcpy(buffer_tampil + isi_tampil, teks, panjang);
+    isi_tampil += panjang;
+}
+
+void tampil_str(const char *teks) {
+    tampil_teks(teks, strlen(teks));
+}
+
+/**
+ * @brief Sama dengan "%lld".
+ * @param tujuan Buffer minimal 24 byte.
+ * @return Panjang teks (tanpa NUL).
+ */
+int format_int(char *tujuan, long long nilai) {
+    char balik[24];
+    int n = 0;
+    int panjang = 0;
+    unsigned long long u = nilai < 0 ? 0ULL - (unsigned long long)nilai : (unsigned long long)nilai;
+    do {
+        balik[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+    if (nilai < 0) {
+        tujuan[panjang++] = '-';
+    }
+    while (n > 0) {
+        tujuan[panjang++] = balik[--n];
+    }
+    return panjang;
+}
+
+/**
+ * @brief Sama dengan "%.2f" untuk float.
+ *
+ * float * 100 selalu eksak di double (24 + 7 bit), jadi pembulatan ke sen cukup half-even seperti
+ * printf. NaN, inf, dan nilai raksasa diserahkan ke snprintf.
+ * @param tujuan Buffer minimal 64 byte.
+ * @return Panjang teks (tanpa NUL).
+ */
+int format_harga(char *tujuan, float harga) {
+    double sen = (double)harga * 100.0;
+    if (!(sen > -1e17 && sen < 1e17)) {
+        return snprintf(tujuan, 64, "%.2f", harga);
+    }
+    uint32_t bit;
+    memcpy(&bit, &harga, sizeof(bit));
+    if (sen < 0) {
+        sen = -sen;
+    }
+    unsigned long long bulat = (unsigned long long)sen;
+    double sisa = sen - (double)bulat;
+    if (sisa > 0.5 || (sisa == 0.5 && (bulat & 1))) {
+        bulat++;
+    }
+    int panjang = 0;
+    if (bit & 0x80000000u) {
+        tujuan[panjang++] = '-'; // -0.0 dan -0.001 pun tercetak "-0.00" oleh printf
+    }
+    panjang += format_int(tujuan + panjang, (long long)(bulat / 100));
+    tujuan[panjang++] = '.';
+    tujuan[panjang++] = (char)('0' + bulat % 100 / 10);
+    tujuan[panjang++] = (char)('0' + bulat % 10);
+    return panjang;
+}
+
+void tampil_int(long long nilai) {
+    char teks[24];
+    tampil_teks(teks, format_int(teks, nilai));
+}
+
+void tampil_harga(float harga) {
+    char teks[64];
+    tampil_teks(teks, format_harga(teks, harga));
+}
+
+/**
+ * @brief "%Y-%m-%d %H:%M:%S"; localtime + strftime hanya saat detik itu belum ada di cache.
+ */
+void tampil_waktu(time_t waktu) {
+    CacheWaktu *c = &cache_waktu[(unsigned long long)waktu % SLOT_CACHE_WAKTU];
+    if (c->panjang == 0 || c->detik != waktu) {
+        struct tm *info_waktu = localtime(&waktu);
+        c->detik = waktu;
+        c->panjang = info_waktu != NULL ? (int)strftime(c->teks, sizeof(c->teks), "%Y-%m-%d %H:%M:%S", info_waktu) : 0;
+    }
+    tampil_teks(c->teks, c->panjang);
+}
+
+/**
+ * @brief Menyusun detail satu tiket ke buffer; pemanggil menyiram setelah satu atau banyak tiket.
+ */
+void susun_tiket_detail(const Tiket *t) {
+    tampil_ke(stdout);
+    tampil_str("  | ID: ");
+    tampil_int(t->id);
+    tampil_str("\n  | Nama Konser: ");
+    tampil_str(t->nama_konser);
+    tampil_str("\n  | Kategori: ");
+    tampil_str(t->kategori);
+    tampil_str("\n  | Harga: Rp");
+    tampil_harga(t->harga);
+    tampil_str("\n  | Stok: ");
+    tampil_int(t->jumlah_stok);
+    tampil_str("\n  | Waktu Dibuat: ");
+    tampil_waktu(t->waktu_dibuat);
+    tampil_str("\n  +-----------------------------------\n");
+}
+
 /**
  * @brief Menampilkan detail satu tiket.
  * @param t Pointer ke struktur Tiket.
  */
 void tampilkan_tiket_detail(const Tiket *t) {
-    char waktu_str[64];
-    struct tm *info_waktu = localtime(&t->waktu_dibuat);
-    strftime(waktu_str, sizeof(waktu_str), "%Y-%m-%d %H:%M:%S", info_waktu);
+    susun_tiket_detail(t);
+    tampil_siram();
+}
 
-    printf("  | ID: %d\n", t->id);
-    printf("  | Nama Konser: %s\n", t->nama_konser);
-    printf("  | Kategori: %s\n", t->kategori);
-    printf("  | Harga: Rp%.2f\n", t->harga);
-    printf("  | Stok: %d\n", t->jumlah_stok);
-    printf("  | Waktu Dibuat: %s\n", waktu_str);
-    printf("  +-----------------------------------\n");
+/**
+ * @brief Pointer ke header di awal blok data.
+ */
+HeaderFile *header_data() {
+    return (HeaderFile *)blok_data;
 }
 
 /**
- * @brief Memuat data tiket dari file.
+ * @brief Mengisi header untuk file data baru.
  */
-void muat_data() {
-    FILE *file = fopen(NAMA_FILE, "r");
-    if (file == NULL) {
-        printf("⚠️ File data tidak ditemukan. Membuat file baru...\n");
+void isi_header_baru(HeaderFile *header, int jumlah, uint32_t id_berikutnya) {
+    memset(header, 0, sizeof(HeaderFile));
+    memcpy(header->magic, MAGIC_FILE, sizeof(header->magic));
+    header->versi = VERSI_FILE;
+    header->jumlah_record = (uint32_t)jumlah;
+    header->ukuran_record = sizeof(Tiket);
+    header->id_berikutnya = id_berikutnya;
+}
+
+/**
+ * @brief Memaksa isi file sampai ke disk, bukan hanya ke buffer stdio atau page cache.
+ * @return 1 jika berhasil, 0 jika gagal.
+ */
+int sinkronkan_file(FILE *file) {
+    if (fflush(file) != 0) {
+        return 0;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief fsync direktori kerja agar hasil rename ikut tahan crash (hanya POSIX).
+ */
+void sinkronkan_direktori() {
+#ifndef _WIN32
+    int fd = open(".", O_RDONLY);
+    if (fd < 0) {
         return;
     }
+    fsync(fd);
+    close(fd);
+#endif
+}
+
+/**
+ * @brief Menulis file data utuh (header + array tiket) lewat file sementara, fsync, rename,
+ *        lalu fsync direktori. Setelah crash yang ada di disk selalu file lama atau file baru
+ *        yang lengkap, tidak pernah file yang terpotong.
+ * @return 1 jika berhasil, 0 jika gagal.
+ */
+int tulis_file_data(const HeaderFile *header, const Tiket *data) {
+    int jumlah = (int)header->jumlah_record;
+    FILE *file = fopen(NAMA_FILE_SEMENTARA, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    int berhasil = fwrite(header, sizeof(HeaderFile), 1, file) == 1 &&
+                   (jumlah == 0 || fwrite(data, sizeof(Tiket), jumlah, file) == (size_t)jumlah) &&
+                   sinkronkan_file(file);
+    if (fclose(file) != 0) {
+        berhasil = 0;
+    }
+    if (!berhasil) {
+        remove(NAMA_FILE_SEMENTARA);
+        return 0;
+    }
+#ifdef _WIN32
+    remove(NAMA_FILE); // rename di Windows gagal jika file tujuan sudah ada
+#endif
+    if (rename(NAMA_FILE_SEMENTARA, NAMA_FILE) != 0) {
+        return 0;
+    }
+    sinkronkan_direktori();
+    return 1;
+}
+
+/**
+ * @brief Mengubah file format lama (array Tiket tanpa header) ke format berheader.
+ * @return 1 jika berhasil, 0 jika isi file tidak bisa dibaca sebagai array Tiket.
+ */
+int migrasi_format_lama() {
+    FILE *file = fopen(NAMA_FILE, "rb");
+    if (file == NULL) {
+        return 0;
+    }
 
-    int count = 0;
-    Tiket temp_tiket;
-    while (fread(&temp_tiket, sizeof(Tiket), 1, file) == 1) {
-        count++;
+    fseek(file, 0, SEEK_END);
+    long ukuran = ftell(file);
+    rewind(file);
+    if (ukuran < 0 || ukuran % sizeof(Tiket) != 0) {
+        fclose(file);
+        return 0;
     }
 
+    int count = (int)(ukuran / sizeof(Tiket));
+    Tiket *lama = NULL;
     if (count > 0) {
-        daftar_tiket = (Tiket *)malloc(count * sizeof(Tiket));
-        if (daftar_tiket == NULL) {
-            perror("Gagal mengalokasikan memori saat memuat data");
+        lama = (Tiket *)malloc(count * sizeof(Tiket));
+        if (lama == NULL || fread(lama, sizeof(Tiket), count, file) != (size_t)count) {
+            free(lama);
             fclose(file);
+            return 0;
+        }
+    }
+    fclose(file);
+
+    // Urutan ID dilanjutkan dari ID terbesar yang ada (sekali saja, saat migrasi)
+    int max_id = 0;
+    for (int i = 0; i < count; i++) {
+        if (lama[i].id > max_id) {
+            max_id = lama[i].id;
+        }
+    }
+    HeaderFile header;
+    isi_header_baru(&header, count, (uint32_t)max_id + 1);
+    int berhasil = tulis_file_data(&header, lama);
+    free(lama);
+    return berhasil;
+}
+
+/**
+ * @brief Membuka file data berheader menjadi blok_data.
+ *        Dengan mmap file dipetakan (MAP_PRIVATE), sehingga waktu muat tidak bergantung pada jumlah tiket.
+ * @return 1 jika berhasil, 0 jika file tidak bisa dibuka atau formatnya tidak cocok.
+ */
+int buka_blok_data() {
+#if PAKAI_MMAP
+    int fd = open(NAMA_FILE, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat info;
+    void *peta = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(HeaderFile)) {
+        peta = mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    close(fd); // pemetaan tetap berlaku; file tidak pernah ditulis lewat pemetaan ini
+    if (peta == MAP_FAILED) {
+        return 0;
+    }
+    blok_data = (char *)peta;
+    ukuran_blok = info.st_size;
+#else
+    FILE *file = fopen(NAMA_FILE, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    long ukuran = ftell(file);
+    rewind(file);
+    if (ukuran < (long)sizeof(HeaderFile)) {
+        fclose(file);
+        return 0;
+    }
+    blok_data = (char *)malloc(ukuran);
+    if (blok_data == NULL || fread(blok_data, 1, ukuran, file) != (size_t)ukuran) {
+        fclose(file);
+        tutup_data();
+        return 0;
+    }
+    fclose(file);
+    ukuran_blok = ukuran;
+#endif
+
+    HeaderFile *header = header_data();
+    if (header->versi < 1 || header->versi > VERSI_FILE || header->ukuran_record != sizeof(Tiket) ||
+        ukuran_blok < sizeof(HeaderFile) + (size_t)header->jumlah_record * sizeof(Tiket)) {
+        tutup_data();
+        return 0;
+    }
+    daftar_tiket = (Tiket *)(blok_data + sizeof(HeaderFile));
+    jumlah_tiket = header->jumlah_record;
+    reset_kotor(jumlah_tiket);
+
+    // Versi 1 belum punya urutan ID: lanjutkan dari ID terbesar, lalu header dinaikkan ke versi 2
+    if (header->versi == 1) {
+        int max_id = 0;
+        for (int i = 0; i < jumlah_tiket; i++) {
+            if (daftar_tiket[i].id > max_id) {
+                max_id = daftar_tiket[i].id;
+            }
+        }
+        header->id_berikutnya = (uint32_t)max_id + 1;
+        header->versi = VERSI_FILE;
+    }
+    return 1;
+}
+
+/**
+ * @brief Mengubah kapasitas blok data menjadi tepat `kapasitas` tiket.
+ *        Dengan mmap isi blok dipindah ke pemetaan anonim baru; file data tidak ikut berubah.
+ * @return 1 jika berhasil, 0 jika gagal (blok lama tetap utuh).
+ */
+int ubah_kapasitas(int kapasitas) {
+    size_t ukuran_baru = sizeof(HeaderFile) + (size_t)kapasitas * sizeof(Tiket);
+#if PAKAI_MMAP
+    void *peta = mmap(NULL, ukuran_baru, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (peta == MAP_FAILED) {
+        return 0;
+    }
+    memcpy(peta, blok_data, ukuran_baru < ukuran_blok ? ukuran_baru : ukuran_blok);
+    munmap(blok_data, ukuran_blok);
+    blok_data = (char *)peta;
+    ukuran_blok = ukuran_baru;
+#else
+    void *peta = realloc(blok_data, ukuran_baru);
+    if (peta == NULL) {
+        return 0;
+    }
+    blok_data = (char *)peta;
+    ukuran_blok = ukuran_baru;
+#endif
+    daftar_tiket = (Tiket *)(blok_data + sizeof(HeaderFile));
+    return 1;
+}
+
+/**
+ * @brief Jumlah tiket yang muat di blok data saat ini.
+ */
+int kapasitas_tiket() {
+    return (int)((ukuran_blok - sizeof(HeaderFile)) / sizeof(Tiket));
+}
+
+/**
+ * @brief Memastikan blok data muat minimal `minimal` tiket.
+ *        Kapasitas tumbuh dua kali lipat sehingga menambah tiket satu per satu tetap
+ *        O(1) teramortisasi. Muat atau impor massal bisa memesan tempat sekaligus di sini.
+ * @return 1 jika berhasil, 0 jika gagal.
+ */
+int cadangkan_kapasitas(int minimal) {
+    int kapasitas = kapasitas_tiket();
+    if (minimal <= kapasitas) {
+        return 1;
+    }
+    int baru = kapasitas < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas;
+    while (baru < minimal) {
+        baru *= 2;
+    }
+    return ubah_kapasitas(baru);
+}
+
+/**
+ * @brief Memperkecil blok data setelah penghapusan, dengan histeresis.
+ *        Blok baru disusutkan jika terisi <= 1/4, dan tetap menyisakan ruang dua kali
+ *        lipat, agar hapus/tambah bergantian di sekitar batas tidak realokasi terus-menerus.
+ * @return 1 jika berhasil atau tidak perlu disusutkan, 0 jika gagal.
+ */
+int susutkan_kapasitas() {
+    int kapasitas = kapasitas_tiket();
+    if (kapasitas <= KAPASITAS_AWAL || jumlah_tiket > kapasitas / 4) {
+        return 1;
+    }
+    int baru = kapasitas / 2;
+    while (baru / 2 >= KAPASITAS_AWAL && jumlah_tiket <= baru / 4) {
+        baru /= 2;
+    }
+    if (baru < KAPASITAS_AWAL) {
+        baru = KAPASITAS_AWAL;
+    }
+    return ubah_kapasitas(baru);
+}
+
+/**
+ * @brief Melepas blok data (munmap/free) beserta pelacak record kotor.
+ */
+void tutup_data() {
+    hentikan_penulis();
+#if PAKAI_MMAP
+    if (blok_data != NULL) {
+        munmap(blok_data, ukuran_blok);
+    }
+#else
+    free(blok_data);
+#endif
+    free(peta_kotor);
+    free(posisi_kotor);
+    peta_kotor = NULL;
+    posisi_kotor = NULL;
+    jumlah_kotor = 0;
+    kapasitas_kotor = 0;
+    tulis_ulang_penuh = 1;
+    blok_data = NULL;
+    ukuran_blok = 0;
+    daftar_tiket = NULL;
+    jumlah_tiket = 0;
+    jumlah_nisan = 0;
+    free(indeks_id);
+    indeks_id = NULL;
+    kapasitas_indeks = 0;
+    free(heap_kadaluarsa);
+    heap_kadaluarsa = NULL;
+    ukuran_heap = 0;
+    kapasitas_heap = 0;
+    kosongkan_indeks_trigram();
+    free(teks_lipat);
+    teks_lipat = NULL;
+    kapasitas_lipat = 0;
+    kosongkan_kamus_kategori();
+    kosongkan_kolom();
+    kosongkan_urutan(&urut_harga);
+    kosongkan_urutan(&urut_nama);
+    kosongkan_pohon_harga();
+    urutan_tampilan = 0;
+}
+
+/**
+ * @brief Memuat data tiket dari file.
+ *        File format lama (tanpa header) diubah sekali ke format berheader.
+ */
+void muat_data() {
+    if (!pulihkan_ubah()) {
+        perror("Gagal menyelesaikan simpan yang terputus");
+        exit(EXIT_FAILURE);
+    }
+    int file_baru = 0;
+    FILE *file = fopen(NAMA_FILE, "rb");
+    if (file == NULL) {
+        printf("⚠️ File data tidak ditemukan. Membuat file baru...\n");
+        HeaderFile header;
+        isi_header_baru(&header, 0, 1);
+        if (!tulis_file_data(&header, NULL)) {
+            perror("Gagal membuat file data");
             exit(EXIT_FAILURE);
         }
+        file_baru = 1;
+    } else {
+        HeaderFile header;
+        int berheader = fread(&header, sizeof(HeaderFile), 1, file) == 1 &&
+                        memcmp(header.magic, MAGIC_FILE, sizeof(header.magic)) == 0;
+        fclose(file);
 
-        rewind(file);
-        size_t items_read = fread(daftar_tiket, sizeof(Tiket), count, file);
-        if (items_read != count) {
+        if (!berheader && !migrasi_format_lama()) {
             fprintf(stderr, "Kesalahan saat membaca data dari file.\n");
-            free(daftar_tiket);
-            daftar_tiket = NULL;
-            jumlah_tiket = 0;
-        } else {
-            jumlah_tiket = count;
-            printf("✅ Berhasil memuat %d tiket dari file.\n", jumlah_tiket);
+            exit(EXIT_FAILURE);
         }
+    }
+
+    if (!buka_blok_data()) {
+        fprintf(stderr, "Kesalahan saat membaca data dari file (format tidak dikenali).\n");
+        exit(EXIT_FAILURE);
+    }
+    bangun_kolom();
+    bangun_indeks_id();
+    bangun_heap_kadaluarsa();
+    bangun_teks_lipat();
+    bangun_indeks_trigram();
+    bangun_urutan(&urut_harga);
+    bangun_urutan(&urut_nama);
+    urutan_tampilan = header_data()->urutan_tampilan <= 2 ? (int)header_data()->urutan_tampilan : 0;
+
+    if (file_baru) {
+        return;
+    }
+    if (jumlah_tiket_aktif() > 0) {
+        printf("✅ Berhasil memuat %d tiket dari file.\n", jumlah_tiket_aktif());
     } else {
         printf("ℹ️ File data kosong.\n");
     }
-
-    fclose(file);
 }
 
 /**
- * @brief Menyimpan data tiket ke file.
+ * @brief Menandai record di `posisi` berubah. Record di belakang jumlah_record_disk tidak perlu
+ *        ditandai karena seluruh ekor ikut disalin saat simpan.
  */
-void simpan_data() {
-    FILE *file = fopen(NAMA_FILE, "w");
-    if (file == NULL) {
-        perror("❌ Gagal membuka file untuk menyimpan data");
+void tandai_kotor(int posisi) {
+    if (tulis_ulang_penuh || posisi >= jumlah_record_disk || (peta_kotor[posisi >> 6] >> (posisi & 63)) & 1) {
+        return;
+    }
+    if (jumlah_kotor >= jumlah_record_disk / RASIO_KOTOR) {
+        tulis_ulang_penuh = 1; // menulis berurutan sekali lebih murah daripada banyak lompatan
         return;
     }
+    peta_kotor[posisi >> 6] |= 1ULL << (posisi & 63);
+    posisi_kotor[jumlah_kotor++] = posisi;
+}
 
-    if (jumlah_tiket > 0) {
-        size_t items_written = fwrite(daftar_tiket, sizeof(Tiket), jumlah_tiket, file);
-        if (items_written != jumlah_tiket) {
-            fprintf(stderr, "Kesalahan saat menulis data ke file.\n");
-        } else {
-            printf("✅ Berhasil menyimpan %d tiket ke file.\n", jumlah_tiket);
+/**
+ * @brief Memulai pelacakan baru setelah perubahan sampai `jumlah` record disalin ke penyangga.
+ *        Hanya bit yang tadinya menyala yang dihapus, sehingga biayanya sebanding jumlah perubahan.
+ */
+void reset_kotor(int jumlah) {
+    for (int k = 0; k < jumlah_kotor; k++) {
+        peta_kotor[posisi_kotor[k] >> 6] &= ~(1ULL << (posisi_kotor[k] & 63));
+    }
+    jumlah_kotor = 0;
+    jumlah_record_disk = jumlah;
+    if (jumlah > kapasitas_kotor) {
+        int baru = kapasitas_kotor < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_kotor;
+        while (baru < jumlah) {
+            baru *= 2;
+        }
+        uint64_t *peta = (uint64_t *)realloc(peta_kotor, ((size_t)baru / 64 + 1) * sizeof(uint64_t));
+        if (peta != NULL) {
+            size_t kata_lama = kapasitas_kotor > 0 ? (size_t)kapasitas_kotor / 64 + 1 : 0;
+            memset(peta + kata_lama, 0, ((size_t)baru / 64 + 1 - kata_lama) * sizeof(uint64_t));
+            peta_kotor = peta;
+        }
+        int *posisi = (int *)realloc(posisi_kotor, ((size_t)baru / RASIO_KOTOR + 1) * sizeof(int));
+        if (posisi != NULL) {
+            posisi_kotor = posisi;
+        }
+        if (peta != NULL && posisi != NULL) {
+            kapasitas_kotor = baru;
+        }
+    }
+    tulis_ulang_penuh = jumlah > kapasitas_kotor; // gagal alokasi: simpan berikutnya menulis ulang utuh
+}
+
+/**
+ * @brief Memastikan penyangga muat minimal `jumlah` record.
+ * @return 1 jika berhasil, 0 jika gagal alokasi (isi penyangga tetap utuh).
+ */
+int siapkan_penyangga(PenyanggaSimpan *p, int jumlah) {
+    if (jumlah <= p->kapasitas) {
+        return 1;
+    }
+    int baru = p->kapasitas < KAPASITAS_AWAL ? KAPASITAS_AWAL : p->kapasitas;
+    while (baru < jumlah) {
+        baru *= 2;
+    }
+    Tiket *isi = (Tiket *)realloc(p->isi, (size_t)baru * sizeof(Tiket));
+    if (isi == NULL) {
+        return 0;
+    }
+    p->isi = isi;
+    int *posisi = (int *)realloc(p->posisi, (size_t)baru * sizeof(int));
+    if (posisi == NULL) {
+        return 0;
+    }
+    p->posisi = posisi;
+    p->kapasitas = baru;
+    return 1;
+}
+
+/**
+ * @brief Menyalin perubahan sejak simpan terakhir ke penyangga `p` (utas utama).
+ *        Dengan `gabung`, `p` masih menunggu ditulis dan perubahan baru ditambahkan ke dalamnya.
+ *        Penyangga penuh dibuat setelah pemadatan, bila perubahan terlalu banyak, atau bila
+ *        penulisan sebelumnya gagal.
+ * @return 1 jika berhasil, 0 jika gagal alokasi (tanda kotor tetap ada untuk simpan berikutnya).
+ */
+int isi_penyangga(PenyanggaSimpan *p, int gabung) {
+    int ekor = jumlah_tiket - jumlah_record_disk;
+    if (tulis_ulang_penuh || simpan_gagal || ekor < 0) {
+        if (!siapkan_penyangga(p, jumlah_tiket)) {
+            return 0;
+        }
+        memcpy(p->isi, daftar_tiket, (size_t)jumlah_tiket * sizeof(Tiket));
+        p->jumlah = jumlah_tiket;
+        p->penuh = 1;
+        simpan_gagal = 0;
+    } else if (gabung && p->penuh) {
+        // Penyangga penuh yang belum ditulis cukup diperbarui di tempat
+        if (!siapkan_penyangga(p, jumlah_tiket)) {
+            return 0;
         }
+        for (int k = 0; k < jumlah_kotor; k++) {
+            p->isi[posisi_kotor[k]] = daftar_tiket[posisi_kotor[k]];
+        }
+        memcpy(p->isi + jumlah_record_disk, daftar_tiket + jumlah_record_disk, (size_t)ekor * sizeof(Tiket));
+        p->jumlah = jumlah_tiket;
     } else {
-        printf("ℹ️ Tidak ada tiket untuk disimpan.\n");
+        int awal = gabung ? p->jumlah : 0;
+        if (!siapkan_penyangga(p, awal + jumlah_kotor + ekor)) {
+            return 0;
+        }
+        if (jumlah_kotor > 0) {
+            qsort(posisi_kotor, jumlah_kotor, sizeof(int), bandingkan_int); // ditulis searah offset
+        }
+        for (int k = 0; k < jumlah_kotor; k++) {
+            p->posisi[awal + k] = posisi_kotor[k];
+            p->isi[awal + k] = daftar_tiket[posisi_kotor[k]];
+        }
+        awal += jumlah_kotor;
+        for (int k = 0; k < ekor; k++) {
+            p->posisi[awal + k] = jumlah_record_disk + k;
+        }
+        memcpy(p->isi + awal, daftar_tiket + jumlah_record_disk, (size_t)ekor * sizeof(Tiket));
+        p->jumlah = awal + ekor;
+        p->penuh = 0;
+    }
+    header_data()->jumlah_record = (uint32_t)jumlah_tiket;
+    p->header = *header_data();
+    reset_kotor(jumlah_tiket);
+    return 1;
+}
+
+/**
+ * @brief FNV-1a berantai untuk checksum file ubah.
+ */
+uint32_t checksum_ubah(uint32_t h, const void *data, size_t ukuran) {
+    const unsigned char *p = (const unsigned char *)data;
+    for (size_t i = 0; i < ukuran; i++) {
+        h ^= p[i];
+        h *= 16777619u;
     }
+    return h;
+}
 
-    fclose(file);
+/**
+ * @brief Menimpa record di offset tetapnya lalu header, kemudian fsync. Posisi yang berurutan
+ *        ditulis sekaligus.
+ * @return 1 jika berhasil, 0 jika gagal.
+ */
+int terapkan_ubah(const HeaderFile *header, const int *posisi, const Tiket *isi, int jumlah) {
+    FILE *file = fopen(NAMA_FILE, "r+b");
+    if (file == NULL) {
+        return 0;
+    }
+    int berhasil = 1;
+    for (int k = 0; k < jumlah && berhasil;) {
+        int n = 1;
+        while (k + n < jumlah && posisi[k + n] == posisi[k] + n) {
+            n++;
+        }
+        long offset = (long)sizeof(HeaderFile) + (long)posisi[k] * (long)sizeof(Tiket);
+        berhasil = fseek(file, offset, SEEK_SET) == 0 && fwrite(&isi[k], sizeof(Tiket), n, file) == (size_t)n;
+        k += n;
+    }
+    berhasil = berhasil && fseek(file, 0, SEEK_SET) == 0 && fwrite(header, sizeof(HeaderFile), 1, file) == 1 &&
+               sinkronkan_file(file);
+    if (fclose(file) != 0) {
+        berhasil = 0;
+    }
+    return berhasil;
+}
+
+/**
+ * @brief Menulis penyangga sebagian dengan double write: record baru ditulis utuh ke
+ *        NAMA_FILE_UBAH (fsync + fsync direktori) sebelum file data ditimpa di tempat. Crash di
+ *        tengah penimpaan diselesaikan pulihkan_ubah() saat muat berikutnya.
+ * @return 1 jika berhasil, 0 jika gagal.
+ */
+int tulis_ubah(const PenyanggaSimpan *p) {
+    HeaderUbah kepala;
+    memset(&kepala, 0, sizeof(kepala));
+    memcpy(kepala.magic, MAGIC_UBAH, sizeof(kepala.magic));
+    kepala.jumlah = (uint32_t)p->jumlah;
+    uint32_t h = checksum_ubah(2166136261u, &p->header, sizeof(HeaderFile));
+    h = checksum_ubah(h, p->posisi, (size_t)p->jumlah * sizeof(int));
+    kepala.checksum = checksum_ubah(h, p->isi, (size_t)p->jumlah * sizeof(Tiket));
+
+    FILE *file = fopen(NAMA_FILE_UBAH, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    int berhasil = fwrite(&kepala, sizeof(kepala), 1, file) == 1 &&
+                   fwrite(&p->header, sizeof(HeaderFile), 1, file) == 1 &&
+                   fwrite(p->posisi, sizeof(int), p->jumlah, file) == (size_t)p->jumlah &&
+                   fwrite(p->isi, sizeof(Tiket), p->jumlah, file) == (size_t)p->jumlah &&
+                   sinkronkan_file(file);
+    if (fclose(file) != 0) {
+        berhasil = 0;
+    }
+    if (!berhasil) {
+        remove(NAMA_FILE_UBAH); // file data belum disentuh
+        return 0;
+    }
+    sinkronkan_direktori();
+    if (!terapkan_ubah(&p->header, p->posisi, p->isi, p->jumlah)) {
+        return 0; // file ubah tetap ada; pulihkan_ubah() menerapkannya lagi
+    }
+    remove(NAMA_FILE_UBAH);
+    sinkronkan_direktori(); // file ubah basi tidak boleh muncul lagi di atas simpan berikutnya
+    return 1;
+}
+
+/**
+ * @brief Menyelesaikan file ubah sisa simpan yang terputus (crash atau gagal). File ubah yang
+ *        utuh diterapkan lagi (idempotent); yang tertulis setengah dibuang, karena file data
+ *        baru ditimpa setelah file ubah lengkap di disk.
+ * @return 1 jika tidak ada file ubah atau berhasil diselesaikan, 0 jika gagal.
+ */
+int pulihkan_ubah() {
+    FILE *file = fopen(NAMA_FILE_UBAH, "rb");
+    if (file == NULL) {
+        return 1;
+    }
+    HeaderUbah kepala;
+    HeaderFile header;
+    int *posisi = NULL;
+    Tiket *isi = NULL;
+    int utuh = fread(&kepala, sizeof(kepala), 1, file) == 1 &&
+               memcmp(kepala.magic, MAGIC_UBAH, sizeof(kepala.magic)) == 0 && kepala.jumlah <= INT_MAX / sizeof(Tiket) &&
+               fread(&header, sizeof(HeaderFile), 1, file) == 1;
+    int jumlah = utuh ? (int)kepala.jumlah : 0;
+    if (utuh && jumlah > 0) {
+        posisi = (int *)malloc((size_t)jumlah * sizeof(int));
+        isi = (Tiket *)malloc((size_t)jumlah * sizeof(Tiket));
+        if (posisi == NULL || isi == NULL) {
+            free(posisi);
+            free(isi);
+            fclose(file);
+            return 0;
+        }
+        utuh = fread(posisi, sizeof(int), jumlah, file) == (size_t)jumlah &&
+               fread(isi, sizeof(Tiket), jumlah, file) == (size_t)jumlah;
+    }
+    fclose(file);
+    if (utuh) {
+        uint32_t h = checksum_ubah(2166136261u, &header, sizeof(HeaderFile));
+        h = checksum_ubah(h, posisi, (size_t)jumlah * sizeof(int));
+        utuh = checksum_ubah(h, isi, (size_t)jumlah * sizeof(Tiket)) == kepala.checksum;
+    }
+    int berhasil = !utuh || terapkan_ubah(&header, posisi, isi, jumlah);
+    free(posisi);
+    free(isi);
+    if (berhasil) {
+        remove(NAMA_FILE_UBAH);
+        sinkronkan_direktori();
+    }
+    return berhasil;
+}
+
+/**
+ * @brief Menulis penyangga ke file data: penuh lewat file sementara + rename, sebagian lewat
+ *        file ubah. Tidak menyentuh blok_data, jadi aman dari utas penulis.
+ * @return 1 jika berhasil, 0 jika gagal.
+ */
+int tulis_penyangga(const PenyanggaSimpan *p) {
+    if (!pulihkan_ubah()) {
+        return 0; // file ubah lama harus selesai dulu agar tidak menimpa hasil simpan ini
+    }
+    return p->penuh ? tulis_file_data(&p->header, p->isi) : tulis_ubah(p);
+}
+
+/**
+ * @brief Menyalin dan menulis perubahan langsung di utas ini (utas penulis harus diam).
+ * @return 1 jika berhasil, 0 jika gagal.
+ */
+int tulis_blok_data() {
+    PenyanggaSimpan *p = &penyangga_simpan[0];
+    if (!isi_penyangga(p, 0)) {
+        return 0;
+    }
+    if (!tulis_penyangga(p)) {
+        simpan_gagal = 1;
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Menyimpan data tiket ke file dan menunggu sampai selesai (saat program keluar).
+ *        Penulisan latar belakang yang masih berjalan ditunggu lebih dulu.
+ */
+void simpan_data() {
+    tunggu_simpan();
+    if (!tulis_blok_data()) {
+        perror("❌ Gagal menyimpan data ke file");
+        return;
+    }
+
+    if (jumlah_tiket_aktif() > 0) {
+        printf("✅ Berhasil menyimpan %d tiket ke file.\n", jumlah_tiket_aktif());
+    } else {
+        printf("ℹ️ Tidak ada tiket untuk disimpan.\n");
+    }
+}
+
+#if PAKAI_MMAP
+/**
+ * @brief Badan utas penulis: tidur sampai ada penyangga yang menunggu, lalu menulisnya.
+ *        Penyangga sebagian dilewati bila penulisan sebelumnya gagal, karena isinya hanya
+ *        selisih dari keadaan yang tidak sampai ke disk; simpan berikutnya menulis penuh.
+ */
+void *jalankan_penulis(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&kunci_simpan);
+    for (;;) {
+        while (penyangga_antre < 0 && !penulis_berhenti) {
+            pthread_cond_wait(&sinyal_simpan, &kunci_simpan);
+        }
+        if (penyangga_antre < 0) {
+            break;
+        }
+        penyangga_ditulis = penyangga_antre;
+        penyangga_antre = -1;
+        PenyanggaSimpan *p = &penyangga_simpan[penyangga_ditulis];
+        int lewati = simpan_gagal && !p->penuh;
+        pthread_mutex_unlock(&kunci_simpan);
+        int berhasil = !lewati && tulis_penyangga(p);
+        pthread_mutex_lock(&kunci_simpan);
+        if (!berhasil && !lewati) {
+            fprintf(stderr, "⚠️ Peringatan: Gagal menyimpan data di latar belakang, akan dicoba saat simpan berikutnya.\n");
+        }
+        if (!berhasil) {
+            simpan_gagal = 1;
+        } else if (p->penuh) {
+            simpan_gagal = 0; // penyangga sebagian yang menunggu dibuat di atas isi penyangga ini
+        }
+        penyangga_ditulis = -1;
+        pthread_cond_broadcast(&sinyal_simpan);
+    }
+    pthread_mutex_unlock(&kunci_simpan);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Menyimpan data tanpa menunggu disk: perubahan disalin ke penyangga, diserahkan ke utas
+ *        penulis, dan fungsi langsung kembali. Tanpa utas (Windows, atau pthread_create gagal)
+ *        ditulis langsung.
+ */
+void simpan_data_latar() {
+#if PAKAI_MMAP
+    pthread_mutex_lock(&kunci_simpan);
+    PenyanggaSimpan *p = &penyangga_simpan[penyangga_ditulis == 0 ? 1 : 0];
+    if (!isi_penyangga(p, penyangga_antre >= 0)) {
+        pthread_mutex_unlock(&kunci_simpan);
+        perror("⚠️ Peringatan: Gagal menyiapkan data untuk disimpan");
+        return;
+    }
+    penyangga_antre = (int)(p - penyangga_simpan);
+    if (!penulis_hidup) {
+        penulis_berhenti = 0;
+        penulis_hidup = pthread_create(&utas_penulis, NULL, jalankan_penulis, NULL) == 0;
+    }
+    if (penulis_hidup) {
+        pthread_cond_broadcast(&sinyal_simpan);
+        pthread_mutex_unlock(&kunci_simpan);
+        return;
+    }
+    penyangga_antre = -1; // utas tidak bisa dibuat: tulis langsung di utas ini
+    pthread_mutex_unlock(&kunci_simpan);
+#else
+    PenyanggaSimpan *p = &penyangga_simpan[0];
+    if (!isi_penyangga(p, 0)) {
+        perror("⚠️ Peringatan: Gagal menyiapkan data untuk disimpan");
+        return;
+    }
+#endif
+    if (!tulis_penyangga(p)) {
+        simpan_gagal = 1;
+        perror("⚠️ Peringatan: Gagal menyimpan data ke file");
+    }
+}
+
+/**
+ * @brief Penghalang: kembali setelah semua penyimpanan yang sudah diminta selesai ditulis.
+ */
+void tunggu_simpan() {
+#if PAKAI_MMAP
+    pthread_mutex_lock(&kunci_simpan);
+    while (penyangga_antre >= 0 || penyangga_ditulis >= 0) {
+        pthread_cond_wait(&sinyal_simpan, &kunci_simpan);
+    }
+    pthread_mutex_unlock(&kunci_simpan);
+#endif
+}
+
+/**
+ * @brief Menghentikan utas penulis setelah permintaan yang tersisa selesai ditulis,
+ *        lalu melepas kedua penyangga.
+ */
+void hentikan_penulis() {
+#if PAKAI_MMAP
+    if (penulis_hidup) {
+        pthread_mutex_lock(&kunci_simpan);
+        penulis_berhenti = 1;
+        pthread_cond_broadcast(&sinyal_simpan);
+        pthread_mutex_unlock(&kunci_simpan);
+        pthread_join(utas_penulis, NULL);
+        penulis_hidup = 0;
+    }
+#endif
+    for (int b = 0; b < 2; b++) {
+        free(penyangga_simpan[b].isi);
+        free(penyangga_simpan[b].posisi);
+        memset(&penyangga_simpan[b], 0, sizeof(PenyanggaSimpan));
+    }
+}
+
+/**
+ * @brief Memesan `jumlah` ID berurutan sekaligus (misalnya untuk tambah massal).
+ *        Urutan ID tersimpan di header file, sehingga pemesanan O(1) dan ID tiket
+ *        yang sudah dihapus tidak pernah dipakai ulang.
+ * @return ID pertama dari blok yang dipesan.
+ */
+int pesan_blok_id(int jumlah) {
+    HeaderFile *header = header_data();
+    int id_awal = (int)header->id_berikutnya;
+    header->id_berikutnya += (uint32_t)jumlah;
+    return id_awal;
+}
+
+/**
+ * @brief Menghasilkan ID unik baru dari urutan ID di header.
+ * @return ID unik baru.
+ */
+int buat_id_unik() {
+    return pesan_blok_id(1);
+}
+
+/**
+ * @brief Fungsi hash untuk ID tiket (mencampur bit agar ID berurutan tersebar rata).
+ */
+unsigned int hash_id(int id) {
+    unsigned int x = (unsigned int)id;
+    x ^= x >> 16;
+    x *= 0x45d9f3bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Memasang pasangan id -> posisi ke tabel indeks (linear probing).
+ */
+void indeks_pasang(int id, int posisi) {
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0 && indeks_id[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    indeks_id[i].id = id;
+    indeks_id[i].posisi = posisi;
+}
+
+/**
+ * @brief Membangun ulang seluruh indeks ID dari daftar_tiket (O(n)).
+ *        Dipakai setelah muat data dan pemadatan yang menggeser posisi tiket.
+ *        Nisan tidak dimasukkan ke indeks dan sekaligus dihitung ulang di sini.
+ */
+void bangun_indeks_id() {
+    int kapasitas = 16;
+    while (kapasitas < jumlah_tiket * 2) {
+        kapasitas *= 2;
+    }
+    if (kapasitas != kapasitas_indeks) {
+        SlotIndeks *baru = (SlotIndeks *)realloc(indeks_id, kapasitas * sizeof(SlotIndeks));
+        if (baru == NULL) {
+            perror("Gagal mengalokasikan indeks tiket");
+            exit(EXIT_FAILURE);
+        }
+        indeks_id = baru;
+        kapasitas_indeks = kapasitas;
+    }
+
+    for (int i = 0; i < kapasitas_indeks; i++) {
+        indeks_id[i].posisi = -1;
+    }
+    jumlah_nisan = 0;
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) {
+            jumlah_nisan++;
+        } else {
+            indeks_pasang(kolom_id[i], i);
+        }
+    }
+}
+
+/**
+ * @brief Mendaftarkan tiket di `posisi` yang baru ditambahkan ke indeks.
+ *        jumlah_tiket harus sudah termasuk tiket ini.
+ */
+void indeks_tambah(int posisi) {
+    if (jumlah_tiket * 2 > kapasitas_indeks) {
+        bangun_indeks_id();
+    } else {
+        indeks_pasang(daftar_tiket[posisi].id, posisi);
+    }
+}
+
+/**
+ * @brief Mengeluarkan `id` dari indeks. Slot sesudahnya digeser mundur (backward shift)
+ *        sehingga rantai linear probing tetap utuh tanpa penanda hapus di tabel indeks.
+ */
+void indeks_hapus(int id) {
+    if (kapasitas_indeks == 0) {
+        return;
+    }
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0 && indeks_id[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    if (indeks_id[i].posisi < 0) {
+        return;
+    }
+    for (unsigned int j = (i + 1) & mask; indeks_id[j].posisi >= 0; j = (j + 1) & mask) {
+        unsigned int asal = hash_id(indeks_id[j].id) & mask;
+        // Slot j boleh mengisi lubang i hanya jika posisi asalnya tidak berada di antara i (eksklusif) dan j
+        if (((j - asal) & mask) >= ((j - i) & mask)) {
+            indeks_id[i] = indeks_id[j];
+            i = j;
+        }
+    }
+    indeks_id[i].posisi = -1;
+}
+
+/**
+ * @brief Mencari posisi tiket berdasarkan ID melalui indeks hash (O(1) rata-rata).
+ * @return Posisi di daftar_tiket, atau -1 jika tidak ditemukan.
+ */
+int cari_indeks_id(int id) {
+    if (kapasitas_indeks == 0) {
+        return -1;
+    }
+    unsigned int mask = kapasitas_indeks - 1;
+    unsigned int i = hash_id(id) & mask;
+    while (indeks_id[i].posisi >= 0) {
+        if (indeks_id[i].id == id) {
+            return indeks_id[i].posisi;
+        }
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+/**
+ * @brief Jumlah tiket yang masih berlaku (slot terpakai dikurangi nisan).
+ */
+int jumlah_tiket_aktif() {
+    return jumlah_tiket - jumlah_nisan;
+}
+
+/**
+ * @brief Menghapus tiket di `posisi` dalam O(1) dengan menandainya sebagai nisan (id = ID_NISAN).
+ *        Tiket lain tidak digeser; semua pemindaian melewati nisan.
+ */
+void tandai_nisan(int posisi) {
+    pohon_harga_lepas(kolom_harga[posisi], kolom_id[posisi]);
+    indeks_hapus(daftar_tiket[posisi].id);
+    kategori_lepas(posisi);
+    urutan_lepas(&urut_harga, posisi);
+    urutan_lepas(&urut_nama, posisi);
+    daftar_tiket[posisi].id = ID_NISAN;
+    tandai_kotor(posisi);
+    kolom_id[posisi] = ID_NISAN;
+    jumlah_nisan++;
+    trigram_catat_basi();
+}
+
+/**
+ * @brief Membuang semua nisan dalam satu sapuan linear, lalu membangun ulang indeks
+ *        dan memperkecil blok data bila perlu.
+ */
+void padatkan_tiket() {
+    if (jumlah_nisan == 0) {
+        return;
+    }
+    int tujuan = 0;
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) {
+            continue;
+        }
+        if (tujuan != i) {
+            daftar_tiket[tujuan] = daftar_tiket[i];
+            teks_lipat[tujuan] = teks_lipat[i];
+            kolom_id[tujuan] = kolom_id[i];
+            kolom_harga[tujuan] = kolom_harga[i];
+            kolom_stok[tujuan] = kolom_stok[i];
+            kolom_waktu[tujuan] = kolom_waktu[i];
+            urutan_pindah(&urut_harga, i, tujuan);
+            urutan_pindah(&urut_nama, i, tujuan);
+        }
+        tujuan++;
+    }
+    jumlah_tiket = tujuan;
+    header_data()->jumlah_record = (uint32_t)jumlah_tiket;
+    tulis_ulang_penuh = 1; // hampir semua record bergeser dari slot yang tercatat di disk
+    bangun_indeks_id(); // sekaligus mengembalikan jumlah_nisan ke 0
+    bangun_bitmap_kategori(); // posisi tiket bergeser
+
+    // Perkecil blok data bila sudah jauh lebih besar dari isinya
+    if (!susutkan_kapasitas()) {
+        perror("Gagal re-alokasi memori setelah pemadatan");
+    }
+}
+
+/**
+ * @brief Memadatkan array hanya jika nisan sudah melebihi 1/RASIO_NISAN dari slot terpakai.
+ */
+void padatkan_jika_perlu() {
+    if (jumlah_nisan * RASIO_NISAN > jumlah_tiket) {
+        padatkan_tiket();
+    }
+}
+
+/**
+ * @brief Memastikan keempat kolom panas muat minimal `minimal` tiket (tumbuh dua kali lipat).
+ */
+void cadangkan_kolom(int minimal) {
+    if (minimal <= kapasitas_kolom) {
+        return;
+    }
+    int kapasitas = kapasitas_kolom < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_kolom;
+    while (kapasitas < minimal) {
+        kapasitas *= 2;
+    }
+    int *id = (int *)realloc(kolom_id, kapasitas * sizeof(int));
+    if (id != NULL) {
+        kolom_id = id;
+    }
+    float *harga = (float *)realloc(kolom_harga, kapasitas * sizeof(float));
+    if (harga != NULL) {
+        kolom_harga = harga;
+    }
+    int *stok = (int *)realloc(kolom_stok, kapasitas * sizeof(int));
+    if (stok != NULL) {
+        kolom_stok = stok;
+    }
+    time_t *waktu = (time_t *)realloc(kolom_waktu, kapasitas * sizeof(time_t));
+    if (waktu != NULL) {
+        kolom_waktu = waktu;
+    }
+    if (id == NULL || harga == NULL || stok == NULL || waktu == NULL) {
+        perror("Gagal mengalokasikan kolom tiket");
+        exit(EXIT_FAILURE);
+    }
+    kapasitas_kolom = kapasitas;
+}
+
+/**
+ * @brief Menyalin field numerik daftar_tiket[posisi] ke kolom panasnya.
+ */
+void isi_kolom(int posisi) {
+    cadangkan_kolom(posisi + 1);
+    kolom_id[posisi] = daftar_tiket[posisi].id;
+    kolom_harga[posisi] = daftar_tiket[posisi].harga;
+    kolom_stok[posisi] = daftar_tiket[posisi].jumlah_stok;
+    kolom_waktu[posisi] = daftar_tiket[posisi].waktu_dibuat;
+}
+
+/**
+ * @brief Membangun ulang semua kolom panas dari daftar_tiket, dipakai setelah muat data.
+ */
+void bangun_kolom() {
+    cadangkan_kolom(jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) {
+        isi_kolom(i);
+    }
+}
+
+/**
+ * @brief Membebaskan semua kolom panas.
+ */
+void kosongkan_kolom() {
+    free(kolom_id);
+    free(kolom_harga);
+    free(kolom_stok);
+    free(kolom_waktu);
+    kolom_id = NULL;
+    kolom_harga = NULL;
+    kolom_stok = NULL;
+    kolom_waktu = NULL;
+    kapasitas_kolom = 0;
+}
+
+/**
+ * @brief Mengubah harga tiket di `posisi` beserta kolomnya.
+ */
+void atur_harga(int posisi, float harga) {
+    daftar_tiket[posisi].harga = harga;
+    tandai_kotor(posisi);
+    if (kolom_harga[posisi] != harga) {
+        pohon_harga_lepas(kolom_harga[posisi], kolom_id[posisi]);
+        pohon_harga_tambah(harga, kolom_id[posisi]);
+        kolom_harga[posisi] = harga;
+        urutan_ubah(&urut_harga, posisi);
+    }
+}
+
+/**
+ * @brief Mengubah stok tiket di `posisi` beserta kolomnya.
+ */
+void atur_stok(int posisi, int stok) {
+    daftar_tiket[posisi].jumlah_stok = stok;
+    tandai_kotor(posisi);
+    kolom_stok[posisi] = stok;
+}
+
+/**
+ * @brief Mengubah waktu_dibuat tiket di `posisi` beserta kolomnya; heap kadaluarsa diurus pemanggil.
+ */
+void atur_waktu(int posisi, time_t waktu) {
+    daftar_tiket[posisi].waktu_dibuat = waktu;
+    tandai_kotor(posisi);
+    kolom_waktu[posisi] = waktu;
+}
+
+/**
+ * @brief Membandingkan dua posisi tiket menurut (harga, id) untuk indeks urutan harga.
+ */
+int banding_urut_harga(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    if (kolom_harga[x] != kolom_harga[y]) {
+        return kolom_harga[x] < kolom_harga[y] ? -1 : 1;
+    }
+    return (kolom_id[x] > kolom_id[y]) - (kolom_id[x] < kolom_id[y]);
+}
+
+/**
+ * @brief Membandingkan dua posisi tiket menurut (nama konser, id) untuk indeks urutan nama.
+ */
+int banding_urut_nama(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    int hasil = strcmp(daftar_tiket[x].nama_konser, daftar_tiket[y].nama_konser);
+    if (hasil != 0) {
+        return hasil;
+    }
+    return (kolom_id[x] > kolom_id[y]) - (kolom_id[x] < kolom_id[y]);
+}
+
+/*
+ * RADIX SORT untuk pengurutan penuh (indeks yang baru dibangun saat muat data, ekor yang besar).
+ * qsort memanggil pembanding lewat pointer fungsi di setiap perbandingan; di sini setiap tiket
+ * diwakili pasangan 16 byte (kunci, id, posisi) yang diurutkan LSD 8 bit per lintasan. Pada data
+ * besar setiap tahap (isi kunci, hitung ember, sebar) dibagi ke beberapa utas.
+ */
+#define AMBANG_RADIX 2048          // di bawah ini qsort lebih murah dari 256 ember per lintasan
+#define AMBANG_RADIX_PARALEL 65536 // di bawah ini membuat utas lebih mahal dari sortingnya
+#define MAKS_UTAS_SORTIR 8
+
+typedef struct {
+    uint64_t kunci;
+    uint32_t id;    // id dengan bit tanda dibalik; 0 jika id sudah tercakup di kunci
+    int posisi;
+} KunciUrut;
+
+/**
+ * @brief Potongan kerja satu utas radix sort untuk satu tahap dari satu lintasan.
+ */
+typedef struct {
+    KunciUrut *sumber, *tujuan;
+    const int *isi;       // tahap 0: posisi yang diurutkan
+    const IndeksUrut *indeks;
+    int awal, akhir;      // potongan milik utas ini
+    int lintasan, tahap;  // tahap 0 = isi kunci, 1 = hitung ember, 2 = sebar
+    int hitungan[256];    // hasil tahap 1, lalu offset tulis untuk tahap 2
+} TugasRadix;
+
+/**
+ * @brief Kunci lengkap indeks harga: bit float diatur agar urutan bilangan = urutan bit tak
+ *        bertanda, id di 32 bit bawah sebagai pemecah seri. `kedalaman` tidak dipakai.
+ */
+uint64_t kunci_urut_harga(int posisi, int kedalaman) {
+    (void)kedalaman;
+    float harga = kolom_harga[posisi];
+    if (harga == 0.0f) {
+        harga = 0.0f; // -0.0 sama dengan 0.0 bagi pembanding
+    }
+    uint32_t bit;
+    memcpy(&bit, &harga, sizeof(bit));
+    bit = (bit & 0x80000000u) ? ~bit : bit | 0x80000000u;
+    return ((uint64_t)bit << 32) | ((uint32_t)kolom_id[posisi] ^ 0x80000000u);
+}
+
+/**
+ * @brief Kunci awalan indeks nama: byte nama ke-8*kedalaman sampai 8*kedalaman+7 sebagai bilangan
+ *        big-endian (sesudah akhir nama diisi 0), sehingga urutannya sama dengan strcmp.
+ */
+uint64_t kunci_urut_nama(int posisi, int kedalaman) {
+    const unsigned char *nama = (const unsigned char *)daftar_tiket[posisi].nama_konser;
+    uint64_t kunci = 0;
+    int habis = 0;
+    for (int i = 8 * kedalaman; i < 8 * kedalaman + 8; i++) {
+        if (i >= MAX_NAMA || nama[i] == '\0') {
+            habis = 1;
+        }
+        kunci = (kunci << 8) | (habis ? 0 : nama[i]);
+    }
+    return kunci;
+}
+
+/**
+ * @brief Pembanding qsort untuk KunciUrut menurut (nama lengkap, id), dipakai kelompok kecil.
+ */
+int banding_kunci_nama(const void *a, const void *b) {
+    return banding_urut_nama(&((const KunciUrut *)a)->posisi, &((const KunciUrut *)b)->posisi);
+}
+
+/**
+ * @brief Mengerjakan satu tahap radix sort atas potongan [awal, akhir) milik tugas t.
+ */
+void kerjakan_radix(TugasRadix *t) {
+    int geser = 8 * (t->lintasan < 4 ? t->lintasan : t->lintasan - 4);
+    if (t->tahap == 0) {
+        for (int i = t->awal; i < t->akhir; i++) {
+            int posisi = t->isi[i];
+            t->sumber[i].kunci = t->indeks->kunci(posisi, 0);
+            t->sumber[i].id = t->indeks->kunci_awalan ? (uint32_t)kolom_id[posisi] ^ 0x80000000u : 0;
+            t->sumber[i].posisi = posisi;
+        }
+    } else if (t->tahap == 1) {
+        memset(t->hitungan, 0, sizeof(t->hitungan));
+        for (int i = t->awal; i < t->akhir; i++) {
+            uint64_t nilai = t->lintasan < 4 ? t->sumber[i].id : t->sumber[i].kunci;
+            t->hitungan[(nilai >> geser) & 0xFF]++;
+        }
+    } else {
+        for (int i = t->awal; i < t->akhir; i++) {
+            uint64_t nilai = t->lintasan < 4 ? t->sumber[i].id : t->sumber[i].kunci;
+            t->tujuan[t->hitungan[(nilai >> geser) & 0xFF]++] = t->sumber[i];
+        }
+    }
+}
+
+#if PAKAI_MMAP
+void *jalankan_radix(void *arg) {
+    kerjakan_radix((TugasRadix *)arg);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Menjalankan satu tahap di semua potongan. Potongan 0 dikerjakan pemanggil, begitu juga
+ *        potongan yang utasnya gagal dibuat; tanpa pthread semuanya dikerjakan berurutan.
+ */
+void jalankan_tahap_radix(TugasRadix *tugas, int jumlah_utas, int tahap) {
+    int dibuat[MAKS_UTAS_SORTIR] = { 0 };
+    for (int t = 0; t < jumlah_utas; t++) {
+        tugas[t].tahap = tahap;
+    }
+#if PAKAI_MMAP
+    pthread_t utas[MAKS_UTAS_SORTIR];
+    for (int t = 1; t < jumlah_utas; t++) {
+        dibuat[t] = pthread_create(&utas[t], NULL, jalankan_radix, &tugas[t]) == 0;
+    }
+#endif
+    for (int t = 0; t < jumlah_utas; t++) {
+        if (!dibuat[t]) {
+            kerjakan_radix(&tugas[t]);
+        }
+    }
+#if PAKAI_MMAP
+    for (int t = 1; t < jumlah_utas; t++) {
+        if (dibuat[t]) {
+            pthread_join(utas[t], NULL);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Radix sort LSD stabil atas 12 byte: 4 byte id lalu 8 byte kunci. Lintasan yang semua
+ *        elemennya jatuh di satu ember dilewati (id nol, byte atas harga yang seragam).
+ * @return a atau b, mana yang berisi hasil.
+ */
+KunciUrut *radix_kunci(TugasRadix *tugas, int jumlah_utas, KunciUrut *a, KunciUrut *b, int n) {
+    for (int lintasan = 0; lintasan < 12; lintasan++) {
+        for (int t = 0; t < jumlah_utas; t++) {
+            tugas[t].sumber = a;
+            tugas[t].tujuan = b;
+            tugas[t].lintasan = lintasan;
+        }
+        jalankan_tahap_radix(tugas, jumlah_utas, 1);
+        int satu_ember = 0;
+        for (int d = 0; d < 256 && !satu_ember; d++) {
+            int isi_ember = 0;
+            for (int t = 0; t < jumlah_utas; t++) {
+                isi_ember += tugas[t].hitungan[d];
+            }
+            satu_ember = isi_ember == n;
+        }
+        if (satu_ember) {
+            continue;
+        }
+        // Offset tulis per (ember, utas): utas dengan potongan lebih awal menulis lebih dulu -> stabil
+        int total = 0;
+        for (int d = 0; d < 256; d++) {
+            for (int t = 0; t < jumlah_utas; t++) {
+                int c = tugas[t].hitungan[d];
+                tugas[t].hitungan[d] = total;
+                total += c;
+            }
+        }
+        jalankan_tahap_radix(tugas, jumlah_utas, 2);
+        KunciUrut *tukar = a;
+        a = b;
+        b = tukar;
+    }
+    return a;
+}
+
+/**
+ * @brief a[0..n) sudah urut menurut nama sampai byte 8*(kedalaman+1) lalu id. Kelompok berkunci
+ *        sama yang namanya belum habis dipecah dengan 8 byte berikutnya (kelompok kecil di-qsort).
+ */
+void urutkan_kelompok_nama(KunciUrut *a, KunciUrut *bantu, int n, int kedalaman) {
+    for (int k = 0; k < n;) {
+        int j = k + 1;
+        while (j < n && a[j].kunci == a[k].kunci) {
+            j++;
+        }
+        if (j - k > 1 && (a[k].kunci & 0xFF) != 0) {
+            if (j - k < AMBANG_RADIX) {
+                qsort(a + k, j - k, sizeof(KunciUrut), banding_kunci_nama);
+            } else {
+                // Kelompok ini sudah urut id, jadi cukup lintasan kunci (id dinolkan agar dilewati)
+                for (int i = k; i < j; i++) {
+                    a[i].kunci = kunci_urut_nama(a[i].posisi, kedalaman + 1);
+                    a[i].id = 0;
+                }
+                TugasRadix tugas = { 0 };
+                tugas.akhir = j - k;
+                KunciUrut *hasil = radix_kunci(&tugas, 1, a + k, bantu + k, j - k);
+                if (hasil != a + k) {
+                    memcpy(a + k, hasil, (j - k) * sizeof(KunciUrut));
+                }
+                urutkan_kelompok_nama(a + k, bantu + k, j - k, kedalaman + 1);
+            }
+        }
+        k = j;
+    }
+}
+
+/**
+ * @brief Mengurutkan n posisi tiket menurut indeks x. Hasilnya sama persis dengan
+ *        qsort(isi, n, sizeof(int), x->banding); n kecil memang diserahkan ke qsort.
+ */
+void urutkan_posisi(IndeksUrut *x, int *isi, int n) {
+    if (n < AMBANG_RADIX) {
+        qsort(isi, n, sizeof(int), x->banding);
+        return;
+    }
+    KunciUrut *a = (KunciUrut *)malloc(n * sizeof(KunciUrut));
+    KunciUrut *b = (KunciUrut *)malloc(n * sizeof(KunciUrut));
+    if (a == NULL || b == NULL) {
+        perror("Gagal mengalokasikan kunci sorting");
+        exit(EXIT_FAILURE);
+    }
+    int jumlah_utas = 1;
+#if PAKAI_MMAP
+    if (n >= AMBANG_RADIX_PARALEL) {
+        long cpu = sysconf(_SC_NPROCESSORS_ONLN);
+        jumlah_utas = cpu < 1 ? 1 : cpu > MAKS_UTAS_SORTIR ? MAKS_UTAS_SORTIR : (int)cpu;
+    }
+#endif
+    TugasRadix tugas[MAKS_UTAS_SORTIR] = { 0 };
+    for (int t = 0; t < jumlah_utas; t++) {
+        tugas[t].sumber = a;
+        tugas[t].isi = isi;
+        tugas[t].indeks = x;
+        tugas[t].awal = (int)((long)n * t / jumlah_utas);
+        tugas[t].akhir = (int)((long)n * (t + 1) / jumlah_utas);
+    }
+    jalankan_tahap_radix(tugas, jumlah_utas, 0);
+    KunciUrut *hasil = radix_kunci(tugas, jumlah_utas, a, b, n);
+    if (x->kunci_awalan) {
+        urutkan_kelompok_nama(hasil, hasil == a ? b : a, n, 0);
+    }
+    for (int i = 0; i < n; i++) {
+        isi[i] = hasil[i].posisi;
+    }
+    free(a);
+    free(b);
+}
+
+/**
+ * @brief Memastikan isi indeks urutan muat `minimal_isi` entri dan letak muat `minimal_letak` posisi.
+ */
+void cadangkan_urutan(IndeksUrut *x, int minimal_isi, int minimal_letak) {
+    if (minimal_isi > x->kapasitas) {
+        int kapasitas = x->kapasitas < KAPASITAS_AWAL ? KAPASITAS_AWAL : x->kapasitas;
+        while (kapasitas < minimal_isi) {
+            kapasitas *= 2;
+        }
+        int *baru = (int *)realloc(x->isi, kapasitas * sizeof(int));
+        if (baru == NULL) {
+            perror("Gagal mengalokasikan indeks urutan");
+            exit(EXIT_FAILURE);
+        }
+        x->isi = baru;
+        x->kapasitas = kapasitas;
+    }
+    if (minimal_letak > x->kapasitas_letak) {
+        int kapasitas = x->kapasitas_letak < KAPASITAS_AWAL ? KAPASITAS_AWAL : x->kapasitas_letak;
+        while (kapasitas < minimal_letak) {
+            kapasitas *= 2;
+        }
+        int *baru = (int *)realloc(x->letak, kapasitas * sizeof(int));
+        if (baru == NULL) {
+            perror("Gagal mengalokasikan indeks urutan");
+            exit(EXIT_FAILURE);
+        }
+        x->letak = baru;
+        x->kapasitas_letak = kapasitas;
+    }
+}
+
+/**
+ * @brief Mendaftarkan tiket di `posisi` ke ekor indeks urutan (O(1)); ekor diurutkan saat dibutuhkan.
+ */
+void urutan_tambah(IndeksUrut *x, int posisi) {
+    cadangkan_urutan(x, x->jumlah + 1, posisi + 1);
+    x->letak[posisi] = x->jumlah;
+    x->isi[x->jumlah++] = posisi;
+}
+
+/**
+ * @brief Mengeluarkan tiket di `posisi` dari indeks urutan dengan menjadikan entrinya lubang (O(1)).
+ */
+void urutan_lepas(IndeksUrut *x, int posisi) {
+    int k = x->letak[posisi];
+    if (k < 0) {
+        return;
+    }
+    x->isi[k] = -1;
+    x->letak[posisi] = -1;
+    x->lubang++;
+}
+
+/**
+ * @brief Kunci tiket di `posisi` berubah: entrinya dipindah dari bagian yang sudah urut ke ekor.
+ */
+void urutan_ubah(IndeksUrut *x, int posisi) {
+    int k = x->letak[posisi];
+    if (k >= 0 && k < x->terurut) {
+        urutan_lepas(x, posisi);
+        urutan_tambah(x, posisi);
+    }
+}
+
+/**
+ * @brief Tiket pindah dari posisi `dari` ke `ke` saat pemadatan (ke <= dari); urutan entri tetap.
+ */
+void urutan_pindah(IndeksUrut *x, int dari, int ke) {
+    int k = x->letak[dari];
+    if (k >= 0) {
+        x->isi[k] = ke;
+    }
+    x->letak[ke] = k;
+}
+
+/**
+ * @brief Mengisi ulang indeks urutan dari semua tiket aktif. Semuanya masuk ekor dan baru
+ *        diurutkan saat pertama kali dibutuhkan, sehingga muat data tidak ikut membayar sorting.
+ */
+void bangun_urutan(IndeksUrut *x) {
+    x->jumlah = 0;
+    x->terurut = 0;
+    x->lubang = 0;
+    cadangkan_urutan(x, jumlah_tiket, jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) {
+            x->letak[i] = -1;
+        } else {
+            urutan_tambah(x, i);
+        }
+    }
+}
+
+/**
+ * @brief Mengurutkan ekor lalu menggabungkannya dengan bagian yang sudah urut dalam satu sapuan
+ *        linear: O(n + m log m) untuk m perubahan, tanpa kerja bila tidak ada perubahan.
+ *        Sesudahnya indeks tidak berlubang.
+ */
+void rapikan_urutan(IndeksUrut *x) {
+    if (x->terurut == x->jumlah && x->lubang == 0) {
+        return;
+    }
+    int awal_ekor = x->terurut;
+    int akhir_ekor = awal_ekor;
+    for (int k = awal_ekor; k < x->jumlah; k++) {
+        if (x->isi[k] >= 0) {
+            x->isi[akhir_ekor++] = x->isi[k];
+        }
+    }
+    urutkan_posisi(x, x->isi + awal_ekor, akhir_ekor - awal_ekor);
+
+    int *baru = (int *)malloc((x->kapasitas > 0 ? x->kapasitas : 1) * sizeof(int));
+    if (baru == NULL) {
+        perror("Gagal mengalokasikan indeks urutan");
+        exit(EXIT_FAILURE);
+    }
+    int i = 0, j = awal_ekor, n = 0;
+    while (i < awal_ekor || j < akhir_ekor) {
+        if (i < awal_ekor && x->isi[i] < 0) {
+            i++;
+            continue;
+        }
+        int posisi;
+        if (j >= akhir_ekor || (i < awal_ekor && x->banding(&x->isi[i], &x->isi[j]) <= 0)) {
+            posisi = x->isi[i++];
+        } else {
+            posisi = x->isi[j++];
+        }
+        baru[n] = posisi;
+        x->letak[posisi] = n;
+        n++;
+    }
+    free(x->isi);
+    x->isi = baru;
+    x->jumlah = n;
+    x->terurut = n;
+    x->lubang = 0;
+}
+
+/**
+ * @brief Membebaskan memori indeks urutan.
+ */
+void kosongkan_urutan(IndeksUrut *x) {
+    free(x->isi);
+    free(x->letak);
+    x->isi = NULL;
+    x->letak = NULL;
+    x->jumlah = 0;
+    x->terurut = 0;
+    x->lubang = 0;
+    x->kapasitas = 0;
+    x->kapasitas_letak = 0;
+}
+
+/**
+ * @brief Menyiapkan urutan tampilan aktif.
+ * @return Banyaknya k yang dijalani posisi_tampilan(k).
+ */
+int siapkan_tampilan() {
+    if (urutan_tampilan == 0) {
+        return jumlah_tiket;
+    }
+    IndeksUrut *x = urutan_tampilan == 1 ? &urut_harga : &urut_nama;
+    rapikan_urutan(x);
+    return x->jumlah;
+}
+
+/**
+ * @brief Posisi tiket ke-k menurut urutan tampilan (sesudah siapkan_tampilan).
+ *        Pada urutan simpan (0) hasilnya bisa berupa nisan.
+ */
+int posisi_tampilan(int k) {
+    if (urutan_tampilan == 0) {
+        return k;
+    }
+    return (urutan_tampilan == 1 ? &urut_harga : &urut_nama)->isi[k];
+}
+
+/**
+ * @brief Menyusun ulang posisi hasil pencarian (urut naik) mengikuti urutan tampilan,
+ *        dengan mengurutkan letak setiap posisi di indeks urutan aktif (O(k log k)).
+ */
+void urutkan_hasil_tampilan(int *posisi, int jumlah) {
+    if (urutan_tampilan == 0 || jumlah < 2) {
+        return;
+    }
+    siapkan_tampilan();
+    IndeksUrut *x = urutan_tampilan == 1 ? &urut_harga : &urut_nama;
+    for (int k = 0; k < jumlah; k++) {
+        posisi[k] = x->letak[posisi[k]];
+    }
+    qsort(posisi, jumlah, sizeof(int), bandingkan_int);
+    for (int k = 0; k < jumlah; k++) {
+        posisi[k] = x->isi[posisi[k]];
+    }
+}
+
+/*
+ * HALAMAN & TOP-K: daftar dibaca per halaman menurut urutan tampilan. Kursor halaman adalah ID
+ * tiket terakhir di halaman sebelumnya; letaknya di urutan didapat lewat indeks ID dan `letak`,
+ * jadi halaman berikutnya cukup O(halaman) walau katalog berubah di antaranya. Tiket termurah
+ * dicari dengan max-heap berukuran k, tanpa menyalin atau mengurutkan seluruh katalog.
+ */
+#define UKURAN_HALAMAN 10 // tiket per halaman di menu interaktif
+
+/**
+ * @brief Apakah slot `posisi` berisi tiket aktif (dan, bila `hanya_tersedia`, stoknya > 0).
+ */
+int tiket_lolos(int posisi, int hanya_tersedia) {
+    return kolom_id[posisi] != ID_NISAN && (!hanya_tersedia || kolom_stok[posisi] > 0);
+}
+
+/**
+ * @brief Letak (k untuk posisi_tampilan) tepat sesudah tiket `id` di urutan tampilan.
+ * @return -1 jika tiket sudah tidak ada (kursor basi).
+ */
+int letak_kursor(int id) {
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) {
+        return -1;
+    }
+    siapkan_tampilan();
+    if (urutan_tampilan == 0) {
+        return posisi + 1;
+    }
+    return (urutan_tampilan == 1 ? &urut_harga : &urut_nama)->letak[posisi] + 1;
+}
+
+/**
+ * @brief Letak tiket lolos ke-`offset` (mulai 0). Tanpa saringan stok dan tanpa nisan di urutan
+ *        hasilnya langsung O(1); selain itu tiket sebelumnya dihitung satu per satu.
+ */
+int letak_offset(int offset, int hanya_tersedia) {
+    int n = siapkan_tampilan();
+    if (!hanya_tersedia && (urutan_tampilan != 0 || jumlah_nisan == 0)) {
+        return offset < n ? offset : n;
+    }
+    for (int k = 0; k < n; k++) {
+        if (tiket_lolos(posisi_tampilan(k), hanya_tersedia) && offset-- == 0) {
+            return k;
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief Mengisi `posisi` dengan paling banyak `batas` tiket lolos mulai letak `mulai`.
+ * @param kursor Diisi ID tiket terakhir bila halaman penuh (mungkin masih ada lanjutan),
+ *               atau 0 bila daftar sudah habis.
+ * @return Banyaknya tiket di halaman.
+ */
+int ambil_halaman(int mulai, int batas, int hanya_tersedia, int *posisi, int *kursor) {
+    int n = siapkan_tampilan();
+    int jumlah = 0;
+    for (int k = mulai; k < n && jumlah < batas; k++) {
+        int i = posisi_tampilan(k);
+        if (tiket_lolos(i, hanya_tersedia)) {
+            posisi[jumlah++] = i;
+        }
+    }
+    *kursor = jumlah > 0 && jumlah == batas ? kolom_id[posisi[jumlah - 1]] : 0;
+    return jumlah;
+}
+
+/**
+ * @brief Menaikkan entri ke-i max-heap (harga, id) ke tempatnya.
+ */
+void termahal_naik(int *heap, int i) {
+    while (i > 0) {
+        int induk = (i - 1) / 2;
+        if (banding_urut_harga(&heap[i], &heap[induk]) <= 0) {
+            break;
+        }
+        int sementara = heap[i];
+        heap[i] = heap[induk];
+        heap[induk] = sementara;
+        i = induk;
+    }
+}
+
+/**
+ * @brief Menurunkan entri ke-i max-heap (harga, id) berukuran n ke tempatnya.
+ */
+void termahal_turun(int *heap, int n, int i) {
+    while (1) {
+        int besar = i;
+        int kiri = 2 * i + 1;
+        int kanan = 2 * i + 2;
+        if (kiri < n && banding_urut_harga(&heap[kiri], &heap[besar]) > 0) {
+            besar = kiri;
+        }
+        if (kanan < n && banding_urut_harga(&heap[kanan], &heap[besar]) > 0) {
+            besar = kanan;
+        }
+        if (besar == i) {
+            return;
+        }
+        int sementara = heap[i];
+        heap[i] = heap[besar];
+        heap[besar] = sementara;
+        i = besar;
+    }
+}
+
+/**
+ * @brief Mengisi `posisi` (muat k entri) dengan k tiket termurah yang stoknya > 0, urut (harga, id).
+ *        Bila indeks harga sedang rapi cukup dijalani dari depan; selain itu satu sapuan kolom
+ *        dengan max-heap berukuran k (O(n log k)), jadi indeks tidak dirapikan hanya demi k tiket.
+ * @return Banyaknya tiket yang didapat.
+ */
+int ambil_termurah(int k, int *posisi) {
+    int jumlah = 0;
+    if (k <= 0) {
+        return 0;
+    }
+    if (urut_harga.terurut == urut_harga.jumlah && urut_harga.lubang == 0) {
+        for (int j = 0; j < urut_harga.jumlah && jumlah < k; j++) {
+            if (kolom_stok[urut_harga.isi[j]] > 0) {
+                posisi[jumlah++] = urut_harga.isi[j];
+            }
+        }
+        return jumlah;
+    }
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (!tiket_lolos(i, 1)) {
+            continue;
+        }
+        if (jumlah < k) {
+            posisi[jumlah] = i;
+            termahal_naik(posisi, jumlah++);
+        } else if (banding_urut_harga(&i, &posisi[0]) < 0) {
+            posisi[0] = i;
+            termahal_turun(posisi, k, 0);
+        }
+    }
+    // Puncak (termahal) dipindah ke belakang satu per satu, sehingga hasilnya urut naik
+    for (int sisa = jumlah - 1; sisa > 0; sisa--) {
+        int sementara = posisi[0];
+        posisi[0] = posisi[sisa];
+        posisi[sisa] = sementara;
+        termahal_turun(posisi, sisa, 0);
+    }
+    return jumlah;
+}
+
+/**
+ * @brief Menanyakan apakah halaman berikutnya ditampilkan.
+ * @return 1 jika pengguna menekan Enter saja, 0 untuk jawaban lain atau EOF.
+ */
+int lanjut_halaman() {
+    char jawaban[16];
+    printf("-- Enter: halaman berikutnya, q: selesai -- ");
+    if (fgets(jawaban, sizeof(jawaban), stdin) == NULL) {
+        return 0;
+    }
+    if (strchr(jawaban, '\n') == NULL) {
+        bersihkan_buffer();
+    }
+    return jawaban[0] == '\n';
+}
+
+/*
+ * POHON HARGA (B+tree): kunci (harga, id) urut naik di simpul lebar, daun dirantai kiri-kanan.
+ * Rentang harga cukup turun sekali ke daun pertama lalu menyusuri daun: O(log n + k), tanpa
+ * merapikan indeks urutan. Daun menyimpan ID, bukan posisi, jadi pemadatan tidak menyentuh pohon.
+ * Pohon dibangun saat rentang pertama diminta, lalu dirawat setiap tiket masuk, dihapus, atau
+ * harganya berubah. Penghapusan tidak menggabung simpul; simpul yang kosong langsung dilepas.
+ */
+#define CABANG_POHON 32 // kunci per simpul; 32 x (harga + id) = 256 byte
+
+typedef struct SimpulHarga {
+    int jumlah;
+    int daun;
+    float harga[CABANG_POHON]; // simpul dalam: kunci terkecil (atau lebih kecil) di anak[i]
+    int id[CABANG_POHON];
+    struct SimpulHarga *anak[CABANG_POHON]; // hanya simpul dalam
+    struct SimpulHarga *kiri, *kanan;       // hanya daun
+} SimpulHarga;
+
+SimpulHarga *akar_harga = NULL;
+int pohon_harga_aktif = 0; // 0 = belum dibangun; perubahan tiket belum perlu dicatat
+
+/**
+ * @brief Membandingkan dua kunci (harga, id).
+ * @return Negatif, 0, atau positif seperti strcmp.
+ */
+int banding_kunci_harga(float harga_a, int id_a, float harga_b, int id_b) {
+    if (harga_a != harga_b) {
+        return harga_a < harga_b ? -1 : 1;
+    }
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * @brief Indeks kunci pertama di simpul `s` yang > (harga, id) bila `lebih`, atau >= bila tidak.
+ */
+int cari_kunci_simpul(const SimpulHarga *s, float harga, int id, int lebih) {
+    int kiri = 0;
+    int kanan = s->jumlah;
+    while (kiri < kanan) {
+        int tengah = (kiri + kanan) / 2;
+        int b = banding_kunci_harga(s->harga[tengah], s->id[tengah], harga, id);
+        if (b < 0 || (lebih && b == 0)) {
+            kiri = tengah + 1;
+        } else {
+            kanan = tengah;
+        }
+    }
+    return kiri;
+}
+
+/**
+ * @brief Anak simpul dalam `s` yang memuat (harga, id): kunci terakhir yang <= kunci itu
+ *        (anak pertama bila semua kunci lebih besar).
+ */
+int cari_anak_simpul(const SimpulHarga *s, float harga, int id) {
+    int i = cari_kunci_simpul(s, harga, id, 1) - 1;
+    return i < 0 ? 0 : i;
+}
+
+/**
+ * @brief Mengalokasikan simpul kosong; program berhenti bila memori habis.
+ */
+SimpulHarga *simpul_harga_baru(int daun) {
+    SimpulHarga *s = (SimpulHarga *)calloc(1, sizeof(SimpulHarga));
+    if (s == NULL) {
+        perror("Gagal mengalokasikan pohon harga");
+        exit(EXIT_FAILURE);
+    }
+    s->daun = daun;
+    return s;
+}
+
+/**
+ * @brief Membelah anak[i] yang penuh menjadi dua; separuh kanan masuk induk sebagai anak[i + 1].
+ */
+void belah_simpul_harga(SimpulHarga *induk, int i) {
+    SimpulHarga *a = induk->anak[i];
+    SimpulHarga *b = simpul_harga_baru(a->daun);
+    int separuh = CABANG_POHON / 2;
+    b->jumlah = a->jumlah - separuh;
+    memcpy(b->harga, a->harga + separuh, b->jumlah * sizeof(float));
+    memcpy(b->id, a->id + separuh, b->jumlah * sizeof(int));
+    if (!a->daun) {
+        memcpy(b->anak, a->anak + separuh, b->jumlah * sizeof(SimpulHarga *));
+    }
+    a->jumlah = separuh;
+    if (a->daun) {
+        b->kiri = a;
+        b->kanan = a->kanan;
+        if (a->kanan != NULL) {
+            a->kanan->kiri = b;
+        }
+        a->kanan = b;
+    }
+    int geser = induk->jumlah - i - 1;
+    memmove(induk->harga + i + 2, induk->harga + i + 1, geser * sizeof(float));
+    memmove(induk->id + i + 2, induk->id + i + 1, geser * sizeof(int));
+    memmove(induk->anak + i + 2, induk->anak + i + 1, geser * sizeof(SimpulHarga *));
+    induk->harga[i + 1] = b->harga[0];
+    induk->id[i + 1] = b->id[0];
+    induk->anak[i + 1] = b;
+    induk->jumlah++;
+}
+
+/**
+ * @brief Menyisipkan kunci (harga, id). Simpul penuh dibelah sambil turun, jadi induknya selalu masih muat.
+ */
+void pohon_harga_tambah(float harga, int id) {
+    if (!pohon_harga_aktif) {
+        return;
+    }
+    if (akar_harga == NULL) {
+        akar_harga = simpul_harga_baru(1);
+    }
+    if (akar_harga->jumlah == CABANG_POHON) {
+        SimpulHarga *akar = simpul_harga_baru(0);
+        akar->harga[0] = akar_harga->harga[0];
+        akar->id[0] = akar_harga->id[0];
+        akar->anak[0] = akar_harga;
+        akar->jumlah = 1;
+        akar_harga = akar;
+        belah_simpul_harga(akar, 0);
+    }
+    SimpulHarga *s = akar_harga;
+    while (!s->daun) {
+        int i = cari_anak_simpul(s, harga, id);
+        if (banding_kunci_harga(harga, id, s->harga[i], s->id[i]) < 0) { // kunci terkecil baru
+            s->harga[i] = harga;
+            s->id[i] = id;
+        }
+        if (s->anak[i]->jumlah == CABANG_POHON) {
+            belah_simpul_harga(s, i);
+            if (banding_kunci_harga(harga, id, s->harga[i + 1], s->id[i + 1]) >= 0) {
+                i++;
+            }
+        }
+        s = s->anak[i];
+    }
+    int i = cari_kunci_simpul(s, harga, id, 0);
+    int geser = s->jumlah - i;
+    memmove(s->harga + i + 1, s->harga + i, geser * sizeof(float));
+    memmove(s->id + i + 1, s->id + i, geser * sizeof(int));
+    s->harga[i] = harga;
+    s->id[i] = id;
+    s->jumlah++;
+}
+
+/**
+ * @brief Menghapus kunci dari subpohon `s`.
+ * @return 1 bila `s` menjadi kosong (dilepas oleh induknya), 0 bila tidak.
+ */
+int hapus_dari_simpul_harga(SimpulHarga *s, float harga, int id) {
+    int i;
+    if (s->daun) {
+        i = cari_kunci_simpul(s, harga, id, 0);
+        if (i == s->jumlah || s->harga[i] != harga || s->id[i] != id) {
+            return 0;
+        }
+    } else {
+        i = cari_anak_simpul(s, harga, id);
+        if (!hapus_dari_simpul_harga(s->anak[i], harga, id)) {
+            return 0;
+        }
+        SimpulHarga *kosong = s->anak[i];
+        if (kosong->daun) {
+            if (kosong->kiri != NULL) {
+                kosong->kiri->kanan = kosong->kanan;
+            }
+            if (kosong->kanan != NULL) {
+                kosong->kanan->kiri = kosong->kiri;
+            }
+        }
+        free(kosong);
+        memmove(s->anak + i, s->anak + i + 1, (s->jumlah - i - 1) * sizeof(SimpulHarga *));
+    }
+    // Kunci simpul dalam yang kini lebih kecil dari isi anaknya tetap sah sebagai pemandu
+    memmove(s->harga + i, s->harga + i + 1, (s->jumlah - i - 1) * sizeof(float));
+    memmove(s->id + i, s->id + i + 1, (s->jumlah - i - 1) * sizeof(int));
+    return --s->jumlah == 0;
+}
+
+/**
+ * @brief Melepas kunci (harga, id) dari pohon; akar yang tinggal punya satu anak diganti anaknya.
+ */
+void pohon_harga_lepas(float harga, int id) {
+    if (!pohon_harga_aktif || akar_harga == NULL) {
+        return;
+    }
+    if (hapus_dari_simpul_harga(akar_harga, harga, id)) {
+        free(akar_harga);
+        akar_harga = NULL;
+        return;
+    }
+    while (!akar_harga->daun && akar_harga->jumlah == 1) {
+        SimpulHarga *lama = akar_harga;
+        akar_harga = lama->anak[0];
+        free(lama);
+    }
+}
+
+/**
+ * @brief Membebaskan subpohon `s`.
+ */
+void bebaskan_simpul_harga(SimpulHarga *s) {
+    if (!s->daun) {
+        for (int i = 0; i < s->jumlah; i++) {
+            bebaskan_simpul_harga(s->anak[i]);
+        }
+    }
+    free(s);
+}
+
+/**
+ * @brief Membebaskan pohon harga; pohon dibangun lagi saat rentang berikutnya diminta.
+ */
+void kosongkan_pohon_harga() {
+    if (akar_harga != NULL) {
+        bebaskan_simpul_harga(akar_harga);
+    }
+    akar_harga = NULL;
+    pohon_harga_aktif = 0;
+}
+
+/**
+ * @brief Membangun pohon dari bawah ke atas memakai indeks harga (sudah urut (harga, id)).
+ *        Daun dan simpul dalam diisi 3/4 agar tiket baru tidak langsung membelah.
+ */
+void bangun_pohon_harga() {
+    kosongkan_pohon_harga();
+    pohon_harga_aktif = 1;
+    rapikan_urutan(&urut_harga);
+    int n = urut_harga.jumlah;
+    int isi = CABANG_POHON * 3 / 4;
+    if (n == 0) {
+        return;
+    }
+    int jumlah_simpul = (n + isi - 1) / isi;
+    SimpulHarga **lapis = (SimpulHarga **)malloc(jumlah_simpul * sizeof(SimpulHarga *));
+    SimpulHarga *kiri = NULL;
+    if (lapis == NULL) {
+        perror("Gagal mengalokasikan pohon harga");
+        exit(EXIT_FAILURE);
+    }
+    for (int j = 0; j < jumlah_simpul; j++) {
+        SimpulHarga *s = simpul_harga_baru(1);
+        for (int k = j * isi; k < n && s->jumlah < isi; k++) {
+            int posisi = urut_harga.isi[k];
+            s->harga[s->jumlah] = kolom_harga[posisi];
+            s->id[s->jumlah] = kolom_id[posisi];
+            s->jumlah++;
+        }
+        s->kiri = kiri;
+        if (kiri != NULL) {
+            kiri->kanan = s;
+        }
+        lapis[j] = kiri = s;
+    }
+    while (jumlah_simpul > 1) {
+        // lapis[j] boleh ditimpa: anak yang dibaca selalu di indeks >= j * isi
+        int atas = (jumlah_simpul + isi - 1) / isi;
+        for (int j = 0; j < atas; j++) {
+            SimpulHarga *s = simpul_harga_baru(0);
+            for (int k = j * isi; k < jumlah_simpul && s->jumlah < isi; k++) {
+                s->harga[s->jumlah] = lapis[k]->harga[0];
+                s->id[s->jumlah] = lapis[k]->id[0];
+                s->anak[s->jumlah] = lapis[k];
+                s->jumlah++;
+            }
+            lapis[j] = s;
+        }
+        jumlah_simpul = atas;
+    }
+    akar_harga = lapis[0];
+    free(lapis);
+}
+
+/**
+ * @brief Mengambil paling banyak `batas` tiket dengan harga_min <= harga <= harga_max, urut
+ *        (harga, id), mulai sesudah tiket `setelah` (0 = dari awal rentang). Saringan stok dan
+ *        kategori (NULL = semua, sudah di-casefold) diperiksa sambil menyusuri daun.
+ * @param kursor Diisi ID tiket terakhir bila halaman penuh, 0 bila rentang sudah habis.
+ * @return Jumlah tiket, atau -1 bila tiket `setelah` sudah tidak ada.
+ */
+int ambil_rentang_harga(float harga_min, float harga_max, int setelah, int hanya_tersedia, const char *kategori_lipat, int *posisi, int batas, int *kursor) {
+    float harga_mulai = harga_min;
+    int id_mulai = INT_MIN;
+    int lewati = 0;
+    int jumlah = 0;
+    *kursor = 0;
+    if (setelah != 0) {
+        int p = cari_indeks_id(setelah);
+        if (p < 0) {
+            return -1;
+        }
+        if (banding_kunci_harga(kolom_harga[p], setelah, harga_min, INT_MIN) > 0) {
+            harga_mulai = kolom_harga[p];
+            id_mulai = setelah;
+            lewati = 1;
+        }
+    }
+    if (!pohon_harga_aktif) {
+        bangun_pohon_harga();
+    }
+    if (akar_harga == NULL || batas <= 0) {
+        return 0;
+    }
+    int kode = kategori_lipat != NULL ? kode_kategori(kategori_lipat, 0) : 0;
+    SimpulHarga *s = akar_harga;
+    while (!s->daun) {
+        s = s->anak[cari_anak_simpul(s, harga_mulai, id_mulai)];
+    }
+    for (int i = cari_kunci_simpul(s, harga_mulai, id_mulai, lewati); s != NULL; s = s->kanan, i = 0) {
+        for (; i < s->jumlah; i++) {
+            if (s->harga[i] > harga_max) {
+                return jumlah;
+            }
+            int p = cari_indeks_id(s->id[i]);
+            if (hanya_tersedia && kolom_stok[p] <= 0) {
+                continue;
+            }
+            if (kategori_lipat != NULL && !tiket_berkategori(p, kode, kategori_lipat)) {
+                continue;
+            }
+            posisi[jumlah++] = p;
+            if (jumlah == batas) {
+                *kursor = s->id[i];
+                return jumlah;
+            }
+        }
+    }
+    return jumlah;
+}
+
+/**
+ * @brief Menukar dua entri heap kadaluarsa.
+ */
+void heap_tukar(int a, int b) {
+    EntriKadaluarsa sementara = heap_kadaluarsa[a];
+    heap_kadaluarsa[a] = heap_kadaluarsa[b];
+    heap_kadaluarsa[b] = sementara;
+}
+
+/**
+ * @brief Menaikkan entri ke-i sampai induknya tidak lebih lambat kadaluarsa.
+ */
+void heap_naik(int i) {
+    while (i > 0 && heap_kadaluarsa[(i - 1) / 2].waktu > heap_kadaluarsa[i].waktu) {
+        heap_tukar(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+/**
+ * @brief Menurunkan entri ke-i sampai kedua anaknya tidak lebih cepat kadaluarsa.
+ */
+void heap_turun(int i) {
+    while (1) {
+        int terkecil = i;
+        int kiri = 2 * i + 1;
+        int kanan = 2 * i + 2;
+        if (kiri < ukuran_heap && heap_kadaluarsa[kiri].waktu < heap_kadaluarsa[terkecil].waktu) {
+            terkecil = kiri;
+        }
+        if (kanan < ukuran_heap && heap_kadaluarsa[kanan].waktu < heap_kadaluarsa[terkecil].waktu) {
+            terkecil = kanan;
+        }
+        if (terkecil == i) {
+            return;
+        }
+        heap_tukar(i, terkecil);
+        i = terkecil;
+    }
+}
+
+/**
+ * @brief Memastikan heap kadaluarsa muat minimal `minimal` entri (tumbuh dua kali lipat).
+ */
+void cadangkan_heap(int minimal) {
+    if (minimal <= kapasitas_heap) {
+        return;
+    }
+    int kapasitas = kapasitas_heap < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_heap;
+    while (kapasitas < minimal) {
+        kapasitas *= 2;
+    }
+    EntriKadaluarsa *baru = (EntriKadaluarsa *)realloc(heap_kadaluarsa, kapasitas * sizeof(EntriKadaluarsa));
+    if (baru == NULL) {
+        perror("Gagal mengalokasikan indeks kadaluarsa");
+        exit(EXIT_FAILURE);
+    }
+    heap_kadaluarsa = baru;
+    kapasitas_heap = kapasitas;
+}
+
+/**
+ * @brief Membangun ulang heap kadaluarsa dari semua tiket aktif dalam O(n) (heapify).
+ *        Entri memakai ID, bukan posisi, sehingga tetap berlaku setelah sorting dan pemadatan.
+ */
+void bangun_heap_kadaluarsa() {
+    cadangkan_heap(jumlah_tiket_aktif());
+    ukuran_heap = 0;
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (kolom_id[i] == ID_NISAN) {
+            continue;
+        }
+        heap_kadaluarsa[ukuran_heap].waktu = kolom_waktu[i] + KADALUARSA_DETIK;
+        heap_kadaluarsa[ukuran_heap].id = kolom_id[i];
+        ukuran_heap++;
+    }
+    for (int i = ukuran_heap / 2 - 1; i >= 0; i--) {
+        heap_turun(i);
+    }
+}
+
+/**
+ * @brief Mendaftarkan tiket di `posisi` yang baru ditambahkan ke heap kadaluarsa.
+ *        Bila entri basi sudah menumpuk, heap dibangun ulang (tiket baru ikut di sana).
+ */
+void kadaluarsa_tambah(int posisi) {
+    if (ukuran_heap >= 2 * jumlah_tiket_aktif() + KAPASITAS_AWAL) {
+        bangun_heap_kadaluarsa();
+        return;
+    }
+    cadangkan_heap(ukuran_heap + 1);
+    heap_kadaluarsa[ukuran_heap].waktu = kolom_waktu[posisi] + KADALUARSA_DETIK;
+    heap_kadaluarsa[ukuran_heap].id = kolom_id[posisi];
+    heap_naik(ukuran_heap);
+    ukuran_heap++;
+}
+
+/**
+ * @brief Membuang entri di puncak heap kadaluarsa.
+ */
+void heap_buang_puncak() {
+    ukuran_heap--;
+    heap_kadaluarsa[0] = heap_kadaluarsa[ukuran_heap];
+    heap_turun(0);
+}
+
+/**
+ * @brief Memeriksa apakah ada tiket aktif yang sudah kadaluarsa pada `sekarang`.
+ *        Entri basi yang sampai di puncak heap dibuang di sini. O(1) bila tidak ada.
+ */
+int ada_tiket_kadaluarsa(time_t sekarang) {
+    while (ukuran_heap > 0 && heap_kadaluarsa[0].waktu < sekarang) {
+        int posisi = cari_indeks_id(heap_kadaluarsa[0].id);
+        if (posisi >= 0 && kolom_waktu[posisi] + KADALUARSA_DETIK == heap_kadaluarsa[0].waktu) {
+            return 1;
+        }
+        heap_buang_puncak();
+    }
+    return 0;
+}
+
+/**
+ * @brief Mengeluarkan tiket kadaluarsa berikutnya dari heap.
+ * @return Posisi tiket di daftar_tiket, atau -1 jika tidak ada lagi yang kadaluarsa.
+ */
+int ambil_tiket_kadaluarsa(time_t sekarang) {
+    if (!ada_tiket_kadaluarsa(sekarang)) {
+        return -1;
+    }
+    int posisi = cari_indeks_id(heap_kadaluarsa[0].id);
+    heap_buang_puncak();
+    return posisi;
+}
+
+// --- TEKS CASEFOLD (KOLOM BAYANGAN) ---
+// Nama dan kategori di-casefold sekali saat muat data dan saat diubah, bukan di setiap
+// pencarian. Memakai tabel ASCII tetap, jadi hasilnya tidak bergantung pada locale seperti tolower.
+
+#define LIPAT_1(c) ((c) >= 'A' && (c) <= 'Z' ? (c) + ('a' - 'A') : (c))
+#define LIPAT_4(c) LIPAT_1(c), LIPAT_1((c) + 1), LIPAT_1((c) + 2), LIPAT_1((c) + 3)
+#define LIPAT_16(c) LIPAT_4(c), LIPAT_4((c) + 4), LIPAT_4((c) + 8), LIPAT_4((c) + 12)
+#define LIPAT_64(c) LIPAT_16(c), LIPAT_16((c) + 16), LIPAT_16((c) + 32), LIPAT_16((c) + 48)
+const unsigned char tabel_lipat[256] = { LIPAT_64(0), LIPAT_64(64), LIPAT_64(128), LIPAT_64(192) };
+
+/**
+ * @brief Menyalin `asal` ke `tujuan` sambil di-casefold; dipotong agar muat di `ukuran` byte.
+ * @return Panjang teks hasil (tanpa '\0').
+ */
+size_t lipat_teks(char *tujuan, const char *asal, size_t ukuran) {
+    size_t i = 0;
+    for (; i + 1 < ukuran && asal[i]; i++) {
+        tujuan[i] = (char)tabel_lipat[(unsigned char)asal[i]];
+    }
+    tujuan[i] = '\0';
+    return i;
+}
+
+/**
+ * @brief Memastikan teks_lipat muat minimal `minimal` tiket (tumbuh dua kali lipat).
+ */
+void cadangkan_lipat(int minimal) {
+    if (minimal <= kapasitas_lipat) {
+        return;
+    }
+    int kapasitas = kapasitas_lipat < KAPASITAS_AWAL ? KAPASITAS_AWAL : kapasitas_lipat;
+    while (kapasitas < minimal) {
+        kapasitas *= 2;
+    }
+    TeksLipat *baru = (TeksLipat *)realloc(teks_lipat, kapasitas * sizeof(TeksLipat));
+    if (baru == NULL) {
+        perror("Gagal mengalokasikan teks casefold");
+        exit(EXIT_FAILURE);
+    }
+    teks_lipat = baru;
+    kapasitas_lipat = kapasitas;
+    perbesar_bitmap_kategori(kapasitas);
+}
+
+/**
+ * @brief Memperbarui salinan casefold nama dan kode kategori tiket di `posisi`; dipanggil
+ *        setelah tiket ditambah atau nama/kategorinya diubah. Bitmap kategori diurus pemanggil.
+ */
+void lipat_tiket(int posisi) {
+    char kategori[MAX_KATEGORI];
+    cadangkan_lipat(posisi + 1);
+    teks_lipat[posisi].panjang_nama = (unsigned char)lipat_teks(teks_lipat[posisi].nama, daftar_tiket[posisi].nama_konser, MAX_NAMA);
+    lipat_teks(kategori, daftar_tiket[posisi].kategori, MAX_KATEGORI);
+    teks_lipat[posisi].kode_kategori = (unsigned char)kode_kategori(kategori, 1);
+}
+
+/**
+ * @brief Membangun ulang semua salinan casefold dan bitmap kategori, dipakai setelah muat data.
+ */
+void bangun_teks_lipat() {
+    cadangkan_lipat(jumlah_tiket);
+    for (int i = 0; i < jumlah_tiket; i++) {
+        lipat_tiket(i);
+    }
+    bangun_bitmap_kategori();
+}
+
+// --- KAMUS KATEGORI ---
+// Filter kategori cukup menelusuri bit yang menyala di bitmap kodenya, dan jumlah tiket per
+// kategori didapat dari popcount. Kode tidak pernah dihapus selama data dimuat, jadi kode yang
+// tersimpan di teks_lipat tetap sah. Slot berkode 0 dicocokkan lewat teks kategori aslinya.
+
+/**
+ * @brief Hash FNV-1a untuk teks yang diakhiri '\0'.
+ */
+uint32_t hash_teks(const char *teks) {
+    uint32_t h = 2166136261u;
+    for (; *teks; teks++) {
+        h = (h ^ (unsigned char)*teks) * 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Mencari kode kategori `nama_lipat` (sudah di-casefold) di kamus.
+ * @param buat Bila bukan 0, kategori yang belum ada ditambahkan ke kamus.
+ * @return Kode kategori; 0 bila tidak ada (dan tidak dibuat) atau kamus sudah penuh.
+ */
+int kode_kategori(const char *nama_lipat, int buat) {
+    unsigned int i = hash_teks(nama_lipat) & (SLOT_KAMUS_KATEGORI - 1);
+    for (; slot_kamus_kategori[i] != 0; i = (i + 1) & (SLOT_KAMUS_KATEGORI - 1)) {
+        if (strcmp(kamus_kategori[slot_kamus_kategori[i]].nama, nama_lipat) == 0) {
+            return slot_kamus_kategori[i];
+        }
+    }
+    if (!buat || jumlah_kode_kategori == MAX_KODE_KATEGORI) {
+        return 0;
+    }
+    int kode = jumlah_kode_kategori;
+    uint64_t *bitmap = (uint64_t *)calloc(kata_bitmap_kategori > 0 ? kata_bitmap_kategori : 1, sizeof(uint64_t));
+    if (bitmap == NULL) {
+        perror("Gagal mengalokasikan bitmap kategori");
+        exit(EXIT_FAILURE);
+    }
+    snprintf(kamus_kategori[kode].nama, MAX_KATEGORI, "%s", nama_lipat);
+    kamus_kategori[kode].bitmap = bitmap;
+    slot_kamus_kategori[i] = (unsigned char)kode;
+    jumlah_kode_kategori++;
+    return kode;
+}
+
+/**
+ * @brief Memastikan setiap bitmap kategori muat `kapasitas_slot` slot (mengikuti kapasitas teks_lipat).
+ */
+void perbesar_bitmap_kategori(int kapasitas_slot) {
+    int kata = (kapasitas_slot + 63) / 64;
+    if (kata <= kata_bitmap_kategori) {
+        return;
+    }
+    for (int k = 0; k < jumlah_kode_kategori; k++) {
+        uint64_t *baru = (uint64_t *)realloc(kamus_kategori[k].bitmap, kata * sizeof(uint64_t));
+        if (baru == NULL) {
+            perror("Gagal mengalokasikan bitmap kategori");
+            exit(EXIT_FAILURE);
+        }
+        memset(baru + kata_bitmap_kategori, 0, (kata - kata_bitmap_kategori) * sizeof(uint64_t));
+        kamus_kategori[k].bitmap = baru;
+    }
+    kata_bitmap_kategori = kata;
+}
+
+/**
+ * @brief Menyalakan / mematikan bit slot `posisi` di bitmap kategorinya.
+ */
+void kategori_pasang(int posisi) {
+    kamus_kategori[teks_lipat[posisi].kode_kategori].bitmap[posisi >> 6] |= 1ULL << (posisi & 63);
+}
+
+void kategori_lepas(int posisi) {
+    kamus_kategori[teks_lipat[posisi].kode_kategori].bitmap[posisi >> 6] &= ~(1ULL << (posisi & 63));
+}
+
+/**
+ * @brief Mengisi ulang semua bitmap dari kode di teks_lipat (setelah muat data atau pemadatan).
+ */
+void bangun_bitmap_kategori() {
+    if (kata_bitmap_kategori == 0) {
+        return; // belum ada slot sama sekali
+    }
+    for (int k = 0; k < jumlah_kode_kategori; k++) {
+        memset(kamus_kategori[k].bitmap, 0, kata_bitmap_kategori * sizeof(uint64_t));
+    }
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (daftar_tiket[i].id != ID_NISAN) {
+            kategori_pasang(i);
+        }
+    }
+}
+
+/**
+ * @brief Membebaskan semua bitmap dan mengosongkan kamus kategori.
+ */
+void kosongkan_kamus_kategori() {
+    for (int k = 0; k < jumlah_kode_kategori; k++) {
+        free(kamus_kategori[k].bitmap);
+        kamus_kategori[k].bitmap = NULL;
+    }
+    memset(slot_kamus_kategori, 0, sizeof(slot_kamus_kategori));
+    jumlah_kode_kategori = 1;
+    kata_bitmap_kategori = 0;
+}
+
+/**
+ * @brief Jumlah tiket aktif berkode `kode` (popcount bitmap).
+ */
+int hitung_kategori(int kode) {
+    int jumlah = 0;
+    for (int w = 0; w < kata_bitmap_kategori; w++) {
+        jumlah += __builtin_popcountll(kamus_kategori[kode].bitmap[w]);
+    }
+    return jumlah;
+}
+
+/**
+ * @brief Apakah kategori tiket di `posisi` sama dengan `kriteria_lipat` (kode = kode_kategori(kriteria_lipat, 0)).
+ *        Tiket berkode 0 (di luar kamus) dibandingkan lewat teksnya.
+ */
+int tiket_berkategori(int posisi, int kode, const char *kriteria_lipat) {
+    if (teks_lipat[posisi].kode_kategori != 0) {
+        return teks_lipat[posisi].kode_kategori == kode;
+    }
+    char kategori[MAX_KATEGORI];
+    lipat_teks(kategori, daftar_tiket[posisi].kategori, MAX_KATEGORI);
+    return strcmp(kategori, kriteria_lipat) == 0;
+}
+
+/**
+ * @brief Mencari tiket aktif yang kategorinya sama persis dengan `kriteria_lipat` (sudah di-casefold).
+ * @param posisi Diisi array posisi di daftar_tiket, urut naik; dibebaskan pemanggil dengan free().
+ * @return Jumlah tiket yang cocok.
+ */
+int cari_posisi_kategori(const char *kriteria_lipat, int **posisi) {
+    int kode = kode_kategori(kriteria_lipat, 0);
+    int jumlah = 0;
+    *posisi = (int *)malloc((jumlah_tiket + 1) * sizeof(int));
+    if (*posisi == NULL || kata_bitmap_kategori == 0) {
+        return 0;
+    }
+    const uint64_t *bitmap = kamus_kategori[kode].bitmap;
+    const uint64_t *lain = kamus_kategori[0].bitmap;
+    for (int w = 0; w < kata_bitmap_kategori; w++) {
+        for (uint64_t bit = (kode ? bitmap[w] : 0) | lain[w]; bit; bit &= bit - 1) {
+            int i = w * 64 + __builtin_ctzll(bit);
+            if (!tiket_berkategori(i, kode, kriteria_lipat)) {
+                continue;
+            }
+            (*posisi)[jumlah++] = i;
+        }
+    }
+    urutkan_hasil_tampilan(*posisi, jumlah);
+    return jumlah;
+}
+
+// --- PENCOCOK SUBSTRING TANPA BEDA HURUF ---
+// Versi SIMD membandingkan byte pertama dan terakhir jarum di 16/32 posisi awal sekaligus lalu
+// hanya memverifikasi posisi yang keduanya cocok. Teks di-casefold di dalam kernel, jadi teks
+// asli pun boleh dipakai. Kernel dipilih sekali saat runtime sesuai kemampuan CPU.
+
+/**
+ * @brief Membandingkan `panjang_jarum` byte `teks` (di-casefold) dengan `jarum` yang sudah di-casefold.
+ */
+int cocok_lipat_di(const char *teks, const char *jarum, size_t panjang_jarum) {
+    for (size_t j = 0; j < panjang_jarum; j++) {
+        if (tabel_lipat[(unsigned char)teks[j]] != (unsigned char)jarum[j]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Pencarian skalar mulai dari posisi awal `mulai`; juga dipakai untuk ekor versi SIMD.
+ */
+int memuat_lipat_dari(const char *teks, size_t mulai, size_t panjang, const char *jarum, size_t panjang_jarum) {
+    for (size_t i = mulai; i + panjang_jarum <= panjang; i++) {
+        if (cocok_lipat_di(teks + i, jarum, panjang_jarum)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Kernel skalar, dipakai bila CPU tidak punya SSE2/AVX2 atau bukan x86.
+ */
+int memuat_lipat_skalar(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    (void)kapasitas;
+    return memuat_lipat_dari(teks, 0, panjang, jarum, panjang_jarum);
+}
+
+#if PAKAI_SIMD_X86
+/**
+ * @brief Casefold 16 byte sekaligus: 'A'..'Z' digeser ke -128..-103 agar cukup satu
+ *        perbandingan bertanda, lalu di-OR 0x20.
+ */
+__attribute__((target("sse2"))) static inline __m128i lipat_sse2(__m128i v) {
+    __m128i geser = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A')));
+    __m128i besar = _mm_cmpgt_epi8(_mm_set1_epi8((char)(0x80 + 26)), geser);
+    return _mm_or_si128(v, _mm_and_si128(besar, _mm_set1_epi8(0x20)));
+}
+
+/**
+ * @brief Kernel SSE2. Blok 16 byte boleh membaca melewati '\0' selama masih di dalam
+ *        `kapasitas` byte buffer teks; posisi di luar `panjang` dibuang dari mask.
+ */
+__attribute__((target("sse2")))
+int memuat_lipat_sse2(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    if (panjang_jarum == 0) {
+        return 1;
+    }
+    const __m128i awal = _mm_set1_epi8(jarum[0]);
+    const __m128i akhir = _mm_set1_epi8(jarum[panjang_jarum - 1]);
+    size_t i = 0;
+    for (; i + panjang_jarum <= panjang && i + panjang_jarum - 1 + 16 <= kapasitas; i += 16) {
+        __m128i blok_awal = lipat_sse2(_mm_loadu_si128((const __m128i *)(teks + i)));
+        __m128i blok_akhir = lipat_sse2(_mm_loadu_si128((const __m128i *)(teks + i + panjang_jarum - 1)));
+        unsigned int kandidat = (unsigned int)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blok_awal, awal), _mm_cmpeq_epi8(blok_akhir, akhir)));
+        size_t sah = panjang - panjang_jarum - i + 1; // posisi awal yang masih di dalam teks
+        if (sah < 16) {
+            kandidat &= (1u << sah) - 1;
+        }
+        for (; kandidat; kandidat &= kandidat - 1) {
+            if (cocok_lipat_di(teks + i + __builtin_ctz(kandidat), jarum, panjang_jarum)) {
+                return 1;
+            }
+        }
+    }
+    return memuat_lipat_dari(teks, i, panjang, jarum, panjang_jarum);
+}
+
+/**
+ * @brief Casefold 32 byte sekaligus (lihat lipat_sse2).
+ */
+__attribute__((target("avx2"))) static inline __m256i lipat_avx2(__m256i v) {
+    __m256i geser = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'A')));
+    __m256i besar = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), geser);
+    return _mm256_or_si256(v, _mm256_and_si256(besar, _mm256_set1_epi8(0x20)));
+}
+
+/**
+ * @brief Kernel AVX2, sama dengan memuat_lipat_sse2 tetapi 32 posisi per blok.
+ */
+__attribute__((target("avx2")))
+int memuat_lipat_avx2(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    if (panjang_jarum == 0) {
+        return 1;
+    }
+    // Buffer yang tidak muat satu blok 32 byte langsung memakai blok 16 byte
+    if (panjang_jarum - 1 + 32 > kapasitas) {
+        return memuat_lipat_sse2(teks, panjang, kapasitas, jarum, panjang_jarum);
+    }
+    const __m256i awal = _mm256_set1_epi8(jarum[0]);
+    const __m256i akhir = _mm256_set1_epi8(jarum[panjang_jarum - 1]);
+    size_t i = 0;
+    for (; i + panjang_jarum <= panjang && i + panjang_jarum - 1 + 32 <= kapasitas; i += 32) {
+        __m256i blok_awal = lipat_avx2(_mm256_loadu_si256((const __m256i *)(teks + i)));
+        __m256i blok_akhir = lipat_avx2(_mm256_loadu_si256((const __m256i *)(teks + i + panjang_jarum - 1)));
+        unsigned int kandidat = (unsigned int)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(blok_awal, awal), _mm256_cmpeq_epi8(blok_akhir, akhir)));
+        size_t sah = panjang - panjang_jarum - i + 1;
+        if (sah < 32) {
+            kandidat &= (1u << sah) - 1;
+        }
+        for (; kandidat; kandidat &= kandidat - 1) {
+            if (cocok_lipat_di(teks + i + __builtin_ctz(kandidat), jarum, panjang_jarum)) {
+                return 1;
+            }
+        }
+    }
+    if (i + panjang_jarum > panjang) {
+        return 0;
+    }
+    // Sisa ekor memakai blok 16 byte; vzeroupper dulu agar kode SSE tidak terkena penalti transisi AVX
+    _mm256_zeroupper();
+    return memuat_lipat_sse2(teks + i, panjang - i, kapasitas - i, jarum, panjang_jarum);
+}
+#endif
+
+typedef int (*PencocokLipat)(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum);
+
+/**
+ * @brief Memilih kernel terbaik yang didukung CPU: AVX2, lalu SSE2, lalu skalar.
+ */
+PencocokLipat pilih_pencocok_lipat() {
+#if PAKAI_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return memuat_lipat_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return memuat_lipat_sse2;
+    }
+#endif
+    return memuat_lipat_skalar;
+}
+
+int memuat_lipat_pertama(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum);
+
+/**
+ * @brief `jarum` (sudah di-casefold, `panjang_jarum` byte) muncul di `teks` sepanjang `panjang` byte
+ *        yang berada di buffer berukuran `kapasitas` byte. Panggilan pertama memilih kernel.
+ */
+PencocokLipat memuat_lipat = memuat_lipat_pertama;
+
+int memuat_lipat_pertama(const char *teks, size_t panjang, size_t kapasitas, const char *jarum, size_t panjang_jarum) {
+    memuat_lipat = pilih_pencocok_lipat();
+    return memuat_lipat(teks, panjang, kapasitas, jarum, panjang_jarum);
+}
+
+/**
+ * @brief Nama konser tiket di `posisi` memuat `kriteria_lipat` (kriteria yang sudah di-casefold).
+ */
+int nama_memuat(int posisi, const char *kriteria_lipat, size_t panjang_kriteria) {
+    return memuat_lipat(teks_lipat[posisi].nama, teks_lipat[posisi].panjang_nama, MAX_NAMA, kriteria_lipat, panjang_kriteria);
+}
+
+// --- INDEKS TRIGRAM NAMA KONSER ---
+// Pencarian substring nama cukup memotong posting list dari setiap trigram kriteria lalu
+// memverifikasi kandidatnya, tanpa memindai semua tiket. ID tiket yang dihapus atau diganti
+// namanya dibiarkan basi di posting list (tersaring saat verifikasi), sama seperti heap kadaluarsa.
+
+/**
+ * @brief Kode trigram dari 3 byte di `p` setelah di-casefold (huruf kecil).
+ */
+uint32_t kode_trigram(const char *p) {
+    return ((uint32_t)tabel_lipat[(unsigned char)p[0]] << 16) |
+           ((uint32_t)tabel_lipat[(unsigned char)p[1]] << 8) |
+           (uint32_t)tabel_lipat[(unsigned char)p[2]];
+}
+
+/**
+ * @brief Melepas seluruh tabel trigram beserta posting list-nya.
+ */
+void kosongkan_indeks_trigram() {
+    for (int i = 0; i < kapasitas_trigram; i++) {
+        free(tabel_trigram[i].id);
+    }
+    free(tabel_trigram);
+    tabel_trigram = NULL;
+    kapasitas_trigram = 0;
+    jumlah_trigram = 0;
+    tiket_basi_trigram = 0;
+}
+
+/**
+ * @brief Mencari posting list untuk `kode` (linear probing); tabel diperbesar dua kali lipat
+ *        sebelum terisi lebih dari separuh.
+ * @param buat Jika 1, posting list kosong dibuat bila `kode` belum ada.
+ * @return Posting list, atau NULL jika tidak ada dan `buat` = 0.
+ */
+PostingTrigram *slot_trigram(uint32_t kode, int buat) {
+    if (buat && (jumlah_trigram + 1) * 2 > kapasitas_trigram) {
+        int kapasitas = kapasitas_trigram ? kapasitas_trigram * 2 : 1024;
+        PostingTrigram *baru = (PostingTrigram *)calloc(kapasitas, sizeof(PostingTrigram));
+        if (baru == NULL) {
+            perror("Gagal mengalokasikan indeks trigram");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < kapasitas_trigram; i++) {
+            if (tabel_trigram[i].kode == 0) {
+                continue;
+            }
+            unsigned int j = hash_id((int)tabel_trigram[i].kode) & (kapasitas - 1);
+            while (baru[j].kode != 0) {
+                j = (j + 1) & (kapasitas - 1);
+            }
+            baru[j] = tabel_trigram[i];
+        }
+        free(tabel_trigram);
+        tabel_trigram = baru;
+        kapasitas_trigram = kapasitas;
+    }
+    if (kapasitas_trigram == 0) {
+        return NULL;
+    }
+
+    unsigned int mask = kapasitas_trigram - 1;
+    unsigned int i = hash_id((int)kode) & mask;
+    while (tabel_trigram[i].kode != 0) {
+        if (tabel_trigram[i].kode == kode) {
+            return &tabel_trigram[i];
+        }
+        i = (i + 1) & mask;
+    }
+    if (!buat) {
+        return NULL;
+    }
+    tabel_trigram[i].kode = kode;
+    jumlah_trigram++;
+    return &tabel_trigram[i];
+}
+
+/**
+ * @brief Posisi pertama di posting list yang ID-nya >= `id` (pencarian biner).
+ */
+int posting_batas_bawah(const PostingTrigram *p, int id) {
+    int kiri = 0, kanan = p->jumlah;
+    while (kiri < kanan) {
+        int tengah = (kiri + kanan) / 2;
+        if (p->id[tengah] < id) {
+            kiri = tengah + 1;
+        } else {
+            kanan = tengah;
+        }
+    }
+    return kiri;
+}
+
+/**
+ * @brief Menyisipkan `id` ke posting list.
+ * @param urut Jika 1, list dijaga urut naik (ID baru selalu terbesar, jadi biasanya cukup ditempel
+ *        di akhir). Jika 0, ID ditempel saja dan list dirapikan oleh bangun_indeks_trigram().
+ */
+void posting_sisip(PostingTrigram *p, int id, int urut) {
+    int letak = p->jumlah;
+    if (urut && p->jumlah > 0 && p->id[p->jumlah - 1] >= id) {
+        letak = posting_batas_bawah(p, id);
+        if (p->id[letak] == id) {
+            return; // trigram muncul lebih dari sekali di nama yang sama
+        }
+    } else if (p->jumlah > 0 && p->id[p->jumlah - 1] == id) {
+        return;
+    }
+
+    if (p->jumlah == p->kapasitas) {
+        int kapasitas = p->kapasitas ? p->kapasitas * 2 : 4;
+        int *baru = (int *)realloc(p->id, kapasitas * sizeof(int));
+        if (baru == NULL) {
+            perror("Gagal mengalokasikan indeks trigram");
+            exit(EXIT_FAILURE);
+        }
+        p->id = baru;
+        p->kapasitas = kapasitas;
+    }
+    memmove(p->id + letak + 1, p->id + letak, (p->jumlah - letak) * sizeof(int));
+    p->id[letak] = id;
+    p->jumlah++;
+}
+
+/**
+ * @brief Mendaftarkan semua trigram `nama` untuk tiket `id`.
+ */
+void trigram_tambah(int id, const char *nama, int urut) {
+    size_t panjang = strlen(nama);
+    for (size_t i = 0; i + 3 <= panjang; i++) {
+        posting_sisip(slot_trigram(kode_trigram(nama + i), 1), id, urut);
+    }
+}
+
+int bandingkan_int(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Membangun ulang indeks trigram dari semua tiket aktif; sekaligus membuang ID basi.
+ */
+void bangun_indeks_trigram() {
+    kosongkan_indeks_trigram();
+    for (int i = 0; i < jumlah_tiket; i++) {
+        if (daftar_tiket[i].id != ID_NISAN) {
+            trigram_tambah(daftar_tiket[i].id, daftar_tiket[i].nama_konser, 0);
+        }
+    }
+    // Urutan di file belum tentu urut ID (misal setelah sorting), jadi posting list dirapikan di sini
+    for (int i = 0; i < kapasitas_trigram; i++) {
+        PostingTrigram *p = &tabel_trigram[i];
+        if (p->kode == 0) {
+            continue;
+        }
+        qsort(p->id, p->jumlah, sizeof(int), bandingkan_int);
+        int unik = 0;
+        for (int j = 0; j < p->jumlah; j++) {
+            if (unik == 0 || p->id[unik - 1] != p->id[j]) {
+                p->id[unik++] = p->id[j];
+            }
+        }
+        p->jumlah = unik;
+    }
+}
+
+/**
+ * @brief Dipanggil setiap kali nama sebuah tiket tidak lagi berlaku (dihapus atau diganti).
+ *        Indeks dibangun ulang bila yang basi sudah lebih banyak dari tiket aktif.
+ */
+void trigram_catat_basi() {
+    tiket_basi_trigram++;
+    if (tiket_basi_trigram > jumlah_tiket_aktif() + KAPASITAS_AWAL) {
+        bangun_indeks_trigram();
+    }
+}
+
+/**
+ * @brief Mencari tiket aktif yang nama konsernya memuat `kriteria` (tanpa membedakan huruf besar/kecil).
+ *        Kriteria kurang dari 3 huruf tidak punya trigram sehingga jatuh ke pemindaian biasa.
+ * @param posisi Diisi array posisi di daftar_tiket, urut naik; dibebaskan pemanggil dengan free().
+ * @return Jumlah tiket yang cocok.
+ */
+int cari_posisi_nama(const char *kriteria_asli, int **posisi) {
+    char kriteria[MAX_NAMA];
+    size_t panjang = lipat_teks(kriteria, kriteria_asli, sizeof(kriteria)); // di-casefold sekali untuk seluruh pencarian
+    *posisi = NULL;
+
+    if (panjang < 3) {
+        *posisi = (int *)malloc((jumlah_tiket + 1) * sizeof(int));
+        if (*posisi == NULL) {
+            return 0;
+        }
+        int jumlah = 0;
+        for (int i = 0; i < jumlah_tiket; i++) {
+            if (daftar_tiket[i].id != ID_NISAN && nama_memuat(i, kriteria, panjang)) {
+                (*posisi)[jumlah++] = i;
+            }
+        }
+        urutkan_hasil_tampilan(*posisi, jumlah);
+        return jumlah;
+    }
+
+    // Posting list setiap trigram kriteria; satu saja yang tidak ada berarti tidak ada hasil
+    PostingTrigram *daftar[MAX_NAMA];
+    int jumlah_daftar = 0;
+    for (size_t i = 0; i + 3 <= panjang && jumlah_daftar < MAX_NAMA; i++) {
+        PostingTrigram *p = slot_trigram(kode_trigram(kriteria + i), 0);
+        if (p == NULL) {
+            return 0;
+        }
+        int sudah = 0;
+        for (int j = 0; j < jumlah_daftar; j++) {
+            sudah |= daftar[j] == p;
+        }
+        if (!sudah) {
+            daftar[jumlah_daftar++] = p;
+        }
+    }
+
+    // Mulai dari posting list terpendek, saring dengan list lainnya lewat pencarian biner
+    int terpendek = 0;
+    for (int j = 1; j < jumlah_daftar; j++) {
+        if (daftar[j]->jumlah < daftar[terpendek]->jumlah) {
+            terpendek = j;
+        }
+    }
+    *posisi = (int *)malloc((daftar[terpendek]->jumlah + 1) * sizeof(int));
+    if (*posisi == NULL) {
+        return 0;
+    }
+    int jumlah = 0;
+    for (int k = 0; k < daftar[terpendek]->jumlah; k++) {
+        int id = daftar[terpendek]->id[k];
+        int cocok = 1;
+        for (int j = 0; j < jumlah_daftar && cocok; j++) {
+            if (j != terpendek) {
+                int letak = posting_batas_bawah(daftar[j], id);
+                cocok = letak < daftar[j]->jumlah && daftar[j]->id[letak] == id;
+            }
+        }
+        if (!cocok) {
+            continue;
+        }
+        // Verifikasi: tiket masih ada dan trigramnya memang berurutan membentuk kriteria
+        int i = cari_indeks_id(id);
+        if (i >= 0 && nama_memuat(i, kriteria, panjang)) {
+            (*posisi)[jumlah++] = i;
+        }
+    }
+    qsort(*posisi, jumlah, sizeof(int), bandingkan_int);
+    urutkan_hasil_tampilan(*posisi, jumlah);
+    return jumlah;
+}
+
+// --- OPERASI INTI ---
+// Tanpa prompt dan tanpa simpan otomatis; dipakai menu interaktif maupun mode batch.
+
+/**
+ * @brief Menambahkan tiket (ID sudah terisi) ke akhir daftar beserta indeksnya.
+ * @return 1 jika berhasil, 0 jika blok data gagal diperbesar.
+ */
+int masukkan_tiket(const Tiket *baru) {
+    if (!cadangkan_kapasitas(jumlah_tiket + 1)) {
+        return 0;
+    }
+    daftar_tiket[jumlah_tiket] = *baru;
+    jumlah_tiket++;
+    isi_kolom(jumlah_tiket - 1);
+    indeks_tambah(jumlah_tiket - 1);
+    urutan_tambah(&urut_harga, jumlah_tiket - 1);
+    urutan_tambah(&urut_nama, jumlah_tiket - 1);
+    kadaluarsa_tambah(jumlah_tiket - 1);
+    pohon_harga_tambah(baru->harga, baru->id);
+    lipat_tiket(jumlah_tiket - 1);
+    kategori_pasang(jumlah_tiket - 1);
+    trigram_tambah(baru->id, baru->nama_konser, 1);
+    return 1;
+}
+
+/**
+ * @brief Mengganti nama konser tiket di `posisi` (dipotong bila melebihi MAX_NAMA - 1)
+ *        dan memperbarui indeks trigram.
+ */
+void ganti_nama_tiket(int posisi, const char *nama) {
+    strncpy(daftar_tiket[posisi].nama_konser, nama, MAX_NAMA - 1);
+    daftar_tiket[posisi].nama_konser[MAX_NAMA - 1] = '\0';
+    tandai_kotor(posisi);
+    urutan_ubah(&urut_nama, posisi);
+    lipat_tiket(posisi);
+    trigram_tambah(daftar_tiket[posisi].id, daftar_tiket[posisi].nama_konser, 1);
+    trigram_catat_basi();
+}
+
+/**
+ * @brief Menghapus tiket berdasarkan ID (ditandai nisan, dipadatkan bila perlu).
+ * @return 1 jika berhasil, 0 jika ID tidak ditemukan.
+ */
+int hapus_tiket_id(int id) {
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) {
+        return 0;
+    }
+    tandai_nisan(posisi);
+    padatkan_jika_perlu();
+    return 1;
+}
+
+/**
+ * @brief Memilih urutan daftar; kriteria 1 = harga (termurah dulu), 2 = nama konser (A-Z).
+ *        Tiket tidak dipindah: indeks urutannya cukup dirapikan (O(n) bila hanya sedikit yang
+ *        berubah sejak terakhir) dan pilihannya disimpan di header file.
+ */
+void urutkan_tiket(int kriteria) {
+    if (kriteria != 1 && kriteria != 2) {
+        return;
+    }
+    urutan_tampilan = kriteria;
+    header_data()->urutan_tampilan = (uint32_t)kriteria;
+    siapkan_tampilan();
 }
 
 /**
- * @brief Menghasilkan ID unik (berdasarkan ID maksimum + 1 atau 1 jika kosong).
- * @return ID unik baru.
+ * @brief Mengurangi stok tiket `id` sebanyak `jumlah` bila stoknya cukup.
+ * @return BELI_BERHASIL, BELI_TIDAK_DITEMUKAN, BELI_STOK_KURANG, atau BELI_JUMLAH_TIDAK_VALID.
  */
-int buat_id_unik() {
-    if (jumlah_tiket == 0) {
-        return 1;
+int beli_stok(int id, int jumlah, int *stok_sesudah) {
+    if (jumlah <= 0) {
+        return BELI_JUMLAH_TIDAK_VALID;
     }
-
-    int max_id = 0;
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id > max_id) {
-            max_id = daftar_tiket[i].id;
-        }
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) {
+        return BELI_TIDAK_DITEMUKAN;
     }
-    return max_id + 1;
+    *stok_sesudah = kolom_stok[posisi];
+    if (kolom_stok[posisi] < jumlah) {
+        return BELI_STOK_KURANG;
+    }
+    atur_stok(posisi, kolom_stok[posisi] - jumlah);
+    *stok_sesudah = kolom_stok[posisi];
+    return BELI_BERHASIL;
 }
 
 /**
@@ -200,15 +3443,11 @@ void tambah_tiket() {
     // Set waktu pembuatan
     baru.waktu_dibuat = time(NULL);
 
-    // Re-alokasi memori
-    Tiket *temp = (Tiket *)realloc(daftar_tiket, (jumlah_tiket + 1) * sizeof(Tiket));
-    if (temp == NULL) {
+    // Perbesar blok data
+    if (!masukkan_tiket(&baru)) {
         perror("❌ Gagal mengalokasikan memori untuk tiket baru");
         return;
     }
-    daftar_tiket = temp;
-    daftar_tiket[jumlah_tiket] = baru;
-    jumlah_tiket++;
 
     printf("\n🎉 Tiket berhasil ditambahkan:\n");
     tampilkan_tiket_detail(&baru);
@@ -218,16 +3457,34 @@ void tambah_tiket() {
  * @brief Menampilkan semua tiket yang ada.
  */
 void lihat_semua_tiket() {
-    printf("\n📚 --- SEMUA DAFTAR TIKET (%d Tiket) ---\n", jumlah_tiket);
+    printf("\n📚 --- SEMUA DAFTAR TIKET (%d Tiket) ---\n", jumlah_tiket_aktif());
 
-    if (jumlah_tiket == 0) {
+    if (jumlah_tiket_aktif() == 0) {
         printf("⚠️ Saat ini tidak ada tiket dalam sistem.\n");
         return;
     }
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        printf("--- Tiket #%d ---\n", i + 1);
-        tampilkan_tiket_detail(&daftar_tiket[i]);
+    int posisi[UKURAN_HALAMAN];
+    int nomor = 0;
+    int mulai = 0;
+    int kursor;
+    while (1) {
+        int jumlah = ambil_halaman(mulai, UKURAN_HALAMAN, 0, posisi, &kursor);
+        tampil_ke(stdout);
+        for (int k = 0; k < jumlah; k++) {
+            tampil_str("--- Tiket #");
+            tampil_int(++nomor);
+            tampil_str(" ---\n");
+            susun_tiket_detail(&daftar_tiket[posisi[k]]);
+        }
+        tampil_siram();
+        if (kursor == 0) {
+            break;
+        }
+        mulai = letak_kursor(kursor);
+        if (mulai < 0 || mulai >= siapkan_tampilan() || !lanjut_halaman()) {
+            break;
+        }
     }
     printf("--------------------------------------\n");
 }
@@ -246,7 +3503,8 @@ void cari_tiket() {
     printf("1. ID Tiket\n");
     printf("2. Nama Konser\n");
     printf("3. Kategori\n");
-    printf("Pilih opsi (1-3): ");
+    printf("4. Rentang Harga\n");
+    printf("Pilih opsi (1-4): ");
 
     if (scanf("%d", &pilihan_cari) != 1) {
         printf("❌ Input tidak valid.\n");
@@ -255,7 +3513,7 @@ void cari_tiket() {
     }
     bersihkan_buffer();
 
-    if (jumlah_tiket == 0) {
+    if (jumlah_tiket_aktif() == 0) {
         printf("⚠️ Tidak ada tiket dalam sistem untuk dicari.\n");
         return;
     }
@@ -271,12 +3529,10 @@ void cari_tiket() {
             bersihkan_buffer();
 
             printf("\nHasil Pencarian ID %d:\n", id_cari);
-            for (int i = 0; i < jumlah_tiket; i++) {
-                if (daftar_tiket[i].id == id_cari) {
-                    tampilkan_tiket_detail(&daftar_tiket[i]);
-                    ditemukan = 1;
-                    break;
-                }
+            int posisi = cari_indeks_id(id_cari);
+            if (posisi >= 0) {
+                tampilkan_tiket_detail(&daftar_tiket[posisi]);
+                ditemukan = 1;
             }
             break;
 
@@ -286,18 +3542,14 @@ void cari_tiket() {
             kriteria_cari[strcspn(kriteria_cari, "\n")] = 0;
 
             printf("\nHasil Pencarian Nama Konser '%s':\n", kriteria_cari);
-            for (int i = 0; i < jumlah_tiket; i++) {
-                char temp_nama[MAX_NAMA], temp_kriteria[MAX_NAMA];
-                strcpy(temp_nama, daftar_tiket[i].nama_konser);
-                strcpy(temp_kriteria, kriteria_cari);
-                for(int j = 0; temp_nama[j]; j++){ temp_nama[j] = tolower(temp_nama[j]); }
-                for(int j = 0; temp_kriteria[j]; j++){ temp_kriteria[j] = tolower(temp_kriteria[j]); }
-
-                if (strstr(temp_nama, temp_kriteria) != NULL) {
-                    tampilkan_tiket_detail(&daftar_tiket[i]);
-                    ditemukan = 1;
-                }
+            int *posisi_nama;
+            int jumlah_nama = cari_posisi_nama(kriteria_cari, &posisi_nama);
+            for (int k = 0; k < jumlah_nama; k++) {
+                susun_tiket_detail(&daftar_tiket[posisi_nama[k]]);
             }
+            tampil_siram();
+            free(posisi_nama);
+            ditemukan = jumlah_nama > 0;
             break;
 
         case 3:
@@ -306,19 +3558,58 @@ void cari_tiket() {
             kriteria_cari[strcspn(kriteria_cari, "\n")] = 0;
 
             printf("\nHasil Pencarian Kategori '%s':\n", kriteria_cari);
-            for (int i = 0; i < jumlah_tiket; i++) {
-                char temp_kategori[MAX_KATEGORI], temp_kriteria[MAX_KATEGORI];
-                strcpy(temp_kategori, daftar_tiket[i].kategori);
-                strcpy(temp_kriteria, kriteria_cari);
-                for(int j = 0; temp_kategori[j]; j++){ temp_kategori[j] = tolower(temp_kategori[j]); }
-                for(int j = 0; temp_kriteria[j]; j++){ temp_kriteria[j] = tolower(temp_kriteria[j]); }
-
-                if (strcmp(temp_kategori, temp_kriteria) == 0) {
-                    tampilkan_tiket_detail(&daftar_tiket[i]);
+            lipat_teks(kriteria_cari, kriteria_cari, sizeof(kriteria_cari));
+            {
+                int *posisi;
+                int jumlah = cari_posisi_kategori(kriteria_cari, &posisi);
+                for (int k = 0; k < jumlah; k++) {
+                    susun_tiket_detail(&daftar_tiket[posisi[k]]);
+                    ditemukan = 1;
+                }
+                tampil_siram();
+                free(posisi);
+            }
+            break;
+
+        case 4: {
+            float harga_min, harga_max;
+            printf("Harga minimum: Rp");
+            if (scanf("%f", &harga_min) != 1 || !(harga_min >= 0)) {
+                printf("❌ Harga tidak valid.\n");
+                bersihkan_buffer();
+                return;
+            }
+            bersihkan_buffer();
+            printf("Harga maksimum: Rp");
+            if (scanf("%f", &harga_max) != 1 || !(harga_max >= harga_min)) {
+                printf("❌ Harga maksimum harus >= harga minimum.\n");
+                bersihkan_buffer();
+                return;
+            }
+            bersihkan_buffer();
+            printf("Kategori (kosongkan untuk semua): ");
+            if (fgets(kriteria_cari, sizeof(kriteria_cari), stdin) == NULL) return;
+            kriteria_cari[strcspn(kriteria_cari, "\n")] = 0;
+
+            printf("\nHasil Pencarian Harga Rp%.2f - Rp%.2f:\n", harga_min, harga_max);
+            lipat_teks(kriteria_cari, kriteria_cari, sizeof(kriteria_cari));
+            const char *kategori = kriteria_cari[0] != '\0' ? kriteria_cari : NULL;
+            int posisi[UKURAN_HALAMAN];
+            int kursor;
+            int jumlah = ambil_rentang_harga(harga_min, harga_max, 0, 0, kategori, posisi, UKURAN_HALAMAN, &kursor);
+            while (jumlah > 0) {
+                for (int k = 0; k < jumlah; k++) {
+                    susun_tiket_detail(&daftar_tiket[posisi[k]]);
                     ditemukan = 1;
                 }
+                tampil_siram();
+                if (kursor == 0 || !lanjut_halaman()) {
+                    break;
+                }
+                jumlah = ambil_rentang_harga(harga_min, harga_max, kursor, 0, kategori, posisi, UKURAN_HALAMAN, &kursor);
             }
             break;
+        }
 
         default:
             printf("❌ Pilihan pencarian tidak valid.\n");
@@ -340,7 +3631,7 @@ void update_tiket() {
 
     printf("\n📝 --- UPDATE TIKET ---\n");
 
-    if (jumlah_tiket == 0) {
+    if (jumlah_tiket_aktif() == 0) {
         printf("⚠️ Tidak ada tiket dalam sistem untuk diupdate.\n");
         return;
     }
@@ -353,12 +3644,7 @@ void update_tiket() {
     }
     bersihkan_buffer();
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id == id_update) {
-            index_update = i;
-            break;
-        }
-    }
+    index_update = cari_indeks_id(id_update);
 
     if (index_update == -1) {
         printf("❌ Tiket dengan ID %d tidak ditemukan.\n", id_update);
@@ -374,8 +3660,7 @@ void update_tiket() {
     if (fgets(buffer, sizeof(buffer), stdin) == NULL) return;
     buffer[strcspn(buffer, "\n")] = 0;
     if (strlen(buffer) > 0) {
-        strncpy(daftar_tiket[index_update].nama_konser, buffer, MAX_NAMA - 1);
-        daftar_tiket[index_update].nama_konser[MAX_NAMA - 1] = '\0';
+        ganti_nama_tiket(index_update, buffer);
     }
 
     // Update Kategori
@@ -385,13 +3670,17 @@ void update_tiket() {
     if (strlen(buffer) > 0) {
         strncpy(daftar_tiket[index_update].kategori, buffer, MAX_KATEGORI - 1);
         daftar_tiket[index_update].kategori[MAX_KATEGORI - 1] = '\0';
+        tandai_kotor(index_update);
+        kategori_lepas(index_update);
+        lipat_tiket(index_update);
+        kategori_pasang(index_update);
     }
 
     // Update Harga
     printf("  Masukkan Harga Tiket Baru (0 untuk tidak diubah): Rp");
     float harga_baru;
     if (scanf("%f", &harga_baru) == 1 && harga_baru > 0) {
-        daftar_tiket[index_update].harga = harga_baru;
+        atur_harga(index_update, harga_baru);
     }
     bersihkan_buffer();
 
@@ -399,7 +3688,7 @@ void update_tiket() {
     printf("  Masukkan Jumlah Stok Tiket Baru (-1 untuk tidak diubah): ");
     int stok_baru;
     if (scanf("%d", &stok_baru) == 1 && stok_baru >= 0) {
-        daftar_tiket[index_update].jumlah_stok = stok_baru;
+        atur_stok(index_update, stok_baru);
     }
     bersihkan_buffer();
 
@@ -407,7 +3696,8 @@ void update_tiket() {
     char konfirmasi;
     printf("Perbarui waktu kadaluarsa (Y/T)? ");
     if (scanf(" %c", &konfirmasi) == 1 && (konfirmasi == 'Y' || konfirmasi == 'y')) {
-        daftar_tiket[index_update].waktu_dibuat = time(NULL);
+        atur_waktu(index_update, time(NULL));
+        kadaluarsa_tambah(index_update); // entri heap yang lama otomatis menjadi basi
         printf("Waktu pembuatan diperbarui.\n");
     }
     bersihkan_buffer();
@@ -427,7 +3717,7 @@ void hapus_tiket() {
 
     printf("\n🗑️ --- HAPUS TIKET ---\n");
 
-    if (jumlah_tiket == 0) {
+    if (jumlah_tiket_aktif() == 0) {
         printf("⚠️ Tidak ada tiket dalam sistem untuk dihapus.\n");
         return;
     }
@@ -440,12 +3730,7 @@ void hapus_tiket() {
     }
     bersihkan_buffer();
 
-    for (int i = 0; i < jumlah_tiket; i++) {
-        if (daftar_tiket[i].id == id_hapus) {
-            index_hapus = i;
-            break;
-        }
-    }
+    index_hapus = cari_indeks_id(id_hapus);
 
     if (index_hapus == -1) {
         printf("❌ Tiket dengan ID %d tidak ditemukan.\n", id_hapus);
@@ -462,48 +3747,12 @@ void hapus_tiket() {
     }
     bersihkan_buffer();
 
-    // Geser elemen setelah yang dihapus
-    for (int i = index_hapus; i < jumlah_tiket - 1; i++) {
-        daftar_tiket[i] = daftar_tiket[i + 1];
-    }
-    jumlah_tiket--;
-
-    // Re-alokasi memori
-    if (jumlah_tiket == 0) {
-        free(daftar_tiket);
-        daftar_tiket = NULL;
-    } else {
-        Tiket *temp = (Tiket *)realloc(daftar_tiket, jumlah_tiket * sizeof(Tiket));
-        if (temp == NULL) {
-            perror("Gagal re-alokasi memori setelah penghapusan");
-        } else {
-            daftar_tiket = temp;
-        }
-    }
+    // Cukup tandai sebagai nisan; tiket lain tidak digeser
+    hapus_tiket_id(id_hapus);
 
     printf("✅ Tiket ID %d berhasil dihapus.\n", id_hapus);
 }
 
-/**
- * @brief Fungsi perbandingan untuk qsort (berdasarkan harga).
- */
-int bandingkan_harga(const void *a, const void *b) {
-    const Tiket *tiket_a = (const Tiket *)a;
-    const Tiket *tiket_b = (const Tiket *)b;
-    if (tiket_a->harga < tiket_b->harga) return -1;
-    if (tiket_a->harga > tiket_b->harga) return 1;
-    return 0;
-}
-
-/**
- * @brief Fungsi perbandingan untuk qsort (berdasarkan nama konser).
- */
-int bandingkan_nama(const void *a, const void *b) {
-    const Tiket *tiket_a = (const Tiket *)a;
-    const Tiket *tiket_b = (const Tiket *)b;
-    return strcmp(tiket_a->nama_konser, tiket_b->nama_konser);
-}
-
 /**
  * @brief Mengurutkan tiket berdasarkan kriteria.
  */
@@ -512,7 +3761,7 @@ void sorting_tiket() {
 
     printf("\n➡️ --- URUTKAN TIKET ---\n");
 
-    if (jumlah_tiket < 2) {
+    if (jumlah_tiket_aktif() < 2) {
         printf("⚠️ Minimal diperlukan 2 tiket untuk melakukan pengurutan.\n");
         return;
     }
@@ -531,12 +3780,12 @@ void sorting_tiket() {
 
     switch (pilihan_sort) {
         case 1:
-            qsort(daftar_tiket, jumlah_tiket, sizeof(Tiket), bandingkan_harga);
+            urutkan_tiket(1);
             printf("✅ Tiket berhasil diurutkan berdasarkan Harga.\n");
             lihat_semua_tiket();
             break;
         case 2:
-            qsort(daftar_tiket, jumlah_tiket, sizeof(Tiket), bandingkan_nama);
+            urutkan_tiket(2);
             printf("✅ Tiket berhasil diurutkan berdasarkan Nama Konser.\n");
             lihat_semua_tiket();
             break;
@@ -550,54 +3799,45 @@ void sorting_tiket() {
  * @brief Menghapus tiket yang sudah kadaluarsa (lebih dari KADALUARSA_DETIK).
  */
 void update_otomatis_kadaluarsa() {
-    if (jumlah_tiket == 0) {
+    if (jumlah_tiket_aktif() == 0) {
         return;
     }
 
     time_t waktu_sekarang = time(NULL);
     int tiket_dihapus = 0;
-    int i = 0;
 
     printf("\n⏳ Pemeriksaan tiket kadaluarsa...\n");
 
-    while (i < jumlah_tiket) {
-        if (waktu_sekarang - daftar_tiket[i].waktu_dibuat > KADALUARSA_DETIK) {
-            // Tiket kadaluarsa, hapus
-            printf("  🗑️ Tiket kadaluarsa ditemukan dan dihapus: ID %d - %s\n",
-                   daftar_tiket[i].id, daftar_tiket[i].nama_konser);
-
-            // Geser elemen setelah yang dihapus
-            for (int j = i; j < jumlah_tiket - 1; j++) {
-                daftar_tiket[j] = daftar_tiket[j + 1];
-            }
-            jumlah_tiket--;
-            tiket_dihapus++;
-            // Jangan increment i, karena elemen berikutnya sekarang ada di posisi i
-        } else {
-            i++; // Lanjut ke elemen berikutnya
-        }
+    // Hanya tiket yang kadaluarsa yang diambil dari heap; masing-masing ditandai nisan
+    // (O(1), tanpa menggeser tiket lain)
+    int posisi;
+    while ((posisi = ambil_tiket_kadaluarsa(waktu_sekarang)) >= 0) {
+        printf("  🗑️ Tiket kadaluarsa ditemukan dan dihapus: ID %d - %s\n",
+               daftar_tiket[posisi].id, daftar_tiket[posisi].nama_konser);
+        tandai_nisan(posisi);
+        tiket_dihapus++;
     }
 
     if (tiket_dihapus > 0) {
-        // Re-alokasi memori setelah semua penghapusan
-        if (jumlah_tiket == 0) {
-            free(daftar_tiket);
-            daftar_tiket = NULL;
-        } else {
-            Tiket *temp = (Tiket *)realloc(daftar_tiket, jumlah_tiket * sizeof(Tiket));
-            if (temp != NULL) {
-                daftar_tiket = temp;
-            } else {
-                perror("Gagal re-alokasi memori setelah penghapusan kadaluarsa");
-            }
-        }
+        // Cukup satu pemadatan linear untuk semua tiket yang kadaluarsa
+        padatkan_jika_perlu();
         printf("✅ Total %d tiket kadaluarsa dihapus.\n", tiket_dihapus);
-        simpan_data(); // Simpan perubahan setelah penghapusan otomatis
+        simpan_data_latar(); // Simpan perubahan setelah penghapusan otomatis, tanpa menunggu disk
     } else {
         printf("✅ Tidak ada tiket yang kadaluarsa.\n");
     }
 }
 
+/**
+ * @brief Menjalankan penghapusan kadaluarsa di tengah sesi, hanya bila memang ada
+ *        tiket yang sudah lewat batas (O(1) selama belum ada). Dipanggil tiap putaran menu.
+ */
+void periksa_kadaluarsa_berkala() {
+    if (ada_tiket_kadaluarsa(time(NULL))) {
+        update_otomatis_kadaluarsa();
+    }
+}
+
 /**
  * @brief Menampilkan menu utama.
  */
@@ -653,8 +3893,615 @@ int login_admin() {
     }
 }
 
+// --- MODE BATCH ---
+// ./program --batch [file]   (tanpa file atau "-": perintah dibaca dari stdin)
+// Satu perintah per baris; baris kosong dan baris berawalan '#' dilewati:
+//   ADD nama;kategori;harga;stok       BUY id jumlah        DELETE id
+//   UPDATE id NAMA|KATEGORI|HARGA|STOK nilai               SORT HARGA|NAMA
+//   SEARCH ID|NAMA|KATEGORI teks        LIST                 SAVE
+//   KATEGORI (jumlah tiket per kategori)                   TERMURAH k (k tiket termurah, stok > 0)
+//   LIST offset batas                   LIST SETELAH id batas (satu halaman)
+//   RENTANG min max batas [SETELAH id] [TERSEDIA] [KATEGORI nama] (harga min..max, urut harga)
+// Setiap perintah menghasilkan tepat satu baris "OK <PERINTAH> ..." atau "ERR <baris> <alasan>".
+// Halaman diakhiri "OK LIST|RENTANG jumlah kursor": kursor = ID untuk SETELAH berikutnya, 0 = sudah habis.
+// LIST, TERMURAH, RENTANG dan SEARCH didahului baris "TIKET id;nama;kategori;harga;stok;waktu_dibuat";
+// KATEGORI didahului baris "KATEGORI nama_casefold;jumlah" (nama "*" = kategori di luar kamus).
+// SAVE hanya mengantre snapshot ke utas penulis; di akhir masukan data disimpan seperti pilihan
+// "Simpan & Keluar", yang menunggu semua penulisan selesai.
+
+FILE *keluaran_batch = NULL; // stdout asli; pesan biasa dialihkan ke stderr selama mode batch
+
+/**
+ * @brief Menulis baris ERR untuk perintah di `nomor_baris`.
+ * @return Selalu 0 (perintah gagal).
+ */
+int gagal_batch(int nomor_baris, const char *alasan) {
+    fprintf(keluaran_batch, "ERR %d %s\n", nomor_baris, alasan);
+    return 0;
+}
+
+/**
+ * @brief Menulis satu tiket sebagai baris TIKET lewat buffer tampilan.
+ *
+ * Pemanggil menyiram dengan tampil_siram() sebelum menulis baris OK.
+ */
+void tulis_tiket_batch(const Tiket *t) {
+    tampil_ke(keluaran_batch);
+    tampil_str("TIKET ");
+    tampil_int(t->id);
+    tampil_str(";");
+    tampil_str(t->nama_konser);
+    tampil_str(";");
+    tampil_str(t->kategori);
+    tampil_str(";");
+    tampil_harga(t->harga);
+    tampil_str(";");
+    tampil_int(t->jumlah_stok);
+    tampil_str(";");
+    tampil_int((long)t->waktu_dibuat);
+    tampil_str("\n");
+}
+
+/**
+ * @brief Field teks harus tidak kosong dan muat di `ukuran` (tidak dipotong diam-diam).
+ */
+int field_teks_valid(const char *teks, size_t ukuran) {
+    return teks[0] != '\0' && strlen(teks) < ukuran;
+}
+
+/**
+ * @brief ADD nama;kategori;harga;stok
+ */
+int batch_add(char *arg, int nomor_baris) {
+    char *p1 = strchr(arg, ';');
+    char *p2 = p1 ? strchr(p1 + 1, ';') : NULL;
+    char *p3 = p2 ? strchr(p2 + 1, ';') : NULL;
+    if (p3 == NULL) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    *p1 = *p2 = *p3 = '\0';
+
+    Tiket baru;
+    int n = 0;
+    memset(&baru, 0, sizeof(baru));
+    if (!field_teks_valid(arg, MAX_NAMA) || !field_teks_valid(p1 + 1, MAX_KATEGORI) ||
+        sscanf(p2 + 1, "%f %n", &baru.harga, &n) != 1 || p2[1 + n] != '\0' || !(baru.harga >= 0) ||
+        sscanf(p3 + 1, "%d %n", &baru.jumlah_stok, &n) != 1 || p3[1 + n] != '\0' || baru.jumlah_stok < 0) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    strcpy(baru.nama_konser, arg);
+    strcpy(baru.kategori, p1 + 1);
+    baru.id = buat_id_unik();
+    baru.waktu_dibuat = time(NULL);
+    if (!masukkan_tiket(&baru)) {
+        return gagal_batch(nomor_baris, "gagal_alokasi");
+    }
+    fprintf(keluaran_batch, "OK ADD %d\n", baru.id);
+    return 1;
+}
+
+/**
+ * @brief BUY id jumlah
+ */
+int batch_buy(char *arg, int nomor_baris) {
+    int id, jumlah, stok_sesudah = 0, n = 0;
+    if (sscanf(arg, "%d %d %n", &id, &jumlah, &n) != 2 || arg[n] != '\0') {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    switch (beli_stok(id, jumlah, &stok_sesudah)) {
+        case BELI_TIDAK_DITEMUKAN: return gagal_batch(nomor_baris, "tidak_ditemukan");
+        case BELI_STOK_KURANG: return gagal_batch(nomor_baris, "stok_kurang");
+        case BELI_JUMLAH_TIDAK_VALID: return gagal_batch(nomor_baris, "jumlah_tidak_valid");
+    }
+    fprintf(keluaran_batch, "OK BUY %d %d %d\n", id, jumlah, stok_sesudah);
+    return 1;
+}
+
+/**
+ * @brief UPDATE id NAMA|KATEGORI|HARGA|STOK nilai
+ */
+int batch_update(char *arg, int nomor_baris) {
+    int id, n = 0, m = 0;
+    char kolom[16];
+    if (sscanf(arg, "%d %15s %n", &id, kolom, &n) != 2) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    int posisi = cari_indeks_id(id);
+    if (posisi < 0) {
+        return gagal_batch(nomor_baris, "tidak_ditemukan");
+    }
+
+    char *nilai = arg + n;
+    Tiket *t = &daftar_tiket[posisi];
+    if (strcmp(kolom, "NAMA") == 0) {
+        if (!field_teks_valid(nilai, MAX_NAMA) || strchr(nilai, ';') != NULL) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        ganti_nama_tiket(posisi, nilai);
+    } else if (strcmp(kolom, "KATEGORI") == 0) {
+        if (!field_teks_valid(nilai, MAX_KATEGORI) || strchr(nilai, ';') != NULL) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        strcpy(t->kategori, nilai);
+        tandai_kotor(posisi);
+        kategori_lepas(posisi);
+        lipat_tiket(posisi);
+        kategori_pasang(posisi);
+    } else if (strcmp(kolom, "HARGA") == 0) {
+        float harga;
+        if (sscanf(nilai, "%f %n", &harga, &m) != 1 || nilai[m] != '\0' || !(harga >= 0)) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        atur_harga(posisi, harga);
+    } else if (strcmp(kolom, "STOK") == 0) {
+        int stok;
+        if (sscanf(nilai, "%d %n", &stok, &m) != 1 || nilai[m] != '\0' || stok < 0) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        atur_stok(posisi, stok);
+    } else {
+        return gagal_batch(nomor_baris, "kolom_tidak_dikenal");
+    }
+    fprintf(keluaran_batch, "OK UPDATE %d\n", id);
+    return 1;
+}
+
+/**
+ * @brief SEARCH ID|NAMA|KATEGORI teks (NAMA: memuat teks, KATEGORI: sama persis, tanpa beda huruf besar/kecil)
+ */
+int batch_search(char *arg, int nomor_baris) {
+    char mode[16];
+    int n = 0, ditemukan = 0;
+    if (sscanf(arg, "%15s %n", mode, &n) != 1 || arg[n] == '\0') {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    char *kriteria = arg + n;
+    if (strcmp(mode, "ID") == 0) {
+        int id, m = 0;
+        if (sscanf(kriteria, "%d %n", &id, &m) != 1 || kriteria[m] != '\0') {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        int posisi = cari_indeks_id(id);
+        if (posisi >= 0) {
+            tulis_tiket_batch(&daftar_tiket[posisi]);
+            ditemukan = 1;
+        }
+    } else if (strcmp(mode, "NAMA") == 0) {
+        int *posisi;
+        ditemukan = cari_posisi_nama(kriteria, &posisi);
+        for (int k = 0; k < ditemukan; k++) {
+            tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+        }
+        free(posisi);
+    } else if (strcmp(mode, "KATEGORI") == 0) {
+        int *posisi;
+        lipat_teks(kriteria, kriteria, strlen(kriteria) + 1);
+        ditemukan = cari_posisi_kategori(kriteria, &posisi);
+        for (int k = 0; k < ditemukan; k++) {
+            tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+        }
+        free(posisi);
+    } else {
+        return gagal_batch(nomor_baris, "mode_tidak_dikenal");
+    }
+    tampil_siram();
+    fprintf(keluaran_batch, "OK SEARCH %d\n", ditemukan);
+    return 1;
+}
+
+/**
+ * @brief LIST "offset batas" atau "SETELAH id batas": satu halaman menurut urutan tampilan,
+ *        diakhiri "OK LIST jumlah kursor" (kursor 0 = daftar sudah habis).
+ * @return 1 jika berhasil, 0 jika menghasilkan ERR.
+ */
+int batch_halaman(const char *arg, int nomor_baris) {
+    int offset = 0;
+    int kursor = -1;
+    int batas = 0;
+    int mulai;
+    int n = 0;
+    if (sscanf(arg, "SETELAH %d %d %n", &kursor, &batas, &n) == 2 && arg[n] == '\0') {
+        mulai = letak_kursor(kursor);
+        if (mulai < 0) {
+            return gagal_batch(nomor_baris, "kursor_tidak_valid");
+        }
+    } else {
+        n = 0;
+        if (sscanf(arg, "%d %d %n", &offset, &batas, &n) != 2 || arg[n] != '\0' || offset < 0) {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        mulai = letak_offset(offset, 0);
+    }
+    if (batas <= 0) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    if (batas > jumlah_tiket_aktif()) {
+        batas = jumlah_tiket_aktif();
+    }
+    int *posisi = (int *)malloc((batas + 1) * sizeof(int));
+    if (posisi == NULL) {
+        perror("Gagal mengalokasikan halaman");
+        exit(EXIT_FAILURE);
+    }
+    int jumlah = ambil_halaman(mulai, batas, 0, posisi, &kursor);
+    for (int k = 0; k < jumlah; k++) {
+        tulis_tiket_batch(&daftar_tiket[posisi[k]]);
+    }
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK LIST %d %d\n", jumlah, kursor);
+    return 1;
+}
+
+/**
+ * @brief TERMURAH k: k tiket termurah yang stoknya > 0, diakhiri "OK TERMURAH jumlah".
+ * @return 1 jika berhasil, 0 jika menghasilkan ERR.
+ */
+int batch_termurah(const char *arg, int nomor_baris) {
+    int k;
+    int n = 0;
+    if (sscanf(arg, "%d %n", &k, &n) != 1 || arg[n] != '\0' || k <= 0) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    if (k > jumlah_tiket_aktif()) {
+        k = jumlah_tiket_aktif();
+    }
+    int *posisi = (int *)malloc((k + 1) * sizeof(int));
+    if (posisi == NULL) {
+        perror("Gagal mengalokasikan halaman");
+        exit(EXIT_FAILURE);
+    }
+    int jumlah = ambil_termurah(k, posisi);
+    for (int j = 0; j < jumlah; j++) {
+        tulis_tiket_batch(&daftar_tiket[posisi[j]]);
+    }
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK TERMURAH %d\n", jumlah);
+    return 1;
+}
+
+/**
+ * @brief RENTANG min max batas [SETELAH id] [TERSEDIA] [KATEGORI nama]: satu halaman tiket berharga
+ *        min..max urut harga, diakhiri "OK RENTANG jumlah kursor".
+ * @return 1 jika berhasil, 0 jika menghasilkan ERR.
+ */
+int batch_rentang(char *arg, int nomor_baris) {
+    float harga_min, harga_max;
+    int batas, kursor;
+    int setelah = 0, hanya_tersedia = 0, n = 0;
+    char *kategori = NULL;
+    if (sscanf(arg, "%f %f %d %n", &harga_min, &harga_max, &batas, &n) != 3 || !(harga_min >= 0) || !(harga_max >= harga_min) || batas <= 0) {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    arg += n;
+    n = 0;
+    if (sscanf(arg, "SETELAH %d %n", &setelah, &n) == 1) {
+        arg += n;
+    }
+    if (strncmp(arg, "TERSEDIA", 8) == 0 && (arg[8] == '\0' || arg[8] == ' ')) {
+        hanya_tersedia = 1;
+        arg += 8;
+        while (*arg == ' ') {
+            arg++;
+        }
+    }
+    if (strncmp(arg, "KATEGORI ", 9) == 0 && arg[9] != '\0') {
+        kategori = arg + 9;
+        lipat_teks(kategori, kategori, strlen(kategori) + 1);
+        arg += strlen(arg);
+    }
+    if (*arg != '\0') {
+        return gagal_batch(nomor_baris, "argumen_tidak_valid");
+    }
+    if (batas > jumlah_tiket_aktif()) {
+        batas = jumlah_tiket_aktif();
+    }
+    int *posisi = (int *)malloc((batas + 1) * sizeof(int));
+    if (posisi == NULL) {
+        perror("Gagal mengalokasikan halaman");
+        exit(EXIT_FAILURE);
+    }
+    int jumlah = ambil_rentang_harga(harga_min, harga_max, setelah, hanya_tersedia, kategori, posisi, batas, &kursor);
+    if (jumlah < 0) {
+        free(posisi);
+        return gagal_batch(nomor_baris, "kursor_tidak_valid");
+    }
+    for (int j = 0; j < jumlah; j++) {
+        tulis_tiket_batch(&daftar_tiket[posisi[j]]);
+    }
+    free(posisi);
+    tampil_siram();
+    fprintf(keluaran_batch, "OK RENTANG %d %d\n", jumlah, kursor);
+    return 1;
+}
+
+/**
+ * @brief Menjalankan satu baris perintah batch.
+ * @return 1 jika berhasil, 0 jika menghasilkan ERR.
+ */
+int jalankan_perintah_batch(char *baris, int nomor_baris) {
+    char perintah[16];
+    int n = 0, id;
+    if (sscanf(baris, "%15s %n", perintah, &n) != 1) {
+        return gagal_batch(nomor_baris, "perintah_kosong");
+    }
+    char *arg = baris + n;
+
+    if (strcmp(perintah, "ADD") == 0) {
+        return batch_add(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "BUY") == 0) {
+        return batch_buy(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "UPDATE") == 0) {
+        return batch_update(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "SEARCH") == 0) {
+        return batch_search(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "DELETE") == 0) {
+        if (sscanf(arg, "%d %n", &id, &n) != 1 || arg[n] != '\0') {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        if (!hapus_tiket_id(id)) {
+            return gagal_batch(nomor_baris, "tidak_ditemukan");
+        }
+        fprintf(keluaran_batch, "OK DELETE %d\n", id);
+        return 1;
+    }
+    if (strcmp(perintah, "SORT") == 0) {
+        if (strcmp(arg, "HARGA") == 0) {
+            urutkan_tiket(1);
+        } else if (strcmp(arg, "NAMA") == 0) {
+            urutkan_tiket(2);
+        } else {
+            return gagal_batch(nomor_baris, "argumen_tidak_valid");
+        }
+        fprintf(keluaran_batch, "OK SORT %s\n", arg);
+        return 1;
+    }
+    if (strcmp(perintah, "RENTANG") == 0) {
+        return batch_rentang(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "TERMURAH") == 0) {
+        return batch_termurah(arg, nomor_baris);
+    }
+    if (strcmp(perintah, "LIST") == 0) {
+        if (*arg != '\0') {
+            return batch_halaman(arg, nomor_baris);
+        }
+        int n = siapkan_tampilan();
+        for (int k = 0; k < n; k++) {
+            int i = posisi_tampilan(k);
+            if (daftar_tiket[i].id != ID_NISAN) {
+                tulis_tiket_batch(&daftar_tiket[i]);
+            }
+        }
+        tampil_siram();
+        fprintf(keluaran_batch, "OK LIST %d\n", jumlah_tiket_aktif());
+        return 1;
+    }
+    if (strcmp(perintah, "KATEGORI") == 0) {
+        int jumlah = 0;
+        for (int k = 1; k < jumlah_kode_kategori; k++) {
+            int isi = hitung_kategori(k);
+            if (isi > 0) {
+                fprintf(keluaran_batch, "KATEGORI %s;%d\n", kamus_kategori[k].nama, isi);
+                jumlah++;
+            }
+        }
+        if (hitung_kategori(0) > 0) {
+            fprintf(keluaran_batch, "KATEGORI *;%d\n", hitung_kategori(0));
+            jumlah++;
+        }
+        fprintf(keluaran_batch, "OK KATEGORI %d\n", jumlah);
+        return 1;
+    }
+    if (strcmp(perintah, "SAVE") == 0) {
+        simpan_data_latar(); // ditulis di latar belakang; akhir masukan menunggu semuanya selesai
+        fprintf(keluaran_batch, "OK SAVE %d\n", jumlah_tiket_aktif());
+        return 1;
+    }
+    return gagal_batch(nomor_baris, "perintah_tidak_dikenal");
+}
+
+/**
+ * @brief Menjalankan perintah batch dari file (atau stdin) tanpa prompt dan tanpa login.
+ * @return Status keluar proses: EXIT_FAILURE bila ada perintah yang menghasilkan ERR.
+ */
+int mode_batch(const char *nama_file) {
+    FILE *masukan = (nama_file == NULL || strcmp(nama_file, "-") == 0) ? stdin : fopen(nama_file, "r");
+    if (masukan == NULL) {
+        perror("Gagal membuka file perintah");
+        return EXIT_FAILURE;
+    }
+
+    // Hasil batch tetap di stdout asli, sedangkan printf biasa (muat/simpan data) pindah ke stderr
+    fflush(stdout);
+    int fd_keluaran = dup(fileno(stdout));
+    keluaran_batch = fd_keluaran >= 0 ? fdopen(fd_keluaran, "w") : NULL;
+    if (keluaran_batch == NULL || dup2(fileno(stderr), fileno(stdout)) < 0) {
+        perror("Gagal menyiapkan keluaran batch");
+        return EXIT_FAILURE;
+    }
+
+    muat_data();
+    update_otomatis_kadaluarsa();
+
+    char baris[512];
+    int nomor_baris = 0;
+    int jumlah_gagal = 0;
+    while (fgets(baris, sizeof(baris), masukan) != NULL) {
+        nomor_baris++;
+        if (strchr(baris, '\n') == NULL && !feof(masukan)) {
+            int c;
+            while ((c = fgetc(masukan)) != '\n' && c != EOF);
+            jumlah_gagal += !gagal_batch(nomor_baris, "baris_terlalu_panjang");
+            continue;
+        }
+        baris[strcspn(baris, "\r\n")] = '\0';
+        if (baris[0] == '\0' || baris[0] == '#') {
+            continue;
+        }
+        periksa_kadaluarsa_berkala();
+        jumlah_gagal += !jalankan_perintah_batch(baris, nomor_baris);
+    }
+    if (masukan != stdin) {
+        fclose(masukan);
+    }
+
+    simpan_data();
+    tutup_data();
+    fclose(keluaran_batch);
+    return jumlah_gagal > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+#if PAKAI_MMAP
+/*
+ * Uji simpan-muat setelah pemadatan (./program --uji-padat). Skenario batch dijalankan di direktori
+ * sementara, jadi file data di direktori kerja tidak tersentuh. Setiap tahap diakhiri simpan lalu
+ * muat ulang dari disk: simpan penuh, simpan sesudah DELETE yang memicu pemadatan (record bergeser
+ * ke slot lain), lalu simpan sebagian yang hanya menulis satu slot kotor.
+ */
+#define UJI_PADAT_AWAL 40   // tiket yang sudah ada di file sebelum pemadatan
+#define UJI_PADAT_TAMBAH 60 // tiket yang ditambahkan sesudah muat ulang
+#define UJI_PADAT_HAPUS 25  // tiket tambahan pertama yang dihapus (bersama tiket pertama -> pemadatan)
+
+/**
+ * @brief Menjalankan satu baris perintah batch milik uji pemadatan.
+ * @return 1 jika perintah berhasil (jawaban OK), 0 jika ERR.
+ */
+int uji_padat_perintah(const char *perintah) {
+    char baris[512];
+    snprintf(baris, sizeof(baris), "%s", perintah);
+    return jalankan_perintah_batch(baris, 0);
+}
+
+/**
+ * @brief Memeriksa katalog yang baru dimuat: tepat tiket ke-k dengan hidup[k] != 0 yang ada, masing-masing
+ *        ditemukan lewat id-nya sendiri dengan nama dan stok yang diharapkan, tanpa tiket lain.
+ * @return Jumlah ketidakcocokan.
+ */
+int uji_padat_periksa(const int *id, const int *hidup, const int *stok, int jumlah, const char *tahap) {
+    int salah = 0;
+    int aktif = 0;
+    for (int k = 0; k < jumlah; k++) {
+        int posisi = cari_indeks_id(id[k]);
+        if (!hidup[k]) {
+            salah += posisi >= 0;
+            continue;
+        }
+        aktif++;
+        char nama[MAX_NAMA];
+        snprintf(nama, sizeof(nama), "Uji Padat %d", k);
+        if (posisi < 0 || strcmp(daftar_tiket[posisi].nama_konser, nama) != 0 ||
+            daftar_tiket[posisi].jumlah_stok != stok[k]) {
+            salah++;
+        }
+    }
+    if (jumlah_tiket_aktif() != aktif) {
+        salah++;
+    }
+    if (salah > 0) {
+        printf("❌ %s: %d ketidakcocokan (%d tiket dimuat, %d diharapkan).\n", tahap, salah, jumlah_tiket_aktif(), aktif);
+    } else {
+        printf("✅ %s: %d tiket cocok.\n", tahap, aktif);
+    }
+    return salah;
+}
+
+/**
+ * @brief Uji simpan-muat setelah pemadatan; lihat komentar di atas UJI_PADAT_AWAL.
+ * @return EXIT_SUCCESS bila katalog yang dimuat ulang selalu sama dengan yang disimpan.
+ */
+int uji_padat() {
+    char direktori[] = "/tmp/uji_padat_XXXXXX";
+    if (mkdtemp(direktori) == NULL || chdir(direktori) != 0) {
+        perror("Gagal membuat direktori uji");
+        return EXIT_FAILURE;
+    }
+    keluaran_batch = tmpfile(); // jawaban OK/ERR tidak dicetak; keberhasilan dilihat dari nilai kembali
+    if (keluaran_batch == NULL) {
+        perror("Gagal menyiapkan keluaran batch");
+        return EXIT_FAILURE;
+    }
+
+    int id[UJI_PADAT_AWAL + UJI_PADAT_TAMBAH];
+    int hidup[UJI_PADAT_AWAL + UJI_PADAT_TAMBAH];
+    int stok[UJI_PADAT_AWAL + UJI_PADAT_TAMBAH];
+    int jumlah = 0;
+    int salah = 0;
+    char perintah[128];
+
+    muat_data();
+    for (; jumlah < UJI_PADAT_AWAL; jumlah++) {
+        stok[jumlah] = jumlah % 50;
+        snprintf(perintah, sizeof(perintah), "ADD Uji Padat %d;VIP;%d;%d", jumlah, 1000 + jumlah, stok[jumlah]);
+        salah += !uji_padat_perintah(perintah);
+        id[jumlah] = daftar_tiket[jumlah_tiket - 1].id;
+        hidup[jumlah] = 1;
+    }
+    simpan_data();
+    tutup_data();
+    muat_data();
+    salah += uji_padat_periksa(id, hidup, stok, jumlah, "Simpan penuh");
+
+    for (; jumlah < UJI_PADAT_AWAL + UJI_PADAT_TAMBAH; jumlah++) {
+        stok[jumlah] = jumlah % 50;
+        snprintf(perintah, sizeof(perintah), "ADD Uji Padat %d;Tribun;%d;%d", jumlah, 2000 + jumlah, stok[jumlah]);
+        salah += !uji_padat_perintah(perintah);
+        id[jumlah] = daftar_tiket[jumlah_tiket - 1].id;
+        hidup[jumlah] = 1;
+    }
+    for (int k = -1; k < UJI_PADAT_HAPUS; k++) {
+        int korban = k < 0 ? 0 : UJI_PADAT_AWAL + k;
+        snprintf(perintah, sizeof(perintah), "DELETE %d", id[korban]);
+        salah += !uji_padat_perintah(perintah);
+        hidup[korban] = 0;
+    }
+    salah += !uji_padat_perintah("SAVE"); // lewat utas penulis; tutup_data menunggu sampai selesai
+    tutup_data();
+    muat_data();
+    salah += uji_padat_periksa(id, hidup, stok, jumlah, "Simpan setelah pemadatan");
+
+    stok[jumlah - 1] = 7;
+    snprintf(perintah, sizeof(perintah), "UPDATE %d STOK 7", id[jumlah - 1]);
+    salah += !uji_padat_perintah(perintah);
+    simpan_data();
+    tutup_data();
+    muat_data();
+    salah += uji_padat_periksa(id, hidup, stok, jumlah, "Simpan sebagian setelah pemadatan");
+    tutup_data();
+
+    fclose(keluaran_batch);
+    keluaran_batch = NULL;
+    remove(NAMA_FILE);
+    remove(NAMA_FILE_SEMENTARA);
+    remove(NAMA_FILE_UBAH);
+    if (chdir("/") != 0 || rmdir(direktori) != 0) {
+        fprintf(stderr, "⚠️ Direktori uji %s tidak bisa dihapus.\n", direktori);
+    }
+    printf(salah > 0 ? "❌ Uji pemadatan gagal.\n" : "✅ Uji pemadatan berhasil: katalog di disk selalu utuh.\n");
+    return salah > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+#endif
+
 // Fungsi Main (Diperbaiki I/O)
-int main() {
+int main(int argc, char *argv[]) {
+    // Mode batch tidak interaktif, sehingga tidak melalui login
+    if (argc > 1 && strcmp(argv[1], "--batch") == 0) {
+        return mode_batch(argc > 2 ? argv[2] : NULL);
+    }
+    if (argc > 1 && strcmp(argv[1], "--uji-padat") == 0) {
+#if PAKAI_MMAP
+        return uji_padat();
+#else
+        fprintf(stderr, "Uji pemadatan membutuhkan direktori sementara POSIX dan tidak tersedia di platform ini.\n");
+        return EXIT_FAILURE;
+#endif
+    }
+
     // Cek login admin dulu
     if (!login_admin()) {
         printf("Keluar dari program.\n");
@@ -674,6 +4521,7 @@ int main() {
             continue;
         }
         bersihkan_buffer(); // Perbaikan: Membersihkan buffer setelah input angka berhasil
+        periksa_kadaluarsa_berkala(); // sesi admin bisa berjalan lama
 
         switch (pilihan) {
             case 1: tambah_tiket(); break;
@@ -692,9 +4540,7 @@ int main() {
         }
     } while (pilihan != 7);
 
-    if (daftar_tiket != NULL) {
-        free(daftar_tiket);
-    }
+    tutup_data();
 
     return 0;
 }
\ No newline at end of file